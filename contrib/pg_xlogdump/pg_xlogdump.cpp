@@ -239,10 +239,13 @@ static void XLogDumpTablePage(XLogReaderState* record, int block_id, RelFileNode
     if (fd < 0)
         fatal_error("could not create file %s :%m", block_path);
 
-    RestoreBlockImage(record->blocks[block_id].bkp_image,
+    if (!RestoreBlockImage(record->blocks[block_id].bkp_image,
         record->blocks[block_id].hole_offset,
         record->blocks[block_id].hole_length,
-        page);
+        record->blocks[block_id].bimg_len,
+        record->blocks[block_id].bimg_method,
+        page))
+        fatal_error("could not restore image of block %u: invalid compressed data", blk);
 
     nbyte = write(fd, page, BLCKSZ);
     if (nbyte != BLCKSZ)
@@ -384,16 +387,17 @@ static void XLogDumpCountRecord(XLogDumpConfig* config, XLogDumpStats* stats, XL
 
     /*
      * Calculate the amount of FPI data in the record. Each backup block
-     * takes up BLCKSZ bytes, minus the "hole" length.
+     * takes up BLCKSZ bytes, minus the "hole" length, or less if it was
+     * compressed.
      *
      * XXX: We peek into xlogreader's private decoded backup blocks for the
-     * hole_length. It doesn't seem worth it to add an accessor macro for
+     * bimg_len. It doesn't seem worth it to add an accessor macro for
      * this.
      */
     fpi_len = 0;
     for (block_id = 0; block_id <= record->max_block_id; block_id++) {
         if (XLogRecHasBlockImage(record, block_id))
-            fpi_len += BLCKSZ - record->blocks[block_id].hole_length;
+            fpi_len += record->blocks[block_id].bimg_len;
     }
 
     /* Update per-rmgr statistics */
@@ -539,6 +543,8 @@ static void XLogDumpDisplayRecord(XLogDumpConfig* config, XLogReaderState* recor
                 printf(" (FPW); hole: offset: %u, length: %u",
                     record->blocks[block_id].hole_offset,
                     record->blocks[block_id].hole_length);
+                if (record->blocks[block_id].bimg_method == BKPIMAGE_COMPRESS_LZ4)
+                    printf(", compressed: lz4, stored length: %u", record->blocks[block_id].bimg_len);
 
                 if (config->write_fpw)
                     XLogDumpTablePage(record, block_id, rnode, blk);
@@ -1803,7 +1803,7 @@ extractPageInfo(XLogReaderState *record, XLogReaderData *reader_data,
         * they will be removed appropriately.
         */
     }
-    else if (rmid == RM_SMGR_ID && rminfo == XLOG_SMGR_CREATE)
+    else if (rmid == RM_SMGR_ID && (rminfo == XLOG_SMGR_CREATE || rminfo == XLOG_SMGR_CREATE_COMPRESSED))
     {
         /*
         * We can safely ignore these. The file will be removed when
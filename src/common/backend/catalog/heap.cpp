@@ -444,7 +444,7 @@ static void InitPartitionDef(Partition newPartition, Oid partOid, char strategy)
 Relation heap_create(const char* relname, Oid relnamespace, Oid reltablespace, Oid relid, Oid relfilenode,
     Oid bucketOid, TupleDesc tupDesc, char relkind, char relpersistence, bool partitioned_relation, bool rowMovement,
     bool shared_relation, bool mapped_relation, bool allow_system_table_mods, int8 row_compress, Oid ownerid,
-    bool skip_create_storage, TableAmType tam_type)
+    bool skip_create_storage, TableAmType tam_type, uint8 page_compress)
 {
     bool create_storage = false;
     Relation rel;
@@ -570,7 +570,7 @@ Relation heap_create(const char* relname, Oid relnamespace, Oid reltablespace, O
     if (create_storage) {
         rel->rd_bucketoid = bucketOid;
         RelationOpenSmgr(rel);
-        RelationCreateStorage(rel->rd_node, relpersistence, ownerid, bucketOid, relfilenode, rel);
+        RelationCreateStorage(rel->rd_node, relpersistence, ownerid, bucketOid, relfilenode, rel, page_compress);
     }
 
     if (RelationUsesSpaceType(rel->rd_rel->relpersistence) == SP_TEMP) {
@@ -2558,6 +2558,24 @@ Oid heap_create_with_catalog(const char* relname, Oid relnamespace, Oid reltable
     /* Get tableAmType from reloptions and relkind */
     bytea* hreloptions = heap_reloptions(relkind, reloptions, false);
     TableAmType tam = get_tableam_from_reloptions(hreloptions, relkind);
+    uint8 pageCompress = PageCompressAlgorithmByName(RelationGetPageCompressType(hreloptions));
+
+    if (pageCompress != PAGE_COMPRESS_NONE) {
+        if (relkind != RELKIND_RELATION || tam != TAM_HEAP ||
+            pg_strcasecmp(StdRdOptionsGetStringData(hreloptions, orientation, ORIENTATION_ROW), ORIENTATION_ROW) != 0) {
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                            errmsg("option \"compresstype\" is only supported for row tables using heap")));
+        }
+        if (relpersistence != RELPERSISTENCE_PERMANENT || partTableState != NULL || bucketinfo != NULL) {
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                            errmsg("option \"compresstype\" is not supported for temporary, unlogged, partitioned or "
+                                   "hash bucket tables")));
+        }
+        if (g_instance.attr.attr_storage.enable_adio_function) {
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                            errmsg("option \"compresstype\" is not supported when enable_adio_function is on")));
+        }
+    }
 
     /*
      * Create the relcache entry (mostly dummy at this point) and the physical
@@ -2582,7 +2600,8 @@ Oid heap_create_with_catalog(const char* relname, Oid relnamespace, Oid reltable
         row_compress,
         ownerid,
         false,
-		tam);
+		tam,
+        pageCompress);
 
     /* Recode the table or other object in pg_class create time. */
     PgObjectType objectType = GetPgObjectTypePgClass(relkind);
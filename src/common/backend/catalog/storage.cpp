@@ -200,7 +200,8 @@ static void InsertStorageIntoPendingList(_in_ const RelFileNode* rnode, _in_ Att
     }
 }
 
-static void RelationCreateStorageInternal(RelFileNode rnode, char relpersistence, Oid ownerid, const oidvector* bucketlist = NULL, Relation rel = NULL)
+static void RelationCreateStorageInternal(RelFileNode rnode, char relpersistence, Oid ownerid, const oidvector* bucketlist = NULL, Relation rel = NULL,
+    uint8 pageCompress = PAGE_COMPRESS_NONE)
 {
     SMgrRelation srel;
     BackendId backend;
@@ -211,10 +212,17 @@ static void RelationCreateStorageInternal(RelFileNode rnode, char relpersistence
     StorageSetBackendAndLogged(relpersistence, &backend, &needs_wal);
 
     srel = smgropen(rnode, backend, 0, bucketlist);
-    smgrcreate(srel, MAIN_FORKNUM, false);
+    if (pageCompress != PAGE_COMPRESS_NONE) {
+        /* heap_create_with_catalog() only allows compression for plain permanent relations */
+        Assert(needs_wal && rnode.bucketNode == InvalidBktId);
+        smgrcreatecompressed(srel, pageCompress, false);
+        log_smgrcreate_compressed(&srel->smgr_rnode.node, pageCompress);
+    } else {
+        smgrcreate(srel, MAIN_FORKNUM, false);
 
-    if (needs_wal) {
-        log_smgrcreate(&srel->smgr_rnode.node, MAIN_FORKNUM, bucketlist);
+        if (needs_wal) {
+            log_smgrcreate(&srel->smgr_rnode.node, MAIN_FORKNUM, bucketlist);
+        }
     }
 
     /* Add the relation to the list of stuff to delete at abort 
@@ -245,14 +253,18 @@ static void RelationCreateStorageInternal(RelFileNode rnode, char relpersistence
  *
  * This function is transactional. The creation is WAL-logged, and if the
  * transaction aborts later on, the storage will be destroyed.
+ *
+ * If pageCompress is not PAGE_COMPRESS_NONE, the pages of the main fork are
+ * stored compressed with that algorithm.
  */
 void RelationCreateStorage(RelFileNode rnode, char relpersistence, Oid ownerid,
-    Oid bucketOid, Oid relfilenode, Relation rel)
+    Oid bucketOid, Oid relfilenode, Relation rel, uint8 pageCompress)
 {
     if (OidIsValid(bucketOid) && (bucketOid != VirtualBktOid)) {
+        Assert(pageCompress == PAGE_COMPRESS_NONE);
         BucketCreateStorage(rnode, bucketOid, ownerid, relfilenode);
     } else {
-        RelationCreateStorageInternal(rnode, relpersistence, ownerid, NULL, rel);
+        RelationCreateStorageInternal(rnode, relpersistence, ownerid, NULL, rel, pageCompress);
     }
 }
 
@@ -333,6 +345,23 @@ void log_smgrcreate(RelFileNode* rnode, ForkNumber forkNum, const oidvector* buc
 
 }
 
+/*
+ * Perform XLogInsert of a XLOG_SMGR_CREATE_COMPRESSED record to WAL. It takes
+ * the place of the XLOG_SMGR_CREATE record of the main fork.
+ */
+void log_smgrcreate_compressed(RelFileNode* rnode, uint8 algorithm)
+{
+    xl_smgr_create_compressed xlrec;
+
+    xlrec.create.forkNum = MAIN_FORKNUM;
+    RelFileNodeRelCopy(xlrec.create.rnode, *rnode);
+    xlrec.algorithm = algorithm;
+
+    XLogBeginInsert();
+    XLogRegisterData((char*)&xlrec, sizeof(xlrec));
+    XLogInsert(RM_SMGR_ID, XLOG_SMGR_CREATE_COMPRESSED | XLR_SPECIAL_REL_UPDATE, false, rnode->bucketNode);
+}
+
 static void CStoreRelDropStorage(Relation rel, RelFileNode* rnode, Oid ownerid)
 {
     Assert((RelationIsColStore(rel)));
@@ -1118,6 +1147,15 @@ void smgr_redo_create(RelFileNode rnode, ForkNumber forkNum, char *data)
         DELETE_EX(cuStorage);
     }
 }
+
+void smgr_redo_create_compressed(RelFileNode rnode, char *data)
+{
+    xl_smgr_create_compressed *xlrec = (xl_smgr_create_compressed *)data;
+    SMgrRelation reln = smgropen(rnode, InvalidBackendId);
+
+    smgrcreatecompressed(reln, xlrec->algorithm, true);
+}
+
 void xlog_block_smgr_redo_truncate(RelFileNode rnode, BlockNumber blkno, XLogRecPtr lsn)
 {
     SMgrRelation reln = smgropen(rnode, InvalidBackendId);
@@ -1150,6 +1188,12 @@ void smgr_redo(XLogReaderState* record)
         smgr_redo_create(rnode, xlrec->forkNum, (char *)xlrec);    
             /* Redo column file, attid is hidden in forkNum */
 
+    } else if (info == XLOG_SMGR_CREATE_COMPRESSED) {
+        xl_smgr_create_compressed* xlrec = (xl_smgr_create_compressed*)XLogRecGetData(record);
+
+        RelFileNode rnode;
+        RelFileNodeCopy(rnode, xlrec->create.rnode, XLogRecGetBucketId(record));
+        smgr_redo_create_compressed(rnode, (char *)xlrec);
     } else if (info == XLOG_SMGR_TRUNCATE) {
         xl_smgr_truncate* xlrec = (xl_smgr_truncate*)XLogRecGetData(record);
         RelFileNode rnode;
@@ -2276,5 +2320,8 @@ bool IsSmgrTruncate(const XLogReaderState* record)
 }
 bool IsSmgrCreate(const XLogReaderState* record)
 {
-    return (XLogRecGetRmid(record) == RM_SMGR_ID && (XLogRecGetInfo(record) & (~XLR_INFO_MASK)) == XLOG_SMGR_CREATE);
+    uint8 info = XLogRecGetInfo(record) & (~XLR_INFO_MASK);
+
+    return (XLogRecGetRmid(record) == RM_SMGR_ID &&
+            (info == XLOG_SMGR_CREATE || info == XLOG_SMGR_CREATE_COMPRESSED));
 }
@@ -12423,6 +12423,77 @@ Datum local_bgwriter_stat(PG_FUNCTION_ARGS)
     PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
 }
 
+#define BUFFER_STRATEGY_STAT_COL_NUM 8
+
+/*
+ * local_buffer_strategy_stat
+ *		Hit and eviction counters of the shared buffer replacement policy.
+ *		They only move under buffer_replacement_policy = 2q.
+ */
+Datum local_buffer_strategy_stat(PG_FUNCTION_ARGS)
+{
+    BufferStrategyStats stats;
+    TupleDesc tupdesc = NULL;
+    Datum values[BUFFER_STRATEGY_STAT_COL_NUM];
+    bool nulls[BUFFER_STRATEGY_STAT_COL_NUM] = {false};
+    int i = 0;
+
+    tupdesc = CreateTemplateTupleDesc(BUFFER_STRATEGY_STAT_COL_NUM, false, TAM_HEAP);
+    TupleDescInitEntry(tupdesc, (AttrNumber)1, "policy", TEXTOID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)2, "probation_hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)3, "protected_hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)4, "ghost_hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)5, "misses", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)6, "probation_evictions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)7, "protected_evictions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)8, "protected_percent", INT4OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    StrategyGetStats(&stats);
+
+    values[i++] = CStringGetTextDatum(
+        g_instance.attr.attr_storage.buffer_replacement_policy == BUFFER_POLICY_2Q ? "2q" : "clock");
+    values[i++] = Int64GetDatum((int64)stats.probation_hits);
+    values[i++] = Int64GetDatum((int64)stats.protected_hits);
+    values[i++] = Int64GetDatum((int64)stats.ghost_hits);
+    values[i++] = Int64GetDatum((int64)stats.misses);
+    values[i++] = Int64GetDatum((int64)stats.probation_evictions);
+    values[i++] = Int64GetDatum((int64)stats.protected_evictions);
+    values[i++] = Int32GetDatum((int32)stats.protected_percent);
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+
+#define REDO_PREFETCH_STAT_COL_NUM 4
+
+/*
+ * local_redo_prefetch_stat
+ *		Counters of the blocks the redo dispatcher looked at for prefetching.
+ *		They only move while recovery_prefetch_distance is non-zero.
+ */
+Datum local_redo_prefetch_stat(PG_FUNCTION_ARGS)
+{
+    RedoPerf* redoPf = &g_instance.comm_cxt.predo_cxt.redoPf;
+    TupleDesc tupdesc = NULL;
+    Datum values[REDO_PREFETCH_STAT_COL_NUM];
+    bool nulls[REDO_PREFETCH_STAT_COL_NUM] = {false};
+    int i = 0;
+
+    tupdesc = CreateTemplateTupleDesc(REDO_PREFETCH_STAT_COL_NUM, false, TAM_HEAP);
+    TupleDescInitEntry(tupdesc, (AttrNumber)1, "hits", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)2, "misses", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)3, "skips", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)4, "distance", INT4OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    values[i++] = Int64GetDatum((int64)redoPf->prefetch_hit);
+    values[i++] = Int64GetDatum((int64)redoPf->prefetch_miss);
+    values[i++] = Int64GetDatum((int64)redoPf->prefetch_skip);
+    values[i++] = Int32GetDatum((int32)u_sess->attr.attr_storage.recovery_prefetch_distance);
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
+
 void xc_stat_view(FuncCallContext* funcctx, int col_num, FuncName name)
 {
     MemoryContext oldcontext = NULL;
@@ -3834,6 +3834,31 @@ void RelationCloseSmgrByOid(Oid relationId)
     RelationCloseSmgr(relation);
 }
 
+/*
+ * RelationInitSmgrCompress - tell a newly opened smgr link whether the main
+ * fork is page compressed, so md.cpp only maps address files when it is
+ *
+ * A fake relcache entry does not know, and neither does the entry of a table
+ * created in this command before its reloptions are read back. md.cpp checks
+ * for an address file for those.
+ */
+void RelationInitSmgrCompress(Relation relation)
+{
+    SMgrRelation reln = relation->rd_smgr;
+
+    if (reln->smgr_compress != SMGR_COMPRESS_UNKNOWN) {
+        return;
+    }
+
+    if (relation->rd_rel->relkind != RELKIND_RELATION) {
+        if (relation->rd_rel->relkind != '\0') {
+            reln->smgr_compress = PAGE_COMPRESS_NONE;
+        }
+    } else if (relation->rd_options != NULL || IsSystemRelation(relation)) {
+        reln->smgr_compress = RelationGetPageCompress(relation);
+    }
+}
+
 Oid RelationGetBucketOid(Relation relation)
 {
     return relation->rd_bucketoid;
@@ -4425,7 +4450,8 @@ void RelationSetNewRelfilenode(Relation relation, TransactionId freezeXid, bool
     newrnode.node.relNode = newrelfilenode;
     newrnode.backend = relation->rd_backend;
     RelationCreateStorage(newrnode.node, relation->rd_rel->relpersistence,
-        relation->rd_rel->relowner, relation->rd_bucketoid, newrelfilenode, relation);
+        relation->rd_rel->relowner, relation->rd_bucketoid, newrelfilenode, relation,
+        RelationGetPageCompress(relation));
     smgrclosenode(newrnode);
 
     /*
@@ -387,6 +387,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_sonic_optspill",
     "enable_sonic_hashjoin",
     "enable_sonic_hashagg",
+    "enable_sonic_shared_hashjoin",
 #ifdef ENABLE_MULTIPLE_NODES
     "enable_stream_recursive",
 #endif
@@ -958,6 +959,14 @@ static const struct config_enum_entry remote_read_options[] = {{"off", REMOTE_RE
     {"authentication", REMOTE_READ_AUTH, false},
     {NULL, 0, false}};
 
+static const struct config_enum_entry buffer_replacement_options[] = {{"clock", BUFFER_POLICY_CLOCK, false},
+    {"2q", BUFFER_POLICY_2Q, false},
+    {NULL, 0, false}};
+
+static const struct config_enum_entry wal_compression_options[] = {{"off", WAL_COMPRESSION_OFF, false},
+    {"lz4", WAL_COMPRESSION_LZ4, false},
+    {NULL, 0, false}};
+
 static const struct config_enum_entry resource_track_log_options[] = {
     {"summary", SUMMARY, false}, {"detail", DETAIL, false}, {NULL, 0, false}};
 
@@ -1339,6 +1348,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_flat_expr",
+            PGC_USERSET,
+            QUERY_TUNING_METHOD,
+            gettext_noop("Enable evaluation of row expressions as flattened step programs."),
+            NULL},
+            &u_sess->attr.attr_sql.enable_flat_expr,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_delta_store", PGC_POSTMASTER, QUERY_TUNING, gettext_noop("Enable delta for column store."), NULL},
             &g_instance.attr.attr_storage.enable_delta_store,
             false,
@@ -1388,6 +1407,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_sonic_shared_hashjoin",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enable one Sonic hashjoin hash table shared by smp threads."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_sonic_shared_hashjoin,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_csqual_pushdown", PGC_SUSET, LOGGING_WHAT, gettext_noop("Enables colstore qual push down."), NULL},
             &u_sess->attr.attr_sql.enable_csqual_pushdown,
             true,
@@ -1765,6 +1794,17 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_wal_insert_staging",
+             PGC_POSTMASTER,
+             WAL_SETTINGS,
+             gettext_noop("Stages WAL records in per NUMA node buffers before they are gathered into WAL buffers."),
+             gettext_noop("Inserters then only write to memory local to their NUMA node, and records are "
+                          "moved into the WAL buffers in LSN order when the WAL is written out.")},
+            &g_instance.attr.attr_storage.enable_wal_insert_staging,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"log_checkpoints", PGC_SIGHUP, LOGGING_WHAT, gettext_noop("Logs each checkpoint."), NULL},
             &u_sess->attr.attr_common.log_checkpoints,
             false,
@@ -3064,6 +3104,28 @@ static void InitConfigureNamesBool()
             NULL,
             NULL},
 
+        {{"enable_uring_io",
+             PGC_POSTMASTER,
+             RESOURCES_ASYNCHRONOUS,
+             gettext_noop("Submits data file reads, writes, fsyncs and prefetches in batches through io_uring."),
+             NULL},
+            &g_instance.attr.attr_storage.enable_uring_io,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
+        {{"enable_lockfree_buffer_lookup",
+             PGC_POSTMASTER,
+             RESOURCES_MEM,
+             gettext_noop("Looks up resident shared buffers without taking the buffer mapping lock."),
+             NULL},
+            &g_instance.attr.attr_storage.enable_lockfree_buffer_lookup,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
         {{"td_compatible_truncation",
              PGC_USERSET,
              QUERY_TUNING_OTHER,
@@ -6634,6 +6696,19 @@ static void InitConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"uring_queue_depth",
+             PGC_POSTMASTER,
+             RESOURCES_ASYNCHRONOUS,
+             gettext_noop("Sets the number of submission queue entries of the io_uring instance of each thread."),
+             NULL},
+            &g_instance.attr.attr_storage.uring_queue_depth,
+            256,
+            8,
+            4096,
+            NULL,
+            NULL,
+            NULL},
+
         {{"datanode_heartbeat_interval",
              PGC_SIGHUP,
              WAL_CHECKPOINTS,
@@ -6711,6 +6786,18 @@ static void InitConfigureNamesInt()
              NULL,
              NULL,
              NULL},
+        {{"recovery_prefetch_distance",
+             PGC_SIGHUP,
+             RESOURCES_RECOVERY,
+             gettext_noop("Sets how many data blocks parallel redo may prefetch ahead of replay."),
+             gettext_noop("Zero disables prefetching.")},
+             &u_sess->attr.attr_storage.recovery_prefetch_distance,
+             0,
+             0,
+             4096,
+             NULL,
+             NULL,
+             NULL},
 
         {{"force_promote",
             PGC_POSTMASTER,
@@ -8880,6 +8967,18 @@ static void InitConfigureNamesEnum()
             assign_xlog_sync_method,
             NULL},
 
+        {{"wal_compression",
+             PGC_SUSET,
+             WAL_SETTINGS,
+             gettext_noop("Compresses full-page images written to WAL."),
+             gettext_noop("Each image is stored compressed only if that makes it smaller.")},
+            &u_sess->attr.attr_storage.wal_compression,
+            WAL_COMPRESSION_OFF,
+            wal_compression_options,
+            NULL,
+            NULL,
+            NULL},
+
         {{"xmlbinary",
              PGC_USERSET,
              CLIENT_CONN_STATEMENT,
@@ -8968,6 +9067,19 @@ static void InitConfigureNamesEnum()
             NULL,
             NULL},
 
+        {{"buffer_replacement_policy",
+             PGC_POSTMASTER,
+             RESOURCES_MEM,
+             gettext_noop("Sets the algorithm that chooses which shared buffer to replace."),
+             gettext_noop("2q evicts pages referenced only once before pages referenced repeatedly, "
+                          "so large scans do not flush the working set.")},
+            &g_instance.attr.attr_storage.buffer_replacement_policy,
+            BUFFER_POLICY_CLOCK,
+            buffer_replacement_options,
+            NULL,
+            NULL,
+            NULL},
+
         {
             {
                 "application_type", PGC_USERSET, GTM,
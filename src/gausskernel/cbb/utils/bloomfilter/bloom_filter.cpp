@@ -931,6 +931,28 @@ void BloomFilterImpl<baseType>::unionAll(const BloomFilter& that)
 {
     if (numBits == that.getBitSize() && numHashFunctions == that.getNumHashFunctions()) {
         bitSet->unionAll(that.getBitSet());
+
+        /* The single value shortcut and the min/max must cover both sides. */
+        if (addMinMax && that.hasMinMax()) {
+            baseType minV = datumToValue(that.getMin());
+            baseType maxV = datumToValue(that.getMax());
+            if (!hasMM) {
+                minValue = minV;
+                maxValue = maxV;
+                hasMM = true;
+            } else {
+                if (compareValue(minValue, minV) > 0) {
+                    minValue = minV;
+                }
+                if (compareValue(maxValue, maxV) < 0) {
+                    maxValue = maxV;
+                }
+            }
+        } else if (that.getNumValues() > 0) {
+            addMinMax = false;
+            hasMM = false;
+        }
+        numValues += that.getNumValues();
     } else {
         ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("BloomFilters are not compatible for merging.")));
     }
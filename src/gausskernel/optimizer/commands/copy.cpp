@@ -4292,8 +4292,8 @@ static uint64 CopyFrom(CopyState cstate)
     /* Handle queued AFTER triggers */
     AfterTriggerEndQuery(estate);
 
-    /* To free the statement allocated in ExecForeignInsert, MOT doesn't need this */
-    if (isForeignTbl && !isMOTFromTblOid(RelationGetRelid(cstate->rel))) {
+    /* To free the statement allocated in ExecForeignInsert, MOT also inserts its last batch of rows here */
+    if (isForeignTbl) {
         resultRelInfo->ri_FdwRoutine->EndForeignModify(estate, resultRelInfo);
     }
 
@@ -2485,6 +2485,7 @@ static void ExplainNode(
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
+            show_bloomfilter<false>(plan, planstate, ancestors, es);
             show_llvm_info(planstate, es);
             break;
         case T_DfsScan: {
@@ -2619,6 +2620,7 @@ static void ExplainNode(
             show_upper_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 2, planstate, es);
+            show_bloomfilter<true>(plan, planstate, ancestors, es);
             show_skew_optimization(planstate, es);
         } break;
         case T_VecHashJoin: {
@@ -13820,7 +13820,8 @@ static void atexecset_table_space(Relation rel, Oid newTableSpace, Oid newrelfil
     newrnode = rel->rd_node;
     newrnode.relNode = newrelfilenode;
     newrnode.spcNode = newTableSpace;
-    RelationCreateStorage(newrnode, rel->rd_rel->relpersistence, rel->rd_rel->relowner, rel->rd_bucketoid, newrelfilenode, rel);
+    RelationCreateStorage(newrnode, rel->rd_rel->relpersistence, rel->rd_rel->relowner, rel->rd_bucketoid, newrelfilenode, rel,
+        RelationGetPageCompress(rel));
     
     if (RELATION_CREATE_BUCKET(rel)) {
         oidvector* bucketlist = searchHashBucketByOid(rel->rd_bucketoid);
@@ -4422,7 +4422,9 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
 
     switch (nodeTag(plan)) {
         case T_ForeignScan:
-        case T_DfsScan: {
+        case T_DfsScan:
+        case T_CStoreScan:
+        case T_SeqScan: {
             if (IsA(plan, ForeignScan)) {
                 ForeignScan* splan = (VecForeignScan*)plan;
 
@@ -4483,13 +4485,16 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
             }
             break;
         }
+        /*
+         * Do not go below a Limit or WindowAgg: they look at rows the join drops
+         * later, so dropping them early changes which rows, or which values, they
+         * return.
+         */
         case T_Material:
         case T_Sort:
         case T_Unique:
         case T_SetOp:
-        case T_Limit:
         case T_Group:
-        case T_WindowAgg:
         case T_BaseResult: {
             search_var_and_mark_bloomfilter(root, expr, outerPlan(plan), context);
             break;
@@ -4543,6 +4548,13 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
             search_var_and_mark_bloomfilter(root, expr, splan->plan.lefttree, context);
             break;
         }
+        case T_Stream: {
+            /* The smp threads on the other side of a local stream get the filter from the stream node group. */
+            if (STREAM_IS_LOCAL_NODE(((Stream*)plan)->smpDesc.distriType)) {
+                search_var_and_mark_bloomfilter(root, expr, outerPlan(plan), context);
+            }
+            break;
+        }
         default: {
             break;
         }
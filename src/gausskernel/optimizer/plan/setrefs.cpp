@@ -318,6 +318,7 @@ static Plan* set_plan_refs(PlannerInfo* root, Plan* plan, int rtoffset)
             if (splan->tablesample) {
                 splan->tablesample = (TableSampleClause*)fix_scan_expr(root, (Node*)splan->tablesample, rtoffset);
             }
+            splan->plan.var_list = fix_scan_list(root, splan->plan.var_list, rtoffset);
         } break;
         case T_DfsScan: {
             DfsScan* splan = (DfsScan*)plan;
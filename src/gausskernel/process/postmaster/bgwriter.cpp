@@ -60,6 +60,7 @@
 #include "utils/resowner.h"
 #include "utils/timestamp.h"
 #include "gssignal/gs_signal.h"
+#include "gs_bbox.h"
 #include "replication/slot.h"
 
 #define MIN(A, B) ((B) < (A) ? (B) : (A))
@@ -709,6 +710,11 @@ void incre_ckpt_bgwriter_cxt_init()
         g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_buf = (char*)TYPEALIGN(BLCKSZ, unaligned_buf);
         g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_page_idx = -1;
         g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.contain_hashbucket = false;
+        g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_file_id = (uint32)i % dw_batch_file_num();
+        if (BBOX_BLACKLIST_DW_BUFFER) {
+            bbox_blacklist_add(DW_BUFFER, g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_buf,
+                DW_BUF_MAX_FOR_NOHBK * BLCKSZ);
+        }
         g_instance.bgwriter_cxt.bgwriter_procs[i].dirty_list_size = dirty_list_size;
         g_instance.bgwriter_cxt.bgwriter_procs[i].dirty_buf_list =
             (CkptSortItem *)palloc0(dirty_list_size * sizeof(CkptSortItem));
@@ -981,6 +987,7 @@ static uint32 get_candidate_buf(bool *contain_hashbucket)
     int thread_id = t_thrd.bgwriter_cxt.thread_id;
     BgWriterProc *bgwriter = &g_instance.bgwriter_cxt.bgwriter_procs[thread_id];
     CkptSortItem *dirty_buf_list = bgwriter->dirty_buf_list;
+    StrategySweepStats sweep = { 0, 0 };
     int batch_scan_num = MIN(bgwriter->cand_list_size, MAX_SCAN_BATCH_NUM);
     int start = MAX(bgwriter->buf_id_start, bgwriter->next_scan_loc);
     int end = bgwriter->buf_id_start + bgwriter->cand_list_size;
@@ -1008,8 +1015,11 @@ static uint32 get_candidate_buf(bool *contain_hashbucket)
             goto UNLOCK;
         }
 
-        /* Not dirty, put directly into flushed candidates */
+        /* Not dirty, put directly into flushed candidates, unless 2Q keeps it protected */
         if (!(local_buf_state & BM_DIRTY)) {
+            if (!StrategyBufferIsCandidate(&local_buf_state, &sweep)) {
+                goto UNLOCK;
+            }
             if (g_instance.bgwriter_cxt.candidate_free_map[buf_id] == false) {
                 candidate_buf_push(buf_id, thread_id);
                 g_instance.bgwriter_cxt.candidate_free_map[buf_id] = true;
@@ -1039,6 +1049,7 @@ static uint32 get_candidate_buf(bool *contain_hashbucket)
 UNLOCK:
         UnlockBufHdr(buf_desc, local_buf_state);
     }
+    StrategyReportSweep(&sweep);
 
     if (end >= bgwriter->buf_id_start + bgwriter->cand_list_size) {
         bgwriter->next_scan_loc = bgwriter->buf_id_start;
@@ -36,6 +36,7 @@
 #include "storage/pmsignal.h"
 #include "access/double_write.h"
 #include "access/xlog.h"
+#include "gs_bbox.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
 #include "utils/resowner.h"
@@ -229,10 +230,18 @@ void incre_ckpt_pagewriter_cxt_init()
 
     g_instance.ckpt_cxt_ctl->page_writer_procs.running_num = 0;
 
-    char *unaligned_buf = (char*)palloc0((DW_BUF_MAX_FOR_NOHBK + 1) * BLCKSZ);
-	g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_buf = (char*)TYPEALIGN(BLCKSZ, unaligned_buf);
-	g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx = -1;
-	g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.contain_hashbucket = false;
+    /* every pagewriter thread writes its part of the batch to its own dw file */
+    for (int i = 0; i < g_instance.ckpt_cxt_ctl->page_writer_procs.num; i++) {
+        ThrdDwCxt *thrd_dw_cxt = &g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[i].thrd_dw_cxt;
+        char *unaligned_buf = (char*)palloc0((DW_BUF_MAX_FOR_NOHBK + 1) * BLCKSZ);
+        thrd_dw_cxt->dw_buf = (char*)TYPEALIGN(BLCKSZ, unaligned_buf);
+        thrd_dw_cxt->dw_page_idx = -1;
+        thrd_dw_cxt->contain_hashbucket = false;
+        thrd_dw_cxt->dw_file_id = (uint32)i % dw_batch_file_num();
+        if (BBOX_BLACKLIST_DW_BUFFER) {
+            bbox_blacklist_add(DW_BUFFER, thrd_dw_cxt->dw_buf, DW_BUF_MAX_FOR_NOHBK * BLCKSZ);
+        }
+    }
 
     (void)MemoryContextSwitchTo(oldcontext);
 }
@@ -570,7 +579,6 @@ static void ckpt_move_queue_head_after_flush()
     while (true) {
         /* wait all sub thread finish flush */
         if (pg_atomic_read_u32(&g_instance.ckpt_cxt_ctl->page_writer_procs.running_num) == 0) {
-            g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx = -1;
             for (i = 0; i < thread_num; i++) {
                 actual_flushed += g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[i].actual_flush_num;
             }
@@ -641,10 +649,11 @@ static void ckpt_pagewriter_main_thread_flush_dirty_page()
         }
         expected_flush_num -= requested_flush_num;
 
-        g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.contain_hashbucket = contain_hashbucket;
-        g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx = -1;
-
-        dw_perform_batch_flush(requested_flush_num, NULL, &g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt);
+        /* each thread double writes its own part of the batch before flushing it, see ckpt_flush_dirty_page */
+        for (int i = 0; i < g_instance.ckpt_cxt_ctl->page_writer_procs.num; i++) {
+            g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[i].thrd_dw_cxt.contain_hashbucket =
+                contain_hashbucket;
+        }
 
         divide_dirty_page_to_thread(requested_flush_num);
 
@@ -952,9 +961,7 @@ static void ckpt_pagewriter_handle_exception(MemoryContext pagewriter_context)
         g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[id].need_flush = false;
         pg_atomic_fetch_sub_u32(&g_instance.ckpt_cxt_ctl->page_writer_procs.running_num, 1);
     }
-    if (pg_atomic_read_u32(&g_instance.ckpt_cxt_ctl->page_writer_procs.running_num) == 0) {
-        g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx = -1;
-    }
+    g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[id].thrd_dw_cxt.dw_page_idx = -1;
     /* Prevent interrupts while cleaning up */
     HOLD_INTERRUPTS();
 
@@ -46,8 +46,11 @@
 #include "libcomm/libcomm.h"
 #include <sys/poll.h>
 #include "executor/execStream.h"
+#include "executor/execRuntimeFilter.h"
 #include "executor/nodeRecursiveunion.h"
 #include "postmaster/postmaster.h"
+#include "access/relscan.h"
+#include "vectorsonic/vsonichashjoin.h"
 #include "access/transam.h"
 #include "gssignal/gs_signal.h"
 #include "utils/distribute_test.h"
@@ -353,6 +356,9 @@ StreamNodeGroup::StreamNodeGroup()
     m_streamConsumerList = NULL;
     m_streamProducerList = NULL;
     m_syncControllers = NIL;
+    m_parallelBlockAllocators = NIL;
+    m_sonicSharedHashTables = NIL;
+    m_sharedBloomFilters = NIL;
     m_streamRuntimeContext = NULL;
     m_streamArray = NULL;
     m_quitWaitCond = 0;
@@ -1022,6 +1028,15 @@ void StreamNodeGroup::deInit(StreamObjStatus status)
         m_syncControllers = NIL;
     }
 
+    list_free_deep(m_parallelBlockAllocators);
+    m_parallelBlockAllocators = NIL;
+
+    /* the contexts of the tables and filters go with the stream runtime context */
+    list_free_deep(m_sonicSharedHashTables);
+    m_sonicSharedHashTables = NIL;
+    list_free_deep(m_sharedBloomFilters);
+    m_sharedBloomFilters = NIL;
+
     m_streamRuntimeContext = NULL;
 
     /*
@@ -1599,6 +1614,143 @@ SyncController* StreamNodeGroup::GetSyncController(int controller_plannodeid)
     return result;
 }
 
+/*
+ * @Function: GetParallelBlockAllocator()
+ *
+ * @Description: fetch the block allocator shared by the smp workers of a parallel
+ * seq scan, the first worker to ask creates it
+ *
+ * @param[IN] plan_node_id: plan node id of the seq scan
+ * @param[IN] nblocks: blocks to scan, used if the allocator is created
+ *
+ * @return: the shared block allocator
+ */
+ParallelBlockAllocator* StreamNodeGroup::GetParallelBlockAllocator(int plan_node_id, BlockNumber nblocks)
+{
+    ParallelBlockAllocator* result = NULL;
+    AutoMutexLock streamLock(&m_mutex);
+
+    streamLock.lock();
+    {
+        ListCell* lc = NULL;
+        foreach (lc, m_parallelBlockAllocators) {
+            ParallelBlockAllocator* allocator = (ParallelBlockAllocator*)lfirst(lc);
+
+            if (allocator->plan_node_id == plan_node_id) {
+                result = allocator;
+                break;
+            }
+        }
+
+        if (result == NULL) {
+            /* the stream runtime context is shared by the threads of the node group */
+            AutoContextSwitch streamCxtGuard(m_streamRuntimeContext);
+            result = (ParallelBlockAllocator*)palloc(sizeof(ParallelBlockAllocator));
+            result->plan_node_id = plan_node_id;
+            result->nblocks = nblocks;
+            pg_atomic_init_u32(&result->nextchunk, 0);
+            m_parallelBlockAllocators = lappend(m_parallelBlockAllocators, result);
+        }
+    }
+    streamLock.unLock();
+
+    return result;
+}
+
+/*
+ * @Function: GetSonicSharedHashTable()
+ *
+ * @Description: fetch the hash table shared by the smp threads of a Sonic hash
+ * join, the first thread to ask creates it
+ *
+ * @param[IN] plan_node_id: plan node id of the hash join
+ * @param[IN] nthreads: smp threads of the hash join, used if the table is created
+ *
+ * @return: the shared hash table
+ */
+SonicSharedHashTable* StreamNodeGroup::GetSonicSharedHashTable(int plan_node_id, int nthreads)
+{
+    SonicSharedHashTable* result = NULL;
+    AutoMutexLock streamLock(&m_mutex);
+
+    streamLock.lock();
+    {
+        ListCell* lc = NULL;
+        foreach (lc, m_sonicSharedHashTables) {
+            SonicSharedHashTable* table = (SonicSharedHashTable*)lfirst(lc);
+
+            if (table->plan_node_id == plan_node_id) {
+                result = table;
+                break;
+            }
+        }
+
+        if (result == NULL) {
+            AutoContextSwitch streamCxtGuard(m_streamRuntimeContext);
+            result = (SonicSharedHashTable*)palloc0(sizeof(SonicSharedHashTable));
+            result->plan_node_id = plan_node_id;
+            pg_atomic_init_u32(&result->status, SONIC_SHARED_HASH_INIT);
+            pg_atomic_init_u32(&result->nusers, (uint32)nthreads);
+            result->context = AllocSetContextCreate(m_streamRuntimeContext,
+                "SonicSharedHashContext",
+                ALLOCSET_DEFAULT_MINSIZE,
+                ALLOCSET_DEFAULT_INITSIZE,
+                ALLOCSET_DEFAULT_MAXSIZE,
+                SHARED_CONTEXT);
+            m_sonicSharedHashTables = lappend(m_sonicSharedHashTables, result);
+        }
+    }
+    streamLock.unLock();
+
+    return result;
+}
+
+/*
+ * @Function: GetSharedBloomFilter()
+ *
+ * @Description: fetch the runtime bloom filter shared by the smp threads, the
+ * first thread to ask creates it
+ *
+ * @param[IN] filter_index: index of the filter in es_bloom_filter.bfarray
+ *
+ * @return: the shared bloom filter
+ */
+SharedBloomFilter* StreamNodeGroup::GetSharedBloomFilter(int filter_index)
+{
+    SharedBloomFilter* result = NULL;
+    AutoMutexLock streamLock(&m_mutex);
+
+    streamLock.lock();
+    {
+        ListCell* lc = NULL;
+        foreach (lc, m_sharedBloomFilters) {
+            SharedBloomFilter* shared = (SharedBloomFilter*)lfirst(lc);
+
+            if (shared->filter_index == filter_index) {
+                result = shared;
+                break;
+            }
+        }
+
+        if (result == NULL) {
+            AutoContextSwitch streamCxtGuard(m_streamRuntimeContext);
+            result = (SharedBloomFilter*)palloc0(sizeof(SharedBloomFilter));
+            result->filter_index = filter_index;
+            pg_atomic_init_u32(&result->ready, 0);
+            result->context = AllocSetContextCreate(m_streamRuntimeContext,
+                "SharedBloomFilterContext",
+                ALLOCSET_SMALL_MINSIZE,
+                ALLOCSET_SMALL_INITSIZE,
+                ALLOCSET_DEFAULT_MAXSIZE,
+                SHARED_CONTEXT);
+            m_sharedBloomFilters = lappend(m_sharedBloomFilters, result);
+        }
+    }
+    streamLock.unLock();
+
+    return result;
+}
+
 /*
  * Mark executor stop flag for all sync controller
  */
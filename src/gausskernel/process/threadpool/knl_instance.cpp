@@ -191,6 +191,9 @@ static void knl_g_parallel_redo_init(knl_g_parallel_redo_context* predo_cxt)
     predo_cxt->redoPf.speed_according_seg = 0;
     predo_cxt->redoPf.local_max_lsn = 0;
     predo_cxt->redoPf.oldest_segment = 0;
+    predo_cxt->redoPf.prefetch_hit = 0;
+    predo_cxt->redoPf.prefetch_miss = 0;
+    predo_cxt->redoPf.prefetch_skip = 0;
     knl_g_set_redo_finish_status(0);
     predo_cxt->redoType = DEFAULT_REDO;
     predo_cxt->pre_enable_switch = 0;
@@ -500,7 +503,10 @@ void knl_instance_init()
     g_instance.ckpt_cxt_ctl = (knl_g_ckpt_context*)TYPEALIGN(SIZE_OF_TWO_UINT64, g_instance.ckpt_cxt_ctl);
     knl_g_heartbeat_init(&g_instance.heartbeat_cxt);
     knl_g_csnminsync_init(&g_instance.csnminsync_cxt);
-    knl_g_dw_init(&g_instance.dw_batch_cxt);
+    for (uint32 i = 0; i < DW_BATCH_FILE_MAX_NUM; i++) {
+        knl_g_dw_init(&g_instance.dw_batch_cxt[i]);
+        g_instance.dw_batch_cxt[i].file_id = i;
+    }
     knl_g_dw_init(&g_instance.dw_single_cxt);
     knl_g_xlog_init(&g_instance.xlog_cxt);
     knl_g_compaction_init(&g_instance.ts_compaction_cxt);
@@ -458,6 +458,8 @@ static void knl_t_xlog_init(knl_t_xlog_context* xlog_cxt)
     xlog_cxt->lockToTry = -1;
     xlog_cxt->cachedPage = 0;
     xlog_cxt->cachedPos = NULL;
+    xlog_cxt->gatheringStagedXLog = false;
+    xlog_cxt->gatheringWithInsertLock = false;
 #ifdef WIN32
     xlog_cxt->deletedcounter = 1;
 #endif
@@ -1137,6 +1139,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->BufferBlocks = NULL;
     storage_cxt->BackendWritebackContext = (WritebackContext*)palloc0(sizeof(WritebackContext));
     storage_cxt->SharedBufHash = NULL;
+    storage_cxt->SharedBufHint = NULL;
+    storage_cxt->SharedBufHintMask = 0;
     storage_cxt->InProgressBuf = NULL;
     storage_cxt->IsForInput = false;
     storage_cxt->PinCountWaitBuf = NULL;
@@ -1144,6 +1148,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->InProgressAioDispatchCount = 0;
     storage_cxt->InProgressAioBuf = NULL;
     storage_cxt->InProgressAioType = AioUnkown;
+    storage_cxt->UringCxt = NULL;
+    storage_cxt->UringUnavailable = false;
     storage_cxt->is_btree_split = false;
     storage_cxt->PrivateRefCountArray =
         (PrivateRefCountEntry*)palloc0(sizeof(PrivateRefCountEntry) * REFCOUNT_ARRAY_ENTRIES);
@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * rowexprcodegen.cpp
+ *     codegeneration of the qual and the tuple deforming of row table scans
+ *
+ * The generated qual evaluates every node without branches: each node yields a
+ * value bit and a null bit, and AND/OR/NOT combine them with three-valued logic.
+ * Nothing it supports can raise an error, so evaluating all arms is safe.
+ *
+ * IDENTIFICATION
+ *     Code/src/gausskernel/runtime/codegen/executor/rowexprcodegen.cpp
+ *
+ * -----------------------------------------------------------------------
+ */
+#include "codegen/gscodegen.h"
+#include "codegen/rowexprcodegen.h"
+#include "codegen/foreignscancodegen.h"
+#include "access/tupmacs.h"
+#include "catalog/pg_operator.h"
+#include "nodes/nodeFuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/var.h"
+
+using namespace llvm;
+using namespace dorado;
+
+typedef enum { ROW_CMP_EQ, ROW_CMP_NE, ROW_CMP_LT, ROW_CMP_LE, ROW_CMP_GT, ROW_CMP_GE } RowCmpKind;
+
+/* Comparison done by one of the operators accepted by ForeignScanCodeGen::IsJittableExpr */
+static RowCmpKind GetRowCmpKind(Oid opno)
+{
+    switch (opno) {
+        case FLOAT8EQOID:
+        case FLOAT4EQOID:
+        case FLOAT48EQOID:
+        case FLOAT84EQOID:
+        case INT2EQOID:
+        case INT4EQOID:
+        case INT8EQOID:
+        case INT24EQOID:
+        case INT28EQOID:
+        case INT42EQOID:
+        case INT48EQOID:
+        case INT82EQOID:
+        case INT84EQOID:
+            return ROW_CMP_EQ;
+        case FLOAT8NEOID:
+        case FLOAT4NEOID:
+        case FLOAT48NEOID:
+        case FLOAT84NEOID:
+        case INT2NEOID:
+        case INT4NEOID:
+        case INT8NEOID:
+        case INT24NEOID:
+        case INT28NEOID:
+        case INT42NEOID:
+        case INT48NEOID:
+        case INT82NEOID:
+        case INT84NEOID:
+            return ROW_CMP_NE;
+        case FLOAT8LTOID:
+        case FLOAT4LTOID:
+        case FLOAT48LTOID:
+        case FLOAT84LTOID:
+        case INT2LTOID:
+        case INT4LTOID:
+        case INT8LTOID:
+        case INT24LTOID:
+        case INT28LTOID:
+        case INT42LTOID:
+        case INT48LTOID:
+        case INT82LTOID:
+        case INT84LTOID:
+            return ROW_CMP_LT;
+        case FLOAT8LEOID:
+        case FLOAT4LEOID:
+        case FLOAT48LEOID:
+        case FLOAT84LEOID:
+        case INT2LEOID:
+        case INT4LEOID:
+        case INT8LEOID:
+        case INT24LEOID:
+        case INT28LEOID:
+        case INT42LEOID:
+        case INT48LEOID:
+        case INT82LEOID:
+        case INT84LEOID:
+            return ROW_CMP_LE;
+        case FLOAT8GTOID:
+        case FLOAT4GTOID:
+        case FLOAT48GTOID:
+        case FLOAT84GTOID:
+        case INT2GTOID:
+        case INT4GTOID:
+        case INT8GTOID:
+        case INT24GTOID:
+        case INT28GTOID:
+        case INT42GTOID:
+        case INT48GTOID:
+        case INT82GTOID:
+        case INT84GTOID:
+            return ROW_CMP_GT;
+        default:
+            return ROW_CMP_GE;
+    }
+}
+
+static inline bool IsRowCodeGenIntType(Oid typeoid)
+{
+    return typeoid == INT2OID || typeoid == INT4OID || typeoid == INT8OID;
+}
+
+static inline bool IsRowCodeGenFloatType(Oid typeoid)
+{
+    return typeoid == FLOAT4OID || typeoid == FLOAT8OID;
+}
+
+/* Is var a user column of the scan tuple? */
+static bool IsRowCodeGenScanVar(Var* var, TupleDesc desc)
+{
+    if (IS_SPECIAL_VARNO(var->varno) || var->varlevelsup != 0 || var->varattno <= 0 || var->varattno > desc->natts) {
+        return false;
+    }
+
+    Form_pg_attribute attr = desc->attrs[var->varattno - 1];
+    return !attr->attisdropped && attr->atttypid == var->vartype;
+}
+
+namespace dorado {
+bool RowExprCodeGen::ExprJittable(Expr* node, TupleDesc desc, int* natts)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    switch (nodeTag(node)) {
+        case T_OpExpr: {
+            OpExpr* op = (OpExpr*)node;
+
+            if (list_length(op->args) != 2 || !ForeignScanCodeGen::IsJittableExpr(node)) {
+                return false;
+            }
+
+            Node* lhs = (Node*)linitial(op->args);
+            Node* rhs = (Node*)lsecond(op->args);
+            if (!IsA(lhs, Var) || !IsA(rhs, Const) || ((Const*)rhs)->constisnull) {
+                return false;
+            }
+
+            Oid vartype = ((Var*)lhs)->vartype;
+            Oid consttype = ((Const*)rhs)->consttype;
+            if (!(IsRowCodeGenIntType(vartype) && IsRowCodeGenIntType(consttype)) &&
+                !(IsRowCodeGenFloatType(vartype) && IsRowCodeGenFloatType(consttype))) {
+                return false;
+            }
+            if (!IsRowCodeGenScanVar((Var*)lhs, desc)) {
+                return false;
+            }
+            *natts = Max(*natts, (int)((Var*)lhs)->varattno);
+            return true;
+        }
+        case T_NullTest: {
+            NullTest* ntest = (NullTest*)node;
+
+            /* the column may be of any type, only its null flag is read */
+            if (ntest->argisrow || ntest->arg == NULL || !IsA(ntest->arg, Var) ||
+                !IsRowCodeGenScanVar((Var*)ntest->arg, desc)) {
+                return false;
+            }
+            *natts = Max(*natts, (int)((Var*)ntest->arg)->varattno);
+            return true;
+        }
+        case T_BoolExpr: {
+            BoolExpr* bexpr = (BoolExpr*)node;
+            ListCell* lc = NULL;
+
+            foreach (lc, bexpr->args) {
+                if (!ExprJittable((Expr*)lfirst(lc), desc, natts)) {
+                    return false;
+                }
+            }
+            return bexpr->args != NIL;
+        }
+        default:
+            return false;
+    }
+}
+
+bool RowExprCodeGen::QualJittable(List* qual, TupleDesc desc, int* natts)
+{
+    ListCell* lc = NULL;
+
+    *natts = 0;
+    if (qual == NIL) {
+        return false;
+    }
+
+    foreach (lc, qual) {
+        if (!ExprJittable((Expr*)lfirst(lc), desc, natts)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RowExprCodeGen::VarCodeGen(Var* var, GsCodeGen::LlvmBuilder* builder, llvm::Value* values,
+    llvm::Value* isnull, llvm::Value** resval, llvm::Value** resnull)
+{
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+
+    DEFINE_CG_TYPE(int16Type, INT2OID);
+    DEFINE_CG_TYPE(int32Type, INT4OID);
+    DEFINE_CG_TYPE(int64Type, INT8OID);
+    DEFINE_CG_TYPE(floatType, FLOAT4OID);
+    DEFINE_CG_TYPE(doubleType, FLOAT8OID);
+    DEFINE_CGVAR_INT8(int8_0, 0);
+    DEFINE_CGVAR_INT64(attoff, var->varattno - 1);
+
+    llvm::Value* ptr = builder->CreateInBoundsGEP(isnull, attoff);
+    llvm::Value* val = builder->CreateAlignedLoad(ptr, 1, "isnull");
+    *resnull = builder->CreateICmpNE(val, int8_0);
+
+    ptr = builder->CreateInBoundsGEP(values, attoff);
+    val = builder->CreateAlignedLoad(ptr, 8, "datum");
+    switch (var->vartype) {
+        case INT2OID:
+            val = builder->CreateSExt(builder->CreateTrunc(val, int16Type), int64Type);
+            break;
+        case INT4OID:
+            val = builder->CreateSExt(builder->CreateTrunc(val, int32Type), int64Type);
+            break;
+        case FLOAT4OID:
+            val = builder->CreateBitCast(builder->CreateTrunc(val, int32Type), floatType);
+            val = builder->CreateFPExt(val, doubleType);
+            break;
+        case FLOAT8OID:
+            val = builder->CreateBitCast(val, doubleType);
+            break;
+        default:
+            break;
+    }
+    *resval = val;
+}
+
+/*
+ * NaN is equal to itself and greater than any other value, as in float8_cmp_internal.
+ */
+llvm::Value* RowExprCodeGen::FloatCmpCodeGen(
+    Oid opno, GsCodeGen::LlvmBuilder* builder, llvm::Value* lhs, llvm::Value* rhs)
+{
+    llvm::Value* lnan = builder->CreateFCmpUNO(lhs, lhs);
+    llvm::Value* rnan = builder->CreateFCmpUNO(rhs, rhs);
+
+    switch (GetRowCmpKind(opno)) {
+        case ROW_CMP_EQ:
+            return builder->CreateOr(builder->CreateAnd(lnan, rnan), builder->CreateFCmpOEQ(lhs, rhs));
+        case ROW_CMP_NE:
+            return builder->CreateNot(
+                builder->CreateOr(builder->CreateAnd(lnan, rnan), builder->CreateFCmpOEQ(lhs, rhs)));
+        case ROW_CMP_LT:
+            return builder->CreateAnd(
+                builder->CreateNot(lnan), builder->CreateOr(rnan, builder->CreateFCmpOLT(lhs, rhs)));
+        case ROW_CMP_LE:
+            return builder->CreateOr(
+                rnan, builder->CreateAnd(builder->CreateNot(lnan), builder->CreateFCmpOLE(lhs, rhs)));
+        case ROW_CMP_GT:
+            return builder->CreateAnd(
+                builder->CreateNot(rnan), builder->CreateOr(lnan, builder->CreateFCmpOGT(lhs, rhs)));
+        default:
+            return builder->CreateOr(
+                lnan, builder->CreateAnd(builder->CreateNot(rnan), builder->CreateFCmpOGE(lhs, rhs)));
+    }
+}
+
+void RowExprCodeGen::ExprCodeGen(Expr* node, GsCodeGen::LlvmBuilder* builder, llvm::Value* values,
+    llvm::Value* isnull, llvm::Value** resval, llvm::Value** resnull)
+{
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+    llvm::LLVMContext& context = llvmCodeGen->context();
+
+    DEFINE_CGVAR_INT1(int1_0, 0);
+
+    switch (nodeTag(node)) {
+        case T_OpExpr: {
+            OpExpr* op = (OpExpr*)node;
+            Var* var = (Var*)linitial(op->args);
+            Const* con = (Const*)lsecond(op->args);
+            llvm::Value* lhs = NULL;
+            llvm::Value* rhs = NULL;
+
+            VarCodeGen(var, builder, values, isnull, &lhs, resnull);
+            if (IsRowCodeGenFloatType(var->vartype)) {
+                float8 cval = (con->consttype == FLOAT8OID) ? DatumGetFloat8(con->constvalue)
+                                                            : (float8)DatumGetFloat4(con->constvalue);
+                rhs = llvm::ConstantFP::get(context, llvm::APFloat(cval));
+                *resval = FloatCmpCodeGen(op->opno, builder, lhs, rhs);
+                break;
+            }
+
+            int64 cval = 0;
+            switch (con->consttype) {
+                case INT8OID:
+                    cval = DatumGetInt64(con->constvalue);
+                    break;
+                case INT4OID:
+                    cval = DatumGetInt32(con->constvalue);
+                    break;
+                default:
+                    cval = DatumGetInt16(con->constvalue);
+                    break;
+            }
+            rhs = llvmCodeGen->getIntConstant(INT8OID, cval);
+            switch (GetRowCmpKind(op->opno)) {
+                case ROW_CMP_EQ:
+                    *resval = builder->CreateICmpEQ(lhs, rhs);
+                    break;
+                case ROW_CMP_NE:
+                    *resval = builder->CreateICmpNE(lhs, rhs);
+                    break;
+                case ROW_CMP_LT:
+                    *resval = builder->CreateICmpSLT(lhs, rhs);
+                    break;
+                case ROW_CMP_LE:
+                    *resval = builder->CreateICmpSLE(lhs, rhs);
+                    break;
+                case ROW_CMP_GT:
+                    *resval = builder->CreateICmpSGT(lhs, rhs);
+                    break;
+                default:
+                    *resval = builder->CreateICmpSGE(lhs, rhs);
+                    break;
+            }
+            break;
+        }
+        case T_NullTest: {
+            NullTest* ntest = (NullTest*)node;
+            llvm::Value* val = NULL;
+            llvm::Value* null = NULL;
+
+            VarCodeGen((Var*)ntest->arg, builder, values, isnull, &val, &null);
+            *resval = (ntest->nulltesttype == IS_NULL) ? null : builder->CreateNot(null);
+            *resnull = int1_0;
+            break;
+        }
+        case T_BoolExpr: {
+            BoolExpr* bexpr = (BoolExpr*)node;
+            ListCell* lc = NULL;
+            llvm::Value* decided = int1_0; /* some argument is false for AND, true for OR */
+            llvm::Value* anynull = int1_0;
+
+            if (bexpr->boolop == NOT_EXPR) {
+                ExprCodeGen((Expr*)linitial(bexpr->args), builder, values, isnull, resval, resnull);
+                *resval = builder->CreateNot(*resval);
+                break;
+            }
+
+            foreach (lc, bexpr->args) {
+                llvm::Value* val = NULL;
+                llvm::Value* null = NULL;
+
+                ExprCodeGen((Expr*)lfirst(lc), builder, values, isnull, &val, &null);
+                if (bexpr->boolop == AND_EXPR) {
+                    val = builder->CreateNot(val);
+                }
+                decided = builder->CreateOr(decided, builder->CreateAnd(builder->CreateNot(null), val));
+                anynull = builder->CreateOr(anynull, null);
+            }
+
+            /* the result is NULL only if no argument decided it and some argument is NULL */
+            *resnull = builder->CreateAnd(builder->CreateNot(decided), anynull);
+            if (bexpr->boolop == AND_EXPR) {
+                *resval = builder->CreateAnd(builder->CreateNot(decided), builder->CreateNot(anynull));
+            } else {
+                *resval = decided;
+            }
+            break;
+        }
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                    errmodule(MOD_LLVM),
+                    errmsg("unrecognized node type %d in row qual codegen", (int)nodeTag(node))));
+            break;
+    }
+}
+
+llvm::Function* RowExprCodeGen::QualCodeGen(List* qual, TupleDesc desc, int* natts)
+{
+    Assert(NULL != (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj);
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+
+    if (!QualJittable(qual, desc, natts)) {
+        return NULL;
+    }
+
+    /* Find and load the IR file from the installaion directory */
+    llvmCodeGen->loadIRFile();
+
+    llvm::LLVMContext& context = llvmCodeGen->context();
+    GsCodeGen::LlvmBuilder builder(context);
+
+    DEFINE_CG_TYPE(int1Type, BITOID);
+    DEFINE_CG_PTRTYPE(int8PtrType, CHAROID);
+    DEFINE_CG_PTRTYPE(int64PtrType, INT8OID);
+    DEFINE_CGVAR_INT1(int1_1, 1);
+
+    llvm::Value* llvmargs[2];
+    llvm::Value* result = int1_1;
+    llvm::Function* jitted_rowqual = NULL;
+    ListCell* lc = NULL;
+
+    GsCodeGen::FnPrototype fn_prototype(llvmCodeGen, "JittedRowQual", int1Type);
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("values", int64PtrType));
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("isnull", int8PtrType));
+    jitted_rowqual = fn_prototype.generatePrototype(&builder, &llvmargs[0]);
+    if (jitted_rowqual == NULL) {
+        return NULL;
+    }
+
+    /* the implicit AND of the qual list, where NULL counts as false */
+    foreach (lc, qual) {
+        llvm::Value* val = NULL;
+        llvm::Value* null = NULL;
+
+        ExprCodeGen((Expr*)lfirst(lc), &builder, llvmargs[0], llvmargs[1], &val, &null);
+        result = builder.CreateAnd(result, builder.CreateAnd(builder.CreateNot(null), val));
+    }
+    builder.CreateRet(result);
+
+    llvmCodeGen->FinalizeFunction(jitted_rowqual);
+    return jitted_rowqual;
+}
+
+int RowExprCodeGen::DeformJittableAttrs(TupleDesc desc, int natts)
+{
+    int attnum;
+
+    natts = Min(natts, desc->natts);
+    for (attnum = 0; attnum < natts; attnum++) {
+        Form_pg_attribute attr = desc->attrs[attnum];
+
+        if (attr->attlen <= 0 || (attr->attbyval && attr->attlen != 1 && attr->attlen != sizeof(int16) &&
+                                     attr->attlen != sizeof(int32) && attr->attlen != sizeof(Datum))) {
+            break;
+        }
+    }
+    return attnum;
+}
+
+llvm::Function* RowExprCodeGen::DeformCodeGen(TupleDesc desc, int natts)
+{
+    Assert(NULL != (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj);
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+
+    Assert(natts > 0 && natts <= DeformJittableAttrs(desc, natts));
+
+    /* Find and load the IR file from the installaion directory */
+    llvmCodeGen->loadIRFile();
+
+    llvm::LLVMContext& context = llvmCodeGen->context();
+    GsCodeGen::LlvmBuilder builder(context);
+
+    DEFINE_CG_TYPE(int64Type, INT8OID);
+    DEFINE_CG_PTRTYPE(int8PtrType, CHAROID);
+    DEFINE_CG_PTRTYPE(int16PtrType, INT2OID);
+    DEFINE_CG_PTRTYPE(int32PtrType, INT4OID);
+    DEFINE_CG_PTRTYPE(int64PtrType, INT8OID);
+    DEFINE_CGVAR_INT8(int8_0, 0);
+    DEFINE_CGVAR_INT8(int8_1, 1);
+    DEFINE_CGVAR_INT64(Datum_0, 0);
+
+    llvm::Value* llvmargs[4];
+    llvm::Function* jitted_deform = NULL;
+
+    GsCodeGen::FnPrototype fn_prototype(llvmCodeGen, "JittedRowDeform", int64Type);
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("tp", int8PtrType));
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("bp", int8PtrType));
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("values", int64PtrType));
+    fn_prototype.addArgument(GsCodeGen::NamedVariable("isnull", int8PtrType));
+    jitted_deform = fn_prototype.generatePrototype(&builder, &llvmargs[0]);
+    if (jitted_deform == NULL) {
+        return NULL;
+    }
+
+    llvm::Value* tp = llvmargs[0];
+    llvm::Value* bp = llvmargs[1];
+    llvm::Value* values = llvmargs[2];
+    llvm::Value* isnull = llvmargs[3];
+
+    llvm::Value* offptr = builder.CreateAlloca(int64Type);
+    builder.CreateAlignedStore(Datum_0, offptr, 8);
+    llvm::Value* hasnulls = builder.CreateICmpNE(bp, llvm::ConstantPointerNull::get((llvm::PointerType*)int8PtrType));
+
+    DEFINE_BLOCK(att_block, jitted_deform);
+    builder.CreateBr(att_block);
+
+    for (int attnum = 0; attnum < natts; attnum++) {
+        Form_pg_attribute attr = desc->attrs[attnum];
+        DEFINE_CGVAR_INT64(attoff, attnum);
+
+        DEFINE_BLOCK(fetch_block, jitted_deform);
+        DEFINE_BLOCK(next_block, jitted_deform);
+
+        builder.SetInsertPoint(att_block);
+        if (!attr->attnotnull) {
+            DEFINE_BLOCK(bitmap_block, jitted_deform);
+            DEFINE_BLOCK(null_block, jitted_deform);
+
+            builder.CreateCondBr(hasnulls, bitmap_block, fetch_block);
+
+            /* att_isnull(attnum, bp) */
+            builder.SetInsertPoint(bitmap_block);
+            llvm::Value* byte = builder.CreateAlignedLoad(
+                builder.CreateInBoundsGEP(bp, llvmCodeGen->getIntConstant(INT8OID, attnum >> 3)), 1, "bits");
+            llvm::Value* bit = builder.CreateAnd(byte, llvmCodeGen->getIntConstant(CHAROID, (int8)(1 << (attnum & 0x07))));
+            builder.CreateCondBr(builder.CreateICmpEQ(bit, int8_0), null_block, fetch_block);
+
+            builder.SetInsertPoint(null_block);
+            builder.CreateAlignedStore(Datum_0, builder.CreateInBoundsGEP(values, attoff), 8);
+            builder.CreateAlignedStore(int8_1, builder.CreateInBoundsGEP(isnull, attoff), 1);
+            builder.CreateBr(next_block);
+        } else {
+            builder.CreateBr(fetch_block);
+        }
+
+        /* off = att_align_nominal(off, attalign), then fetchatt() */
+        builder.SetInsertPoint(fetch_block);
+        llvm::Value* off = builder.CreateAlignedLoad(offptr, 8, "off");
+        int64 alignto = (int64)att_align_nominal(1, attr->attalign) - 1;
+        if (alignto > 0) {
+            off = builder.CreateAnd(builder.CreateAdd(off, llvmCodeGen->getIntConstant(INT8OID, alignto)),
+                llvmCodeGen->getIntConstant(INT8OID, ~alignto));
+        }
+        llvm::Value* attptr = builder.CreateInBoundsGEP(tp, off);
+        llvm::Value* datum = NULL;
+        if (!attr->attbyval) {
+            datum = builder.CreatePtrToInt(attptr, int64Type);
+        } else if (attr->attlen == 1) {
+            datum = builder.CreateAlignedLoad(attptr, 1, "attr");
+            /* CharGetDatum extends the sign of a plain char */
+            datum = ((char)-1 < 0) ? builder.CreateSExt(datum, int64Type) : builder.CreateZExt(datum, int64Type);
+        } else if (attr->attlen == sizeof(int16)) {
+            datum = builder.CreateAlignedLoad(builder.CreateBitCast(attptr, int16PtrType), sizeof(int16), "attr");
+            datum = builder.CreateSExt(datum, int64Type);
+        } else if (attr->attlen == sizeof(int32)) {
+            datum = builder.CreateAlignedLoad(builder.CreateBitCast(attptr, int32PtrType), sizeof(int32), "attr");
+            datum = builder.CreateSExt(datum, int64Type);
+        } else {
+            datum = builder.CreateAlignedLoad(builder.CreateBitCast(attptr, int64PtrType), sizeof(int64), "attr");
+        }
+        builder.CreateAlignedStore(datum, builder.CreateInBoundsGEP(values, attoff), 8);
+        builder.CreateAlignedStore(int8_0, builder.CreateInBoundsGEP(isnull, attoff), 1);
+        builder.CreateAlignedStore(
+            builder.CreateAdd(off, llvmCodeGen->getIntConstant(INT8OID, attr->attlen)), offptr, 8);
+        builder.CreateBr(next_block);
+
+        att_block = next_block;
+    }
+
+    builder.SetInsertPoint(att_block);
+    builder.CreateRet(builder.CreateAlignedLoad(offptr, 8, "off"));
+
+    llvmCodeGen->FinalizeFunction(jitted_deform);
+    return jitted_deform;
+}
+}  // namespace dorado
+
+/*
+ * Codegen the qual and the tuple deforming of a row table scan. The jitted
+ * functions are filled in once the module is compiled in ExecutorRun, and stay
+ * NULL if it is not.
+ */
+void RowScanCodeGen(ScanState* node)
+{
+    GsCodeGen* llvmCodeGen = (GsCodeGen*)t_thrd.codegen_cxt.thr_codegen_obj;
+    TupleDesc desc = node->ss_ScanTupleSlot->tts_tupleDescriptor;
+    Plan* plan = node->ps.plan;
+    llvm::Function* jitted_func = NULL;
+    int natts = 0;
+
+    jitted_func = RowExprCodeGen::QualCodeGen(plan->qual, desc, &natts);
+    if (jitted_func != NULL) {
+        node->jitted_rowqual_natts = natts;
+        llvmCodeGen->addFunctionToMCJit(jitted_func, reinterpret_cast<void**>(&(node->jitted_rowqual)));
+    }
+
+    /* deform the fixed-length prefix of what the qual and the targetlist read */
+    List* vars = pull_var_clause((Node*)list_concat(list_copy(plan->targetlist), list_copy(plan->qual)),
+        PVC_RECURSE_AGGREGATES, PVC_RECURSE_PLACEHOLDERS);
+    ListCell* lc = NULL;
+    foreach (lc, vars) {
+        Var* var = (Var*)lfirst(lc);
+        if (IS_SPECIAL_VARNO(var->varno)) {
+            continue;
+        }
+        natts = Max(natts, (var->varattno == InvalidAttrNumber) ? desc->natts : (int)var->varattno);
+    }
+    list_free_ext(vars);
+
+    natts = RowExprCodeGen::DeformJittableAttrs(desc, natts);
+    if (natts > 0) {
+        jitted_func = RowExprCodeGen::DeformCodeGen(desc, natts);
+        if (jitted_func != NULL) {
+            node->jitted_deform_natts = natts;
+            llvmCodeGen->addFunctionToMCJit(jitted_func, reinterpret_cast<void**>(&(node->jitted_deform)));
+        }
+    }
+}
@@ -0,0 +1,759 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * execExprInterp.cpp
+ *        Compile row engine expressions into step programs and run them
+ *
+ * The compiler walks the ExprState tree built by ExecInitExpr. Vars, Consts,
+ * calls of builtin functions and operators, AND/OR/NOT, scalar IS [NOT] NULL
+ * and RelabelType become steps; anything else becomes one EEOP_EVAL_SUBTREE
+ * step, so every expression the tree evaluator handles can be compiled. The
+ * tree is left intact and keeps serving the subtrees, and callers that look
+ * into it.
+ *
+ * Builtin functions are called directly: they never return sets, take or
+ * return cursors, run as procedures or get tracked by track_functions, so
+ * none of the bookkeeping of ExecMakeFunctionResultNoSets applies to them.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/runtime/executor/execExprInterp.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/tableam.h"
+#include "catalog/pg_type.h"
+#include "executor/execExprInterp.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/fmgrtab.h"
+#include "utils/lsyscache.h"
+
+#if defined(__GNUC__)
+#define EEO_USE_COMPUTED_GOTO
+#endif
+
+#define EXPR_STEPS_INITIAL 16
+
+typedef struct ExprStepBuild {
+    ExprStepProgram* prog;
+    int last[EEOP_SLOT_COUNT]; /* highest attribute read from each slot */
+} ExprStepBuild;
+
+static bool ExecStepsCompileNode(ExprStepBuild* build, ExprState* state, Datum* resvalue, bool* resnull);
+static Datum ExecInterpExpr(ExprState* state, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
+
+static int ExecStepsPush(ExprStepBuild* build, int opcode, Datum* resvalue, bool* resnull)
+{
+    ExprStepProgram* prog = build->prog;
+    ExprStep* step = NULL;
+    errno_t rc;
+
+    if (prog->nsteps == prog->maxsteps) {
+        prog->maxsteps *= 2;
+        prog->steps = (ExprStep*)repalloc(prog->steps, sizeof(ExprStep) * prog->maxsteps);
+    }
+
+    step = &prog->steps[prog->nsteps];
+    rc = memset_s(step, sizeof(ExprStep), 0, sizeof(ExprStep));
+    securec_check(rc, "\0", "\0");
+    step->opcode = opcode;
+    step->resvalue = resvalue;
+    step->resnull = resnull;
+
+    return prog->nsteps++;
+}
+
+/* Slot a scalar user-attribute Var reads from, or -1 if it is something else */
+static int ExecStepsVarSlot(Expr* expr)
+{
+    Var* var = (Var*)expr;
+
+    if (expr == NULL || !IsA(expr, Var) || var->varattno <= 0) {
+        return -1;
+    }
+
+    switch (var->varno) {
+        case INNER_VAR:
+            return EEOP_SLOT_INNER;
+        case OUTER_VAR:
+            return EEOP_SLOT_OUTER;
+        default:
+            return EEOP_SLOT_SCAN;
+    }
+}
+
+/*
+ * Can a call of funcid over args be a step? Only builtin functions qualify,
+ * see the file header.
+ */
+static bool ExecStepsFunctionOk(Oid funcid, List* args)
+{
+    const FmgrBuiltin* fbp = fmgr_isbuiltin(funcid);
+    ListCell* lc = NULL;
+
+    if (fbp == NULL || fbp->retset || fbp->rettype == REFCURSOROID || list_length(args) > FUNC_MAX_ARGS) {
+        return false;
+    }
+
+    foreach (lc, args) {
+        if (exprType((Node*)((ExprState*)lfirst(lc))->expr) == REFCURSOROID) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool ExecStepsCompileFunc(
+    ExprStepBuild* build, FuncExprState* fstate, Oid funcid, Oid inputcollid, Datum* resvalue, bool* resnull)
+{
+    List* args = fstate->args;
+    int nargs = list_length(args);
+    FmgrInfo* finfo = NULL;
+    FunctionCallInfo fcinfo = NULL;
+    ExprState* larg = NULL;
+    ExprState* rarg = NULL;
+    AclResult aclresult;
+    ListCell* lc = NULL;
+    int argno = 0;
+    int stepno;
+
+    if (!ExecStepsFunctionOk(funcid, args)) {
+        return false;
+    }
+
+    /* Check permission to call function, as init_fcache would on first use */
+    aclresult = pg_proc_aclcheck(funcid, GetUserId(), ACL_EXECUTE);
+    if (aclresult != ACLCHECK_OK) {
+        aclcheck_error(aclresult, ACL_KIND_PROC, get_func_name(funcid));
+    }
+
+    finfo = (FmgrInfo*)palloc0(sizeof(FmgrInfo));
+    fcinfo = (FunctionCallInfo)palloc0(sizeof(FunctionCallInfoData));
+    fmgr_info(funcid, finfo);
+    fmgr_info_set_expr((Node*)fstate->xprstate.expr, finfo);
+    InitFunctionCallInfoData(*fcinfo, finfo, nargs, inputcollid, NULL, NULL);
+
+    foreach (lc, args) {
+        fcinfo->argTypes[argno++] = ((ExprState*)lfirst(lc))->resultType;
+    }
+
+    /* Var op Const: read the Var straight into the call, the Const is set once */
+    if (nargs == 2 && finfo->fn_strict) {
+        larg = (ExprState*)linitial(args);
+        rarg = (ExprState*)lsecond(args);
+    }
+    if (larg != NULL && ExecStepsVarSlot(larg->expr) >= 0 && IsA(rarg->expr, Const) &&
+        !((Const*)rarg->expr)->constisnull && ((Const*)rarg->expr)->consttype != REFCURSOROID) {
+        Var* var = (Var*)larg->expr;
+        int slot = ExecStepsVarSlot(larg->expr);
+
+        stepno = ExecStepsPush(build, EEOP_VAR_OP_CONST, resvalue, resnull);
+        build->prog->steps[stepno].d.varopconst.fcinfo = fcinfo;
+        build->prog->steps[stepno].d.varopconst.slot = slot;
+        build->prog->steps[stepno].d.varopconst.attnum = var->varattno;
+        build->prog->steps[stepno].d.varopconst.vartype = var->vartype;
+        build->last[slot] = Max(build->last[slot], var->varattno);
+
+        fcinfo->arg[1] = ((Const*)rarg->expr)->constvalue;
+        fcinfo->argnull[1] = false;
+        return true;
+    }
+
+    argno = 0;
+    foreach (lc, args) {
+        (void)ExecStepsCompileNode(build, (ExprState*)lfirst(lc), &fcinfo->arg[argno], &fcinfo->argnull[argno]);
+        argno++;
+    }
+
+    stepno = ExecStepsPush(build, finfo->fn_strict ? EEOP_FUNCEXPR_STRICT : EEOP_FUNCEXPR, resvalue, resnull);
+    build->prog->steps[stepno].d.func.fcinfo = fcinfo;
+    build->prog->steps[stepno].d.func.nargs = nargs;
+    return true;
+}
+
+static bool ExecStepsCompileBool(ExprStepBuild* build, BoolExprState* bstate, Datum* resvalue, bool* resnull)
+{
+    BoolExpr* expr = (BoolExpr*)bstate->xprstate.expr;
+    int nargs = list_length(bstate->args);
+    bool* anynull = NULL;
+    int* stepnos = NULL;
+    ListCell* lc = NULL;
+    int argno = 0;
+    int first_op;
+    int op;
+    int last_op;
+
+    if (expr->boolop == NOT_EXPR) {
+        (void)ExecStepsCompileNode(build, (ExprState*)linitial(bstate->args), resvalue, resnull);
+        (void)ExecStepsPush(build, EEOP_BOOL_NOT, resvalue, resnull);
+        return true;
+    }
+
+    if (expr->boolop == AND_EXPR) {
+        first_op = EEOP_BOOL_AND_STEP_FIRST;
+        op = EEOP_BOOL_AND_STEP;
+        last_op = EEOP_BOOL_AND_STEP_LAST;
+    } else if (expr->boolop == OR_EXPR) {
+        first_op = EEOP_BOOL_OR_STEP_FIRST;
+        op = EEOP_BOOL_OR_STEP;
+        last_op = EEOP_BOOL_OR_STEP_LAST;
+    } else {
+        return false;
+    }
+
+    /* the planner never leaves an AND or OR with less than two arguments */
+    if (nargs < 2) {
+        return false;
+    }
+
+    anynull = (bool*)palloc0(sizeof(bool));
+    stepnos = (int*)palloc(sizeof(int) * nargs);
+
+    foreach (lc, bstate->args) {
+        int opcode = (argno == 0) ? first_op : ((argno == nargs - 1) ? last_op : op);
+
+        (void)ExecStepsCompileNode(build, (ExprState*)lfirst(lc), resvalue, resnull);
+        stepnos[argno] = ExecStepsPush(build, opcode, resvalue, resnull);
+        build->prog->steps[stepnos[argno]].d.boolexpr.anynull = anynull;
+        argno++;
+    }
+
+    /* a decided argument skips the rest */
+    for (argno = 0; argno < nargs; argno++) {
+        build->prog->steps[stepnos[argno]].d.boolexpr.jumpdone = build->prog->nsteps;
+    }
+    pfree(stepnos);
+
+    return true;
+}
+
+/*
+ * Append the steps computing state into resvalue/resnull. Returns false if the
+ * node itself could not be compiled and is evaluated as a subtree instead.
+ */
+static bool ExecStepsCompileNode(ExprStepBuild* build, ExprState* state, Datum* resvalue, bool* resnull)
+{
+    Expr* expr = state->expr;
+    int stepno;
+    bool done = false;
+
+    check_stack_depth();
+
+    switch (nodeTag(expr)) {
+        case T_Var: {
+            int slot = ExecStepsVarSlot(expr);
+
+            if (slot >= 0) {
+                Var* var = (Var*)expr;
+
+                stepno = ExecStepsPush(build, EEOP_VAR, resvalue, resnull);
+                build->prog->steps[stepno].d.var.slot = slot;
+                build->prog->steps[stepno].d.var.attnum = var->varattno;
+                build->prog->steps[stepno].d.var.vartype = var->vartype;
+                build->last[slot] = Max(build->last[slot], var->varattno);
+                done = true;
+            }
+            break;
+        }
+        case T_Const: {
+            Const* con = (Const*)expr;
+
+            /* cursor constants also hand their options to econtext */
+            if (con->consttype != REFCURSOROID) {
+                stepno = ExecStepsPush(build, EEOP_CONST, resvalue, resnull);
+                build->prog->steps[stepno].d.constval.value = con->constvalue;
+                build->prog->steps[stepno].d.constval.isnull = con->constisnull;
+                done = true;
+            }
+            break;
+        }
+        case T_OpExpr: {
+            OpExpr* op = (OpExpr*)expr;
+
+            done = !op->opretset &&
+                   ExecStepsCompileFunc(build, (FuncExprState*)state, op->opfuncid, op->inputcollid, resvalue, resnull);
+            break;
+        }
+        case T_FuncExpr: {
+            FuncExpr* func = (FuncExpr*)expr;
+
+            done = !func->funcretset &&
+                   ExecStepsCompileFunc(build, (FuncExprState*)state, func->funcid, func->inputcollid, resvalue, resnull);
+            break;
+        }
+        case T_BoolExpr:
+            done = ExecStepsCompileBool(build, (BoolExprState*)state, resvalue, resnull);
+            break;
+        case T_NullTest: {
+            NullTest* ntest = (NullTest*)expr;
+
+            if (!ntest->argisrow && (ntest->nulltesttype == IS_NULL || ntest->nulltesttype == IS_NOT_NULL)) {
+                (void)ExecStepsCompileNode(build, ((NullTestState*)state)->arg, resvalue, resnull);
+                (void)ExecStepsPush(build,
+                    ntest->nulltesttype == IS_NULL ? EEOP_NULLTEST_ISNULL : EEOP_NULLTEST_ISNOTNULL,
+                    resvalue, resnull);
+                done = true;
+            }
+            break;
+        }
+        case T_RelabelType:
+            /* binary compatible, the argument's steps already give the result */
+            (void)ExecStepsCompileNode(build, ((GenericExprState*)state)->arg, resvalue, resnull);
+            done = true;
+            break;
+        default:
+            break;
+    }
+
+    if (!done) {
+        stepno = ExecStepsPush(build, EEOP_EVAL_SUBTREE, resvalue, resnull);
+        build->prog->steps[stepno].d.subtree.state = state;
+    }
+
+    return done;
+}
+
+/*
+ * Put one EEOP_FETCHSOME step per slot the program reads in front of it, so
+ * that every slot is deformed once, up to the last attribute needed.
+ */
+static void ExecStepsAddFetches(ExprStepBuild* build)
+{
+    ExprStepProgram* prog = build->prog;
+    int nfetch = 0;
+    int slot;
+    int i;
+    errno_t rc;
+
+    for (slot = 0; slot < EEOP_SLOT_COUNT; slot++) {
+        if (build->last[slot] > 0) {
+            nfetch++;
+        }
+    }
+    if (nfetch == 0) {
+        return;
+    }
+
+    for (i = 0; i < nfetch; i++) {
+        (void)ExecStepsPush(build, EEOP_DONE, NULL, NULL);
+    }
+    rc = memmove_s(&prog->steps[nfetch], sizeof(ExprStep) * (prog->maxsteps - nfetch), &prog->steps[0],
+        sizeof(ExprStep) * (prog->nsteps - nfetch));
+    securec_check(rc, "\0", "\0");
+
+    for (i = nfetch; i < prog->nsteps; i++) {
+        switch (prog->steps[i].opcode) {
+            case EEOP_BOOL_AND_STEP_FIRST:
+            case EEOP_BOOL_AND_STEP:
+            case EEOP_BOOL_AND_STEP_LAST:
+            case EEOP_BOOL_OR_STEP_FIRST:
+            case EEOP_BOOL_OR_STEP:
+            case EEOP_BOOL_OR_STEP_LAST:
+                prog->steps[i].d.boolexpr.jumpdone += nfetch;
+                break;
+            default:
+                break;
+        }
+    }
+
+    i = 0;
+    for (slot = 0; slot < EEOP_SLOT_COUNT; slot++) {
+        if (build->last[slot] > 0) {
+            ExprStep* step = &prog->steps[i++];
+
+            rc = memset_s(step, sizeof(ExprStep), 0, sizeof(ExprStep));
+            securec_check(rc, "\0", "\0");
+            step->opcode = EEOP_FETCHSOME;
+            step->d.fetch.slot = slot;
+            step->d.fetch.last = build->last[slot];
+            step->d.fetch.checked = false;
+        }
+    }
+}
+
+/*
+ * ExecCompileExprSteps
+ *
+ * Compile the expression state was built for into a step program and have
+ * ExecEvalExpr run that instead. Only done for roots worth it, i.e. those that
+ * are not a bare Var or Const, and for the expression of a TargetEntry.
+ */
+void ExecCompileExprSteps(ExprState* state)
+{
+    ExprStepBuild build;
+    ExprStepProgram* prog = NULL;
+    errno_t rc;
+
+    if (state == NULL) {
+        return;
+    }
+    if (IsA(state, GenericExprState) && IsA(state->expr, TargetEntry)) {
+        state = ((GenericExprState*)state)->arg;
+        if (state == NULL) {
+            return;
+        }
+    }
+
+    switch (nodeTag(state->expr)) {
+        case T_OpExpr:
+        case T_FuncExpr:
+        case T_BoolExpr:
+        case T_NullTest:
+            break;
+        default:
+            return;
+    }
+    if (expression_returns_set((Node*)state->expr)) {
+        return;
+    }
+
+    rc = memset_s(&build, sizeof(build), 0, sizeof(build));
+    securec_check(rc, "\0", "\0");
+    prog = (ExprStepProgram*)palloc0(sizeof(ExprStepProgram));
+    prog->maxsteps = EXPR_STEPS_INITIAL;
+    prog->steps = (ExprStep*)palloc(sizeof(ExprStep) * prog->maxsteps);
+    build.prog = prog;
+
+    if (!ExecStepsCompileNode(&build, state, &prog->resvalue, &prog->resnull)) {
+        pfree(prog->steps);
+        pfree(prog);
+        return;
+    }
+    (void)ExecStepsPush(&build, EEOP_DONE, NULL, NULL);
+    ExecStepsAddFetches(&build);
+
+    state->steps = prog;
+    state->evalfunc = ExecInterpExpr;
+}
+
+/*
+ * The checks ExecEvalScalarVar makes on first use, for all Vars of the program
+ * that read the given slot.
+ */
+static void ExecStepsCheckSlot(ExprStepProgram* prog, TupleTableSlot* slot, int slotno)
+{
+    TupleDesc tupdesc = slot->tts_tupleDescriptor;
+
+    for (int i = 0; i < prog->nsteps; i++) {
+        ExprStep* step = &prog->steps[i];
+        int attnum;
+        Oid vartype;
+        Form_pg_attribute attr;
+
+        if (step->opcode == EEOP_VAR && step->d.var.slot == slotno) {
+            attnum = step->d.var.attnum;
+            vartype = step->d.var.vartype;
+        } else if (step->opcode == EEOP_VAR_OP_CONST && step->d.varopconst.slot == slotno) {
+            attnum = step->d.varopconst.attnum;
+            vartype = step->d.varopconst.vartype;
+        } else {
+            continue;
+        }
+
+        if (attnum > tupdesc->natts) {
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_ATTRIBUTE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("attribute number %d exceeds number of columns %d", attnum, tupdesc->natts)));
+        }
+
+        attr = tupdesc->attrs[attnum - 1];
+
+        /* can't check type if dropped, since atttypid is probably 0 */
+        if (!attr->attisdropped && vartype != attr->atttypid) {
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_ATTRIBUTE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("attribute %d has wrong type", attnum),
+                    errdetail("Table has type %s, but query expects %s.",
+                        format_type_be(attr->atttypid),
+                        format_type_be(vartype))));
+        }
+    }
+}
+
+/*
+ * ExecInterpExpr
+ *
+ * evalfunc of a compiled root. With GCC every step jumps straight to the code
+ * of the next one through a table of label addresses, which spreads the
+ * indirect branches over the opcodes and keeps them predictable.
+ */
+static Datum ExecInterpExpr(ExprState* state, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone)
+{
+    ExprStepProgram* prog = state->steps;
+    ExprStep* op = prog->steps;
+    TupleTableSlot* slots[EEOP_SLOT_COUNT];
+
+#ifdef EEO_USE_COMPUTED_GOTO
+    static const void* const dispatch_table[] = {
+        &&CASE_EEOP_DONE,
+        &&CASE_EEOP_FETCHSOME,
+        &&CASE_EEOP_VAR,
+        &&CASE_EEOP_CONST,
+        &&CASE_EEOP_FUNCEXPR,
+        &&CASE_EEOP_FUNCEXPR_STRICT,
+        &&CASE_EEOP_VAR_OP_CONST,
+        &&CASE_EEOP_BOOL_AND_STEP_FIRST,
+        &&CASE_EEOP_BOOL_AND_STEP,
+        &&CASE_EEOP_BOOL_AND_STEP_LAST,
+        &&CASE_EEOP_BOOL_OR_STEP_FIRST,
+        &&CASE_EEOP_BOOL_OR_STEP,
+        &&CASE_EEOP_BOOL_OR_STEP_LAST,
+        &&CASE_EEOP_BOOL_NOT,
+        &&CASE_EEOP_NULLTEST_ISNULL,
+        &&CASE_EEOP_NULLTEST_ISNOTNULL,
+        &&CASE_EEOP_EVAL_SUBTREE,
+    };
+    StaticAssertStmt(lengthof(dispatch_table) == EEOP_LAST, "dispatch_table out of sync with ExprStepOp");
+
+#define EEO_SWITCH() goto *dispatch_table[op->opcode];
+#define EEO_CASE(name) CASE_##name:
+#define EEO_DISPATCH() goto *dispatch_table[op->opcode]
+#else
+#define EEO_SWITCH() \
+    starteval:       \
+    switch (op->opcode)
+#define EEO_CASE(name) case name:
+#define EEO_DISPATCH() goto starteval
+#endif
+
+#define EEO_NEXT()      \
+    do {                \
+        op++;           \
+        EEO_DISPATCH(); \
+    } while (0)
+
+#define EEO_JUMP(stepno)                 \
+    do {                                 \
+        op = &prog->steps[stepno];       \
+        EEO_DISPATCH();                  \
+    } while (0)
+
+    if (isDone != NULL) {
+        *isDone = ExprSingleResult;
+    }
+
+    slots[EEOP_SLOT_SCAN] = econtext->ecxt_scantuple;
+    slots[EEOP_SLOT_INNER] = econtext->ecxt_innertuple;
+    slots[EEOP_SLOT_OUTER] = econtext->ecxt_outertuple;
+
+    EEO_SWITCH()
+    {
+        EEO_CASE(EEOP_DONE)
+        {
+            goto out;
+        }
+
+        EEO_CASE(EEOP_FETCHSOME)
+        {
+            TupleTableSlot* slot = slots[op->d.fetch.slot];
+
+            Assert(slot != NULL);
+            if (unlikely(!op->d.fetch.checked)) {
+                ExecStepsCheckSlot(prog, slot, op->d.fetch.slot);
+                op->d.fetch.checked = true;
+            }
+            if (slot->tts_nvalid < op->d.fetch.last) {
+                tableam_tslot_getsomeattrs(slot, op->d.fetch.last);
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_VAR)
+        {
+            TupleTableSlot* slot = slots[op->d.var.slot];
+            int attno = op->d.var.attnum - 1;
+
+            *op->resvalue = slot->tts_values[attno];
+            *op->resnull = slot->tts_isnull[attno];
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_CONST)
+        {
+            *op->resvalue = op->d.constval.value;
+            *op->resnull = op->d.constval.isnull;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_FUNCEXPR)
+        {
+            FunctionCallInfo fcinfo = op->d.func.fcinfo;
+
+            fcinfo->isnull = false;
+            *op->resvalue = FunctionCallInvoke(fcinfo);
+            *op->resnull = fcinfo->isnull;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_FUNCEXPR_STRICT)
+        {
+            FunctionCallInfo fcinfo = op->d.func.fcinfo;
+            int argno;
+
+            for (argno = 0; argno < op->d.func.nargs; argno++) {
+                if (fcinfo->argnull[argno]) {
+                    *op->resvalue = (Datum)0;
+                    *op->resnull = true;
+                    EEO_NEXT();
+                }
+            }
+            fcinfo->isnull = false;
+            *op->resvalue = FunctionCallInvoke(fcinfo);
+            *op->resnull = fcinfo->isnull;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_VAR_OP_CONST)
+        {
+            TupleTableSlot* slot = slots[op->d.varopconst.slot];
+            FunctionCallInfo fcinfo = op->d.varopconst.fcinfo;
+            int attno = op->d.varopconst.attnum - 1;
+
+            if (slot->tts_isnull[attno]) {
+                *op->resvalue = (Datum)0;
+                *op->resnull = true;
+                EEO_NEXT();
+            }
+            fcinfo->arg[0] = slot->tts_values[attno];
+            fcinfo->argnull[0] = false;
+            fcinfo->isnull = false;
+            *op->resvalue = FunctionCallInvoke(fcinfo);
+            *op->resnull = fcinfo->isnull;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_AND_STEP_FIRST)
+        {
+            *op->d.boolexpr.anynull = false;
+            /* the rest is the same as EEOP_BOOL_AND_STEP */
+            if (*op->resnull) {
+                *op->d.boolexpr.anynull = true;
+            } else if (!DatumGetBool(*op->resvalue)) {
+                EEO_JUMP(op->d.boolexpr.jumpdone);
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_AND_STEP)
+        {
+            if (*op->resnull) {
+                *op->d.boolexpr.anynull = true;
+            } else if (!DatumGetBool(*op->resvalue)) {
+                /* one FALSE makes the AND FALSE */
+                EEO_JUMP(op->d.boolexpr.jumpdone);
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_AND_STEP_LAST)
+        {
+            if (*op->resnull) {
+                /* result is already NULL */
+            } else if (!DatumGetBool(*op->resvalue)) {
+                /* result is already FALSE */
+            } else if (*op->d.boolexpr.anynull) {
+                *op->resvalue = (Datum)0;
+                *op->resnull = true;
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_OR_STEP_FIRST)
+        {
+            *op->d.boolexpr.anynull = false;
+            /* the rest is the same as EEOP_BOOL_OR_STEP */
+            if (*op->resnull) {
+                *op->d.boolexpr.anynull = true;
+            } else if (DatumGetBool(*op->resvalue)) {
+                EEO_JUMP(op->d.boolexpr.jumpdone);
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_OR_STEP)
+        {
+            if (*op->resnull) {
+                *op->d.boolexpr.anynull = true;
+            } else if (DatumGetBool(*op->resvalue)) {
+                /* one TRUE makes the OR TRUE */
+                EEO_JUMP(op->d.boolexpr.jumpdone);
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_OR_STEP_LAST)
+        {
+            if (*op->resnull) {
+                /* result is already NULL */
+            } else if (DatumGetBool(*op->resvalue)) {
+                /* result is already TRUE */
+            } else if (*op->d.boolexpr.anynull) {
+                *op->resvalue = (Datum)0;
+                *op->resnull = true;
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_BOOL_NOT)
+        {
+            /* a NULL input stays NULL */
+            if (!*op->resnull) {
+                *op->resvalue = BoolGetDatum(!DatumGetBool(*op->resvalue));
+            }
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_NULLTEST_ISNULL)
+        {
+            *op->resvalue = BoolGetDatum(*op->resnull);
+            *op->resnull = false;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_NULLTEST_ISNOTNULL)
+        {
+            *op->resvalue = BoolGetDatum(!*op->resnull);
+            *op->resnull = false;
+            EEO_NEXT();
+        }
+
+        EEO_CASE(EEOP_EVAL_SUBTREE)
+        {
+            *op->resvalue = ExecEvalExpr(op->d.subtree.state, econtext, op->resnull, NULL);
+            EEO_NEXT();
+        }
+
+#ifndef EEO_USE_COMPUTED_GOTO
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("unrecognized expression step: %d", op->opcode)));
+            break;
+#endif
+    }
+
+out:
+    *isNull = prog->resnull;
+    return prog->resvalue;
+}
@@ -43,6 +43,7 @@
 #include "catalog/pg_type.h"
 #include "commands/typecmds.h"
 #include "executor/execdebug.h"
+#include "executor/execExprInterp.h"
 #include "executor/nodeSubplan.h"
 #include "executor/nodeAgg.h"
 #include "funcapi.h"
@@ -4714,7 +4715,7 @@ Datum ExecEvalExprSwitchContext(ExprState* expression, ExprContext* econtext, bo
 }
 
 /*
- * ExecInitExpr: prepare an expression tree for execution
+ * ExecInitExprRec: prepare an expression tree for execution
  *
  * This function builds and returns an ExprState tree paralleling the given
  * Expr node tree.	The ExprState tree can then be handed to ExecEvalExpr
@@ -4745,7 +4746,7 @@ Datum ExecEvalExprSwitchContext(ExprState* expression, ExprContext* econtext, bo
  * associated with a plan tree.  (If so, it can't have aggs or subplans.)
  * This case should usually come through ExecPrepareExpr, not directly here.
  */
-ExprState* ExecInitExpr(Expr* node, PlanState* parent)
+static ExprState* ExecInitExprRec(Expr* node, PlanState* parent)
 {
     ExprState* state = NULL;
 
@@ -4814,9 +4815,9 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 aggstate->aggs = lcons(astate, aggstate->aggs);
                 naggs = ++aggstate->numaggs;
 
-                astate->aggdirectargs = (List*)ExecInitExpr((Expr*)aggref->aggdirectargs, parent);
+                astate->aggdirectargs = (List*)ExecInitExprRec((Expr*)aggref->aggdirectargs, parent);
 
-                astate->args = (List*)ExecInitExpr((Expr*)aggref->args, parent);
+                astate->args = (List*)ExecInitExprRec((Expr*)aggref->args, parent);
 
                 /*
                  * Complain if the aggregate's arguments contain any
@@ -4883,7 +4884,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 if (wfunc->winagg)
                     winstate->numaggs++;
 
-                wfstate->args = (List*)ExecInitExpr((Expr*)wfunc->args, parent);
+                wfstate->args = (List*)ExecInitExprRec((Expr*)wfunc->args, parent);
 
                 /*
                  * Complain if the windowfunc's arguments contain any
@@ -4906,10 +4907,10 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ArrayRefExprState* astate = makeNode(ArrayRefExprState);
 
             astate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalArrayRef;
-            astate->refupperindexpr = (List*)ExecInitExpr((Expr*)aref->refupperindexpr, parent);
-            astate->reflowerindexpr = (List*)ExecInitExpr((Expr*)aref->reflowerindexpr, parent);
-            astate->refexpr = ExecInitExpr(aref->refexpr, parent);
-            astate->refassgnexpr = ExecInitExpr(aref->refassgnexpr, parent);
+            astate->refupperindexpr = (List*)ExecInitExprRec((Expr*)aref->refupperindexpr, parent);
+            astate->reflowerindexpr = (List*)ExecInitExprRec((Expr*)aref->reflowerindexpr, parent);
+            astate->refexpr = ExecInitExprRec(aref->refexpr, parent);
+            astate->refassgnexpr = ExecInitExprRec(aref->refassgnexpr, parent);
             /* do one-time catalog lookups for type info */
             astate->refattrlength = get_typlen(aref->refarraytype);
             get_typlenbyvalalign(
@@ -4922,7 +4923,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalFunc;
 
-            fstate->args = (List*)ExecInitExpr((Expr*)funcexpr->args, parent);
+            fstate->args = (List*)ExecInitExprRec((Expr*)funcexpr->args, parent);
             fstate->func.fn_oid = InvalidOid; /* not initialized */
             state = (ExprState*)fstate;
         } break;
@@ -4931,7 +4932,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             FuncExprState* fstate = makeNode(FuncExprState);
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalOper;
-            fstate->args = (List*)ExecInitExpr((Expr*)opexpr->args, parent);
+            fstate->args = (List*)ExecInitExprRec((Expr*)opexpr->args, parent);
             fstate->func.fn_oid = InvalidOid; /* not initialized */
             state = (ExprState*)fstate;
         } break;
@@ -4940,7 +4941,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             FuncExprState* fstate = makeNode(FuncExprState);
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalDistinct;
-            fstate->args = (List*)ExecInitExpr((Expr*)distinctexpr->args, parent);
+            fstate->args = (List*)ExecInitExprRec((Expr*)distinctexpr->args, parent);
             fstate->func.fn_oid = InvalidOid; /* not initialized */
             state = (ExprState*)fstate;
         } break;
@@ -4949,7 +4950,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             FuncExprState* fstate = makeNode(FuncExprState);
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalNullIf;
-            fstate->args = (List*)ExecInitExpr((Expr*)nullifexpr->args, parent);
+            fstate->args = (List*)ExecInitExprRec((Expr*)nullifexpr->args, parent);
             fstate->func.fn_oid = InvalidOid; /* not initialized */
             state = (ExprState*)fstate;
         } break;
@@ -4958,7 +4959,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ScalarArrayOpExprState* sstate = makeNode(ScalarArrayOpExprState);
 
             sstate->fxprstate.xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalScalarArrayOp;
-            sstate->fxprstate.args = (List*)ExecInitExpr((Expr*)opexpr->args, parent);
+            sstate->fxprstate.args = (List*)ExecInitExprRec((Expr*)opexpr->args, parent);
             sstate->fxprstate.func.fn_oid = InvalidOid; /* not initialized */
             sstate->element_type = InvalidOid;          /* ditto */
             state = (ExprState*)sstate;
@@ -4984,7 +4985,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                             errmsg("unrecognized boolop: %d", (int)boolexpr->boolop)));
                     break;
             }
-            bstate->args = (List*)ExecInitExpr((Expr*)boolexpr->args, parent);
+            bstate->args = (List*)ExecInitExprRec((Expr*)boolexpr->args, parent);
             state = (ExprState*)bstate;
         } break;
         case T_SubPlan: {
@@ -5023,7 +5024,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             FieldSelectState* fstate = makeNode(FieldSelectState);
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalFieldSelect;
-            fstate->arg = ExecInitExpr(fselect->arg, parent);
+            fstate->arg = ExecInitExprRec(fselect->arg, parent);
             fstate->argdesc = NULL;
             state = (ExprState*)fstate;
         } break;
@@ -5032,8 +5033,8 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             FieldStoreState* fstate = makeNode(FieldStoreState);
 
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalFieldStore;
-            fstate->arg = ExecInitExpr(fstore->arg, parent);
-            fstate->newvals = (List*)ExecInitExpr((Expr*)fstore->newvals, parent);
+            fstate->arg = ExecInitExprRec(fstore->arg, parent);
+            fstate->newvals = (List*)ExecInitExprRec((Expr*)fstore->newvals, parent);
             fstate->argdesc = NULL;
             state = (ExprState*)fstate;
         } break;
@@ -5042,7 +5043,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             GenericExprState* gstate = makeNode(GenericExprState);
 
             gstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalRelabelType;
-            gstate->arg = ExecInitExpr(relabel->arg, parent);
+            gstate->arg = ExecInitExprRec(relabel->arg, parent);
             state = (ExprState*)gstate;
         } break;
         case T_CoerceViaIO: {
@@ -5052,7 +5053,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             bool typisvarlena = false;
 
             iostate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalCoerceViaIO;
-            iostate->arg = ExecInitExpr(iocoerce->arg, parent);
+            iostate->arg = ExecInitExprRec(iocoerce->arg, parent);
             /* lookup the result type's input function */
             getTypeInputInfo(iocoerce->resulttype, &iofunc, &iostate->intypioparam);
             fmgr_info(iofunc, &iostate->infunc);
@@ -5066,7 +5067,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ArrayCoerceExprState* astate = makeNode(ArrayCoerceExprState);
 
             astate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalArrayCoerceExpr;
-            astate->arg = ExecInitExpr(acoerce->arg, parent);
+            astate->arg = ExecInitExprRec(acoerce->arg, parent);
             astate->resultelemtype = get_element_type(acoerce->resulttype);
             if (astate->resultelemtype == InvalidOid)
                 ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("target type is not an array")));
@@ -5081,7 +5082,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ConvertRowtypeExprState* cstate = makeNode(ConvertRowtypeExprState);
 
             cstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalConvertRowtype;
-            cstate->arg = ExecInitExpr(convert->arg, parent);
+            cstate->arg = ExecInitExprRec(convert->arg, parent);
             state = (ExprState*)cstate;
         } break;
         case T_CaseExpr: {
@@ -5091,7 +5092,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ListCell* l = NULL;
 
             cstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalCase;
-            cstate->arg = ExecInitExpr(caseexpr->arg, parent);
+            cstate->arg = ExecInitExprRec(caseexpr->arg, parent);
             foreach (l, caseexpr->args) {
                 CaseWhen* when = (CaseWhen*)lfirst(l);
                 CaseWhenState* wstate = makeNode(CaseWhenState);
@@ -5099,12 +5100,12 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Assert(IsA(when, CaseWhen));
                 wstate->xprstate.evalfunc = NULL; /* not used */
                 wstate->xprstate.expr = (Expr*)when;
-                wstate->expr = ExecInitExpr(when->expr, parent);
-                wstate->result = ExecInitExpr(when->result, parent);
+                wstate->expr = ExecInitExprRec(when->expr, parent);
+                wstate->result = ExecInitExprRec(when->result, parent);
                 outlist = lappend(outlist, wstate);
             }
             cstate->args = outlist;
-            cstate->defresult = ExecInitExpr(caseexpr->defresult, parent);
+            cstate->defresult = ExecInitExprRec(caseexpr->defresult, parent);
             state = (ExprState*)cstate;
         } break;
         case T_ArrayExpr: {
@@ -5118,7 +5119,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             astate->elements = outlist;
@@ -5175,7 +5176,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                      */
                     e = (Expr*)makeNullConst(INT4OID, -1, InvalidOid);
                 }
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
                 i++;
             }
@@ -5199,7 +5200,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             rstate->largs = outlist;
@@ -5209,7 +5210,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             rstate->rargs = outlist;
@@ -5253,7 +5254,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             cstate->args = outlist;
@@ -5271,7 +5272,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             mstate->args = outlist;
@@ -5304,7 +5305,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(arg);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             xstate->named_args = outlist;
@@ -5314,7 +5315,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(arg);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
             xstate->args = outlist;
@@ -5326,7 +5327,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             NullTestState* nstate = makeNode(NullTestState);
 
             nstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalNullTest;
-            nstate->arg = ExecInitExpr(ntest->arg, parent);
+            nstate->arg = ExecInitExprRec(ntest->arg, parent);
             nstate->argdesc = NULL;
             state = (ExprState*)nstate;
         } break;
@@ -5343,7 +5344,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
                 Expr* e = (Expr*)lfirst(l);
                 ExprState* estate = NULL;
 
-                estate = ExecInitExpr(e, parent);
+                estate = ExecInitExprRec(e, parent);
                 outlist = lappend(outlist, estate);
             }
 
@@ -5360,7 +5361,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             GenericExprState* gstate = makeNode(GenericExprState);
 
             gstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalBooleanTest;
-            gstate->arg = ExecInitExpr(btest->arg, parent);
+            gstate->arg = ExecInitExprRec(btest->arg, parent);
             state = (ExprState*)gstate;
         } break;
         case T_CoerceToDomain: {
@@ -5368,7 +5369,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             CoerceToDomainState* cstate = makeNode(CoerceToDomainState);
 
             cstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalCoerceToDomain;
-            cstate->arg = ExecInitExpr(ctest->arg, parent);
+            cstate->arg = ExecInitExprRec(ctest->arg, parent);
             cstate->constraints = GetDomainConstraints(ctest->resulttype);
             state = (ExprState*)cstate;
         } break;
@@ -5381,7 +5382,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             GenericExprState* gstate = makeNode(GenericExprState);
 
             gstate->xprstate.evalfunc = NULL; /* not used */
-            gstate->arg = ExecInitExpr(tle->expr, parent);
+            gstate->arg = ExecInitExprRec(tle->expr, parent);
             state = (ExprState*)gstate;
         } break;
         case T_List: {
@@ -5389,7 +5390,7 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             ListCell* l = NULL;
 
             foreach (l, (List*)node) {
-                outlist = lappend(outlist, ExecInitExpr((Expr*)lfirst(l), parent));
+                outlist = lappend(outlist, ExecInitExprRec((Expr*)lfirst(l), parent));
             }
             /* Don't fall through to the "common" code below */
             gstrace_exit(GS_TRC_ID_ExecInitExpr);
@@ -5419,6 +5420,31 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
     return state;
 }
 
+/*
+ * ExecInitExpr
+ *
+ * Build the state tree with ExecInitExprRec. With enable_flat_expr on, the root
+ * of the tree, or each one of a list, is also compiled into a step program.
+ */
+ExprState* ExecInitExpr(Expr* node, PlanState* parent)
+{
+    ExprState* state = ExecInitExprRec(node, parent);
+    ListCell* l = NULL;
+
+    if (state == NULL || !u_sess->attr.attr_sql.enable_flat_expr)
+        return state;
+
+    if (IsA(node, List)) {
+        foreach (l, (List*)state) {
+            ExecCompileExprSteps((ExprState*)lfirst(l));
+        }
+    } else {
+        ExecCompileExprSteps(state);
+    }
+
+    return state;
+}
+
 /*
  * ExecPrepareExpr --- initialize for expression execution outside a normal
  * Plan tree context.
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * execRuntimeFilter.cpp
+ *        Bloom filters pushed down from hash joins into row and column table scans
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/runtime/executor/execRuntimeFilter.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/tableam.h"
+#include "catalog/pg_type.h"
+#include "distributelayer/streamCore.h"
+#include "executor/executor.h"
+#include "executor/execRuntimeFilter.h"
+#include "storage/barrier.h"
+#include "utils/builtins.h"
+#include "utils/memutils.h"
+
+#define IsRuntimeFilterIntType(type) ((type) == INT2OID || (type) == INT4OID || (type) == INT8OID)
+#define IsRuntimeFilterFloatType(type) ((type) == FLOAT4OID || (type) == FLOAT8OID)
+
+/*
+ * Can the filter built on the inner join key be probed with the values of the
+ * scan attribute? Integers and floats are hashed through int64 and double, so
+ * the widths need not match. Strings are hashed as they are stored, so a
+ * bpchar must also be padded to the same length.
+ */
+static bool RuntimeFilterTypeMatch(const filter::BloomFilter* bf, Oid atttype, int32 atttypmod)
+{
+    Oid ftype = bf->getDataType();
+
+    if (IsRuntimeFilterIntType(atttype)) {
+        return IsRuntimeFilterIntType(ftype);
+    }
+    if (IsRuntimeFilterFloatType(atttype)) {
+        return IsRuntimeFilterFloatType(ftype);
+    }
+    if (atttype == BPCHAROID) {
+        return ftype == BPCHAROID && atttypmod >= 0 && bf->getTypeMod() == atttypmod;
+    }
+    return (atttype == VARCHAROID || atttype == TEXTOID || atttype == CLOBOID) && ftype == atttype;
+}
+
+static int64 RuntimeFilterIntValue(Oid type, Datum value)
+{
+    switch (type) {
+        case INT2OID:
+            return DatumGetInt16(value);
+        case INT4OID:
+            return DatumGetInt32(value);
+        default:
+            return DatumGetInt64(value);
+    }
+}
+
+/* Forget filter i of the scan, keeping the others in the first nfilters slots. */
+static void RuntimeFilterRemove(ScanRuntimeFilter* rtf, int i)
+{
+    int last = --rtf->nfilters;
+
+    rtf->attnos[i] = rtf->attnos[last];
+    rtf->atttypes[i] = rtf->atttypes[last];
+    rtf->atttypmods[i] = rtf->atttypmods[last];
+    rtf->filterIndex[i] = rtf->filterIndex[last];
+    rtf->filters[i] = rtf->filters[last];
+    rtf->shared[i] = rtf->shared[last];
+}
+
+/*
+ * Set up the filters the planner marked on the scan. Returns NULL if there
+ * are none to apply.
+ */
+ScanRuntimeFilter* ExecInitScanRuntimeFilter(ScanState* node)
+{
+    Plan* plan = node->ps.plan;
+    EState* estate = node->ps.state;
+    ScanRuntimeFilter* rtf = NULL;
+    ListCell* lc1 = NULL;
+    ListCell* lc2 = NULL;
+    int n;
+    int i = 0;
+
+    if (!u_sess->attr.attr_sql.enable_bloom_filter || plan->var_list == NIL ||
+        estate->es_bloom_filter.bfarray == NULL) {
+        return NULL;
+    }
+
+    n = list_length(plan->var_list);
+    Assert(n == list_length(plan->filterIndexList));
+
+    rtf = (ScanRuntimeFilter*)palloc0(sizeof(ScanRuntimeFilter));
+    rtf->attnos = (AttrNumber*)palloc(sizeof(AttrNumber) * n);
+    rtf->atttypes = (Oid*)palloc(sizeof(Oid) * n);
+    rtf->atttypmods = (int32*)palloc(sizeof(int32) * n);
+    rtf->filterIndex = (int*)palloc(sizeof(int) * n);
+    rtf->filters = (filter::BloomFilter**)palloc0(sizeof(filter::BloomFilter*) * n);
+    rtf->shared = (SharedBloomFilter**)palloc0(sizeof(SharedBloomFilter*) * n);
+
+    forboth(lc1, plan->var_list, lc2, plan->filterIndexList) {
+        Var* var = (Var*)lfirst(lc1);
+        int idx = lfirst_int(lc2);
+
+        if (!IsA(var, Var) || var->varattno <= 0 || idx < 0 || idx >= estate->es_bloom_filter.array_size) {
+            continue;
+        }
+        rtf->attnos[i] = var->varattno;
+        rtf->atttypes[i] = var->vartype;
+        rtf->atttypmods[i] = var->vartypmod;
+        rtf->filterIndex[i] = idx;
+        i++;
+    }
+    rtf->nfilters = i;
+
+    if (rtf->nfilters == 0) {
+        pfree_ext(rtf->attnos);
+        pfree_ext(rtf->atttypes);
+        pfree_ext(rtf->atttypmods);
+        pfree_ext(rtf->filterIndex);
+        pfree_ext(rtf->filters);
+        pfree_ext(rtf->shared);
+        pfree_ext(rtf);
+        return NULL;
+    }
+    return rtf;
+}
+
+/*
+ * Pick up the filters built since the last call. A filter the hash join of
+ * this thread built is in the EState, one built by the threads of a hash join
+ * above a local stream is in the stream node group. Returns true if the scan
+ * has at least one filter to apply.
+ */
+bool ExecScanRuntimeFilterReady(ScanState* node)
+{
+    ScanRuntimeFilter* rtf = node->ss_runtimeFilter;
+    filter::BloomFilter** bfarray = node->ps.state->es_bloom_filter.bfarray;
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+
+    if (likely(rtf->nready == rtf->nfilters)) {
+        return rtf->nready > 0;
+    }
+
+    for (int i = 0; i < rtf->nfilters; i++) {
+        filter::BloomFilter* bf = NULL;
+
+        if (rtf->filters[i] != NULL) {
+            continue;
+        }
+
+        bf = bfarray[rtf->filterIndex[i]];
+        if (bf == NULL && group != NULL) {
+            if (rtf->shared[i] == NULL) {
+                rtf->shared[i] = group->GetSharedBloomFilter(rtf->filterIndex[i]);
+            }
+            if (pg_atomic_read_u32(&rtf->shared[i]->ready) != 0) {
+                pg_read_barrier();
+                bf = rtf->shared[i]->filter;
+            }
+        }
+
+        if (bf == NULL) {
+            continue;
+        }
+        if (!RuntimeFilterTypeMatch(bf, rtf->atttypes[i], rtf->atttypmods[i])) {
+            RuntimeFilterRemove(rtf, i);
+            i--;
+            continue;
+        }
+        rtf->filters[i] = bf;
+        rtf->nready++;
+    }
+
+    return rtf->nready > 0;
+}
+
+/*
+ * On rescan the hash joins of this thread may rebuild their tables, so look
+ * their filters up again. The union of the smp threads is built only once.
+ */
+void ExecReScanScanRuntimeFilter(ScanState* node)
+{
+    ScanRuntimeFilter* rtf = node->ss_runtimeFilter;
+
+    for (int i = 0; i < rtf->nfilters; i++) {
+        if (rtf->filters[i] != NULL && rtf->shared[i] == NULL) {
+            rtf->filters[i] = NULL;
+            rtf->nready--;
+        }
+    }
+}
+
+/*
+ * Could the value of the scan attribute find a match in the hash table the
+ * filter was built from? Strings are copied into the current memory context,
+ * which the caller resets.
+ */
+bool ExecRuntimeFilterInclude(const filter::BloomFilter* bf, Oid atttype, Datum value)
+{
+    switch (atttype) {
+        case INT2OID:
+        case INT4OID:
+        case INT8OID:
+            return bf->includeLong(RuntimeFilterIntValue(atttype, value));
+        case FLOAT4OID:
+        case FLOAT8OID: {
+            double val = (atttype == FLOAT4OID) ? (double)DatumGetFloat4(value) : DatumGetFloat8(value);
+
+            /* -0 and 0 join but do not hash alike */
+            if (val == 0.0) {
+                return true;
+            }
+            return bf->includeDouble(val);
+        }
+        default:
+            return bf->includeString(TextDatumGetCString(value));
+    }
+}
+
+/*
+ * Could any value in [min, max] of the scan attribute find a match? Only
+ * integer attributes are checked, the CU min/max of other types may be
+ * truncated.
+ */
+bool ExecRuntimeFilterMinMax(const filter::BloomFilter* bf, Oid atttype, Datum min, Datum max)
+{
+    Oid ftype = bf->getDataType();
+
+    if (!IsRuntimeFilterIntType(atttype) || !IsRuntimeFilterIntType(ftype) || !bf->hasMinMax()) {
+        return true;
+    }
+
+    int64 lo = RuntimeFilterIntValue(atttype, min);
+    int64 hi = RuntimeFilterIntValue(atttype, max);
+
+    if (lo == hi) {
+        return bf->includeLong(lo);
+    }
+    return hi >= RuntimeFilterIntValue(ftype, bf->getMin()) && lo <= RuntimeFilterIntValue(ftype, bf->getMax());
+}
+
+/*
+ * Does the scan tuple pass the filters built so far? Rows with a NULL key are
+ * left to the join.
+ */
+bool ExecScanRuntimeFilterTuple(ScanState* node, TupleTableSlot* slot)
+{
+    ScanRuntimeFilter* rtf = node->ss_runtimeFilter;
+    MemoryContext oldcxt;
+    bool passed = true;
+
+    if (!ExecScanRuntimeFilterReady(node)) {
+        return true;
+    }
+
+    oldcxt = MemoryContextSwitchTo(node->ps.ps_ExprContext->ecxt_per_tuple_memory);
+    for (int i = 0; i < rtf->nfilters && passed; i++) {
+        bool isnull = false;
+        Datum value;
+
+        if (rtf->filters[i] == NULL) {
+            continue;
+        }
+        value = tableam_tslot_getattr(slot, rtf->attnos[i], &isnull);
+        if (!isnull) {
+            passed = ExecRuntimeFilterInclude(rtf->filters[i], rtf->atttypes[i], value);
+        }
+    }
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    return passed;
+}
+
+/*
+ * Publish the filter a hash join thread built to the scans below a local
+ * stream. The union in the stream node group becomes ready once every smp
+ * thread of the hash join has published, later publishes are ignored. String
+ * filters are kept to their thread, since probing them allocates in the
+ * context of the filter.
+ */
+void ExecPublishRuntimeFilter(PlanState* join, int filter_index, filter::BloomFilter* bf)
+{
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+    Oid type = bf->getDataType();
+    SharedBloomFilter* shared = NULL;
+
+    if (group == NULL || EXEC_IN_RECURSIVE_MODE(join->plan) ||
+        !(IsRuntimeFilterIntType(type) || IsRuntimeFilterFloatType(type))) {
+        return;
+    }
+
+    shared = group->GetSharedBloomFilter(filter_index);
+
+    AutoMutexLock streamLock(group->GetStreamMutext());
+    streamLock.lock();
+    if (shared->filter == NULL) {
+        AutoContextSwitch sharedCxtGuard(shared->context);
+        shared->nbuilders = join->plan->dop;
+        shared->filter = filter::createBloomFilter(
+            type, bf->getTypeMod(), InvalidOid, HASHJOIN_BLOOM_FILTER, DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5, true);
+    }
+
+    if (!shared->invalid && shared->nbuilt < shared->nbuilders) {
+        if (shared->filter->getBitSize() == bf->getBitSize() &&
+            shared->filter->getNumHashFunctions() == bf->getNumHashFunctions()) {
+            shared->filter->unionAll(*bf);
+            if (++shared->nbuilt == shared->nbuilders) {
+                pg_write_barrier();
+                pg_atomic_write_u32(&shared->ready, 1);
+            }
+        } else {
+            shared->invalid = true;
+        }
+    }
+    streamLock.unLock();
+}
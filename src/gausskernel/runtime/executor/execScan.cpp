@@ -20,10 +20,62 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/tableam.h"
 #include "executor/executor.h"
+#include "executor/execRuntimeFilter.h"
 #include "miscadmin.h"
 #include "utils/memutils.h"
 
+/*
+ * ExecScanJittedDeform -- deform a new heap tuple with the codegened function
+ *
+ * The function only knows the fixed-length prefix of the scan tuple, so any
+ * tuple it was not built for is left to tableam_tslot_getsomeattrs.
+ */
+static inline void ExecScanJittedDeform(ScanState* node, TupleTableSlot* slot)
+{
+    HeapTuple tuple = (HeapTuple)slot->tts_tuple;
+
+    if (slot->tts_tupslotTableAm != TAM_HEAP || tuple == NULL || slot->tts_nvalid != 0 ||
+#ifdef PGXC
+        slot->tts_dataRow != NULL ||
+#endif
+        HEAP_TUPLE_IS_COMPRESSED(tuple->t_data) ||
+        (int)HeapTupleHeaderGetNatts(tuple->t_data, slot->tts_tupleDescriptor) < node->jitted_deform_natts) {
+        return;
+    }
+
+    HeapTupleHeader tup = tuple->t_data;
+    slot->tts_off = node->jitted_deform(
+        (char*)tup + tup->t_hoff, HeapTupleHasNulls(tuple) ? tup->t_bits : NULL, slot->tts_values, slot->tts_isnull);
+    slot->tts_nvalid = node->jitted_deform_natts;
+    slot->tts_slow = true;
+}
+
+/*
+ * ExecScanJittedQualValid -- can the codegened qual stand in for qual?
+ *
+ * It was built from the plan qual, while ps.qual may be rebuilt from another
+ * list, as for a relation in redistribution. Comparing the expressions the
+ * states were built from costs a few pointer compares per tuple.
+ */
+static inline bool ExecScanJittedQualValid(ScanState* node, List* qual)
+{
+    List* plan_qual = node->ps.plan->qual;
+    ListCell* lc1 = NULL;
+    ListCell* lc2 = NULL;
+
+    if (node->jitted_rowqual == NULL || list_length(qual) != list_length(plan_qual)) {
+        return false;
+    }
+    forboth(lc1, qual, lc2, plan_qual) {
+        if (((ExprState*)lfirst(lc1))->expr != (Expr*)lfirst(lc2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * ExecScanFetch -- fetch next potential tuple
  *
@@ -119,7 +171,7 @@ TupleTableSlot* ExecScan(ScanState* node, ExecScanAccessMtd access_mtd, /* funct
      * If we have neither a qual to check nor a projection to do, just skip
      * all the overhead and return the raw scan tuple.
      */
-    if (qual == NULL && proj_info == NULL) {
+    if (qual == NULL && proj_info == NULL && node->ss_runtimeFilter == NULL) {
         ResetExprContext(econtext);
         return ExecScanFetch(node, access_mtd, recheck_mtd);
     }
@@ -184,6 +236,10 @@ TupleTableSlot* ExecScan(ScanState* node, ExecScanAccessMtd access_mtd, /* funct
          */
         econtext->ecxt_scantuple = slot;
 
+        if (node->jitted_deform != NULL) {
+            ExecScanJittedDeform(node, slot);
+        }
+
         /*
          * check that the current tuple satisfies the qual-clause
          *
@@ -191,7 +247,20 @@ TupleTableSlot* ExecScan(ScanState* node, ExecScanAccessMtd access_mtd, /* funct
          * when the qual is nil ... saves only a few cycles, but they add up
          * ...
          */
-        if (qual == NULL || ExecQual(qual, econtext, false)) {
+        bool qual_passed = false;
+        if (node->ss_runtimeFilter != NULL && !ExecScanRuntimeFilterTuple(node, slot)) {
+            /* the key has no match in the hash table of the join above */
+            qual_passed = false;
+        } else if (qual == NULL) {
+            qual_passed = true;
+        } else if (ExecScanJittedQualValid(node, qual)) {
+            tableam_tslot_getsomeattrs(slot, node->jitted_rowqual_natts);
+            qual_passed = node->jitted_rowqual(slot->tts_values, slot->tts_isnull);
+        } else {
+            qual_passed = ExecQual(qual, econtext, false);
+        }
+
+        if (qual_passed) {
             /*
              * Found a satisfactory scan tuple.
              */
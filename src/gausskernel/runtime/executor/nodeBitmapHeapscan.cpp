@@ -43,6 +43,7 @@
 #include "executor/nodeBitmapHeapscan.h"
 #include "pgstat.h"
 #include "storage/buf/bufmgr.h"
+#include "storage/fd.h"
 #include "storage/predicate.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
@@ -938,6 +939,8 @@ void BitmapHeapPrefetchNext(
             /* For posix_fadvise() we just send the one request */
             PrefetchBuffer(prefetchRel, MAIN_FORKNUM, tbmpre->blockno);
         }
+        /* With io_uring the requests above were only queued, submit them together */
+        FileSubmitPendingIO();
         /* recover old oid after prefetch switch */
         GPISetCurrPartOid(node->gpi_scan, oldOid);
     }
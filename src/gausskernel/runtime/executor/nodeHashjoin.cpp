@@ -16,13 +16,16 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/tableam.h"
 #include "executor/executor.h"
+#include "executor/execRuntimeFilter.h"
 #include "executor/execStream.h"
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
 #include "miscadmin.h"
 #include "utils/anls_opt.h"
+#include "utils/bloom_filter.h"
 #include "utils/memutils.h"
 
 /*
@@ -44,6 +47,8 @@ static TupleTableSlot* ExecHashJoinOuterGetTuple(PlanState* outerNode, HashJoinS
 static TupleTableSlot* ExecHashJoinGetSavedTuple(
     HashJoinState* hjstate, BufFile* file, uint32* hashvalue, TupleTableSlot* tupleSlot);
 static bool ExecHashJoinNewBatch(HashJoinState* hjstate);
+static void ExecHashJoinPushDownBloomFilter(HashJoinState* hjstate);
+static void ExecHashJoinResetBloomFilter(HashJoinState* hjstate);
 
 /* ----------------------------------------------------------------
  *		ExecHashJoin
@@ -214,6 +219,9 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                     return NULL;
                 }
 
+                /* let the scans below the outer side skip the rows without a match */
+                ExecHashJoinPushDownBloomFilter(node);
+
                 /*
                  * need to remember whether nbatch has increased since we
                  * began scanning the outer relation
@@ -999,6 +1007,90 @@ static TupleTableSlot* ExecHashJoinGetSavedTuple(
     return ExecStoreMinimalTuple(tuple, tupleSlot, true);
 }
 
+/*
+ * ExecHashJoinPushDownBloomFilter
+ *		Build a bloom filter on each join key the planner marked and hand it to
+ *		the scans below the outer side. Only done for a single batch, whose
+ *		tuples are all in memory.
+ */
+static void ExecHashJoinPushDownBloomFilter(HashJoinState* hjstate)
+{
+    HashJoinTable hashtable = hjstate->hj_HashTable;
+    Plan* plan = hjstate->js.ps.plan;
+    filter::BloomFilter** bfarray = hjstate->js.ps.state->es_bloom_filter.bfarray;
+    ExprContext* econtext = hjstate->js.ps.ps_ExprContext;
+    TupleTableSlot* slot = hjstate->hj_HashTupleSlot;
+    ListCell* lc1 = NULL;
+    ListCell* lc2 = NULL;
+
+    if (!u_sess->attr.attr_sql.enable_bloom_filter || plan->var_list == NIL || bfarray == NULL ||
+        hashtable->nbatch != 1 || hashtable->totalTuples > DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
+        return;
+    }
+
+    forboth(lc1, plan->var_list, lc2, plan->filterIndexList) {
+        Var* var = (Var*)lfirst(lc1);
+        int pos = lfirst_int(lc2);
+        filter::BloomFilter* bf = NULL;
+        MemoryContext oldcxt;
+
+        if (!IsA(var, Var) || !SATISFY_BLOOM_FILTER(var->vartype) || pos < 0 ||
+            pos >= hjstate->js.ps.state->es_bloom_filter.array_size) {
+            continue;
+        }
+
+        bf = filter::createBloomFilter(var->vartype, var->vartypmod, var->varcollid, HASHJOIN_BLOOM_FILTER,
+            DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5, true);
+
+        oldcxt = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+        for (int i = 0; i < hashtable->nbuckets + hashtable->nSkewBuckets; i++) {
+            HashJoinTuple tuple = (i < hashtable->nbuckets)
+                                      ? hashtable->buckets[i]
+                                      : hashtable->skewBucket[hashtable->skewBucketNums[i - hashtable->nbuckets]]->tuples;
+
+            for (; tuple != NULL; tuple = tuple->next) {
+                bool isnull = false;
+                Datum value;
+
+                (void)ExecStoreMinimalTuple(HJTUPLE_MINTUPLE(tuple), slot, false);
+                value = tableam_tslot_getattr(slot, var->varattno, &isnull);
+
+                /* Null value will not be joined, so we can ignore null value. */
+                if (!isnull) {
+                    bf->addDatum(value);
+                }
+                ResetExprContext(econtext);
+            }
+        }
+        (void)MemoryContextSwitchTo(oldcxt);
+        (void)ExecClearTuple(slot);
+
+        bfarray[pos] = bf;
+        ExecPublishRuntimeFilter(&hjstate->js.ps, pos, bf);
+    }
+}
+
+/*
+ * ExecHashJoinResetBloomFilter
+ *		Forget the filters of a hash table about to be rebuilt.
+ */
+static void ExecHashJoinResetBloomFilter(HashJoinState* hjstate)
+{
+    filter::BloomFilter** bfarray = hjstate->js.ps.state->es_bloom_filter.bfarray;
+    ListCell* lc = NULL;
+
+    if (bfarray == NULL) {
+        return;
+    }
+    foreach (lc, hjstate->js.ps.plan->filterIndexList) {
+        int pos = lfirst_int(lc);
+
+        if (pos >= 0 && pos < hjstate->js.ps.state->es_bloom_filter.array_size) {
+            bfarray[pos] = NULL;
+        }
+    }
+}
+
 void ExecReScanHashJoin(HashJoinState* node)
 {
     /* Already reset, just rescan righttree and lefttree */
@@ -1051,6 +1143,7 @@ void ExecReScanHashJoin(HashJoinState* node)
             ExecHashTableDestroy(node->hj_HashTable);
             node->hj_HashTable = NULL;
             node->hj_JoinState = HJ_BUILD_HASHTABLE;
+            ExecHashJoinResetBloomFilter(node);
 
             /*
              * if chgParam of subnode is not null then plan will be re-scanned
@@ -1065,6 +1158,7 @@ void ExecReScanHashJoin(HashJoinState* node)
             // no need to destroy hash table, just build it.
             node->hj_HashTable = NULL;
             node->hj_JoinState = HJ_BUILD_HASHTABLE;
+            ExecHashJoinResetBloomFilter(node);
 
             // swtich to next partition, in the right tree
             if (node->js.ps.righttree->chgParam == NULL) {
@@ -27,7 +27,9 @@
 
 #include "access/relscan.h"
 #include "access/tableam.h"
+#include "distributelayer/streamCore.h"
 #include "executor/execdebug.h"
+#include "executor/execRuntimeFilter.h"
 #include "executor/nodeModifyTable.h"
 #include "executor/nodeSamplescan.h"
 #include "executor/nodeSeqscan.h"
@@ -42,6 +44,9 @@
 #include "optimizer/pruning.h"
 
 extern void StrategyGetRingPrefetchQuantityAndTrigger(BufferAccessStrategy strategy, int* quantity, int* trigger);
+extern bool CodeGenThreadObjectReady();
+extern bool CodeGenPassThreshold(double rows, int dn_num, int dop);
+extern void RowScanCodeGen(ScanState* node);
 /* ----------------------------------------------------------------
  *		prefetch_pages
  *
@@ -432,6 +437,29 @@ void InitScanRelation(SeqScanState* node, EState* estate)
 
     ExecAssignScanType(node, RelationGetDescr(current_relation));
 }
+/*
+ * Let the smp workers of a parallel scan share the blocks of a plain heap
+ * through an allocator of the stream node group, so that a worker held up by
+ * the rest of its plan leaves its blocks to the others. Rescans, and scans the
+ * fixed split handles specially, keep that split.
+ */
+static bool SeqScanAttachBlockAllocator(SeqScanState* node)
+{
+    TableScanDesc scan = node->ss_currentScanDesc;
+    Relation rel = node->ss_currentRelation;
+
+    if (node->ps.plan->dop <= 1 || u_sess->stream_cxt.global_obj == NULL || node->isPartTbl ||
+        node->isSampleScan || rel->rd_tam_type != TAM_HEAP || RELATION_OWN_BUCKET(rel) ||
+        scan->rs_rangeScanInRedis.isRangeScanInRedis || ScanDirectionIsBackward(node->partScanDirection)) {
+        return false;
+    }
+
+    ParallelBlockAllocator* allocator =
+        u_sess->stream_cxt.global_obj->GetParallelBlockAllocator(node->ps.plan->plan_node_id, scan->rs_nblocks);
+    heap_attach_parallel_seqscan(scan, allocator);
+    return true;
+}
+
 static inline void InitSeqNextMtd(SeqScan* node, SeqScanState* scanstate)
 {
     if (!node->tablesample) {
@@ -524,8 +552,10 @@ SeqScanState* ExecInitSeqScan(SeqScan* node, EState* estate, int eflags)
      */
     InitSeqNextMtd(node, scanstate);
     if (IsValidScanDesc(scanstate->ss_currentScanDesc)) {
-        scan_handler_tbl_init_parallel_seqscan(scanstate->ss_currentScanDesc, 
-            scanstate->ps.plan->dop, scanstate->partScanDirection);
+        if (!SeqScanAttachBlockAllocator(scanstate)) {
+            scan_handler_tbl_init_parallel_seqscan(scanstate->ss_currentScanDesc,
+                scanstate->ps.plan->dop, scanstate->partScanDirection);
+        }
     } else {
         scanstate->ps.stubType = PST_Scan;
     }
@@ -541,6 +571,18 @@ SeqScanState* ExecInitSeqScan(SeqScan* node, EState* estate, int eflags)
 
     ExecAssignScanProjectionInfo(scanstate);
 
+    /* Pick up the bloom filters the hash joins above push down to this scan. */
+    scanstate->ss_runtimeFilter = ExecInitScanRuntimeFilter((ScanState*)scanstate);
+
+    /*
+     * Check if the qual and the deforming of the scan tuple could be
+     * codegened or not.
+     */
+    if (scanstate->ss_currentRelation->rd_tam_type == TAM_HEAP && CodeGenThreadObjectReady() &&
+        CodeGenPassThreshold(((Plan*)node)->plan_rows, estate->es_plannedstmt->num_nodes, ((Plan*)node)->dop)) {
+        RowScanCodeGen((ScanState*)scanstate);
+    }
+
     return scanstate;
 }
 
@@ -637,6 +679,9 @@ void ExecReScanSeqScan(SeqScanState* node)
     }
 
     scan_handler_tbl_init_parallel_seqscan(scan, node->ps.plan->dop, node->partScanDirection);
+    if (node->ss_runtimeFilter != NULL) {
+        ExecReScanScanRuntimeFilter((ScanState*)node);
+    }
     ExecScanReScan((ScanState*)node);
 }
 
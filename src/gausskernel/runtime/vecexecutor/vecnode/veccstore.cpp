@@ -29,6 +29,7 @@
 #include "access/relscan.h"
 #include "access/tableam.h"
 #include "executor/execdebug.h"
+#include "executor/execRuntimeFilter.h"
 #include "vecexecutor/vecnodecstorescan.h"
 #include "vecexecutor/vecnoderowtovector.h"
 #include "executor/nodeModifyTable.h"
@@ -175,6 +176,45 @@ void OptimizeProjectionAndFilter(CStoreScanState* node)
     node->m_fSimpleMap = simple_map;
 }
 
+/*
+ * Drop the rows of the scan batch whose join key the bloom filters pushed down
+ * from the hash joins above exclude. Returns false if no row is left.
+ */
+static bool ApplyRuntimeFilter(CStoreScanState* node, VectorBatch* p_scan_batch)
+{
+    ScanRuntimeFilter* rtf = node->ss_runtimeFilter;
+    bool* sel = p_scan_batch->m_sel;
+    int nrows = p_scan_batch->m_rows;
+    MemoryContext oldcxt;
+
+    if (!ExecScanRuntimeFilterReady((ScanState*)node)) {
+        return true;
+    }
+
+    for (int i = 0; i < nrows; i++) {
+        sel[i] = true;
+    }
+
+    oldcxt = MemoryContextSwitchTo(node->ps.ps_ExprContext->ecxt_per_tuple_memory);
+    for (int i = 0; i < rtf->nfilters; i++) {
+        ScalarVector* vec = NULL;
+
+        if (rtf->filters[i] == NULL) {
+            continue;
+        }
+        vec = &p_scan_batch->m_arr[rtf->attnos[i] - 1];
+        for (int j = 0; j < nrows; j++) {
+            if (sel[j] && NOT_NULL(vec->m_flag[j])) {
+                sel[j] = ExecRuntimeFilterInclude(rtf->filters[i], rtf->atttypes[i], vec->m_vals[j]);
+            }
+        }
+    }
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    p_scan_batch->Pack(sel);
+    return p_scan_batch->m_rows > 0;
+}
+
 VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan_batch, ExprDoneCond* done)
 {
     List* qual = NIL;
@@ -246,6 +286,13 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             node->ss_deltaScan = false;
         }
 
+        // Drop the rows the hash joins above would not match
+        //
+        if (node->ss_runtimeFilter != NULL && !ApplyRuntimeFilter(node, p_scan_batch)) {
+            p_out_batch->m_rows = 0;
+            goto done;
+        }
+
         // Project the final result
         //
         if (!simple_map) {
@@ -790,6 +837,8 @@ CStoreScanState* ExecInitCStoreScan(
         &scan_stat->m_pScanRunTimeKeys,
         &scan_stat->m_ScanRunTimeKeysNum);
 
+    scan_stat->ss_runtimeFilter = ExecInitScanRuntimeFilter((ScanState*)scan_stat);
+
     scan_stat->m_CStore = New(CurrentMemoryContext) CStore();
     scan_stat->m_CStore->InitScan(scan_stat, GetActiveSnapshot());
     OptimizeProjectionAndFilter(scan_stat);
@@ -1151,6 +1200,10 @@ void ExecReScanCStoreScan(CStoreScanState* node)
     }
     node->m_ScanRunTimeKeysReady = true;
 
+    if (node->ss_runtimeFilter != NULL) {
+        ExecReScanScanRuntimeFilter((ScanState*)node);
+    }
+
     scan = (TableScanDesc)(node->ss_currentScanDesc);
     if (node->isPartTbl) {
         if (PointerIsValid(node->partitions)) {
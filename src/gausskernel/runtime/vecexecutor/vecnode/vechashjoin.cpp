@@ -34,6 +34,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 #include "executor/executor.h"
+#include "executor/execRuntimeFilter.h"
 #include "commands/explain.h"
 #include "utils/anls_opt.h"
 #include "utils/biginteger.h"
@@ -980,6 +981,7 @@ void HashJoinTbl::PushDownFilterIfNeed()
 
             int pos = list_nth_int(m_runtime->bf_runtime.bf_filter_index, i);
             bf_array[pos] = filter;
+            ExecPublishRuntimeFilter(&m_runtime->js.ps, pos, filter);
         }
     }
 }
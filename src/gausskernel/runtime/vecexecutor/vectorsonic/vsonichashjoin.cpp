@@ -25,6 +25,11 @@
  */
 #include "vectorsonic/vsonichash.h"
 #include "vectorsonic/vsonichashjoin.h"
+#include "distributelayer/streamCore.h"
+#include "executor/execStream.h"
+#include "executor/execRuntimeFilter.h"
+#include "optimizer/streamplan.h"
+#include "storage/barrier.h"
 #include "utils/memprot.h"
 
 #define leftrot(x, k) (((x) << (k)) | ((x) >> (32 - (k))))
@@ -37,6 +42,9 @@
     }
 #define INSTR (m_runtime->js.ps.instrument)
 
+/* Sleep time between polls while waiting for a shared hash table. */
+#define SONIC_SHARED_HASH_WAIT_USEC 1000L
+
 /*
  * Hash table size: next size + bucket size
  * next size   : 4bytes * (nrows + 1)
@@ -75,6 +83,7 @@ SonicHashJoin::SonicHashJoin(int size, VecHashJoinState* node)
     : SonicHash(size),
       m_complicatekey(false),
       m_runtime(node),
+      m_sharedTable(NULL),
       m_outRawBatch(NULL),
       m_matchLocIndx(0),
       m_probeIdx(0),
@@ -172,6 +181,11 @@ SonicHashJoin::SonicHashJoin(int size, VecHashJoinState* node)
 
     m_diskPartNum = 0;
     m_strategy = MEMORY_HASH;
+
+    if (sharedBuildEnable()) {
+        Plan* plan = m_runtime->js.ps.plan;
+        m_sharedTable = u_sess->stream_cxt.global_obj->GetSonicSharedHashTable(plan->plan_node_id, plan->dop);
+    }
 }
 
 /*
@@ -328,6 +342,140 @@ void SonicHashJoin::initPartition(SonicHashPartition* partition)
     (void)MemoryContextSwitchTo(old_cxt);
 }
 
+/*
+ * @Description: Check whether the smp threads of the join could share one hash table.
+ * 	Every thread gets the whole build side from a local broadcast, so one
+ * 	thread builds the table and the others drop their copy and probe it.
+ * 	Probing must not write the table, which holds for the atoms of integer
+ * 	and varlena columns only: the others decode into a buffer of the array.
+ */
+bool SonicHashJoin::sharedBuildEnable()
+{
+    Plan* plan = m_runtime->js.ps.plan;
+    Plan* inner_plan = innerPlan(plan);
+    PlanState* inner_node = innerPlanState(m_runtime);
+    SonicHashMemPartition* partition = (SonicHashMemPartition*)m_innerPartitions[0];
+
+    if (!u_sess->attr.attr_sql.enable_sonic_shared_hashjoin || plan->dop <= 1 || plan->ispwj ||
+        ((VecHashJoin*)plan)->rebuildHashTable || u_sess->stream_cxt.global_obj == NULL ||
+        m_runtime->js.ps.state->es_skip_early_deinit_consumer) {
+        return false;
+    }
+
+    if (!IsA(inner_node, VecStreamState) || ((Stream*)inner_plan)->smpDesc.distriType != LOCAL_BROADCAST) {
+        return false;
+    }
+
+    /* The shared table can not be spilled, it takes the memory of all the threads. */
+    if (inner_plan->plan_rows * inner_plan->plan_width > (double)m_memControl.totalMem * plan->dop) {
+        return false;
+    }
+
+    for (int i = 0; i < m_buildOp.cols; i++) {
+        int data_type = partition->m_data[i]->m_desc.dataType;
+        if (data_type != SONIC_INT_TYPE && data_type != SONIC_VAR_TYPE) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * @Description: Move the build side of the builder thread to the shared context,
+ * 	so that the table stays valid until the last thread has done with it.
+ */
+void SonicHashJoin::initSharedBuild()
+{
+    SonicHashPartition* partition = NULL;
+
+    m_innerPartitions[0]->freeResources();
+    {
+        AutoContextSwitch memSwitch(m_sharedTable->context);
+        partition = New(CurrentMemoryContext) SonicHashMemPartition((char*)"innerPartitionContext",
+            m_complicatekey,
+            m_buildOp.tupleDesc,
+            m_memControl.totalMem * m_runtime->js.ps.plan->dop);
+    }
+    initPartition<true>(partition);
+    m_innerPartitions[0] = partition;
+}
+
+/*
+ * @Description: Wait for the builder thread and probe the table it built.
+ */
+void SonicHashJoin::attachSharedHashTable()
+{
+    SonicHashMemPartition* partition = NULL;
+    instr_time start_time;
+
+    /* The build side of this thread is not needed, let its producers skip us. */
+    ExecEarlyDeinitConsumer(innerPlanState(m_runtime));
+
+    (void)INSTR_TIME_SET_CURRENT(start_time);
+    WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
+    while (pg_atomic_read_u32(&m_sharedTable->status) != SONIC_SHARED_HASH_DONE) {
+        CHECK_FOR_INTERRUPTS();
+        pg_usleep(SONIC_SHARED_HASH_WAIT_USEC);
+    }
+    pg_read_barrier();
+    (void)pgstat_report_waitstatus(oldStatus);
+
+    partition = m_sharedTable->partition;
+    m_innerPartitions[0]->freeResources();
+    m_innerPartitions[0] = partition;
+    m_rows = m_sharedTable->rows;
+    m_bucketTypeSize = partition->m_bucketTypeSize;
+
+    if (m_bucketTypeSize == 2) {
+        if (m_complicatekey) {
+            m_probeTypeFun = partition->m_segHashTable ? &SonicHashJoin::probeMemoryTable<uint16, true, true>
+                                                       : &SonicHashJoin::probeMemoryTable<uint16, true, false>;
+        } else {
+            m_probeTypeFun = partition->m_segHashTable ? &SonicHashJoin::probeMemoryTable<uint16, false, true>
+                                                       : &SonicHashJoin::probeMemoryTable<uint16, false, false>;
+        }
+    } else {
+        if (m_complicatekey) {
+            m_probeTypeFun = partition->m_segHashTable ? &SonicHashJoin::probeMemoryTable<uint32, true, true>
+                                                       : &SonicHashJoin::probeMemoryTable<uint32, true, false>;
+        } else {
+            m_probeTypeFun = partition->m_segHashTable ? &SonicHashJoin::probeMemoryTable<uint32, false, true>
+                                                       : &SonicHashJoin::probeMemoryTable<uint32, false, false>;
+        }
+    }
+    m_build_time += elapsed_time(&start_time);
+
+    pushDownFilterIfNeed();
+
+    m_probeStatus = PROBE_FETCH;
+    m_runtime->joinState = HASH_PROBE;
+
+    if (HAS_INSTR(&m_runtime->js, true)) {
+        INSTR->sorthashinfo.hashbuild_time = m_build_time;
+    }
+}
+
+/*
+ * @Description: Drop the reference of this thread to the shared table,
+ * 	the last thread frees it.
+ */
+void SonicHashJoin::releaseSharedHashTable()
+{
+    if (m_sharedTable == NULL) {
+        return;
+    }
+
+    if (pg_atomic_sub_fetch_u32(&m_sharedTable->nusers, 1) == 0) {
+        MemoryContextDelete(m_sharedTable->context);
+        m_sharedTable->context = NULL;
+    }
+    if (m_innerPartitions != NULL) {
+        m_innerPartitions[0] = NULL;
+    }
+    m_sharedTable = NULL;
+}
+
 /*
  * @Description: try to load as many inner partitions as possible from files.
  * 	This function is called during GRACE_HASH,
@@ -490,10 +638,23 @@ void SonicHashJoin::Build()
     VectorBatch* batch = NULL;
     instr_time start_time;
 
+    if (m_sharedTable != NULL) {
+        uint32 expected = SONIC_SHARED_HASH_INIT;
+
+        /* The first thread here builds the table, the others wait for it. */
+        if (!pg_atomic_compare_exchange_u32(&m_sharedTable->status, &expected, SONIC_SHARED_HASH_BUILDING)) {
+            attachSharedHashTable();
+            return;
+        }
+        initSharedBuild();
+    }
+
     for (;;) {
         batch = VectorEngine(inner_node);
         if (unlikely(BatchIsNull(batch))) {
-            if (m_strategy == MEMORY_HASH) {
+            if (m_sharedTable != NULL) {
+                judgeSharedMemoryOverflow(get_hash_head_size(m_rows));
+            } else if (m_strategy == MEMORY_HASH) {
                 (void)INSTR_TIME_SET_CURRENT(start_time);
                 uint64 hash_head_size = get_hash_head_size(m_rows);
                 judgeMemoryOverflow(hash_head_size);
@@ -549,6 +710,13 @@ void SonicHashJoin::Build()
     /* prepareProbe, also record the build time and profile */
     prepareProbe();
 
+    if (m_sharedTable != NULL) {
+        m_sharedTable->partition = (SonicHashMemPartition*)m_innerPartitions[0];
+        m_sharedTable->rows = m_rows;
+        pg_write_barrier();
+        pg_atomic_write_u32(&m_sharedTable->status, SONIC_SHARED_HASH_DONE);
+    }
+
     /*
      * Done building hash table for build side,
      * record memory and time related information here.
@@ -571,7 +739,17 @@ void SonicHashJoin::saveToMemory(VectorBatch* batch)
     int rows = batch->m_rows;
     SonicHashMemPartition* memPartition = (SonicHashMemPartition*)m_innerPartitions[0];
 
-    if (!hasEnoughMem() || (m_rows + rows) > SONIC_MAX_ROWS) {
+    if (m_sharedTable != NULL) {
+        /* The other threads dropped their copy of the build side, so it can not be spilled. */
+        if ((m_rows + rows) > SONIC_MAX_ROWS) {
+            ereport(ERROR,
+                (errmodule(MOD_VEC_EXECUTOR),
+                    errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                    errmsg("shared hash table of Sonic hashjoin can not hold more than %lu rows",
+                        (unsigned long)SONIC_MAX_ROWS),
+                    errhint("Set enable_sonic_shared_hashjoin to off.")));
+        }
+    } else if (!hasEnoughMem() || (m_rows + rows) > SONIC_MAX_ROWS) {
         /*
          * If the total number of rows reaches SONIC_MAX_ROWS,
          * spill the data into disk.
@@ -600,7 +778,11 @@ void SonicHashJoin::saveToMemory(VectorBatch* batch)
      * Check the memory utilization to tell
      * whether to spill the next coming batch.
      */
-    judgeMemoryOverflow(0);
+    if (m_sharedTable != NULL) {
+        judgeSharedMemoryOverflow(0);
+    } else {
+        judgeMemoryOverflow(0);
+    }
 }
 
 /*
@@ -1956,6 +2138,8 @@ void SonicHashJoin::rePartition(uint32 rePartIdx)
  */
 void SonicHashJoin::freeMemoryContext()
 {
+    releaseSharedHashTable();
+
     if (m_memControl.hashContext != NULL) {
         /* Delete child context for hashContext */
         MemoryContextDelete(m_memControl.hashContext);
@@ -2301,6 +2485,33 @@ void SonicHashJoin::judgeMemoryOverflow(uint64 hash_head_size)
     }
 }
 
+/*
+ * @Description: Check the memory of a shared build against the operator memory
+ * 	of all the threads, which it is built for. A shared table can not be spilled,
+ * 	so it raises an error instead.
+ * @in hash_head_size: memory of the hash table head, still to be allocated
+ */
+void SonicHashJoin::judgeSharedMemoryOverflow(uint64 hash_head_size)
+{
+    uint64 avail_mem = 0;
+    uint64 allocate_mem = 0;
+    uint64 shared_mem = m_memControl.totalMem * SET_DOP(m_runtime->js.ps.plan->dop);
+
+    calcHashContextSize(m_innerPartitions[0]->m_context, &allocate_mem, &avail_mem);
+    m_memControl.allocatedMem = allocate_mem;
+    m_memControl.availMem = avail_mem;
+
+    if (allocate_mem + hash_head_size > shared_mem) {
+        ereport(ERROR,
+            (errmodule(MOD_VEC_EXECUTOR),
+                errcode(ERRCODE_INSUFFICIENT_RESOURCES),
+                errmsg("shared hash table of Sonic hashjoin(%d) needs more than %luKB of memory",
+                    m_runtime->js.ps.plan->plan_node_id,
+                    shared_mem / 1024L),
+                errhint("Set enable_sonic_shared_hashjoin to off.")));
+    }
+}
+
 /*
  * @Description: check if there is enough memory to fit in the coming batch.
  * @return: true if has enought memory, false if need to spill.
@@ -2850,6 +3061,7 @@ void SonicHashJoin::pushDownFilterIfNeed()
             }
             int pos = list_nth_int(m_runtime->bf_runtime.bf_filter_index, i);
             bf_array[pos] = filter;
+            ExecPublishRuntimeFilter(&m_runtime->js.ps, pos, filter);
         }
     }
 }
@@ -2972,8 +3184,13 @@ inline uint64 SonicHashJoin::calcHashSize(int64 nrows)
  */
 void SonicHashJoin::ResetNecessary()
 {
-    if (!m_runtime->js.ps.plan->ispwj && m_strategy == MEMORY_HASH && m_runtime->js.ps.righttree->chgParam == NULL &&
-        !((VecHashJoin*)m_runtime->js.ps.plan)->rebuildHashTable) {
+    /*
+     * A shared table is only used with a local broadcast inner, which is
+     * never rescanned, so it is always reused.
+     */
+    if (m_sharedTable != NULL ||
+        (!m_runtime->js.ps.plan->ispwj && m_strategy == MEMORY_HASH && m_runtime->js.ps.righttree->chgParam == NULL &&
+            !((VecHashJoin*)m_runtime->js.ps.plan)->rebuildHashTable)) {
         /* Okay to reuse the hash table; needn't rescan inner, either. */
         m_runtime->joinState = HASH_PROBE;
         m_probeStatus = PROBE_FETCH;
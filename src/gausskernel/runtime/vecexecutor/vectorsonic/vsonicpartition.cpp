@@ -41,12 +41,13 @@ SonicHashPartition::SonicHashPartition(const char* cxtname, uint16 cols, int64 w
     m_size = 0;
     m_fileRecords = NULL;
 
+    /* A partition created in a shared context is read by other threads. */
     m_context = AllocSetContextCreate(CurrentMemoryContext,
         cxtname,
         ALLOCSET_DEFAULT_MINSIZE,
         ALLOCSET_DEFAULT_INITSIZE,
         ALLOCSET_DEFAULT_MAXSIZE,
-        STANDARD_CONTEXT,
+        MemoryContextIsShared(CurrentMemoryContext) ? SHARED_CONTEXT : STANDARD_CONTEXT,
         workMem);
 
     m_status = partitionStatusInitial;
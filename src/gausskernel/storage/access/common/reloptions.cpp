@@ -27,6 +27,7 @@
 #include "commands/tablespace.h"
 #include "nodes/makefuncs.h"
 #include "pgxc/redistrib.h"
+#include "storage/page_compression.h"
 #ifdef ENABLE_MULTIPLE_NODES
 #include "tsdb/utils/delta_utils.h"
 #endif
@@ -60,6 +61,7 @@
 static void ValidateStrOptOrientation(const char *val);
 static void ValidateStrOptCompression(const char *val);
 static void ValidateStrOptTableAccessMethod(const char* val);
+static void ValidateStrOptCompressType(const char* val);
 static void ValidateStrOptTTL(const char *val);
 static void ValidateStrOptPeriod(const char *val);
 static void ValidateStrOptPartitionInterval(const char *val);
@@ -430,6 +432,13 @@ static relopt_string stringRelOpts[] = {
         ValidateStrOptStringOptimize,
         COLUMN_UNDEFINED,
     },
+    {
+        { "compresstype", "page compression algorithm of a row table", RELOPT_KIND_HEAP },
+        4,
+        false,
+        ValidateStrOptCompressType,
+        "none",
+    },
     /* list terminator */
     {{NULL}}
 };
@@ -1595,7 +1604,8 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket) },
         { "primarynode", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, primarynode) },
         { "on_commit_delete_rows", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, on_commit_delete_rows)},
-        { "wait_clean_gpi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_gpi)}
+        { "wait_clean_gpi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_gpi)},
+        { "compresstype", RELOPT_TYPE_STRING, offsetof(StdRdOptions, compresstype)}
     };
 
     options = parseRelOptions(reloptions, validate, kind, &numoptions);
@@ -1983,6 +1993,12 @@ static void ValidateStrOptTableAccessMethod(const char* val)
                 errdetail("Valid strings are \"HEAP\", \"USTORE\"")));
 }
 
+static void ValidateStrOptCompressType(const char* val)
+{
+    /* reports unknown algorithms */
+    (void)PageCompressAlgorithmByName(val);
+}
+
 /*
  * Brief        : Check the filesystem option for tablespace.
  * Input        : val, the filesystem option value.
@@ -2140,7 +2156,7 @@ int8 heaprel_get_compresslevel_from_modes(int16 modes)
 void ForbidUserToSetDefinedOptions(List *options)
 {
     /* the following option must be in tab[] of default_reloptions(). */
-    static const char *unchangedOpt[] = {"orientation"};
+    static const char *unchangedOpt[] = {"orientation", "compresstype"};
 
     int firstInvalidOpt = -1;
     if (FindInvalidOption(options, unchangedOpt, lengthof(unchangedOpt), &firstInvalidOpt)) {
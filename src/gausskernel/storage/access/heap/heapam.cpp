@@ -241,6 +241,7 @@ static void initscan(HeapScanDesc scan, ScanKey key, bool is_rescan)
     scan->rs_base.rs_cblock = InvalidBlockNumber;
     scan->rs_base.rs_ss_accessor = NULL;
     scan->dop = 1;
+    scan->rs_parallel = NULL;
 
     /* we don't have a marked position... */
     ItemPointerSetInvalid(&(scan->rs_mctid));
@@ -400,6 +401,34 @@ void heap_prefetch(HeapScanDesc scan, ScanDirection dir)
     ADIO_END();
 }
 
+/*
+ * @Description: Take the next chunk of blocks from the shared allocator of a parallel scan.
+ *
+ * @param[IN] allocator: block allocator shared by the smp workers.
+ * @return BlockNumber: first block of the chunk, InvalidBlockNumber if all are handed out.
+ */
+static inline BlockNumber heap_parallel_next_chunk(ParallelBlockAllocator* allocator)
+{
+    uint64 start = (uint64)pg_atomic_fetch_add_u32(&allocator->nextchunk, 1) * PARALLEL_SCAN_GAP;
+
+    return (start < allocator->nblocks) ? (BlockNumber)start : InvalidBlockNumber;
+}
+
+/*
+ * @Description: Calculate the first page of a forward scan.
+ *
+ * @param[IN] scan: heap scan describtion.
+ * @return BlockNumber: first page, InvalidBlockNumber if there is nothing to scan.
+ */
+FORCE_INLINE
+BlockNumber first_page(HeapScanDesc scan)
+{
+    if (scan->rs_parallel != NULL) {
+        return heap_parallel_next_chunk(scan->rs_parallel);
+    }
+    return (scan->rs_base.rs_nblocks == 0) ? InvalidBlockNumber : scan->rs_base.rs_startblock;
+}
+
 /*
  * @Description: Calculate the next page number.
  *
@@ -412,7 +441,15 @@ FORCE_INLINE
 bool next_page(HeapScanDesc scan, ScanDirection dir, BlockNumber &page)
 {
     bool finished = false;
-    if (scan->dop > 1) {
+    if (scan->rs_parallel != NULL) {
+        /* a parallel scan with a shared allocator only goes forward */
+        Assert(ScanDirectionIsForward(dir));
+        page++;
+        if (page >= scan->rs_parallel->nblocks || page % PARALLEL_SCAN_GAP == 0) {
+            page = heap_parallel_next_chunk(scan->rs_parallel);
+        }
+        finished = (page == InvalidBlockNumber);
+    } else if (scan->dop > 1) {
         if (BackwardScanDirection == dir) {
             finished = (page == 0);
             if (finished)
@@ -590,14 +627,14 @@ static bool VerifyHeapGetTup(HeapScanDesc scan, ScanDirection dir)
     Assert(ScanDirectionIsForward(dir));
     if (!scan->rs_base.rs_inited) {
         /* return null immediately if relation is empty */
-        if (scan->rs_base.rs_nblocks == 0) {
+        page = first_page(scan);
+        if (page == InvalidBlockNumber) {
             Assert(!BufferIsValid(scan->rs_base.rs_cbuf));
             tuple->t_data = NULL;
             return is_valid_relation_page;
         }
 
         /* first page and first offnum */
-        page = scan->rs_base.rs_startblock;
         scan->rs_base.rs_cblock = page;
         line_off = FirstOffsetNumber;
         scan->rs_base.rs_inited = true;
@@ -745,12 +782,12 @@ static void heapgettup(HeapScanDesc scan, ScanDirection dir, int nkeys, ScanKey
             /*
              * return null immediately if relation is empty
              */
-            if (scan->rs_base.rs_nblocks == 0) {
+            page = first_page(scan);
+            if (page == InvalidBlockNumber) {
                 Assert(!BufferIsValid(scan->rs_base.rs_cbuf));
                 tuple->t_data = NULL;
                 return;
             }
-            page = scan->rs_base.rs_startblock; /* first page */
             heapgetpage((TableScanDesc)scan, page);
             line_off = FirstOffsetNumber; /* first offnum */
             scan->rs_base.rs_inited = true;
@@ -978,12 +1015,12 @@ static void heapgettup_pagemode(HeapScanDesc scan, ScanDirection dir, int nkeys,
             /*
              * return null immediately if relation is empty
              */
-            if (scan->rs_base.rs_nblocks == 0) {
+            page = first_page(scan);
+            if (page == InvalidBlockNumber) {
                 Assert(!BufferIsValid(scan->rs_base.rs_cbuf));
                 tuple->t_data = NULL;
                 return;
             }
-            page = scan->rs_base.rs_startblock; /* first page */
             heapgetpage((TableScanDesc)scan, page);
             line_index = 0;
             scan->rs_base.rs_inited = true;
@@ -7834,6 +7871,24 @@ void heap_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection di
     }
 }
 
+/*
+ * Take the blocks of a forward parallel seqscan from the allocator shared by
+ * its smp workers rather than from the fixed split of heap_init_parallel_seqscan.
+ * The first chunk is taken on the first fetch, so a worker that never fetches
+ * leaves its blocks to the others. heap_rescan detaches the scan again.
+ */
+void heap_attach_parallel_seqscan(TableScanDesc sscan, ParallelBlockAllocator* allocator)
+{
+    HeapScanDesc scan = (HeapScanDesc)sscan;
+
+    Assert(!scan->rs_base.rs_inited);
+    Assert(!scan->rs_base.rs_rangeScanInRedis.isRangeScanInRedis);
+
+    scan->rs_parallel = allocator;
+    scan->rs_base.rs_startblock = 0;
+    scan->rs_base.rs_nblocks = allocator->nblocks;
+}
+
 IndexFetchTableData *heapam_index_fetch_begin(Relation rel)
 {
     IndexFetchHeapData *hscan = (IndexFetchHeapData *)palloc(sizeof(IndexFetchHeapData));
@@ -147,32 +147,35 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
            }
     }
 
-    while (extra_blocks-- >= 0) {
-        /* Ouch - an unnecessary lseek() each time through the loop! */
-        buffer = ReadBufferBI(relation, P_NEW, bistate);
+    /*
+     * Extend the file by all of the extra blocks in one go, rather than going
+     * through P_NEW once per block, which costs an lseek() and a write() each
+     * time while we hold the extension lock.  Nobody else can extend the
+     * relation concurrently, so the blocks from first_block on are ours.
+     */
+    RelationOpenSmgr(relation);
+    first_block = RelationGetNumberOfBlocks(relation);
+    smgrzeroextend(relation->rd_smgr, MAIN_FORKNUM, first_block, extra_blocks, false);
 
-        /* Extend by one page. */
-        LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
-        page = BufferGetPage(buffer);
-        if (!RelationIsIndex(relation)) {
+    for (block_num = first_block; block_num < first_block + (BlockNumber)extra_blocks; block_num++) {
+        if (RelationIsIndex(relation)) {
+            /* index pages are initialized by their first user; the zero page on disk will do */
+            freespace = BLCKSZ - 1;
+        } else {
+            /*
+             * Initialize the heap page in a buffer right away, so that vacuum never
+             * sees an uninitialized page.  No need to read it: it's all zeroes.
+             */
+            buffer = ReadBufferExtended(relation, MAIN_FORKNUM, block_num, RBM_ZERO_AND_LOCK,
+                                        bistate ? bistate->strategy : NULL);
+            page = BufferGetPage(buffer);
             phdr = (HeapPageHeader)page;
             PageInit(page, BufferGetPageSize(buffer), 0, true);
             phdr->pd_xid_base = u_sess->utils_cxt.RecentXmin - FirstNormalTransactionId;
             phdr->pd_multi_base = 0;
             MarkBufferDirty(buffer);
-        }
-
-        block_num = BufferGetBlockNumber(buffer);
-        if (!RelationIsIndex(relation)) {
             freespace = PageGetHeapFreeSpace(page);
-        } else {
-            freespace = BLCKSZ - 1;
-        }
-        UnlockReleaseBuffer(buffer);
-
-        /* Remember first block number thus added. */
-        if (first_block == InvalidBlockNumber) {
-            first_block = block_num;
+            UnlockReleaseBuffer(buffer);
         }
 
         /*
@@ -182,6 +185,7 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
          */
         RecordPageWithFreeSpace(relation, block_num, freespace);
     }
+    block_num = first_block + (BlockNumber)extra_blocks - 1;
 
     /*
      * Updating the upper levels of the free space map is too expensive
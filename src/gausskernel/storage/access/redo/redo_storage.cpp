@@ -45,6 +45,10 @@ XLogRecParseState *smgr_xlog_relnode_parse_to_block(XLogReaderState *record, uin
         forknum = xlrec->forkNum;
         ddltype = BLOCK_DDL_CREATE_RELNODE;
         colmrel = IsValidColForkNum(xlrec->forkNum);
+    } else if (info == XLOG_SMGR_CREATE_COMPRESSED) {
+        xl_smgr_create_compressed *xlrec = (xl_smgr_create_compressed *)XLogRecGetData(record);
+        rnode = &(xlrec->create.rnode);
+        ddltype = BLOCK_DDL_CREATE_COMPRESSED_RELNODE;
     } else {
         xl_smgr_truncate *xlrec = (xl_smgr_truncate *)XLogRecGetData(record);
         rnode = &(xlrec->rnode);
@@ -71,7 +75,7 @@ XLogRecParseState *smgr_redo_parse_to_block(XLogReaderState *record, uint32 *blo
     XLogRecParseState *recordstatehead = NULL;
 
     *blocknum = 0;
-    if ((info == XLOG_SMGR_CREATE) || (info == XLOG_SMGR_TRUNCATE)) {
+    if ((info == XLOG_SMGR_CREATE) || (info == XLOG_SMGR_CREATE_COMPRESSED) || (info == XLOG_SMGR_TRUNCATE)) {
         recordstatehead = smgr_xlog_relnode_parse_to_block(record, blocknum);
     } else {
         ereport(PANIC, (errmsg("smgr_redo_parse_to_block: unknown op code %u", info)));
@@ -139,7 +139,8 @@ char *XLogBlockDataGetMainData(XLogBlockDataParse *datadecode, Size *len)
     return datadecode->main_data;
 }
 
-char *XLogBlockDataRecGetImage(XLogBlockDataParse *datadecode, uint16 *hole_offset, uint16 *hole_length)
+char *XLogBlockDataRecGetImage(XLogBlockDataParse *datadecode, uint16 *hole_offset, uint16 *hole_length,
+                               uint16 *bimg_len, uint8 *bimg_method)
 {
     if (!XLogBlockDataHasBlockImage(datadecode))
         return NULL;
@@ -148,6 +149,10 @@ char *XLogBlockDataRecGetImage(XLogBlockDataParse *datadecode, uint16 *hole_offs
         *hole_offset = datadecode->blockdata.hole_offset;
     if (hole_length != NULL)
         *hole_length = datadecode->blockdata.hole_length;
+    if (bimg_len != NULL)
+        *bimg_len = datadecode->blockdata.bimg_len;
+    if (bimg_method != NULL)
+        *bimg_method = datadecode->blockdata.bimg_method;
     return datadecode->blockdata.bkp_image;
 }
 
@@ -226,13 +231,15 @@ XLogRedoAction XLogCheckBlockDataRedoAction(XLogBlockDataParse *datadecode, Redo
         char *imagedata;
         uint16 hole_offset;
         uint16 hole_length;
+        uint16 bimg_len;
+        uint8 bimg_method;
 
-        imagedata = XLogBlockDataRecGetImage(datadecode, &hole_offset, &hole_length);
-        if (imagedata == NULL) {
+        imagedata = XLogBlockDataRecGetImage(datadecode, &hole_offset, &hole_length, &bimg_len, &bimg_method);
+        if (imagedata == NULL || !RestoreBlockImage(imagedata, hole_offset, hole_length, bimg_len, bimg_method,
+                                                    (char *)bufferinfo->pageinfo.page)) {
             ereport(ERROR,
                     (errcode(ERRCODE_DATA_EXCEPTION), errmsg("XLogCheckRedoAction failed to restore block image")));
         } else {
-            RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page);
             XlogUpdateFullPageWriteLsn(bufferinfo->pageinfo.page, bufferinfo->lsn);
             PageSetJustAfterFullPageWrite(bufferinfo->pageinfo.page);
             MakeRedoBufferDirty(bufferinfo);
@@ -346,6 +353,8 @@ void XLogRecSetBlockDataState(XLogReaderState *record, uint32 blockid, XLogRecPa
     blockdatarec->blockdata.extra_flag = decodebkp->extra_flag;
     blockdatarec->blockdata.hole_offset = decodebkp->hole_offset;
     blockdatarec->blockdata.hole_length = decodebkp->hole_length;
+    blockdatarec->blockdata.bimg_len = decodebkp->bimg_len;
+    blockdatarec->blockdata.bimg_method = decodebkp->bimg_method;
     blockdatarec->blockdata.data_len = decodebkp->data_len;
     blockdatarec->blockdata.last_lsn = decodebkp->last_lsn;
     blockdatarec->blockdata.bkp_image = decodebkp->bkp_image;
@@ -937,6 +946,9 @@ void XLogBlockDdlCommonRedo(XLogBlockHead *blockhead, void *blockrecbody, RedoBu
         case BLOCK_DDL_CREATE_RELNODE:
             smgr_redo_create(rnode, blockhead->forknum, blockddlrec->mainData);
             break;
+        case BLOCK_DDL_CREATE_COMPRESSED_RELNODE:
+            smgr_redo_create_compressed(rnode, blockddlrec->mainData);
+            break;
         case BLOCK_DDL_TRUNCATE_RELNODE:
             XLogBlockDdlTruncateRedo(rnode, blockhead->blkno);
             break;
@@ -959,6 +971,9 @@ void XLogBlockDdlDoSmgrAction(XLogBlockHead *blockhead, void *blockrecbody, Redo
         case BLOCK_DDL_CREATE_RELNODE:
             smgr_redo_create(rnode, blockhead->forknum, blockddlrec->mainData);
             break;
+        case BLOCK_DDL_CREATE_COMPRESSED_RELNODE:
+            smgr_redo_create_compressed(rnode, blockddlrec->mainData);
+            break;
         case BLOCK_DDL_TRUNCATE_RELNODE:
             xlog_block_smgr_redo_truncate(rnode, blockhead->blkno, blockhead->end_ptr);
             break;
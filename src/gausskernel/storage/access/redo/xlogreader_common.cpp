@@ -26,8 +26,10 @@
 #include "knl/knl_variable.h"
 
 #include "access/xlogreader.h"
+#include "access/xlogrecord.h"
 #include "storage/buf/bufpage.h"
 #include "access/redo_common.h"
+#include "lz4.h"
 
 /*
  * Returns information about the block that a block reference refers to.
@@ -82,14 +84,27 @@ char *XLogRecGetBlockData(XLogReaderState *record, uint8 block_id, Size *len)
 /*
  * Restore a full-page image from a backup block attached to an XLOG record.
  *
- * Returns the buffer number containing the page.
+ * bimg_len is the number of bytes of bkp_image stored in the record and
+ * bimg_method tells whether they have to be decompressed first. Returns false
+ * if a compressed image turns out to be corrupt.
  *
  * Reconstruct for batchredo
  */
-void RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_length, char *page)
+bool RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_length, uint16 bimg_len,
+                       uint8 bimg_method, char *page)
 {
+    char tmp[BLCKSZ];
     errno_t rc = EOK;
 
+    if (bimg_method == BKPIMAGE_COMPRESS_LZ4) {
+        int rawlen = LZ4_decompress_safe(bkp_image, tmp, bimg_len, BLCKSZ - hole_length);
+        if (rawlen != BLCKSZ - hole_length)
+            return false;
+        bkp_image = tmp;
+    } else if (bimg_method != BKPIMAGE_COMPRESS_NONE) {
+        return false;
+    }
+
     if (hole_length == 0) {
         rc = memcpy_s(page, BLCKSZ, bkp_image, BLCKSZ);
         securec_check(rc, "", "");
@@ -102,10 +117,11 @@ void RestoreBlockImage(const char *bkp_image, uint16 hole_offset, uint16 hole_le
 
         Assert(hole_offset + hole_length <= BLCKSZ);
         if (hole_offset + hole_length == BLCKSZ)
-            return;
+            return true;
 
         rc = memcpy_s(page + (hole_offset + hole_length), BLCKSZ - (hole_offset + hole_length), bkp_image + hole_offset,
                       BLCKSZ - (hole_offset + hole_length));
         securec_check(rc, "", "");
     }
+    return true;
 }
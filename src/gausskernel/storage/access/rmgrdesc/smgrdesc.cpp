@@ -37,6 +37,20 @@ void smgr_desc(StringInfo buf, XLogReaderState *record)
         path = NULL;
 #else
         pfree_ext(path);
+#endif
+    } else if (info == XLOG_SMGR_CREATE_COMPRESSED) {
+        xl_smgr_create_compressed *xlrec = (xl_smgr_create_compressed *)rec;
+        RelFileNode rnode;
+        RelFileNodeCopy(rnode, xlrec->create.rnode, XLogRecGetBucketId(record));
+
+        char *path = relpathperm(rnode, MAIN_FORKNUM);
+
+        appendStringInfo(buf, "file create: %s compressed with algorithm %u", path, xlrec->algorithm);
+#ifdef FRONTEND
+        free(path);
+        path = NULL;
+#else
+        pfree_ext(path);
 #endif
     } else if (info == XLOG_SMGR_TRUNCATE) {
         xl_smgr_truncate *xlrec = (xl_smgr_truncate *)rec;
@@ -973,7 +973,7 @@ static void TrackChangeBlock(XLogReaderState *record)
     } else if (XLogRecGetRmid(record) == RM_SMGR_ID) {
         Assert(!XLogRecHasAnyBlockRefs(record));
         uint8 info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
-        if (info == XLOG_SMGR_CREATE)
+        if (info == XLOG_SMGR_CREATE || info == XLOG_SMGR_CREATE_COMPRESSED)
             TrackRelStorageCreate(record);
         else if (info == XLOG_SMGR_TRUNCATE)
             TrackRelStorageTruncate(record);
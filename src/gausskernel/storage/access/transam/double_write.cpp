@@ -85,7 +85,7 @@ Datum dw_get_single_flush_total_writes()
 Datum dw_get_dw_number()
 {
     if (dw_enabled()) {
-        return UInt64GetDatum((uint64)g_instance.dw_batch_cxt.file_head->head.dwn);
+        return UInt64GetDatum((uint64)g_instance.dw_batch_cxt[0].file_head->head.dwn);
     }
 
     return UInt64GetDatum(0);
@@ -94,50 +94,61 @@ Datum dw_get_dw_number()
 Datum dw_get_start_page()
 {
     if (dw_enabled()) {
-        return UInt64GetDatum((uint64)g_instance.dw_batch_cxt.file_head->start);
+        return UInt64GetDatum((uint64)g_instance.dw_batch_cxt[0].file_head->start);
     }
 
     return UInt64GetDatum(0);
 }
 
+/* the batch flush statistics are summed over all the batch flush files */
+static uint64 dw_sum_batch_stat(size_t offset)
+{
+    uint64 sum = 0;
+
+    for (uint32 i = 0; i < DW_BATCH_FILE_MAX_NUM; i++) {
+        sum += *(volatile uint64 *)((char *)&g_instance.dw_batch_cxt[i].batch_stat_info + offset);
+    }
+    return sum;
+}
+
 Datum dw_get_file_trunc_num()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.file_trunc_num);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, file_trunc_num)));
 }
 
 Datum dw_get_file_reset_num()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.file_reset_num);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, file_reset_num)));
 }
 
 Datum dw_get_total_writes()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.total_writes);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, total_writes)));
 }
 
 Datum dw_get_low_threshold_writes()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.low_threshold_writes);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, low_threshold_writes)));
 }
 
 Datum dw_get_high_threshold_writes()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.high_threshold_writes);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, high_threshold_writes)));
 }
 
 Datum dw_get_total_pages()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.total_pages);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, total_pages)));
 }
 
 Datum dw_get_low_threshold_pages()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.low_threshold_pages);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, low_threshold_pages)));
 }
 
 Datum dw_get_high_threshold_pages()
 {
-    return UInt64GetDatum(g_instance.dw_batch_cxt.batch_stat_info.high_threshold_pages);
+    return UInt64GetDatum(dw_sum_batch_stat(offsetof(dw_stat_info_batch, high_threshold_pages)));
 }
 
 /* double write statistic view */
@@ -164,7 +175,7 @@ const dw_view_col_t g_dw_single_view[DW_SINGLE_VIEW_COL_NUM] = {
     {"file_reset_num", INT8OID, dw_get_single_flush_reset_num}
 };
 
-static void dw_generate_batch_file();
+static void dw_generate_batch_file(const char *file_name);
 static void dw_generate_single_file();
 static void dw_recovery_partial_write_single();
 
@@ -275,9 +286,9 @@ static bool dw_verify_pg_checksum(PageHeader page_header, BlockNumber blockNum)
     }
 }
 
-inline void dw_prepare_page(dw_batch_t *batch, uint16 page_num, uint16 page_id, uint16 dwn)
+inline void dw_prepare_page(dw_batch_t *batch, uint16 page_num, uint16 page_id, uint16 dwn, bool contain_hashbucket)
 {
-    if (g_instance.dw_batch_cxt.contain_hashbucket == true) {
+    if (contain_hashbucket) {
         if (t_thrd.proc->workingVersionNum < DW_SUPPORT_SINGLE_FLUSH_VERSION) {
             page_num = page_num | IS_HASH_BKT_MASK;
         }
@@ -436,11 +447,20 @@ static void dw_recover_pages(T1 *batch, T2 *buf_tag, PageHeader data_page, BufTa
     }
 }
 
-void wait_all_dw_page_finish_flush()
+/*
+ * The page writer and bgwriter threads that write to one batch flush file, identified by
+ * ThrdDwCxt.dw_file_id, are the only ones whose data file flushing that file has to wait for.
+ */
+static inline bool dw_thrd_in_flush(ThrdDwCxt *thrd_dw_cxt, uint32 file_id)
+{
+    return thrd_dw_cxt->dw_file_id == file_id && thrd_dw_cxt->dw_page_idx != -1;
+}
+
+void wait_all_dw_page_finish_flush(uint32 file_id)
 {
     if (g_instance.bgwriter_cxt.bgwriter_procs != NULL) {
         for (int i = 0; i < g_instance.bgwriter_cxt.bgwriter_num;) {
-            if (g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_page_idx == -1) {
+            if (!dw_thrd_in_flush(&g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt, file_id)) {
                 i++;
                 continue;
             } else {
@@ -449,37 +469,45 @@ void wait_all_dw_page_finish_flush()
         }
     }
     if (g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc != NULL) {
-        while (g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx != -1) {
-            (void)sched_yield();
+        for (int i = 0; i < g_instance.ckpt_cxt_ctl->page_writer_procs.num;) {
+            if (!dw_thrd_in_flush(&g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[i].thrd_dw_cxt, file_id)) {
+                i++;
+                continue;
+            } else {
+                (void)sched_yield();
+            }
         }
     }
     return;
 }
 
-int get_dw_page_min_idx()
+static inline void dw_update_page_min_idx(ThrdDwCxt *thrd_dw_cxt, uint32 file_id, uint16 *min_idx)
+{
+    int dw_page_idx = thrd_dw_cxt->dw_page_idx;
+
+    if (dw_page_idx != -1 && thrd_dw_cxt->dw_file_id == file_id) {
+        if (*min_idx == 0 || (uint16)dw_page_idx < *min_idx) {
+            *min_idx = dw_page_idx;
+        }
+    }
+}
+
+int get_dw_page_min_idx(uint32 file_id)
 {
     uint16 min_idx = 0;
-    int dw_page_idx;
 
     if (g_instance.bgwriter_cxt.bgwriter_procs != NULL) {
         for (int i = 0; i < g_instance.bgwriter_cxt.bgwriter_num; i++) {
-            dw_page_idx = g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt.dw_page_idx;
-            if (dw_page_idx != -1) {
-                if (min_idx == 0 || (uint16)dw_page_idx < min_idx) {
-                    min_idx = dw_page_idx;
-                }
-            }
+            dw_update_page_min_idx(&g_instance.bgwriter_cxt.bgwriter_procs[i].thrd_dw_cxt, file_id, &min_idx);
         }
     }
     if (g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc != NULL) {
-        dw_page_idx = g_instance.ckpt_cxt_ctl->page_writer_procs.thrd_dw_cxt.dw_page_idx;
-        if (dw_page_idx != -1) {
-            if (min_idx == 0 || (uint16)dw_page_idx < min_idx) {
-                min_idx = dw_page_idx;
-            }
+        for (int i = 0; i < g_instance.ckpt_cxt_ctl->page_writer_procs.num; i++) {
+            dw_update_page_min_idx(&g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[i].thrd_dw_cxt, file_id,
+                &min_idx);
         }
     }
-	
+
     return min_idx;
 }
 
@@ -520,14 +548,14 @@ static bool dw_reset_if_need(knl_g_dw_context *cxt, uint16 pages_to_write, bool
         /*
          * Record min flush position for truncate because flush lock is not held during smgrsync.
          */
-        min_idx = get_dw_page_min_idx();
+        min_idx = get_dw_page_min_idx(cxt->file_id);
         LWLockRelease(cxt->flush_lock);
     } else {
         Assert(AmStartupProcess() || AmPageWriterProcess() || AmMulitBackgroundWriterProcess());
         /* reset start position and flush page num for full recycle */
         file_head->start = DW_BATCH_FILE_START;
         cxt->flush_page = 0;
-        wait_all_dw_page_finish_flush();
+        wait_all_dw_page_finish_flush(cxt->file_id);
     }
 
     smgrsync_for_dw();
@@ -642,7 +670,7 @@ static void dw_recover_batch_head(knl_g_dw_context *cxt, dw_batch_t *curr_head)
     errno_t rc;
     rc = memset_s(curr_head, BLCKSZ, 0, BLCKSZ);
     securec_check(rc, "\0", "\0");
-    dw_prepare_page(curr_head, 0, cxt->file_head->start, cxt->file_head->head.dwn);
+    dw_prepare_page(curr_head, 0, cxt->file_head->start, cxt->file_head->head.dwn, false);
     pgstat_report_waitevent(WAIT_EVENT_DW_WRITE);
     dw_pwrite_file(cxt->fd, curr_head, BLCKSZ, (curr_head->head.page_id * BLCKSZ));
     pgstat_report_waitevent(WAIT_EVENT_END);
@@ -766,13 +794,32 @@ static void dw_recover_partial_write(knl_g_dw_context *cxt)
     pfree(data_page);
 }
 
+void dw_get_batch_file_name(uint32 file_id, char *file_name, size_t len)
+{
+    errno_t rc;
+
+    Assert(file_id < DW_BATCH_FILE_MAX_NUM);
+    if (file_id == 0) {
+        rc = strcpy_s(file_name, len, DW_FILE_NAME);
+        securec_check(rc, "\0", "\0");
+    } else {
+        rc = snprintf_s(file_name, len, len - 1, DW_BATCH_FILE_NAME_FMT, file_id);
+        securec_check_ss(rc, "\0", "\0");
+    }
+}
+
 void dw_bootstrap()
 {
-    dw_generate_batch_file();
+    char file_name[MAXPGPATH];
+
+    for (uint32 i = 0; i < dw_batch_file_num(); i++) {
+        dw_get_batch_file_name(i, file_name, MAXPGPATH);
+        dw_generate_batch_file(file_name);
+    }
     dw_generate_single_file();
 }
 
-static void dw_generate_batch_file()
+static void dw_generate_batch_file(const char *file_name)
 {
     char *file_head = NULL;
     dw_batch_t *batch_head = NULL;
@@ -780,17 +827,18 @@ static void dw_generate_batch_file()
     int fd = -1;
     char *unaligned_buf = NULL;
 
-    if (file_exists(DW_FILE_NAME)) {
-        ereport(PANIC, (errcode_for_file_access(), errmodule(MOD_DW), "DW batch flush file already exists"));
+    if (file_exists(file_name)) {
+        ereport(PANIC, (errcode_for_file_access(), errmodule(MOD_DW),
+                        errmsg("DW batch flush file \"%s\" already exists", file_name)));
     }
 
-    ereport(LOG, (errmodule(MOD_DW), errmsg("DW bootstrap batch flush file")));
+    ereport(LOG, (errmodule(MOD_DW), errmsg("DW bootstrap batch flush file \"%s\"", file_name)));
 
     /* create dw batch flush file */
-    fd = open(DW_FILE_NAME, (DW_FILE_FLAG | O_CREAT), DW_FILE_PERM);
+    fd = open(file_name, (DW_FILE_FLAG | O_CREAT), DW_FILE_PERM);
     if (fd == -1) {
         ereport(PANIC,
-                (errcode_for_file_access(), errmodule(MOD_DW), errmsg("Could not create file \"%s\"", DW_FILE_NAME)));
+                (errcode_for_file_access(), errmodule(MOD_DW), errmsg("Could not create file \"%s\"", file_name)));
     }
 
     /* Open file with O_SYNC, to make sure the data and file system control info on file after block writing. */
@@ -807,7 +855,7 @@ static void dw_generate_batch_file()
     dw_pwrite_file(fd, file_head, (BLCKSZ + BLCKSZ), 0);
     dw_extend_file(fd, file_head, DW_FILE_EXTEND_SIZE, remain_size, false);
     pgstat_report_waitevent(WAIT_EVENT_END);
-    ereport(LOG, (errmodule(MOD_DW), errmsg("Double write batch flush file created successfully")));
+    ereport(LOG, (errmodule(MOD_DW), errmsg("Double write batch flush file \"%s\" created successfully", file_name)));
 
     (void)close(fd);
     fd = -1;
@@ -842,6 +890,8 @@ static void dw_free_resource(knl_g_dw_context *cxt)
 
 void dw_file_check_and_rebuild()
 {
+    char file_name[MAXPGPATH];
+
     if (file_exists(DW_BUILD_FILE_NAME)) {
         ereport(LOG, (errmodule(MOD_DW), errmsg("Double write initializing after build")));
 
@@ -857,6 +907,15 @@ void dw_file_check_and_rebuild()
                                 errmsg("Could not remove the residual batch flush DW single flush file")));
             }
         }
+
+        /* the other batch flush files are as stale as the first one */
+        for (uint32 i = 1; i < DW_BATCH_FILE_MAX_NUM; i++) {
+            dw_get_batch_file_name(i, file_name, MAXPGPATH);
+            if (file_exists(file_name) && unlink(file_name) != 0) {
+                ereport(PANIC, (errcode_for_file_access(), errmodule(MOD_DW),
+                                errmsg("Could not remove the residual batch flush DW file \"%s\"", file_name)));
+            }
+        }
         
         if (file_exists(SINGLE_DW_FILE_NAME)) {
             /*
@@ -885,6 +944,17 @@ void dw_file_check_and_rebuild()
         ereport(PANIC, (errcode_for_file_access(), errmodule(MOD_DW), errmsg("batch flush DW file does not exist")));
     }
 
+    /*
+     * More page writer threads than the last time, or the first start after upgrading from one batch flush
+     * file. Nothing has been double written to the missing files, so just create them.
+     */
+    for (uint32 i = 1; i < dw_batch_file_num(); i++) {
+        dw_get_batch_file_name(i, file_name, MAXPGPATH);
+        if (!file_exists(file_name)) {
+            dw_generate_batch_file(file_name);
+        }
+    }
+
     if (t_thrd.proc->workingVersionNum >= DW_SUPPORT_SINGLE_FLUSH_VERSION) {
         if (!file_exists(SINGLE_DW_FILE_NAME)) {
             ereport(PANIC, (errcode_for_file_access(), 
@@ -927,34 +997,28 @@ const void init_dw_single_flush_map()
     }
 }
 
-void dw_cxt_init_batch()
+static void dw_cxt_init_batch(knl_g_dw_context *batch_cxt)
 {
-    uint32 buf_size;
-    char *buf = NULL;
-    knl_g_dw_context *batch_cxt = &g_instance.dw_batch_cxt;
+    char file_name[MAXPGPATH];
 
     Assert(batch_cxt->flush_lock == NULL);
     batch_cxt->flush_lock = LWLockAssign(LWTRANCHE_DOUBLE_WRITE);
 
     /* double write file disk space pre-allocated, O_DSYNC for less IO */
-    batch_cxt->fd = open(DW_FILE_NAME, DW_FILE_FLAG, DW_FILE_PERM);
+    dw_get_batch_file_name(batch_cxt->file_id, file_name, MAXPGPATH);
+    batch_cxt->fd = open(file_name, DW_FILE_FLAG, DW_FILE_PERM);
     if (batch_cxt->fd == -1) {
         ereport(PANIC,
-            (errcode_for_file_access(), errmodule(MOD_DW), errmsg("Could not open file \"%s\"", DW_FILE_NAME)));
+            (errcode_for_file_access(), errmodule(MOD_DW), errmsg("Could not open file \"%s\"", file_name)));
     }
 
-    buf_size = DW_MEM_CTX_MAX_BLOCK_SIZE_FOR_NOHBK;
-
-    batch_cxt->unaligned_buf = (char *)palloc0(buf_size); /* one more BLCKSZ for alignment */
-    buf = (char *)TYPEALIGN(BLCKSZ, batch_cxt->unaligned_buf);
-
-    batch_cxt->file_head = (dw_file_head_t *)buf;
-    buf += BLCKSZ;
-
-    batch_cxt->buf = buf;
-    if (BBOX_BLACKLIST_DW_BUFFER) {
-        bbox_blacklist_add(DW_BUFFER, buf, buf_size - BLCKSZ - BLCKSZ);
-    }
+    /*
+     * Only the file head stays in memory. The batches are written straight from the buffer of the
+     * flushing thread, and recovery borrows a buffer for reading batches, see dw_init.
+     */
+    batch_cxt->unaligned_buf = (char *)palloc0(BLCKSZ + BLCKSZ); /* one more BLCKSZ for alignment */
+    batch_cxt->file_head = (dw_file_head_t *)TYPEALIGN(BLCKSZ, batch_cxt->unaligned_buf);
+    batch_cxt->buf = NULL;
     batch_cxt->closed = 0;
     batch_cxt->write_pos = 0;
     batch_cxt->flush_page = 0;
@@ -994,11 +1058,42 @@ void dw_cxt_init_single()
 }
 
 
+/*
+ * Recover the partial writes in one batch flush file. A file left behind by more page writer threads than
+ * we run now is removed once its pages are recovered and synced.
+ */
+static void dw_recover_batch_file(knl_g_dw_context *batch_cxt, char *recovery_buf)
+{
+    char file_name[MAXPGPATH];
+
+    dw_cxt_init_batch(batch_cxt);
+    batch_cxt->buf = recovery_buf;
+
+    (void)LWLockAcquire(batch_cxt->flush_lock, LW_EXCLUSIVE);
+    dw_recover_file_head(batch_cxt, false);
+
+    dw_recover_partial_write(batch_cxt);
+    LWLockRelease(batch_cxt->flush_lock);
+    batch_cxt->buf = NULL;
+
+    if (batch_cxt->file_id >= dw_batch_file_num()) {
+        dw_free_resource(batch_cxt);
+        dw_get_batch_file_name(batch_cxt->file_id, file_name, MAXPGPATH);
+        if (unlink(file_name) != 0) {
+            ereport(PANIC, (errcode_for_file_access(), errmodule(MOD_DW),
+                            errmsg("Could not remove the unused batch flush DW file \"%s\"", file_name)));
+        }
+        ereport(LOG, (errmodule(MOD_DW), errmsg("Removed the unused batch flush DW file \"%s\"", file_name)));
+    }
+}
+
 void dw_init(bool shut_down)
 {
     MemoryContext old_mem_cxt;
-    knl_g_dw_context *batch_cxt = &g_instance.dw_batch_cxt;
     knl_g_dw_context *single_cxt = &g_instance.dw_single_cxt;
+    char file_name[MAXPGPATH];
+    char *unaligned_buf = NULL;
+    char *recovery_buf = NULL;
 
     MemoryContext mem_cxt = AllocSetContextCreate(
             INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE),
@@ -1008,7 +1103,9 @@ void dw_init(bool shut_down)
             ALLOCSET_DEFAULT_MAXSIZE,
             SHARED_CONTEXT);
 
-    g_instance.dw_batch_cxt.mem_cxt = mem_cxt;
+    for (uint32 i = 0; i < DW_BATCH_FILE_MAX_NUM; i++) {
+        g_instance.dw_batch_cxt[i].mem_cxt = mem_cxt;
+    }
     g_instance.dw_single_cxt.mem_cxt = mem_cxt;
 
     old_mem_cxt = MemoryContextSwitchTo(mem_cxt);
@@ -1016,15 +1113,18 @@ void dw_init(bool shut_down)
     dw_file_check_and_rebuild();
     ereport(LOG, (errmodule(MOD_DW), errmsg("Double Write init")));
 
-    dw_cxt_init_batch();
     dw_cxt_init_single();
 
-    /* recovery batch flush dw file */
-    (void)LWLockAcquire(batch_cxt->flush_lock, LW_EXCLUSIVE);
-    dw_recover_file_head(batch_cxt, false);
-
-    dw_recover_partial_write(batch_cxt);
-    LWLockRelease(batch_cxt->flush_lock);
+    /* recovery batch flush dw files, including the ones left by more page writer threads */
+    unaligned_buf = (char *)palloc0((DW_BUF_MAX_FOR_NOHBK + 1) * BLCKSZ); /* one more BLCKSZ for alignment */
+    recovery_buf = (char *)TYPEALIGN(BLCKSZ, unaligned_buf);
+    for (uint32 i = 0; i < DW_BATCH_FILE_MAX_NUM; i++) {
+        dw_get_batch_file_name(i, file_name, MAXPGPATH);
+        if (i < dw_batch_file_num() || file_exists(file_name)) {
+            dw_recover_batch_file(&g_instance.dw_batch_cxt[i], recovery_buf);
+        }
+    }
+    pfree(unaligned_buf);
 
     /* recovery single flush dw file */
     (void)LWLockAcquire(single_cxt->flush_lock, LW_EXCLUSIVE);
@@ -1040,10 +1140,12 @@ void dw_init(bool shut_down)
      * After recovering partially written pages (if any), we will un-initialize, if the double write is disabled.
      */
     if (!dw_enabled()) {
-        dw_free_resource(batch_cxt);
+        for (uint32 i = 0; i < dw_batch_file_num(); i++) {
+            dw_free_resource(&g_instance.dw_batch_cxt[i]);
+        }
         dw_free_resource(single_cxt);
         (void)MemoryContextSwitchTo(old_mem_cxt);
-        MemoryContextDelete(g_instance.dw_batch_cxt.mem_cxt);
+        MemoryContextDelete(mem_cxt);
         ereport(LOG, (errmodule(MOD_DW), errmsg("Double write exit after recovering partial write")));
     } else {
         (void)MemoryContextSwitchTo(old_mem_cxt);
@@ -1138,9 +1240,8 @@ static XLogRecPtr dw_copy_page(ThrdDwCxt* thrd_dw_cxt, int buf_desc_id, bool* is
     return page_lsn;
 }
 
-inline uint16 dw_batch_add_extra(uint16 page_num)
+inline uint16 dw_batch_add_extra(uint16 page_num, bool contain_hashbucket)
 {
-    bool contain_hashbucket = g_instance.dw_batch_cxt.contain_hashbucket;
     Assert(page_num <= GET_DW_DIRTY_PAGE_MAX(contain_hashbucket));
     if (page_num <= GET_DW_BATCH_DATA_PAGE_MAX(contain_hashbucket)) {
         return page_num + DW_EXTRA_FOR_ONE_BATCH;
@@ -1149,27 +1250,28 @@ inline uint16 dw_batch_add_extra(uint16 page_num)
     }
 }
 
-static void dw_assemble_batch(knl_g_dw_context *dw_cxt, uint16 page_id, uint16 dwn)
+static void dw_assemble_batch(ThrdDwCxt *thrd_dw_cxt, uint16 page_id, uint16 dwn)
 {
     dw_batch_t *batch = NULL;
     uint16 first_batch_pages;
     uint16 second_batch_pages;
+    bool contain_hashbucket = thrd_dw_cxt->contain_hashbucket;
 
-    if (dw_cxt->write_pos > GET_DW_BATCH_DATA_PAGE_MAX(dw_cxt->contain_hashbucket)) {
-        first_batch_pages = GET_DW_BATCH_DATA_PAGE_MAX(dw_cxt->contain_hashbucket);
-        second_batch_pages = dw_cxt->write_pos - GET_DW_BATCH_DATA_PAGE_MAX(dw_cxt->contain_hashbucket);
+    if (thrd_dw_cxt->write_pos > GET_DW_BATCH_DATA_PAGE_MAX(contain_hashbucket)) {
+        first_batch_pages = GET_DW_BATCH_DATA_PAGE_MAX(contain_hashbucket);
+        second_batch_pages = thrd_dw_cxt->write_pos - GET_DW_BATCH_DATA_PAGE_MAX(contain_hashbucket);
     } else {
-        first_batch_pages = dw_cxt->write_pos;
+        first_batch_pages = thrd_dw_cxt->write_pos;
         second_batch_pages = 0;
     }
 
-    batch = (dw_batch_t *)dw_cxt->buf;
-    dw_prepare_page(batch, first_batch_pages, page_id, dwn);
+    batch = (dw_batch_t *)thrd_dw_cxt->dw_buf;
+    dw_prepare_page(batch, first_batch_pages, page_id, dwn, contain_hashbucket);
 
     /* tail of the first batch */
     page_id = page_id + 1 + GET_REL_PGAENUM(batch->page_num);
     batch = dw_batch_tail_page(batch);
-    dw_prepare_page(batch, second_batch_pages, page_id, dwn);
+    dw_prepare_page(batch, second_batch_pages, page_id, dwn, contain_hashbucket);
 
     if (second_batch_pages == 0) {
         return;
@@ -1177,25 +1279,26 @@ static void dw_assemble_batch(knl_g_dw_context *dw_cxt, uint16 page_id, uint16 d
     /* also head of the second batch, if second batch not empty, prepare its tail */
     page_id = page_id + 1 + GET_REL_PGAENUM(batch->page_num);
     batch = dw_batch_tail_page(batch);
-    dw_prepare_page(batch, 0, page_id, dwn);
+    dw_prepare_page(batch, 0, page_id, dwn, contain_hashbucket);
 }
 
-static inline void dw_stat_batch_flush(dw_stat_info_batch *stat_info, uint32 page_to_write)
+static inline void dw_stat_batch_flush(dw_stat_info_batch *stat_info, uint32 page_to_write, bool contain_hashbucket)
 {
     (void)pg_atomic_add_fetch_u64(&stat_info->total_writes, 1);
     (void)pg_atomic_add_fetch_u64(&stat_info->total_pages, page_to_write);
     if (page_to_write < DW_WRITE_STAT_LOWER_LIMIT) {
         (void)pg_atomic_add_fetch_u64(&stat_info->low_threshold_writes, 1);
         (void)pg_atomic_add_fetch_u64(&stat_info->low_threshold_pages, page_to_write);
-    } else if (page_to_write > GET_DW_BATCH_MAX(g_instance.dw_batch_cxt.contain_hashbucket)) {
+    } else if (page_to_write > GET_DW_BATCH_MAX(contain_hashbucket)) {
         (void)pg_atomic_add_fetch_u64(&stat_info->high_threshold_writes, 1);
         (void)pg_atomic_add_fetch_u64(&stat_info->high_threshold_pages, page_to_write);
     }
 }
 
 /**
- * flush the copied page in the buffer into dw file, allocate the token for outside data file flushing
- * @param dw_cxt double write context
+ * flush the copied pages in the thread buffer into its dw file with one write, allocate the token for
+ * outside data file flushing
+ * @param dw_cxt double write context of the dw file the thread writes to
  * @param latest_lsn the latest lsn in the copied pages
  */
 static void dw_batch_flush(knl_g_dw_context* dw_cxt, XLogRecPtr latest_lsn, ThrdDwCxt* thrd_dw_cxt)
@@ -1203,56 +1306,48 @@ static void dw_batch_flush(knl_g_dw_context* dw_cxt, XLogRecPtr latest_lsn, Thrd
     uint16 offset_page;
     uint16 pages_to_write = 0;
     dw_file_head_t* file_head = NULL;
-    errno_t rc;
 
-    (void)LWLockAcquire(dw_cxt->flush_lock, LW_EXCLUSIVE);
+    Assert(thrd_dw_cxt->write_pos > 0);
 
     if (!XLogRecPtrIsInvalid(latest_lsn)) {
         XLogFlush(latest_lsn);
         g_instance.ckpt_cxt_ctl->page_writer_xlog_flush_loc = latest_lsn;
     }
 
-    if (thrd_dw_cxt->contain_hashbucket) {
-        dw_cxt->contain_hashbucket = true;
-    }
+    pages_to_write = dw_batch_add_extra(thrd_dw_cxt->write_pos, thrd_dw_cxt->contain_hashbucket);
 
-    dw_cxt->write_pos = thrd_dw_cxt->write_pos;
-    Assert(dw_cxt->write_pos > 0);
+    (void)LWLockAcquire(dw_cxt->flush_lock, LW_EXCLUSIVE);
 
     file_head = dw_cxt->file_head;
-    pages_to_write = dw_batch_add_extra(dw_cxt->write_pos);
-    rc = memcpy_s(dw_cxt->buf, pages_to_write * BLCKSZ, thrd_dw_cxt->dw_buf, pages_to_write * BLCKSZ);
-    securec_check(rc, "\0", "\0");
     (void)dw_reset_if_need(dw_cxt, pages_to_write, false);
 
     /* calculate it after checking file space, in case of updated by sync */
     offset_page = file_head->start + dw_cxt->flush_page;
 
-    dw_assemble_batch(dw_cxt, offset_page, file_head->head.dwn);
+    dw_assemble_batch(thrd_dw_cxt, offset_page, file_head->head.dwn);
 
     pgstat_report_waitevent(WAIT_EVENT_DW_WRITE);
-    dw_pwrite_file(dw_cxt->fd, dw_cxt->buf, (pages_to_write * BLCKSZ), (offset_page * BLCKSZ));
+    dw_pwrite_file(dw_cxt->fd, thrd_dw_cxt->dw_buf, (pages_to_write * BLCKSZ), (offset_page * BLCKSZ));
     pgstat_report_waitevent(WAIT_EVENT_END);
 
-    dw_stat_batch_flush(&dw_cxt->batch_stat_info, pages_to_write);
+    dw_stat_batch_flush(&dw_cxt->batch_stat_info, pages_to_write, thrd_dw_cxt->contain_hashbucket);
     /* the tail of this flushed batch is the head of the next batch */
     dw_cxt->flush_page += (pages_to_write - 1);
-    dw_cxt->write_pos = 0;
-    dw_cxt->contain_hashbucket = false;
     thrd_dw_cxt->dw_page_idx = offset_page;
     LWLockRelease(dw_cxt->flush_lock);
 
     ereport(DW_LOG_LEVEL,
             (errmodule(MOD_DW),
-             errmsg("[batch flush] file_head[dwn %hu, start %hu], total_pages %hu, data_pages %hu, flushed_pages %hu",
-                    dw_cxt->file_head->head.dwn, dw_cxt->file_head->start, dw_cxt->flush_page, dw_cxt->write_pos,
-                    pages_to_write)));
+             errmsg("[batch flush] file %u file_head[dwn %hu, start %hu], total_pages %hu, data_pages %hu, "
+                    "flushed_pages %hu",
+                    dw_cxt->file_id, dw_cxt->file_head->head.dwn, dw_cxt->file_head->start, dw_cxt->flush_page,
+                    thrd_dw_cxt->write_pos, pages_to_write)));
 }
 
 void dw_perform_batch_flush(uint32 size, CkptSortItem *dirty_buf_list, ThrdDwCxt* thrd_dw_cxt)
 {
     uint16 batch_size;
-    knl_g_dw_context *dw_cxt = &g_instance.dw_batch_cxt;
+    knl_g_dw_context *dw_cxt = &g_instance.dw_batch_cxt[thrd_dw_cxt->dw_file_id];
     XLogRecPtr latest_lsn = InvalidXLogRecPtr;
     XLogRecPtr page_lsn;
 
@@ -1304,14 +1399,12 @@ void dw_perform_batch_flush(uint32 size, CkptSortItem *dirty_buf_list, ThrdDwCxt
         dw_batch_flush(dw_cxt, latest_lsn, thrd_dw_cxt);
     }
 }
-void dw_truncate_batch_file()
+static void dw_truncate_batch_file(knl_g_dw_context *cxt)
 {
-    knl_g_dw_context *cxt = &g_instance.dw_batch_cxt;
-
     ereport(DW_LOG_LEVEL,
         (errmodule(MOD_DW),
-            errmsg("[batch flush] DW truncate start: file_head[dwn %hu, start %hu], total_pages %hu",
-                cxt->file_head->head.dwn, cxt->file_head->start, cxt->flush_page)));
+            errmsg("[batch flush] DW truncate start: file %u file_head[dwn %hu, start %hu], total_pages %hu",
+                cxt->file_id, cxt->file_head->head.dwn, cxt->file_head->start, cxt->flush_page)));
     /*
      * If we can grab dw flush lock, truncate dw file for faster recovery.
      *
@@ -1329,8 +1422,8 @@ void dw_truncate_batch_file()
     }
 
     ereport(LOG, (errmodule(MOD_DW),
-        errmsg("[batch flush] DW truncate end: file_head[dwn %hu, start %hu], total_pages %hu",
-            cxt->file_head->head.dwn, cxt->file_head->start, cxt->flush_page)));
+        errmsg("[batch flush] DW truncate end: file %u file_head[dwn %hu, start %hu], total_pages %hu",
+            cxt->file_id, cxt->file_head->head.dwn, cxt->file_head->start, cxt->flush_page)));
 }
 
 void dw_truncate_single_file()
@@ -1358,27 +1451,17 @@ void dw_truncate()
     }
 
     gstrace_entry(GS_TRC_ID_dw_truncate);
-    dw_truncate_batch_file();
+    for (uint32 i = 0; i < dw_batch_file_num(); i++) {
+        dw_truncate_batch_file(&g_instance.dw_batch_cxt[i]);
+    }
     dw_truncate_single_file();
     gstrace_exit(GS_TRC_ID_dw_truncate);
 }
 
-void dw_exit(bool single)
+static void dw_exit_cxt(knl_g_dw_context *dw_cxt, bool single)
 {
-    knl_g_dw_context *dw_cxt = NULL;
     uint32 expected = 0;
 
-    if (!dw_enabled()) {
-        /* Double write is not enabled, nothing to do. */
-        return;
-    }
-
-    if (single) {
-        dw_cxt = &g_instance.dw_single_cxt;
-    } else {
-        dw_cxt = &g_instance.dw_batch_cxt;
-    }
-
     if (!pg_atomic_compare_exchange_u32(&dw_cxt->closed, &expected, 1)) {
         ereport(WARNING, (errmodule(MOD_DW), errmsg("Double write already closed")));
         return;
@@ -1392,11 +1475,26 @@ void dw_exit(bool single)
     if (single) {
         dw_truncate_single_file();
     } else {
-        dw_truncate_batch_file();
+        dw_truncate_batch_file(dw_cxt);
     }
 
     dw_free_resource(dw_cxt);
+}
+
+void dw_exit(bool single)
+{
+    if (!dw_enabled()) {
+        /* Double write is not enabled, nothing to do. */
+        return;
+    }
 
+    if (single) {
+        dw_exit_cxt(&g_instance.dw_single_cxt, true);
+    } else {
+        for (uint32 i = 0; i < dw_batch_file_num(); i++) {
+            dw_exit_cxt(&g_instance.dw_batch_cxt[i], false);
+        }
+    }
 }
 
 static void dw_generate_single_file()
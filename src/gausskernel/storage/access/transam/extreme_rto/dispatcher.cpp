@@ -147,7 +147,7 @@ bool CheckBufHasSpaceToDispatch(XLogRecPtr endRecPtr);
 static const RmgrDispatchData g_dispatchTable[RM_MAX_ID + 1] = {
     { DispatchXLogRecord, RmgrRecordInfoValid, RM_XLOG_ID, XLOG_CHECKPOINT_SHUTDOWN, XLOG_DELAY_XLOG_RECYCLE },
     { DispatchXactRecord, RmgrRecordInfoValid, RM_XACT_ID, XLOG_XACT_COMMIT, XLOG_XACT_COMMIT_COMPACT },
-    { DispatchSmgrRecord, RmgrRecordInfoValid, RM_SMGR_ID, XLOG_SMGR_CREATE, XLOG_SMGR_TRUNCATE },
+    { DispatchSmgrRecord, RmgrRecordInfoValid, RM_SMGR_ID, XLOG_SMGR_CREATE, XLOG_SMGR_CREATE_COMPRESSED },
     { DispatchCLogRecord, RmgrRecordInfoValid, RM_CLOG_ID, CLOG_ZEROPAGE, CLOG_TRUNCATE },
     { DispatchDataBaseRecord, RmgrRecordInfoValid, RM_DBASE_ID, XLOG_DBASE_CREATE, XLOG_DBASE_DROP },
     { DispatchTableSpaceRecord, RmgrRecordInfoValid, RM_TBLSPC_ID, XLOG_TBLSPC_CREATE, XLOG_TBLSPC_RELATIVE_CREATE },
@@ -688,6 +688,8 @@ void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, Times
 #endif
         ResetChosedPageLineList();
         if (fatalerror != true) {
+            /* the page workers may free the record once it is dispatched */
+            RedoPrefetchRecordBlocks(record);
             g_dispatchTable[rmid].rm_dispatch(record, expectedTLIs, recordXTime);
         } else {
             DispatchDefaultRecord(record, expectedTLIs, recordXTime);
@@ -988,7 +990,7 @@ static bool DispatchSmgrRecord(XLogReaderState *record, List *expectedTLIs, Time
     bool isNeedFullSync = false;
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
 
-    if (info == XLOG_SMGR_CREATE) {
+    if (info == XLOG_SMGR_CREATE || info == XLOG_SMGR_CREATE_COMPRESSED) {
         /* only need to dispatch to one page worker */
         /* for parallel performance */
         if (SUPPORT_FPAGE_DISPATCH) {
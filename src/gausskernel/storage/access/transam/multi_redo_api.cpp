@@ -35,6 +35,8 @@
 #include "access/parallel_recovery/dispatcher.h"
 #include "access/extreme_rto/page_redo.h"
 #include "access/parallel_recovery/page_redo.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/smgr.h"
 
 
 #ifdef ENABLE_MULTIPLE_NODES
@@ -103,6 +105,129 @@ bool IsExtremeRtoReadWorkerRunning()
     return true;
 }
 
+/*
+ * Blocks the dispatcher has asked the kernel to read ahead of the page workers,
+ * in dispatch order. An entry stays in flight until replay has passed the record
+ * that referenced it; recovery_prefetch_distance caps how many are in flight.
+ */
+typedef struct RedoPrefetchEntry {
+    RelFileNode rnode;
+    ForkNumber forknum;
+    BlockNumber blkno;
+    XLogRecPtr endPtr; /* end of the record that referenced the block */
+} RedoPrefetchEntry;
+
+typedef struct RedoPrefetchQueue {
+    RedoPrefetchEntry *entries;
+    uint32 size;
+    uint32 head;  /* oldest entry in flight */
+    uint32 count; /* number of entries in flight */
+} RedoPrefetchQueue;
+
+static THR_LOCAL RedoPrefetchQueue g_redoPrefetchQueue = {NULL, 0, 0, 0};
+
+/* How many of the newest in-flight entries are checked for a repeated block */
+static const uint32 REDO_PREFETCH_RECENT_NUM = 8;
+
+static bool RedoPrefetchRecentlyIssued(const RedoPrefetchQueue *queue, const DecodedBkpBlock *block)
+{
+    uint32 checkNum = Min(queue->count, REDO_PREFETCH_RECENT_NUM);
+
+    for (uint32 i = 1; i <= checkNum; i++) {
+        const RedoPrefetchEntry *entry = &queue->entries[(queue->head + queue->count - i) % queue->size];
+        if (entry->blkno == block->blkno && entry->forknum == block->forknum &&
+            RelFileNodeEquals(entry->rnode, block->rnode)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool RedoRecordWillRemoveRelFiles(XLogReaderState *record)
+{
+    RmgrId rmid = XLogRecGetRmid(record);
+
+    if (rmid == RM_SMGR_ID || rmid == RM_DBASE_ID || rmid == RM_TBLSPC_ID) {
+        return true;
+    }
+    return IsExtremeRedo() ? extreme_rto::XactWillRemoveRelFiles(record)
+                           : parallel_recovery::XactWillRemoveRelFiles(record);
+}
+
+/*
+ * Prefetch the data blocks a record is going to read during replay, before the
+ * record is handed to the page workers. Blocks restored from a full-page image
+ * or initialized by the record are never read and are skipped, and so is every
+ * block once recovery_prefetch_distance blocks are in flight.
+ *
+ * Run from the dispatcher thread.
+ */
+void RedoPrefetchRecordBlocks(XLogReaderState *record)
+{
+    RedoPrefetchQueue *queue = &g_redoPrefetchQueue;
+    RedoPerf *perf = &g_instance.comm_cxt.predo_cxt.redoPf;
+    uint32 distance = (uint32)u_sess->attr.attr_storage.recovery_prefetch_distance;
+
+    if (queue->size != distance) {
+        if (queue->entries != NULL) {
+            pfree(queue->entries);
+            queue->entries = NULL;
+        }
+        if (distance > 0) {
+            queue->entries =
+                (RedoPrefetchEntry *)MemoryContextAllocZero(t_thrd.top_mem_cxt, sizeof(RedoPrefetchEntry) * distance);
+        }
+        queue->size = distance;
+        queue->head = 0;
+        queue->count = 0;
+    }
+    if (distance == 0) {
+        return;
+    }
+
+    /* Don't hold open files that replaying this record is going to remove */
+    if (RedoRecordWillRemoveRelFiles(record)) {
+        smgrcloseall();
+        queue->head = 0;
+        queue->count = 0;
+        return;
+    }
+
+    if (queue->count > 0) {
+        XLogRecPtr replayedPtr = GetXLogReplayRecPtr(NULL);
+        while (queue->count > 0 && XLByteLE(queue->entries[queue->head].endPtr, replayedPtr)) {
+            queue->head = (queue->head + 1) % queue->size;
+            queue->count--;
+        }
+    }
+
+    for (int i = 0; i <= record->max_block_id; i++) {
+        DecodedBkpBlock *block = &record->blocks[i];
+
+        if (!block->in_use) {
+            continue;
+        }
+        if (block->has_image || (block->flags & BKPBLOCK_WILL_INIT) || block->forknum > MAX_FORKNUM ||
+            queue->count == queue->size) {
+            perf->prefetch_skip++;
+            continue;
+        }
+        if (RedoPrefetchRecentlyIssued(queue, block) ||
+            !PrefetchBufferWithoutRelcache(block->rnode, block->forknum, block->blkno)) {
+            perf->prefetch_hit++;
+            continue;
+        }
+
+        RedoPrefetchEntry *entry = &queue->entries[(queue->head + queue->count) % queue->size];
+        entry->rnode = block->rnode;
+        entry->forknum = block->forknum;
+        entry->blkno = block->blkno;
+        entry->endPtr = record->EndRecPtr;
+        queue->count++;
+        perf->prefetch_miss++;
+    }
+}
+
 void DispatchRedoRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
 {
     if (IsExtremeRedo()) {
@@ -147,7 +147,7 @@ RedoWaitInfo redo_get_io_event(int32 event_id);
 static const RmgrDispatchData g_dispatchTable[RM_MAX_ID + 1] = {
     { DispatchXLogRecord, RmgrRecordInfoValid, RM_XLOG_ID, XLOG_CHECKPOINT_SHUTDOWN, XLOG_DELAY_XLOG_RECYCLE },
     { DispatchXactRecord, RmgrRecordInfoValid, RM_XACT_ID, XLOG_XACT_COMMIT, XLOG_XACT_COMMIT_COMPACT },
-    { DispatchSmgrRecord, RmgrRecordInfoValid, RM_SMGR_ID, XLOG_SMGR_CREATE, XLOG_SMGR_TRUNCATE },
+    { DispatchSmgrRecord, RmgrRecordInfoValid, RM_SMGR_ID, XLOG_SMGR_CREATE, XLOG_SMGR_CREATE_COMPRESSED },
     { DispatchCLogRecord, RmgrRecordInfoValid, RM_CLOG_ID, CLOG_ZEROPAGE, CLOG_TRUNCATE },
     { DispatchDataBaseRecord, RmgrRecordInfoValid, RM_DBASE_ID, XLOG_DBASE_CREATE, XLOG_DBASE_DROP },
     { DispatchTableSpaceRecord, RmgrRecordInfoValid, RM_TBLSPC_ID, XLOG_TBLSPC_CREATE, XLOG_TBLSPC_RELATIVE_CREATE },
@@ -545,6 +545,7 @@ void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, Times
         ResetChosedWorkerList();
 
         if (fatalerror != true) {
+            RedoPrefetchRecordBlocks(record);
             isNeedFullSync = g_dispatchTable[rmid].rm_dispatch(record, expectedTLIs, recordXTime);
         } else {
             isNeedFullSync = DispatchDefaultRecord(record, expectedTLIs, recordXTime);
@@ -865,7 +866,7 @@ static bool DispatchSmgrRecord(XLogReaderState *record, List *expectedTLIs, Time
 {
     bool isNeedFullSync = false;
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
-    if (info == XLOG_SMGR_CREATE) {
+    if (info == XLOG_SMGR_CREATE || info == XLOG_SMGR_CREATE_COMPRESSED) {
         /* only need to dispatch to one page worker */
         /* for parallel performance */
         if (SUPPORT_FPAGE_DISPATCH) {
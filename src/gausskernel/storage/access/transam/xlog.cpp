@@ -259,6 +259,24 @@ typedef union WALInsertLockPadded {
     char pad[PG_CACHE_LINE_SIZE];
 } WALInsertLockPadded;
 
+/*
+ * Per NUMA node staging ring for WAL insertion (enable_wal_insert_staging).
+ *
+ * A record reserved at usable byte position P is copied to data[P % size] of
+ * the ring on the inserter's own node, wrapping around the end.  Once it is
+ * complete, the mark of its first MAXALIGN granule is set to the lap number
+ * P / size + 1; GatherStagedXLog() looks for that mark to find the record,
+ * and clears it again when it has moved the record into the WAL buffers.
+ */
+typedef struct XLogStagingRing {
+    char *data;
+    pg_atomic_uint32 *marks;
+} XLogStagingRing;
+
+/* records larger than this go straight to the WAL buffers */
+#define XLOG_STAGING_MAX_RECORD(size) ((size) / 4)
+#define XLOG_STAGING_MAX_SIZE ((uint64)128 * 1024 * 1024)
+
 /*
  * Shared state data for WAL insertion.
  */
@@ -360,6 +378,24 @@ typedef struct XLogCtlData {
     int XLogCacheBlck;    /* highest allocated xlog buffer index */
     TimeLineID ThisTimeLineID;
 
+    /*
+     * With enable_wal_insert_staging, inserters copy their records into the
+     * staging ring of their NUMA node rather than into the pages above, and
+     * the records are moved into the pages in LSN order by whoever needs the
+     * WAL written out, under WALGatherLock.  gatheredBytePos is the usable
+     * byte position up to which that has been done; it only advances while
+     * WALGatherLock is held.  stagingRings is NULL when staging is off.
+     *
+     * An inserter that can't stage its record until an earlier one is staged
+     * sleeps on its latch, advertised in stagingWaiters at the index of the
+     * insertion lock it holds; stagingWaiterCount says whether there are any.
+     */
+    XLogStagingRing *stagingRings;
+    uint64 stagingSize; /* bytes per ring, a power of 2 */
+    pg_atomic_uint64 gatheredBytePos;
+    PGPROC *volatile *stagingWaiters;
+    pg_atomic_uint32 stagingWaiterCount;
+
     /*
      * archiveCleanupCommand is read from recovery.conf but needs to be in
      * shared memory so that the checkpointer process can access it.
@@ -592,6 +628,12 @@ static void CopyXLogRecordToWAL(int write_len, bool isLogSwitch, XLogRecData *rd
 static void ReserveXLogInsertLocation(uint32 size, XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr);
 static bool ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr, bool isupgrade = false);
 static XLogRecPtr WaitXLogInsertionsToFinish(XLogRecPtr upto);
+static void XLogStagingShmemInit(void);
+static void StageXLogRecord(int write_len, bool direct, bool isLogSwitch, XLogRecData *rdata, XLogRecPtr StartPos,
+                            XLogRecPtr EndPos);
+static uint64 GatherStagedXLog(uint64 upto);
+static void WaitForStagedXLog(uint64 startbytepos, uint64 endbytepos, bool direct);
+static void WakeStagingWaiters(void);
 
 template <bool isGroupInsert>
 static char *GetXLogBuffer(XLogRecPtr ptr, PGPROC *proc = NULL);
@@ -1204,7 +1246,11 @@ static XLogRecPtr XLogInsertRecordSingle(XLogRecData *rdata, XLogRecPtr fpw_lsn,
          * All the record data, including the header, is now ready to be
          * inserted. Copy the record in the space reserved.
          */
-        CopyXLogRecordToWAL(rechdr->xl_tot_len, isLogSwitch, rdata, StartPos, EndPos);
+        if (t_thrd.shemem_ptr_cxt.XLogCtl->stagingRings != NULL) {
+            StageXLogRecord(rechdr->xl_tot_len, isupgrade, isLogSwitch, rdata, StartPos, EndPos);
+        } else {
+            CopyXLogRecordToWAL(rechdr->xl_tot_len, isLogSwitch, rdata, StartPos, EndPos);
+        }
     } else {
         /*
          * This was an xlog-switch record, but the current insert location was
@@ -1328,7 +1374,7 @@ XLogRecPtr XLogInsertRecord(XLogRecData *rdata, XLogRecPtr fpw_lsn, bool isupgra
     bool isLogSwitch =
         ((isupgrade ? ((XLogRecordOld *)rechdr)->xl_rmid : ((XLogRecord *)rechdr)->xl_rmid) == RM_XLOG_ID &&
          (isupgrade ? ((XLogRecordOld *)rechdr)->xl_info : ((XLogRecord *)rechdr)->xl_info) == XLOG_SWITCH);
-    if (isLogSwitch || isupgrade) {
+    if (isLogSwitch || isupgrade || t_thrd.shemem_ptr_cxt.XLogCtl->stagingRings != NULL) {
         return XLogInsertRecordSingle(rdata, fpw_lsn, isupgrade);
     } else {
         return XLogInsertRecordGroup(rdata, fpw_lsn);
@@ -1832,6 +1878,16 @@ static XLogRecPtr WaitXLogInsertionsToFinish(XLogRecPtr upto)
         ereport(PANIC, (errmsg("cannot wait without a PGPROC structure")));
     }
 
+    /*
+     * Called back from AdvanceXLInsertBuffer() while we are gathering staged
+     * records.  The page it wants to write out lies before the record being
+     * gathered, so it is complete already, and waiting for the inserters here
+     * could deadlock against one that waits for room in its staging ring.
+     */
+    if (t_thrd.xlog_cxt.gatheringStagedXLog) {
+        return upto;
+    }
+
     /* Read the current insert position */
 #if defined(__x86_64__) || defined(__aarch64__)
     bytepos = pg_atomic_barrier_read_u64((uint64*)&Insert->CurrBytePos);
@@ -1901,9 +1957,282 @@ static XLogRecPtr WaitXLogInsertionsToFinish(XLogRecPtr upto)
             }
         }
     }
+
+    /*
+     * With staging, the insertions are finished once they are in the staging
+     * rings; move them into the WAL buffers before anyone writes them out.
+     * XLogFlush calls us again holding WALWriteLock, which a gatherer may need
+     * to evict a WAL buffer, so then only report what is gathered already.
+     */
+    if (t_thrd.shemem_ptr_cxt.XLogCtl->stagingRings != NULL) {
+        uint64 target = XLogRecPtrToBytePos(finishedUpto);
+        uint64 gathered = pg_atomic_read_u64(&t_thrd.shemem_ptr_cxt.XLogCtl->gatheredBytePos);
+
+        if (gathered < target && !LWLockHeldByMe(WALWriteLock)) {
+            (void)LWLockAcquire(WALGatherLock, LW_EXCLUSIVE);
+            gathered = GatherStagedXLog(target);
+            LWLockRelease(WALGatherLock);
+        }
+        if (gathered < target) {
+            finishedUpto = XLogBytePosToEndRecPtr(gathered);
+        }
+    }
     return finishedUpto;
 }
 
+/*
+ * Set up the per NUMA node staging rings, if enable_wal_insert_staging is on.
+ * Every ring covers the same window of usable byte positions: the size of
+ * wal_buffers rounded down to a power of 2, capped at XLOG_STAGING_MAX_SIZE.
+ */
+static void XLogStagingShmemInit(void)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    int nNumaNodes = g_instance.shmem_cxt.numaNodeNum;
+    uint64 walBufferSize = (uint64)XLOG_BLCKSZ * g_instance.attr.attr_storage.XLOGbuffers;
+    uint64 size = XLOG_BLCKSZ;
+    Size marksSize;
+    errno_t errorno = EOK;
+
+    xlogctl->stagingRings = NULL;
+    xlogctl->stagingSize = 0;
+    pg_atomic_init_u64(&xlogctl->gatheredBytePos, 0);
+    xlogctl->stagingWaiters = NULL;
+    pg_atomic_init_u32(&xlogctl->stagingWaiterCount, 0);
+    if (!g_instance.attr.attr_storage.enable_wal_insert_staging) {
+        return;
+    }
+
+    while (size * 2 <= walBufferSize && size * 2 <= XLOG_STAGING_MAX_SIZE) {
+        size *= 2;
+    }
+    marksSize = (Size)(size / MAXIMUM_ALIGNOF) * sizeof(pg_atomic_uint32);
+
+    XLogStagingRing *rings = (XLogStagingRing *)palloc0(nNumaNodes * sizeof(XLogStagingRing));
+    for (int i = 0; i < nNumaNodes; i++) {
+        char *ptr = NULL;
+        Size allocSize = (Size)size + marksSize + PG_CACHE_LINE_SIZE;
+#ifdef __USE_NUMA
+        if (nNumaNodes > 1) {
+            ptr = (char *)numa_alloc_onnode(allocSize, i);
+            if (ptr == NULL) {
+                ereport(PANIC, (errmsg("XLOGShmemInit could not alloc WAL staging memory on node %d", i)));
+            }
+            add_numa_alloc_info(ptr, allocSize);
+        } else {
+#endif
+            ptr = (char *)palloc(allocSize);
+#ifdef __USE_NUMA
+        }
+#endif
+        ptr = (char *)CACHELINEALIGN(ptr);
+        rings[i].data = ptr;
+        rings[i].marks = (pg_atomic_uint32 *)(ptr + size);
+        errorno = memset_s(rings[i].marks, marksSize, 0, marksSize);
+        securec_check(errorno, "", "");
+    }
+
+    xlogctl->stagingWaiters =
+        (PGPROC *volatile *)palloc0(nNumaNodes * g_instance.xlog_cxt.num_locks_in_group * sizeof(PGPROC *));
+    xlogctl->stagingSize = size;
+    xlogctl->stagingRings = rings;
+    ereport(LOG, (errmsg("WAL insertion staging enabled, %d ring(s) of %lu bytes", nNumaNodes, size)));
+}
+
+/*
+ * Copy a WAL record, already reserved at StartPos..EndPos, into the staging
+ * ring of our NUMA node.  The caller holds a WAL insertion lock.
+ *
+ * Records that are too large to stage, xlog-switch records and records in the
+ * old format (direct) are copied into the WAL buffers right away instead, as
+ * soon as everything before them has been gathered.
+ */
+static void StageXLogRecord(int write_len, bool direct, bool isLogSwitch, XLogRecData *rdata, XLogRecPtr StartPos,
+                            XLogRecPtr EndPos)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    uint64 startbytepos = XLogRecPtrToBytePos(StartPos);
+    uint64 endbytepos = XLogRecPtrToBytePos(EndPos);
+    uint64 size = xlogctl->stagingSize;
+    uint64 offset = startbytepos & (size - 1);
+    XLogStagingRing *ring = &xlogctl->stagingRings[t_thrd.proc->nodeno];
+    errno_t errorno = EOK;
+
+    if (direct || isLogSwitch || (uint64)write_len > XLOG_STAGING_MAX_RECORD(size)) {
+        WaitForStagedXLog(startbytepos, endbytepos, true);
+        t_thrd.xlog_cxt.gatheringStagedXLog = true;
+        t_thrd.xlog_cxt.gatheringWithInsertLock = true;
+        CopyXLogRecordToWAL(write_len, isLogSwitch, rdata, StartPos, EndPos);
+        t_thrd.xlog_cxt.gatheringWithInsertLock = false;
+        t_thrd.xlog_cxt.gatheringStagedXLog = false;
+        pg_atomic_write_u64(&xlogctl->gatheredBytePos, endbytepos);
+        LWLockRelease(WALGatherLock);
+        WakeStagingWaiters();
+        return;
+    }
+
+    /*
+     * Wait for the ring to have room.  Whatever is in the way before us can be
+     * gathered, so help with that rather than just waiting for the WAL writer.
+     */
+    if (endbytepos - pg_atomic_read_u64(&xlogctl->gatheredBytePos) > size) {
+        pgstat_report_waitevent(WAIT_EVENT_WAL_BUFFER_FULL);
+        WaitForStagedXLog(startbytepos, endbytepos, false);
+        pgstat_report_waitevent(WAIT_EVENT_END);
+    }
+
+    for (; rdata != NULL; rdata = rdata->next) {
+        char *src = rdata->data;
+        uint64 len = rdata->len;
+
+        while (len > 0) {
+            uint64 chunk = Min(len, size - offset);
+
+            errorno = memcpy_s(ring->data + offset, (size_t)(size - offset), src, (size_t)chunk);
+            securec_check(errorno, "", "");
+            src += chunk;
+            len -= chunk;
+            offset = (offset + chunk) & (size - 1);
+        }
+    }
+
+    /* make the record visible to gatherers, see GatherStagedXLog() */
+    pg_write_barrier();
+    pg_atomic_write_u32(&ring->marks[(startbytepos & (size - 1)) / MAXIMUM_ALIGNOF],
+                        (uint32)(startbytepos / size) + 1);
+    WakeStagingWaiters();
+}
+
+/*
+ * Wait in StageXLogRecord() until everything before startbytepos has been
+ * gathered (direct), or until the ring has room for a record ending at
+ * endbytepos.  Gathering stops only at a record that its inserter is still
+ * staging, so between attempts we sleep on our latch until an inserter has
+ * staged or copied a record, see WakeStagingWaiters().  The caller holds a
+ * WAL insertion lock, which gives us our waiter slot.  In the direct case,
+ * returns with WALGatherLock held.
+ */
+static void WaitForStagedXLog(uint64 startbytepos, uint64 endbytepos, bool direct)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    int slot = t_thrd.proc->nodeno * g_instance.xlog_cxt.num_locks_in_group + t_thrd.xlog_cxt.MyLockNo;
+    bool registered = false;
+
+    for (;;) {
+        (void)LWLockAcquire(WALGatherLock, LW_EXCLUSIVE);
+        t_thrd.xlog_cxt.gatheringWithInsertLock = true;
+        uint64 gathered = GatherStagedXLog(startbytepos);
+        t_thrd.xlog_cxt.gatheringWithInsertLock = false;
+        if (direct ? (gathered == startbytepos) : (endbytepos - gathered <= xlogctl->stagingSize)) {
+            break;
+        }
+        LWLockRelease(WALGatherLock);
+
+        if (!registered) {
+            /* advertise ourselves, then look once more before the first sleep */
+            xlogctl->stagingWaiters[slot] = t_thrd.proc;
+            (void)pg_atomic_fetch_add_u32(&xlogctl->stagingWaiterCount, 1);
+            registered = true;
+            continue;
+        }
+        (void)WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET, -1L);
+        ResetLatch(&t_thrd.proc->procLatch);
+    }
+
+    if (registered) {
+        xlogctl->stagingWaiters[slot] = NULL;
+        (void)pg_atomic_fetch_sub_u32(&xlogctl->stagingWaiterCount, 1);
+    }
+    if (!direct) {
+        LWLockRelease(WALGatherLock);
+    }
+}
+
+/*
+ * Wake the inserters sleeping in WaitForStagedXLog(), after we have staged or
+ * copied a record.  The barrier pairs with the atomic increment of a waiter
+ * registering itself: either the waiter sees our record when it looks again,
+ * or we see the waiter here.
+ */
+static void WakeStagingWaiters(void)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    int nslots = g_instance.shmem_cxt.numaNodeNum * g_instance.xlog_cxt.num_locks_in_group;
+
+    pg_memory_barrier();
+    if (pg_atomic_read_u32(&xlogctl->stagingWaiterCount) == 0) {
+        return;
+    }
+    for (int i = 0; i < nslots; i++) {
+        PGPROC *proc = xlogctl->stagingWaiters[i];
+
+        if (proc != NULL) {
+            SetLatch(&proc->procLatch);
+        }
+    }
+}
+
+/*
+ * Move staged WAL records into the WAL buffers in LSN order, starting at
+ * gatheredBytePos, until reaching 'upto' or a record that is not completely
+ * staged yet.  Returns the new gatheredBytePos.  Caller holds WALGatherLock.
+ */
+static uint64 GatherStagedXLog(uint64 upto)
+{
+    XLogCtlData *xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    uint64 size = xlogctl->stagingSize;
+    uint64 pos = pg_atomic_read_u64(&xlogctl->gatheredBytePos);
+    int nNumaNodes = g_instance.shmem_cxt.numaNodeNum;
+
+    t_thrd.xlog_cxt.gatheringStagedXLog = true;
+    while (pos < upto) {
+        uint64 offset = pos & (size - 1);
+        uint32 lap = (uint32)(pos / size) + 1;
+        pg_atomic_uint32 *mark = NULL;
+        XLogStagingRing *ring = NULL;
+        XLogRecData chunks[2];
+        uint32 len;
+        uint64 first;
+
+        for (int i = 0; i < nNumaNodes; i++) {
+            mark = &xlogctl->stagingRings[i].marks[offset / MAXIMUM_ALIGNOF];
+            if (pg_atomic_read_u32(mark) == lap) {
+                ring = &xlogctl->stagingRings[i];
+                break;
+            }
+        }
+        if (ring == NULL) {
+            break;
+        }
+        pg_read_barrier();
+
+        /* xl_tot_len is the first field and records are MAXALIGNed, so it never wraps */
+        len = ((XLogRecord *)(ring->data + offset))->xl_tot_len;
+        first = Min((uint64)len, size - offset);
+        chunks[0].data = ring->data + offset;
+        chunks[0].len = (uint32)first;
+        chunks[0].buffer = InvalidBuffer;
+        chunks[0].next = NULL;
+        if (first < len) {
+            chunks[1].data = ring->data;
+            chunks[1].len = len - (uint32)first;
+            chunks[1].buffer = InvalidBuffer;
+            chunks[1].next = NULL;
+            chunks[0].next = &chunks[1];
+        }
+
+        CopyXLogRecordToWAL((int)len, false, chunks, XLogBytePosToRecPtr(pos),
+                            XLogBytePosToEndRecPtr(pos + MAXALIGN(len)));
+
+        pg_atomic_write_u32(mark, 0);
+        pos += MAXALIGN(len);
+        pg_atomic_write_u64(&xlogctl->gatheredBytePos, pos);
+    }
+    t_thrd.xlog_cxt.gatheringStagedXLog = false;
+
+    return pos;
+}
+
 /*
  * Get a pointer to the right location in the WAL buffer containing the
  * given XLogRecPtr.
@@ -1966,8 +2295,15 @@ static char *GetXLogBuffer(XLogRecPtr ptr, PGPROC *proc)
 
     endptr = t_thrd.shemem_ptr_cxt.XLogCtl->xlblocks[idx];
     if (expectedEndPtr != endptr) {
-        // Let others know that we're finished inserting the record up to the page boundary.
-        WALInsertLockUpdateInsertingAt(expectedEndPtr - XLOG_BLCKSZ);
+        /*
+         * Let others know that we're finished inserting the record up to the page boundary.
+         * A thread gathering staged records from WaitXLogInsertionsToFinish() holds no
+         * insertion lock; the records it gathers are accounted for by gatheredBytePos.
+         * An inserter gathers only records before its own, so it can advertise as usual.
+         */
+        if (!t_thrd.xlog_cxt.gatheringStagedXLog || t_thrd.xlog_cxt.gatheringWithInsertLock) {
+            WALInsertLockUpdateInsertingAt(expectedEndPtr - XLOG_BLCKSZ);
+        }
         pgstat_report_waitevent(WAIT_EVENT_WAL_BUFFER_FULL);
         AdvanceXLInsertBuffer<isGroupInsert>(ptr, false, proc);
 
@@ -6549,6 +6885,8 @@ void XLOGShmemInit(void)
         }
     }
 
+    XLogStagingShmemInit();
+
     /*
      * Align the start of the page buffers to a full xlog block size boundary.
      * This simplifies some calculations in XLOG insertion. It is also required
@@ -9136,6 +9474,7 @@ void StartupXLOG(void)
     Insert = &t_thrd.shemem_ptr_cxt.XLogCtl->Insert;
     Insert->PrevBytePos = XLogRecPtrToBytePos(t_thrd.xlog_cxt.LastRec);
     Insert->CurrBytePos = XLogRecPtrToBytePos(EndOfLog);
+    pg_atomic_write_u64(&t_thrd.shemem_ptr_cxt.XLogCtl->gatheredBytePos, Insert->CurrBytePos);
 
     /*
      * Tricky point here: readBuf contains the *last* block that the LastRec
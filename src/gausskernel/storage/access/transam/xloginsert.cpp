@@ -33,6 +33,7 @@
 #include "utils/guc.h"
 #include "pg_trace.h"
 #include "replication/logical.h"
+#include "lz4.h"
 
 /*
  * For each block reference registered with XLogRegisterBuffer, we fill in
@@ -52,6 +53,8 @@ typedef struct registered_buffer {
     uint16 extra_flag;
     XLogRecData bkp_rdatas[2]; /* temporary rdatas used to hold references to
                                 * backup block data in XLogRecordAssemble() */
+    char compressed_page[BLCKSZ]; /* buffer to store a compressed version of
+                                   * backup block image */
 } registered_buffer;
 
 #define HEADER_SCRATCH_SIZE \
@@ -60,6 +63,8 @@ typedef struct registered_buffer {
 static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_info, XLogRecPtr *fpw_lsn,
                                        bool isupgrade = false, int bucket_id = -1);
 static void XLogResetLogicalPage(void);
+static bool XLogCompressBackupBlock(const char *page, uint16 hole_offset, uint16 hole_length, char *dest,
+                                    uint16 *dlen);
 
 /*
  * Begin constructing a WAL record. This must be called before the
@@ -495,6 +500,7 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
     errno_t rc = EOK;
     bool hashbucket_flag = false;
     bool no_hashbucket_flag = false;
+    bool compress_images = !isupgrade && u_sess->attr.attr_storage.wal_compression != WAL_COMPRESSION_OFF;
     /*
      * Note: this function can be called multiple times for the same record.
      * All the modifications we do to the rdata chains below must handle that.
@@ -520,6 +526,7 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
         bool needs_data = false;
         XLogRecordBlockHeader bkpb;
         XLogRecordBlockImageHeader bimg;
+        XLogRecordBlockCompressHeader cbimg = {0, BKPIMAGE_COMPRESS_NONE};
         bool page_logical = false;
         bool samerel = false;
 
@@ -603,17 +610,33 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
                 bimg.hole_length = 0;
             }
 
+            /*
+             * Try to compress the image, hole excluded. An image that does not
+             * shrink is stored as is, but still gets a compression header so
+             * that every image of the record can be decoded the same way.
+             */
+            if (compress_images) {
+                cbimg.length = BLCKSZ - bimg.hole_length;
+                if (XLogCompressBackupBlock(page, bimg.hole_offset, bimg.hole_length, regbuf->compressed_page,
+                                            &cbimg.length))
+                    cbimg.method = BKPIMAGE_COMPRESS_LZ4;
+                info |= XLR_BKP_COMPRESSED;
+            }
+
             /* Fill in the remaining fields in the XLogRecordBlockData struct */
             bkpb.fork_flags |= BKPBLOCK_HAS_IMAGE;
 
-            total_len += BLCKSZ - bimg.hole_length;
+            total_len += (cbimg.method == BKPIMAGE_COMPRESS_LZ4) ? cbimg.length : (BLCKSZ - bimg.hole_length);
 
             /*
              * Construct XLogRecData entries for the page content.
              */
             rdt_datas_last->next = &regbuf->bkp_rdatas[0];
             rdt_datas_last = rdt_datas_last->next;
-            if (bimg.hole_length == 0) {
+            if (cbimg.method == BKPIMAGE_COMPRESS_LZ4) {
+                rdt_datas_last->data = regbuf->compressed_page;
+                rdt_datas_last->len = cbimg.length;
+            } else if (bimg.hole_length == 0) {
                 rdt_datas_last->data = page;
                 rdt_datas_last->len = BLCKSZ;
             } else {
@@ -662,6 +685,12 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
             rc = memcpy_s(scratch, SizeOfXLogRecordBlockImageHeader, &bimg, SizeOfXLogRecordBlockImageHeader);
             securec_check(rc, "", "");
             scratch += SizeOfXLogRecordBlockImageHeader;
+            if (compress_images) {
+                rc = memcpy_s(scratch, SizeOfXLogRecordBlockCompressHeader, &cbimg,
+                              SizeOfXLogRecordBlockCompressHeader);
+                securec_check(rc, "", "");
+                scratch += SizeOfXLogRecordBlockCompressHeader;
+            }
         }
 
         if (!samerel) {
@@ -781,6 +810,39 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
     return t_thrd.xlog_cxt.ptr_hdr_rdt;
 }
 
+/*
+ * Compress a backup block image, hole excluded, into dest with LZ4. Returns
+ * false if the image does not get any smaller, in which case the caller
+ * stores it uncompressed; otherwise *dlen is set to the compressed length.
+ */
+static bool XLogCompressBackupBlock(const char *page, uint16 hole_offset, uint16 hole_length, char *dest, uint16 *dlen)
+{
+    int orig_len = BLCKSZ - hole_length;
+    const char *source = page;
+    char tmp[BLCKSZ];
+    int len;
+    errno_t rc = EOK;
+
+    if (hole_length != 0) {
+        rc = memcpy_s(tmp, BLCKSZ, page, hole_offset);
+        securec_check(rc, "", "");
+        if (hole_offset + hole_length < BLCKSZ) {
+            rc = memcpy_s(tmp + hole_offset, BLCKSZ - hole_offset, page + (hole_offset + hole_length),
+                          BLCKSZ - (hole_offset + hole_length));
+            securec_check(rc, "", "");
+        }
+        source = tmp;
+    }
+
+    /* leave no room for an output as large as the input, so LZ4 gives up on incompressible pages */
+    len = LZ4_compress_default(source, dest, orig_len, orig_len - 1);
+    if (len <= 0)
+        return false;
+
+    *dlen = (uint16)len;
+    return true;
+}
+
 /*
  * Write a backup block if needed when we are setting a hint. Note that
  * this may be called for a variety of page types, not just heaps.
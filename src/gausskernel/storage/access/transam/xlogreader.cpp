@@ -1222,6 +1222,7 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
     DecodedBkpBlock *lastBlock = NULL;
     uint8 block_id;
     errno_t rc = EOK;
+    bool imagecompressed = !readoldversion && (record->xl_info & XLR_BKP_COMPRESSED) != 0;
 
     ResetDecoder(state);
 
@@ -1335,7 +1336,30 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
                 ptr += sizeof(uint16);
                 remaining -= sizeof(uint16);
 
-                datatotal += BLCKSZ - blk->hole_length;
+                if (imagecompressed) {
+                    if (remaining < SizeOfXLogRecordBlockCompressHeader)
+                        goto shortdata_err;
+                    blk->bimg_len = *(uint16 *)ptr;
+                    ptr += sizeof(uint16);
+                    remaining -= sizeof(uint16);
+                    blk->bimg_method = *(uint8 *)ptr;
+                    ptr += sizeof(uint8);
+                    remaining -= sizeof(uint8);
+
+                    if ((blk->bimg_method == BKPIMAGE_COMPRESS_NONE && blk->bimg_len != BLCKSZ - blk->hole_length) ||
+                        (blk->bimg_method == BKPIMAGE_COMPRESS_LZ4 && blk->bimg_len >= BLCKSZ - blk->hole_length) ||
+                        blk->bimg_method > BKPIMAGE_COMPRESS_LZ4) {
+                        report_invalid_record(state, "invalid compressed image length %u method %u at %X/%X",
+                                              (unsigned int)blk->bimg_len, (unsigned int)blk->bimg_method,
+                                              (uint32)(state->ReadRecPtr >> 32), (uint32)state->ReadRecPtr);
+                        goto err;
+                    }
+                } else {
+                    blk->bimg_len = BLCKSZ - blk->hole_length;
+                    blk->bimg_method = BKPIMAGE_COMPRESS_NONE;
+                }
+
+                datatotal += blk->bimg_len;
             }
             if (!(fork_flags & BKPBLOCK_SAME_REL)) {
                 uint32 filenodelen = (hasbucket ? sizeof(RelFileNode) : sizeof(RelFileNodeOld));
@@ -1404,7 +1428,7 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
             continue;
         if (blk->has_image) {
             blk->bkp_image = ptr;
-            ptr += BLCKSZ - blk->hole_length;
+            ptr += blk->bimg_len;
         }
         if (blk->has_data) {
             if (!blk->data || blk->data_len > blk->data_bufsz) {
@@ -1471,7 +1495,8 @@ bool XLogRecGetBlockLastLsn(XLogReaderState *record, uint8 block_id, XLogRecPtr
     return true;
 }
 
-char *XLogRecGetBlockImage(XLogReaderState *record, uint8 block_id, uint16 *hole_offset, uint16 *hole_length)
+char *XLogRecGetBlockImage(XLogReaderState *record, uint8 block_id, uint16 *hole_offset, uint16 *hole_length,
+                           uint16 *bimg_len, uint8 *bimg_method)
 {
     DecodedBkpBlock *bkpb = NULL;
 
@@ -1486,48 +1511,13 @@ char *XLogRecGetBlockImage(XLogReaderState *record, uint8 block_id, uint16 *hole
         *hole_offset = bkpb->hole_offset;
     if (hole_length != NULL)
         *hole_length = bkpb->hole_length;
+    if (bimg_len != NULL)
+        *bimg_len = bkpb->bimg_len;
+    if (bimg_method != NULL)
+        *bimg_method = bkpb->bimg_method;
     return bkpb->bkp_image;
 }
 
-/*
- * Restore a full-page image from a backup block attached to an XLOG record.
- *
- * Returns the buffer number containing the page.
- */
-bool RestoreBlockImage(XLogReaderState *record, uint8 block_id, char *page)
-{
-    DecodedBkpBlock *bkpb = NULL;
-    errno_t rc = EOK;
-
-    if (!record->blocks[block_id].in_use)
-        return false;
-    if (!record->blocks[block_id].has_image)
-        return false;
-
-    bkpb = &record->blocks[block_id];
-
-    if (bkpb->hole_length == 0) {
-        rc = memcpy_s(page, BLCKSZ, bkpb->bkp_image, BLCKSZ);
-        securec_check(rc, "", "");
-    } else {
-        rc = memcpy_s(page, BLCKSZ, bkpb->bkp_image, bkpb->hole_offset);
-        securec_check(rc, "", "");
-        /* must zero-fill the hole */
-        rc = memset_s(page + bkpb->hole_offset, BLCKSZ - bkpb->hole_offset, 0, bkpb->hole_length);
-        securec_check(rc, "", "");
-
-        Assert(bkpb->hole_offset + bkpb->hole_length <= BLCKSZ);
-        if (bkpb->hole_offset + bkpb->hole_length == BLCKSZ)
-            return true;
-
-        rc = memcpy_s(page + (bkpb->hole_offset + bkpb->hole_length), BLCKSZ - (bkpb->hole_offset + bkpb->hole_length),
-                      bkpb->bkp_image + bkpb->hole_offset, BLCKSZ - (bkpb->hole_offset + bkpb->hole_length));
-        securec_check(rc, "", "");
-    }
-
-    return true;
-}
-
 /* XLogreader callback function, to read a WAL page */
 int SimpleXLogPageRead(XLogReaderState *xlogreader, XLogRecPtr targetPagePtr, int reqLen, XLogRecPtr targetRecPtr,
                        char *readBuf, TimeLineID *pageTLI)
@@ -538,11 +538,14 @@ XLogRedoAction XLogReadBufferForRedoExtended(XLogReaderState *record, uint8 bloc
         char *imagedata;
         uint16 hole_offset;
         uint16 hole_length;
-        imagedata = XLogRecGetBlockImage(record, block_id, &hole_offset, &hole_length);
-        if (NULL == imagedata)
+        uint16 bimg_len;
+        uint8 bimg_method;
+        imagedata = XLogRecGetBlockImage(record, block_id, &hole_offset, &hole_length, &bimg_len, &bimg_method);
+        if (NULL == imagedata ||
+            !RestoreBlockImage(imagedata, hole_offset, hole_length, bimg_len, bimg_method,
+                               (char *)bufferinfo->pageinfo.page))
             ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION),
                             errmsg("XLogReadBufferForRedoExtended failed to restore block image")));
-        RestoreBlockImage(imagedata, hole_offset, hole_length, (char *)bufferinfo->pageinfo.page);
         XlogUpdateFullPageWriteLsn(bufferinfo->pageinfo.page, bufferinfo->lsn);
         PageSetJustAfterFullPageWrite(bufferinfo->pageinfo.page);
         if (readmethod == WITH_NORMAL_CACHE) {
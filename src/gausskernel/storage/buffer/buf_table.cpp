@@ -9,6 +9,9 @@
  * in most cases the caller needs to adjust the buffer header contents
  * before the lock is released (see notes in README).
  *
+ * The lookup hint table at the end of this file is the exception: it is read
+ * without any lock, and only ever used as a hint (see BufTableHintLookup).
+ *
  *
  * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
  * Portions Copyright (c) 1996-2012, PostgreSQL Global Development Group
@@ -30,19 +33,63 @@
 #include "gstrace/storage_gstrace.h"
 
 extern uint32 hashquickany(uint32 seed, register const unsigned char *data, register int len);
+static void BufTableHintInsert(uint32 hashcode, int buf_id);
+static void BufTableHintDelete(uint32 hashcode, int buf_id);
 /* entry for buffer lookup hashtable */
 typedef struct {
     BufferTag key; /* Tag of a disk page */
     int id;        /* Associated buffer ID */
 } BufferLookupEnt;
 
+/*
+ * Lookup hint table, used when enable_lockfree_buffer_lookup is on.
+ *
+ * A set-associative array shadowing the mapping hashtable, which readers may
+ * probe without taking the BufMappingLock.  Each way packs the full hash code
+ * of a tag with the buffer ID it was last mapped to, so one 64-bit atomic read
+ * yields a consistent pair.  Writers update it while holding the partition
+ * lock exclusively, but since a set is shared by tags of several partitions
+ * all updates are done with atomics.
+ *
+ * The table is allowed to be wrong: entries can be evicted while the mapping
+ * still exists, and can point at a buffer that has since been given to another
+ * page.  Readers must therefore pin the buffer and check its tag before using
+ * it, falling back to the locked lookup when the hint doesn't pan out.
+ */
+#define BUF_HINT_WAYS 4
+
+typedef struct BufLookupHintSet {
+    pg_atomic_uint64 ways[BUF_HINT_WAYS];
+} BufLookupHintSet;
+
+#define BufHintMakeEntry(hashcode, buf_id) (((uint64)(hashcode) << 32) | (uint64)(uint32)((buf_id) + 1))
+#define BufHintGetHashCode(entry) ((uint32)((entry) >> 32))
+#define BufHintGetBufId(entry) ((int)(uint32)(entry)-1)
+
+/* Enough sets for twice as many ways as there are buffers, rounded up to a power of 2 */
+static uint32 BufHintNumSets(void)
+{
+    uint32 nsets = 1;
+
+    while (nsets * BUF_HINT_WAYS < (uint32)g_instance.attr.attr_storage.NBuffers * 2) {
+        nsets <<= 1;
+    }
+    return nsets;
+}
+
 /*
  * Estimate space needed for mapping hashtable
  *		size is the desired hash table size (possibly more than g_instance.attr.attr_storage.NBuffers)
  */
 Size BufTableShmemSize(int size)
 {
-    return hash_estimate_size(size, sizeof(BufferLookupEnt));
+    Size hash_size = hash_estimate_size(size, sizeof(BufferLookupEnt));
+
+    if (g_instance.attr.attr_storage.enable_lockfree_buffer_lookup) {
+        hash_size = add_size(hash_size, mul_size(BufHintNumSets(), sizeof(BufLookupHintSet)));
+        hash_size = add_size(hash_size, PG_CACHE_LINE_SIZE);
+    }
+    return hash_size;
 }
 
 /*
@@ -64,6 +111,23 @@ void InitBufTable(int size)
 
     t_thrd.storage_cxt.SharedBufHash = ShmemInitHash("Shared Buffer Lookup Table", size, size, &info,
                                                      HASH_ELEM | HASH_FUNCTION | HASH_PARTITION);
+
+    if (g_instance.attr.attr_storage.enable_lockfree_buffer_lookup) {
+        bool found = false;
+        uint32 nsets = BufHintNumSets();
+
+        t_thrd.storage_cxt.SharedBufHint = (BufLookupHintSet *)CACHELINEALIGN(ShmemInitStruct(
+            "Shared Buffer Lookup Hint", nsets * sizeof(BufLookupHintSet) + PG_CACHE_LINE_SIZE, &found));
+        t_thrd.storage_cxt.SharedBufHintMask = nsets - 1;
+
+        if (!found) {
+            for (uint32 i = 0; i < nsets; i++) {
+                for (int j = 0; j < BUF_HINT_WAYS; j++) {
+                    pg_atomic_init_u64(&t_thrd.storage_cxt.SharedBufHint[i].ways[j], 0);
+                }
+            }
+        }
+    }
 }
 
 /*
@@ -125,6 +189,10 @@ int BufTableInsert(BufferTag *tag, uint32 hashcode, int buf_id)
 
     result->id = buf_id;
 
+    if (t_thrd.storage_cxt.SharedBufHint != NULL) {
+        BufTableHintInsert(hashcode, buf_id);
+    }
+
     return -1;
 }
 
@@ -138,9 +206,89 @@ void BufTableDelete(BufferTag *tag, uint32 hashcode)
 {
     BufferLookupEnt *result = NULL;
 
+    /*
+     * Drop the hint first, while the entry is still ours to read; once removed,
+     * its slot may be reused by an insert in another partition.
+     */
+    if (t_thrd.storage_cxt.SharedBufHint != NULL) {
+        result = (BufferLookupEnt *)buf_hash_operate<HASH_FIND>(t_thrd.storage_cxt.SharedBufHash, tag, hashcode, NULL);
+        if (result != NULL) {
+            BufTableHintDelete(hashcode, result->id);
+        }
+    }
+
     result = (BufferLookupEnt *)buf_hash_operate<HASH_REMOVE>(t_thrd.storage_cxt.SharedBufHash, tag, hashcode, NULL);
 
     if (result == NULL) { /* shouldn't happen */
         ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), (errmsg("shared buffer hash table corrupted."))));
     }
 }
+
+/*
+ * BufTableHintLookup
+ *		Collect the buffer IDs the lookup hint table has for the given hash
+ *		code into buf_ids (which must have room for BUF_HINT_MAX_CANDIDATES
+ *		entries), and return how many were found.
+ *
+ * No lock is needed.  The result is only a hint: the caller must pin each
+ * candidate and verify its tag before trusting it.
+ */
+int BufTableHintLookup(uint32 hashcode, int *buf_ids)
+{
+    BufLookupHintSet *set = &t_thrd.storage_cxt.SharedBufHint[hashcode & t_thrd.storage_cxt.SharedBufHintMask];
+    int n = 0;
+
+    StaticAssertStmt(BUF_HINT_WAYS <= BUF_HINT_MAX_CANDIDATES, "hint set is larger than the candidate array");
+
+    for (int i = 0; i < BUF_HINT_WAYS; i++) {
+        uint64 entry = pg_atomic_read_u64(&set->ways[i]);
+
+        if (entry != 0 && BufHintGetHashCode(entry) == hashcode) {
+            buf_ids[n++] = BufHintGetBufId(entry);
+        }
+    }
+    return n;
+}
+
+/*
+ * BufTableHintInsert
+ *		Remember that the tag with the given hash code now lives in buf_id.
+ *
+ * Caller must hold exclusive lock on BufMappingLock for tag's partition
+ */
+static void BufTableHintInsert(uint32 hashcode, int buf_id)
+{
+    BufLookupHintSet *set = &t_thrd.storage_cxt.SharedBufHint[hashcode & t_thrd.storage_cxt.SharedBufHintMask];
+    uint64 entry = BufHintMakeEntry(hashcode, buf_id);
+
+    for (int i = 0; i < BUF_HINT_WAYS; i++) {
+        uint64 expected = 0;
+
+        if (pg_atomic_read_u64(&set->ways[i]) == 0 && pg_atomic_compare_exchange_u64(&set->ways[i], &expected, entry)) {
+            return;
+        }
+    }
+
+    /* set is full; evict a way picked by buffer ID, so that evictions spread over the set */
+    pg_atomic_write_u64(&set->ways[(uint32)buf_id % BUF_HINT_WAYS], entry);
+}
+
+/*
+ * BufTableHintDelete
+ *		Forget the hint for the tag with the given hash code, if it's still there.
+ *
+ * Caller must hold exclusive lock on BufMappingLock for tag's partition
+ */
+static void BufTableHintDelete(uint32 hashcode, int buf_id)
+{
+    BufLookupHintSet *set = &t_thrd.storage_cxt.SharedBufHint[hashcode & t_thrd.storage_cxt.SharedBufHintMask];
+    uint64 entry = BufHintMakeEntry(hashcode, buf_id);
+
+    for (int i = 0; i < BUF_HINT_WAYS; i++) {
+        uint64 expected = entry;
+
+        if (pg_atomic_read_u64(&set->ways[i]) == entry) {
+            (void)pg_atomic_compare_exchange_u64(&set->ways[i], &expected, 0);
+        }
+    }
+}
@@ -58,6 +58,7 @@
 #include "service/rpc_client.h"
 #include "storage/buf/buf_internals.h"
 #include "storage/buf/bufmgr.h"
+#include "storage/fd.h"
 #include "storage/ipc.h"
 #include "storage/proc.h"
 #include "storage/smgr.h"
@@ -417,6 +418,42 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 #endif /* USE_PREFETCH && USE_POSIX_FADVISE */
 }
 
+/*
+ * PrefetchBufferWithoutRelcache -- like PrefetchBuffer, for callers that only
+ * have a RelFileNode, such as the redo dispatcher.
+ *
+ * Returns true if a read was initiated, false if the block is already in
+ * shared buffers or prefetching isn't compiled in.
+ */
+bool PrefetchBufferWithoutRelcache(const RelFileNode &rnode, ForkNumber forkNum, BlockNumber blockNum)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
+    BufferTag new_tag;          /* identity of requested block */
+    uint32 new_hash;            /* hash value for newTag */
+    LWLock *new_partition_lock; /* buffer partition lock for it */
+    int buf_id;
+
+    Assert(BlockNumberIsValid(blockNum));
+
+    INIT_BUFFERTAG(new_tag, rnode, forkNum, blockNum);
+    new_hash = BufTableHashCode(&new_tag);
+    new_partition_lock = BufMappingPartitionLock(new_hash);
+
+    (void)LWLockAcquire(new_partition_lock, LW_SHARED);
+    buf_id = BufTableLookup(&new_tag, new_hash);
+    LWLockRelease(new_partition_lock);
+
+    if (buf_id >= 0) {
+        return false;
+    }
+
+    smgrprefetch(smgropen(rnode, InvalidBackendId), forkNum, blockNum);
+    return true;
+#else
+    return false;
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+}
+
 /*
  * @Description: ConditionalStartBufferIO: conditionally begin and Asynchronous Prefetch or
  * WriteBack I/O on this buffer.
@@ -2240,6 +2277,41 @@ static Buffer ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumb
     return BufferDescriptorGetBuffer(bufHdr);
 }
 
+/*
+ * BufferAllocLockFree -- try to find a resident, valid buffer for the tag
+ *		without taking the buffer mapping lock.
+ *
+ * The candidates come from the lookup hint table, which may be stale, so each
+ * one is pinned before its tag is checked.  Once we hold a pin the buffer can't
+ * be given to another page (that requires a zero refcount under the header
+ * lock), and the atomic pin orders our read of the tag after any earlier
+ * retagging, so reading the tag without the header lock is fine.  Buffers that
+ * aren't BM_VALID are left to the locked path, which knows how to wait for I/O.
+ *
+ * Returns the pinned buffer, or NULL if the caller must do the regular lookup.
+ */
+static BufferDesc *BufferAllocLockFree(BufferTag *new_tag, uint32 new_hash, BufferAccessStrategy strategy)
+{
+    int buf_ids[BUF_HINT_MAX_CANDIDATES];
+    int ncandidates = BufTableHintLookup(new_hash, buf_ids);
+
+    for (int i = 0; i < ncandidates; i++) {
+        BufferDesc *buf = GetBufferDescriptor(buf_ids[i]);
+
+        /* cheap unlocked peek first, so we don't pin unrelated buffers */
+        if (!BUFFERTAGS_EQUAL(buf->tag, *new_tag)) {
+            continue;
+        }
+
+        if (PinBuffer(buf, strategy) && BUFFERTAGS_EQUAL(buf->tag, *new_tag)) {
+            return buf;
+        }
+        UnpinBuffer(buf, true);
+    }
+
+    return NULL;
+}
+
 /*
  * BufferAlloc -- subroutine for ReadBuffer.  Handles lookup of a shared
  *		buffer.  If no buffer exists already, selects a replacement
@@ -2273,6 +2345,7 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
     BufferDesc *buf = NULL;
     bool valid = false;
     uint32 buf_state;
+    uint32 usage_count;
 
     /* create a tag so we can lookup the buffer */
     INIT_BUFFERTAG(new_tag, smgr->smgr_rnode.node, fork_num, block_num);
@@ -2281,6 +2354,16 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
     new_hash = BufTableHashCode(&new_tag);
     new_partition_lock = BufMappingPartitionLock(new_hash);
 
+    /* resident and valid pages can usually be found without the mapping lock */
+    if (t_thrd.storage_cxt.SharedBufHint != NULL) {
+        buf = BufferAllocLockFree(&new_tag, new_hash, strategy);
+        if (buf != NULL) {
+            StrategyRecordHit(buf);
+            *found = TRUE;
+            return buf;
+        }
+    }
+
     /* see if the block is in the buffer pool already */
     (void)LWLockAcquire(new_partition_lock, LW_SHARED);
     pgstat_report_waitevent(WAIT_EVENT_BUF_HASH_SEARCH);
@@ -2295,6 +2378,7 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
         buf = GetBufferDescriptor(buf_id);
 
         valid = PinBuffer(buf, strategy);
+        StrategyRecordHit(buf);
 
         /* Can release the mapping lock as soon as we've pinned it */
         LWLockRelease(new_partition_lock);
@@ -2488,6 +2572,7 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
             buf = GetBufferDescriptor(buf_id);
 
             valid = PinBuffer(buf, strategy);
+            StrategyRecordHit(buf);
 
             /* Can release the mapping lock as soon as we've pinned it */
             LWLockRelease(new_partition_lock);
@@ -2545,7 +2630,8 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
      * Clearing BM_VALID here is necessary, clearing the dirtybits is just
      * paranoia.  We also reset the usage_count since any recency of use of
      * the old content is no longer relevant.  (The usage_count starts out at
-     * 1 so that the buffer can survive one clock-sweep pass.)
+     * 1 so that the buffer can survive one clock-sweep pass; under the 2Q
+     * policy a page evicted only recently may start out protected instead.)
      *
      * Make sure BM_PERMANENT is set for buffers that must be written at every
      * checkpoint.  Unlogged buffers only need to be written at shutdown
@@ -2553,13 +2639,14 @@ static BufferDesc *BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
      * just like permanent relations.
      */
     ((BufferDesc *)buf)->tag = new_tag;
+    usage_count = StrategyReplaceBuffer(buf_state, (old_flags & BM_TAG_VALID) ? old_hash : 0, new_hash);
     buf_state &= ~(BM_VALID | BM_DIRTY | BM_JUST_DIRTIED | BM_CHECKPOINT_NEEDED | BM_IO_ERROR | BM_PERMANENT |
                    BUF_USAGECOUNT_MASK);
     if (relpersistence == RELPERSISTENCE_PERMANENT || fork_num == INIT_FORKNUM ||
         ((relpersistence == RELPERSISTENCE_TEMP) && STMT_RETRY_ENABLED)) {
-        buf_state |= BM_TAG_VALID | BM_PERMANENT | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | BM_PERMANENT | usage_count;
     } else {
-        buf_state |= BM_TAG_VALID | BUF_USAGECOUNT_ONE;
+        buf_state |= BM_TAG_VALID | usage_count;
     }
 
     UnlockBufHdr(buf, buf_state);
@@ -5903,6 +5990,9 @@ void IssuePendingWritebacks(WritebackContext *context)
         smgrwriteback(reln, tag.forkNum, tag.blockNum, nblocks);
     }
 
+    /* with io_uring the writebacks above were only queued, start them all at once */
+    FileSubmitPendingIO();
+
     context->nr_pending = 0;
 }
 
@@ -6040,9 +6130,16 @@ void ckpt_flush_dirty_page(int thread_id, WritebackContext wb_context)
     int buf_id;
     BufferDesc* buf_desc = NULL;
     uint32 buf_state;
+    PageWriterProc* pgwr = &g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id];
+
+    /* double write this thread's part of the batch to its own dw file first */
+    pgwr->thrd_dw_cxt.dw_page_idx = -1;
+    if (pgwr->end_loc >= pgwr->start_loc) {
+        dw_perform_batch_flush(pgwr->end_loc - pgwr->start_loc + 1,
+            g_instance.ckpt_cxt_ctl->CkptBufferIds + pgwr->start_loc, &pgwr->thrd_dw_cxt);
+    }
 
-    for (i = g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].start_loc;
-         i <= g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].end_loc; i++) {
+    for (i = pgwr->start_loc; i <= pgwr->end_loc; i++) {
         buf_id = g_instance.ckpt_cxt_ctl->CkptBufferIds[i].buf_id;
         if (buf_id == DW_INVALID_BUFFER_ID) {
             continue;
@@ -6064,8 +6161,9 @@ void ckpt_flush_dirty_page(int thread_id, WritebackContext wb_context)
         }
     }
 
-    g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].need_flush = false;
-    g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].actual_flush_num = actual_written;
+    pgwr->thrd_dw_cxt.dw_page_idx = -1;
+    pgwr->need_flush = false;
+    pgwr->actual_flush_num = actual_written;
     (void)pg_atomic_fetch_sub_u32(&g_instance.ckpt_cxt_ctl->page_writer_procs.running_num, 1);
     smgrcloseall();
 }
@@ -30,6 +30,38 @@
 
 #define INT_ACCESS_ONCE(var) ((int)(*((volatile int *)&(var))))
 
+/*
+ * 2Q replacement (buffer_replacement_policy = 2q).
+ *
+ * A buffer whose usage_count is below BUF_USAGE_PROTECTED has not been hit
+ * again since it was read in, and is on the probation queue; the next hit
+ * promotes it to the protected queue.  Victims are only taken from probation,
+ * so pages touched once by big scans or vacuum recycle among themselves instead
+ * of pushing out the frequently used ones.  Protected buffers are aged back
+ * toward probation only while they make up more than STRATEGY_PROTECTED_PERCENT
+ * of the unpinned buffers the sweeps pass over.  Finally, the hash codes of
+ * pages evicted from probation are kept in a small ghost table, and a page that
+ * is read back while still remembered there starts out protected.
+ */
+#define BUF_USAGE_PROTECTED 2
+#define STRATEGY_PROTECTED_PERCENT 75
+#define STRATEGY_STAT_SLOTS 64
+
+/* hit and eviction counters, striped over cache lines to keep the hit path cheap */
+typedef struct BufferStrategyStatSlot {
+    pg_atomic_uint64 probationHits;
+    pg_atomic_uint64 protectedHits;
+    pg_atomic_uint64 ghostHits;
+    pg_atomic_uint64 misses;
+    pg_atomic_uint64 probationEvictions;
+    pg_atomic_uint64 protectedEvictions;
+} BufferStrategyStatSlot;
+
+typedef union BufferStrategyStatSlotPadded {
+    BufferStrategyStatSlot slot;
+    char pad[PG_CACHE_LINE_SIZE];
+} BufferStrategyStatSlotPadded;
+
 /*
  * The shared freelist control information.
  */
@@ -56,6 +88,18 @@ typedef struct BufferStrategyControl {
      * StrategyNotifyBgWriter.
      */
     int bgwprocno;
+
+    /*
+     * 2Q state, unused under the clock policy.  Sweeps report the unpinned
+     * buffers they pass over; once a window of NBuffers of them is complete,
+     * the share that was protected is published in protectedPercent.
+     */
+    pg_atomic_uint32 sweepVisited;
+    pg_atomic_uint32 sweepProtected;
+    pg_atomic_uint32 protectedPercent;
+    uint32 ghostMask;
+    pg_atomic_uint32 *ghostHashes;      /* hash codes of pages recently evicted from probation */
+    BufferStrategyStatSlotPadded *stats; /* STRATEGY_STAT_SLOTS counter slots */
 } BufferStrategyControl;
 
 typedef struct {
@@ -79,6 +123,162 @@ void PageListBackWrite(uint32* bufList, int32 n,
     int32* bufs_reusable = NULL);     /* opt reusable count returned */
 static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, uint32* buf_state);
 
+#define STRATEGY_USE_2Q() (g_instance.attr.attr_storage.buffer_replacement_policy == BUFFER_POLICY_2Q)
+
+/* Ghost table size: a slot for every other buffer, rounded up to a power of 2 */
+static uint32 StrategyGhostSize(void)
+{
+    uint32 size = 1;
+
+    while (size < (uint32)g_instance.attr.attr_storage.NBuffers / 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static inline BufferStrategyStatSlot *StrategyStatSlot(void)
+{
+    int slot = (t_thrd.proc != NULL) ? t_thrd.proc->pgprocno : 0;
+
+    return &t_thrd.storage_cxt.StrategyControl->stats[slot % STRATEGY_STAT_SLOTS].slot;
+}
+
+/*
+ * StrategyBufferIsCandidate -- may this unpinned buffer be replaced?
+ *
+ * Under the clock policy any unpinned buffer may.  Under 2Q only probation
+ * buffers may; a protected buffer is passed over, and aged by one step if the
+ * protected queue has outgrown its share.  Caller holds the buffer header lock
+ * and must store *buf_state when releasing it.  The visit is counted in *sweep
+ * for a later StrategyReportSweep().
+ */
+bool StrategyBufferIsCandidate(uint32 *buf_state, StrategySweepStats *sweep)
+{
+    if (!STRATEGY_USE_2Q()) {
+        return true;
+    }
+
+    sweep->visited++;
+    if (BUF_STATE_GET_USAGECOUNT(*buf_state) < BUF_USAGE_PROTECTED) {
+        return true;
+    }
+
+    sweep->protected_seen++;
+    if (pg_atomic_read_u32(&t_thrd.storage_cxt.StrategyControl->protectedPercent) > STRATEGY_PROTECTED_PERCENT) {
+        *buf_state -= BUF_USAGECOUNT_ONE;
+    }
+    return false;
+}
+
+/*
+ * StrategyReportSweep -- add the buffers a sweep passed over to the current
+ *		measurement window, and publish the protected share once it is full.
+ */
+void StrategyReportSweep(const StrategySweepStats *sweep)
+{
+    BufferStrategyControl *ctl = t_thrd.storage_cxt.StrategyControl;
+    uint32 visited;
+    uint32 protected_seen;
+
+    if (sweep->visited == 0) {
+        return;
+    }
+
+    (void)pg_atomic_fetch_add_u32(&ctl->sweepProtected, sweep->protected_seen);
+    visited = pg_atomic_add_fetch_u32(&ctl->sweepVisited, sweep->visited);
+    if (visited < (uint32)g_instance.attr.attr_storage.NBuffers) {
+        return;
+    }
+
+    /* the window is full; whoever resets it publishes the result */
+    if (pg_atomic_compare_exchange_u32(&ctl->sweepVisited, &visited, 0)) {
+        protected_seen = pg_atomic_exchange_u32(&ctl->sweepProtected, 0);
+        pg_atomic_write_u32(&ctl->protectedPercent, (uint32)Min((uint64)protected_seen * 100 / visited, 100));
+    }
+}
+
+/*
+ * StrategyRecordHit -- count a hit on a buffer we just pinned, by the queue it was on.
+ */
+void StrategyRecordHit(BufferDesc *buf)
+{
+    uint32 buf_state;
+
+    if (!STRATEGY_USE_2Q()) {
+        return;
+    }
+
+    /* pinning already bumped the usage count, so a probation buffer now shows at most BUF_USAGE_PROTECTED */
+    buf_state = pg_atomic_read_u32(&buf->state);
+    if (BUF_STATE_GET_USAGECOUNT(buf_state) <= BUF_USAGE_PROTECTED) {
+        (void)pg_atomic_fetch_add_u64(&StrategyStatSlot()->probationHits, 1);
+    } else {
+        (void)pg_atomic_fetch_add_u64(&StrategyStatSlot()->protectedHits, 1);
+    }
+}
+
+/*
+ * StrategyReplaceBuffer -- note that a victim buffer is being given to a new page.
+ *
+ * old_buf_state is the victim's state before it is renamed; old_hash is only
+ * looked at if it had BM_TAG_VALID.  Returns the usage count bits the new page
+ * should start with: under 2Q, a page still remembered in the ghost table goes
+ * straight to the protected queue.  Called with the buffer header lock held.
+ */
+uint32 StrategyReplaceBuffer(uint32 old_buf_state, uint32 old_hash, uint32 new_hash)
+{
+    BufferStrategyControl *ctl = t_thrd.storage_cxt.StrategyControl;
+    BufferStrategyStatSlot *stats = NULL;
+
+    if (!STRATEGY_USE_2Q()) {
+        return BUF_USAGECOUNT_ONE;
+    }
+
+    stats = StrategyStatSlot();
+    if (old_buf_state & BM_TAG_VALID) {
+        if (BUF_STATE_GET_USAGECOUNT(old_buf_state) < BUF_USAGE_PROTECTED) {
+            pg_atomic_write_u32(&ctl->ghostHashes[old_hash & ctl->ghostMask], old_hash);
+            (void)pg_atomic_fetch_add_u64(&stats->probationEvictions, 1);
+        } else {
+            (void)pg_atomic_fetch_add_u64(&stats->protectedEvictions, 1);
+        }
+    }
+
+    if (pg_atomic_read_u32(&ctl->ghostHashes[new_hash & ctl->ghostMask]) == new_hash) {
+        (void)pg_atomic_fetch_add_u64(&stats->ghostHits, 1);
+        return BUF_USAGECOUNT_ONE * BUF_USAGE_PROTECTED;
+    }
+
+    (void)pg_atomic_fetch_add_u64(&stats->misses, 1);
+    return BUF_USAGECOUNT_ONE;
+}
+
+/*
+ * StrategyGetStats -- sum up the 2Q counters for monitoring.
+ */
+void StrategyGetStats(BufferStrategyStats *stats)
+{
+    BufferStrategyControl *ctl = t_thrd.storage_cxt.StrategyControl;
+    errno_t rc = memset_s(stats, sizeof(BufferStrategyStats), 0, sizeof(BufferStrategyStats));
+    securec_check(rc, "\0", "\0");
+
+    if (ctl->stats == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < STRATEGY_STAT_SLOTS; i++) {
+        BufferStrategyStatSlot *slot = &ctl->stats[i].slot;
+
+        stats->probation_hits += pg_atomic_read_u64(&slot->probationHits);
+        stats->protected_hits += pg_atomic_read_u64(&slot->protectedHits);
+        stats->ghost_hits += pg_atomic_read_u64(&slot->ghostHits);
+        stats->misses += pg_atomic_read_u64(&slot->misses);
+        stats->probation_evictions += pg_atomic_read_u64(&slot->probationEvictions);
+        stats->protected_evictions += pg_atomic_read_u64(&slot->protectedEvictions);
+    }
+    stats->protected_percent = pg_atomic_read_u32(&ctl->protectedPercent);
+}
+
 static void perform_delay(StrategyDelayStatus *status)
 {
     if (++(status->retry_times) > MAX_RETRY_TIMES &&
@@ -185,6 +385,8 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
     bool am_standby = RecoveryInProgress();
     StrategyDelayStatus retry_lock_status = { 0, 0 };
     StrategyDelayStatus retry_buf_status = { 0, 0 };
+    StrategySweepStats sweep = { 0, 0 };
+    bool take_protected = !STRATEGY_USE_2Q();
 
     /*
      * If given a strategy object, see whether it can select a buffer. We
@@ -266,13 +468,33 @@ retry:
         retry_lock_status.retry_times = 0;
         if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
             (backend_can_flush_dirty_page() || !(local_buf_state & BM_DIRTY))) {
+            if (!take_protected && !StrategyBufferIsCandidate(&local_buf_state, &sweep)) {
+                /*
+                 * Protected under 2Q, pass it over.  If a whole lap turns up
+                 * nothing else, settle for protected buffers after all.
+                 */
+                UnlockBufHdr(buf, local_buf_state);
+                if (--try_counter == 0) {
+                    take_protected = true;
+                    try_counter = max_buffer_can_use;
+                }
+                continue;
+            }
+
             /* Found a usable buffer */
             if (strategy != NULL)
                 AddBufferToRing(strategy, buf);
             *buf_state = local_buf_state;
             (void)pg_atomic_fetch_add_u64(&g_instance.bgwriter_cxt.get_buf_num_clock_sweep, 1);
+            StrategyReportSweep(&sweep);
             return buf;
-        } else if (--try_counter == 0) {
+        } else if (--try_counter == 0 && !take_protected) {
+            /* a whole lap found only pinned and protected buffers, so widen the search */
+            UnlockBufHdr(buf, local_buf_state);
+            take_protected = true;
+            try_counter = max_buffer_can_use;
+            continue;
+        } else if (try_counter == 0) {
             /*
              * We've scanned all the buffers without making any state changes,
              * so all the buffers are pinned (or were when we looked at them).
@@ -382,6 +604,13 @@ Size StrategyShmemSize(void)
     /* size of the shared replacement strategy control block */
     size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+    /* 2Q ghost table and counters */
+    if (STRATEGY_USE_2Q()) {
+        size = add_size(size, MAXALIGN(mul_size(StrategyGhostSize(), sizeof(pg_atomic_uint32))));
+        size = add_size(size, mul_size(STRATEGY_STAT_SLOTS, sizeof(BufferStrategyStatSlotPadded)));
+        size = add_size(size, PG_CACHE_LINE_SIZE);
+    }
+
     return size;
 }
 
@@ -430,6 +659,40 @@ void StrategyInitialize(bool init)
 
         /* No pending notification */
         t_thrd.storage_cxt.StrategyControl->bgwprocno = -1;
+
+        /* 2Q state; protected buffers are not aged until a window has been measured */
+        pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->sweepVisited, 0);
+        pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->sweepProtected, 0);
+        pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->protectedPercent, 0);
+        t_thrd.storage_cxt.StrategyControl->ghostMask = 0;
+        t_thrd.storage_cxt.StrategyControl->ghostHashes = NULL;
+        t_thrd.storage_cxt.StrategyControl->stats = NULL;
+
+        if (STRATEGY_USE_2Q()) {
+            uint32 ghost_size = StrategyGhostSize();
+            bool found_ghost = false;
+            bool found_stats = false;
+            BufferStrategyStatSlotPadded *stats = NULL;
+
+            t_thrd.storage_cxt.StrategyControl->ghostHashes = (pg_atomic_uint32 *)ShmemInitStruct(
+                "Buffer Strategy Ghost Table", ghost_size * sizeof(pg_atomic_uint32), &found_ghost);
+            for (uint32 i = 0; i < ghost_size; i++) {
+                pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->ghostHashes[i], 0);
+            }
+            t_thrd.storage_cxt.StrategyControl->ghostMask = ghost_size - 1;
+
+            stats = (BufferStrategyStatSlotPadded *)CACHELINEALIGN(ShmemInitStruct("Buffer Strategy Statistics",
+                STRATEGY_STAT_SLOTS * sizeof(BufferStrategyStatSlotPadded) + PG_CACHE_LINE_SIZE, &found_stats));
+            for (int i = 0; i < STRATEGY_STAT_SLOTS; i++) {
+                pg_atomic_init_u64(&stats[i].slot.probationHits, 0);
+                pg_atomic_init_u64(&stats[i].slot.protectedHits, 0);
+                pg_atomic_init_u64(&stats[i].slot.ghostHits, 0);
+                pg_atomic_init_u64(&stats[i].slot.misses, 0);
+                pg_atomic_init_u64(&stats[i].slot.probationEvictions, 0);
+                pg_atomic_init_u64(&stats[i].slot.protectedEvictions, 0);
+            }
+            t_thrd.storage_cxt.StrategyControl->stats = stats;
+        }
     } else {
         Assert(!init);
     }
@@ -673,6 +936,11 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
 
             if (g_instance.bgwriter_cxt.candidate_free_map[buf_id]) {
                 g_instance.bgwriter_cxt.candidate_free_map[buf_id] = false;
+                /* under 2Q, drop candidates that have been promoted since the bgwriter pushed them */
+                if (STRATEGY_USE_2Q() && BUF_STATE_GET_USAGECOUNT(local_buf_state) >= BUF_USAGE_PROTECTED) {
+                    UnlockBufHdr(buf, local_buf_state);
+                    continue;
+                }
                 if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 && !(local_buf_state & BM_DIRTY)) {
                     if (strategy != NULL) {
                         AddBufferToRing(strategy, buf);
@@ -699,7 +967,8 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
             buf_id = candidate_dirty_list[i];
             buf = GetBufferDescriptor(buf_id);
             local_buf_state = LockBufHdr(buf);
-            if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0) {
+            if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
+                (!STRATEGY_USE_2Q() || BUF_STATE_GET_USAGECOUNT(local_buf_state) < BUF_USAGE_PROTECTED)) {
                 if (strategy != NULL) {
                     AddBufferToRing(strategy, buf);
                 }
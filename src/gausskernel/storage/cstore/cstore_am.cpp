@@ -49,6 +49,7 @@
 #include "access/heapam.h"
 #include "access/sysattr.h"
 #include "executor/instrument.h"
+#include "executor/execRuntimeFilter.h"
 #include "utils/date.h"
 #include "utils/rel.h"
 #include "utils/rel_gs.h"
@@ -1183,6 +1184,56 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
     return hitCU;
 }
 
+static Datum RuntimeFilterCUValue(Oid atttype, const char* val)
+{
+    switch (atttype) {
+        case INT2OID:
+            return Int16GetDatum(*(int16*)val);
+        case INT4OID:
+            return Int32GetDatum(*(int32*)val);
+        default:
+            return Int64GetDatum(*(int64*)val);
+    }
+}
+
+/*
+ * @Description: cudesc rough check against the bloom filters pushed down from the hash joins above
+ * @Param[IN] state: cstore scan state
+ * @Param[IN] cuDescIdx: index of load cudesc info
+ * @Return: true--hit, false--not hit
+ * @See also: ExecRuntimeFilterMinMax
+ */
+bool CStore::RuntimeFilterRoughCheck(CStoreScanState* state, int cuDescIdx)
+{
+    ScanRuntimeFilter* rtf = state->ss_runtimeFilter;
+
+    for (int i = 0; i < rtf->nfilters; i++) {
+        Oid atttype = rtf->atttypes[i];
+
+        if (rtf->filters[i] == NULL || !(atttype == INT2OID || atttype == INT4OID || atttype == INT8OID)) {
+            continue;
+        }
+
+        for (int j = 0; j < m_colNum; j++) {
+            if (m_colId[j] != rtf->attnos[i] - 1) {
+                continue;
+            }
+
+            /* rows with a NULL key are left to the join */
+            CUDesc* cudesc = &(m_CUDescInfo[j]->cuDescArray[cuDescIdx]);
+            if (cudesc->IsNullCU() || cudesc->IsNoMinMaxCU() || cudesc->CUHasNull()) {
+                break;
+            }
+            if (!ExecRuntimeFilterMinMax(rtf->filters[i], atttype, RuntimeFilterCUValue(atttype, cudesc->cu_min),
+                RuntimeFilterCUValue(atttype, cudesc->cu_max))) {
+                return false;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1190,6 +1241,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     PlanState* planstate = (PlanState*)state;
     uint32 curLoadNum;
     uint32 lastLoadNum;
+    bool hasRuntimeFilter = false;
 
     // m_needRCheck is true means these CUs alreay done the rough check
     // m_colNum == 0 means not have normal columns
@@ -1197,7 +1249,10 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    hasRuntimeFilter = state->ss_runtimeFilter != NULL && m_colNum != 0 &&
+                       ExecScanRuntimeFilterReady((ScanState*)state);
+
+    if (likely(((nkeys == 0 || scanKey == NULL) && !hasRuntimeFilter) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1224,6 +1279,9 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     curLoadNum = m_CUDescInfo[0]->curLoadNum;
     for (int i = (int)lastLoadNum; i != (int)curLoadNum; IncLoadCuDescIdx(i), IncLoadCuDescIdx(cudesc_idx_tmp)) {
         hitCU = RoughCheck(scanKey, nkeys, i);
+        if (hitCU && hasRuntimeFilter) {
+            hitCU = RuntimeFilterRoughCheck(state, i);
+        }
         if (hitCU) {
             // fliter CU not hit
             ADIO_RUN()
@@ -1243,7 +1301,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
             RCInfo* rcPtr = &(planstate->instrument->rcInfo);
 
             if (!hitCU) {
-                int seq = scanKey[0].cs_attno;
+                int seq = (nkeys > 0) ? scanKey[0].cs_attno : 0;
                 CUDesc *cudesc = &(m_CUDescInfo[seq]->cuDescArray[i]);
                 planstate->instrument->nfiltered1 += cudesc->row_count;
 
@@ -83,6 +83,7 @@
 #include "storage/vfd.h"
 #include "storage/ipc.h"
 #include "storage/shmem.h"
+#include "storage/uring.h"
 #include "threadpool/threadpool.h"
 #include "utils/guc.h"
 #include "utils/plog.h"
@@ -1133,6 +1134,9 @@ static void DataFileIdCloseFile(Vfd* vfdP)
 {
     DataFileIdCacheEntry* entry = NULL;
 
+    /* queued io_uring requests may still refer to this fd, hand them to the kernel first */
+    UringSubmitPending();
+
     /*
      * Do not use thread-share fd cache when:
      *  1. vfd is not in fd cache;
@@ -1666,6 +1670,12 @@ int FilePrefetch(File file, off_t offset, int amount, uint32 wait_event_info)
     if (returnCode < 0)
         return returnCode;
 
+    /* with io_uring the hint is queued, and submitted together with the following ones */
+    FileIORequest req = {FILE_IO_PREFETCH, file, u_sess->storage_cxt.VfdCache[file].fd, NULL, offset, amount, 0, 0};
+    if (UringQueue(&req, false)) {
+        return 0;
+    }
+
     pgstat_report_waitevent(wait_event_info);
     returnCode = posix_fadvise(u_sess->storage_cxt.VfdCache[file].fd, offset, amount, POSIX_FADV_WILLNEED);
     pgstat_report_waitevent(WAIT_EVENT_END);
@@ -1701,6 +1711,12 @@ void FileWriteback(File file, off_t offset, off_t nbytes)
     if (returnCode < 0)
         return;
 
+    /* with io_uring the flush is queued, and submitted together with the following ones */
+    FileIORequest req = {FILE_IO_WRITEBACK, file, u_sess->storage_cxt.VfdCache[file].fd, NULL, offset, nbytes, 0, 0};
+    if (u_sess->attr.attr_storage.enableFsync && UringQueue(&req, false)) {
+        return;
+    }
+
     pg_flush_data(u_sess->storage_cxt.VfdCache[file].fd, offset, nbytes);
 }
 
@@ -1773,6 +1789,102 @@ retry:
     return returnCode;
 }
 
+/* Execute one request of a batch with the plain system call */
+static void FileIOExecute(FileIORequest* req)
+{
+    errno = 0;
+    switch (req->type) {
+        case FILE_IO_READ:
+            do {
+                req->result = (int)pread(req->fd, req->buffer, (size_t)req->amount, req->offset);
+            } while (req->result < 0 && errno == EINTR);
+            break;
+        case FILE_IO_WRITE:
+            do {
+                req->result = (int)pwrite(req->fd, req->buffer, (size_t)req->amount, req->offset);
+            } while (req->result < 0 && errno == EINTR);
+            break;
+        case FILE_IO_FSYNC:
+            req->result = pg_fsync(req->fd);
+            break;
+        case FILE_IO_WRITEBACK:
+            pg_flush_data(req->fd, req->offset, req->amount);
+            req->result = 0;
+            break;
+        case FILE_IO_PREFETCH:
+#if defined(USE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+            req->result = posix_fadvise(req->fd, req->offset, req->amount, POSIX_FADV_WILLNEED);
+#else
+            req->result = 0;
+#endif
+            break;
+        default:
+            ereport(ERROR, (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                            errmsg("unrecognized file I/O request type %d", (int)req->type)));
+    }
+    req->error = (req->result < 0) ? errno : 0;
+}
+
+/*
+ * FileBatchIO
+ *		Perform a batch of reads, writes, fsyncs or flushes on virtual files.
+ *
+ * With enable_uring_io the fsyncs and flushes of the batch are handed to io_uring in as
+ * few system calls as the queue depth allows, and overlap. Reads and writes, and every
+ * request without io_uring, are executed one after another. Either way, every request has completed on return, with
+ * its outcome in result and error. Short reads and writes are not retried.
+ */
+void FileBatchIO(FileIORequest* reqs, int count, uint32 wait_event_info)
+{
+    bool useUring = UringEnabled();
+
+    pgstat_report_waitevent(wait_event_info);
+    PGSTAT_INIT_TIME_RECORD();
+    PGSTAT_START_TIME_RECORD();
+    PG_TRY();
+    {
+        for (int i = 0; i < count; i++) {
+            FileIORequest* req = &reqs[i];
+
+            Assert(FileIsValid(req->file));
+            DO_DB(ereport(LOG, (errmsg("FileBatchIO: %d (%s) type %d " INT64_FORMAT " " INT64_FORMAT, req->file,
+                                       u_sess->storage_cxt.VfdCache[req->file].fileName, (int)req->type,
+                                       (int64)req->offset, (int64)req->amount))));
+
+            if (FileAccess(req->file) < 0) {
+                req->result = -1;
+                req->error = errno;
+                continue;
+            }
+            req->fd = u_sess->storage_cxt.VfdCache[req->file].fd;
+
+            if (!useUring || !UringQueue(req, true)) {
+                FileIOExecute(req);
+            }
+        }
+        UringWaitAll();
+    }
+    PG_CATCH();
+    {
+        /* the kernel reports completions into reqs, which is gone once we unwind */
+        UringWaitAll();
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+    PGSTAT_END_TIME_RECORD(DATA_IO_TIME);
+    pgstat_report_waitevent(WAIT_EVENT_END);
+}
+
+/*
+ * FileSubmitPendingIO
+ *		Submit the writeback and prefetch requests queued by FileWriteback() and
+ *		FilePrefetch(), without waiting for them. No-op without io_uring.
+ */
+void FileSubmitPendingIO(void)
+{
+    UringSubmitPending();
+}
+
 int FileWrite(File file, const char* buffer, int amount, off_t offset)
 {
     int returnCode;
@@ -1936,6 +2048,46 @@ retry:
     return returnCode;
 }
 
+/*
+ * FileFallocate
+ *		Allocate zero-filled disk space for [offset, offset + amount) with a single
+ *		fallocate() call, extending the file if needed.
+ *
+ * Returns 0 on success. On failure returns -1 with errno set, and the caller is
+ * expected to fall back to writing zeroes (e.g. EOPNOTSUPP on filesystems that
+ * can't preallocate).
+ */
+int FileFallocate(File file, off_t offset, off_t amount, uint32 wait_event_info)
+{
+    int returnCode;
+
+    Assert(FileIsValid(file));
+
+    DO_DB(ereport(LOG,
+                  (errmsg("FileFallocate: %d (%s) " INT64_FORMAT " " INT64_FORMAT,
+                          file,
+                          u_sess->storage_cxt.VfdCache[file].fileName,
+                          (int64)offset,
+                          (int64)amount))));
+
+    returnCode = FileAccess(file);
+    if (returnCode < 0)
+        return returnCode;
+
+retry:
+    pgstat_report_waitevent(wait_event_info);
+    returnCode = fallocate(u_sess->storage_cxt.VfdCache[file].fd, 0, offset, amount);
+    pgstat_report_waitevent(WAIT_EVENT_END);
+
+    if (returnCode != 0 && errno == EINTR)
+        goto retry;
+
+    /* the file may have grown, so we no longer know where its end is */
+    u_sess->storage_cxt.VfdCache[file].seekPos = FileUnknownPos;
+
+    return returnCode;
+}
+
 template <typename dlistType>
 static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dListCount)
 {
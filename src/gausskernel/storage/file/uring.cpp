@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * uring.cpp
+ *        io_uring submission layer beneath the virtual file descriptors of fd.cpp
+ *
+ * The ring is driven through the raw io_uring_setup/io_uring_enter/io_uring_register
+ * system calls, so no user space library is needed. If the kernel does not support
+ * io_uring, or the ring cannot be created, UringEnabled() returns false and callers
+ * fall back to the synchronous system calls.
+ *
+ * Only fsyncs, writeback flushes and prefetch hints go through the ring. Reads and
+ * writes are refused by UringQueue(), so callers execute them synchronously.
+ *
+ * Queued requests refer to kernel fds. The kernel only takes its own reference on the
+ * file when the request is submitted, so fd.cpp calls UringSubmitPending() before it
+ * closes a kernel fd.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/file/uring.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "miscadmin.h"
+#include "storage/barrier.h"
+#include "storage/ipc.h"
+#include "storage/uring.h"
+#include "utils/memutils.h"
+
+#ifdef USE_URING
+#include <linux/io_uring.h>
+
+typedef struct UringContext {
+    int ringFd;
+
+    /* submission queue */
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned sqEntries;
+    struct io_uring_sqe* sqes;
+    unsigned sqLocalTail; /* sqes filled in but not yet published to the kernel */
+
+    /* completion queue */
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    unsigned cqEntries;
+    struct io_uring_cqe* cqes;
+
+    /* mappings, kept for munmap() */
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+
+    unsigned toSubmit; /* requests published to the submission queue, not yet entered */
+    unsigned inflight; /* requests queued or submitted, not yet completed */
+} UringContext;
+
+static int uring_setup(unsigned entries, struct io_uring_params* params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static int uring_register(int ringFd, unsigned opcode, const void* arg, unsigned nrArgs)
+{
+    return (int)syscall(__NR_io_uring_register, ringFd, opcode, arg, nrArgs);
+}
+
+static void UringDestroy(UringContext* ring)
+{
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        (void)munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqRing != NULL && ring->cqRing != MAP_FAILED && ring->cqRing != ring->sqRing) {
+        (void)munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != NULL && ring->sqRing != MAP_FAILED) {
+        (void)munmap(ring->sqRing, ring->sqRingSize);
+    }
+    if (ring->ringFd >= 0) {
+        (void)close(ring->ringFd);
+    }
+    pfree(ring);
+}
+
+static void UringAtExit(int code, Datum arg)
+{
+    UringContext* ring = t_thrd.storage_cxt.UringCxt;
+
+    if (ring != NULL) {
+        t_thrd.storage_cxt.UringCxt = NULL;
+        UringDestroy(ring);
+    }
+}
+
+/* The ring is only used if the kernel supports every operation that can be queued on it */
+static bool UringProbeOps(const UringContext* ring)
+{
+    static const int requiredOps[] = {IORING_OP_FSYNC, IORING_OP_SYNC_FILE_RANGE, IORING_OP_FADVISE};
+    Size probeSize = sizeof(struct io_uring_probe) + IORING_OP_LAST * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*)palloc0(probeSize);
+    bool supported = (uring_register(ring->ringFd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) == 0);
+
+    for (size_t i = 0; supported && i < lengthof(requiredOps); i++) {
+        supported = (requiredOps[i] <= probe->last_op) && (probe->ops[requiredOps[i]].flags & IO_URING_OP_SUPPORTED);
+    }
+    pfree(probe);
+    return supported;
+}
+
+static UringContext* UringCreate(void)
+{
+    struct io_uring_params params;
+    errno_t rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    UringContext* ring = (UringContext*)MemoryContextAllocZero(
+        THREAD_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE), sizeof(UringContext));
+    ring->ringFd = uring_setup((unsigned)g_instance.attr.attr_storage.uring_queue_depth, &params);
+    if (ring->ringFd < 0) {
+        ereport(LOG, (errmsg("could not create io_uring instance, using synchronous I/O: %m")));
+        pfree(ring);
+        return NULL;
+    }
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sqRingSize = Max(ring->sqRingSize, ring->cqRingSize);
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFd,
+        IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED) {
+        goto fail;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cqRing = ring->sqRing;
+    } else {
+        ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFd,
+            IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED) {
+            goto fail;
+        }
+    }
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring->ringFd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        goto fail;
+    }
+
+    ring->sqHead = (unsigned*)((char*)ring->sqRing + params.sq_off.head);
+    ring->sqTail = (unsigned*)((char*)ring->sqRing + params.sq_off.tail);
+    ring->sqMask = (unsigned*)((char*)ring->sqRing + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned*)((char*)ring->sqRing + params.sq_off.array);
+    ring->sqEntries = params.sq_entries;
+    ring->sqLocalTail = *ring->sqTail;
+
+    ring->cqHead = (unsigned*)((char*)ring->cqRing + params.cq_off.head);
+    ring->cqTail = (unsigned*)((char*)ring->cqRing + params.cq_off.tail);
+    ring->cqMask = (unsigned*)((char*)ring->cqRing + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)((char*)ring->cqRing + params.cq_off.cqes);
+    ring->cqEntries = params.cq_entries;
+
+    if (!UringProbeOps(ring)) {
+        ereport(LOG, (errmsg("kernel io_uring lacks required operations, using synchronous I/O")));
+        UringDestroy(ring);
+        return NULL;
+    }
+
+    on_proc_exit(UringAtExit, 0);
+
+    ereport(DEBUG1, (errmsg("created io_uring instance with %u entries", ring->sqEntries)));
+    return ring;
+
+fail:
+    ereport(LOG, (errmsg("could not map io_uring queues, using synchronous I/O: %m")));
+    UringDestroy(ring);
+    return NULL;
+}
+
+static UringContext* UringGetContext(void)
+{
+    if (!g_instance.attr.attr_storage.enable_uring_io || t_thrd.storage_cxt.UringUnavailable) {
+        return NULL;
+    }
+
+    if (t_thrd.storage_cxt.UringCxt == NULL) {
+        t_thrd.storage_cxt.UringCxt = UringCreate();
+        /* do not retry on every I/O of this thread */
+        t_thrd.storage_cxt.UringUnavailable = (t_thrd.storage_cxt.UringCxt == NULL);
+    }
+    return t_thrd.storage_cxt.UringCxt;
+}
+
+/* Consume all available completions, returns the number consumed */
+static unsigned UringReap(UringContext* ring)
+{
+    unsigned head = *ring->cqHead;
+    unsigned reaped = 0;
+
+    for (;;) {
+        pg_read_barrier();
+        if (head == *ring->cqTail) {
+            break;
+        }
+
+        struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cqMask];
+        FileIORequest* req = (FileIORequest*)(uintptr_t)cqe->user_data;
+        if (req != NULL) {
+            if (cqe->res < 0) {
+                req->result = -1;
+                req->error = -cqe->res;
+            } else {
+                req->result = cqe->res;
+                req->error = 0;
+            }
+        }
+        head++;
+        reaped++;
+    }
+
+    if (reaped > 0) {
+        pg_memory_barrier();
+        *ring->cqHead = head;
+        ring->inflight -= reaped;
+    }
+    return reaped;
+}
+
+/* Hand the published requests to the kernel, and wait until at least minComplete of them finished */
+static void UringEnter(UringContext* ring, unsigned minComplete)
+{
+    for (;;) {
+        unsigned flags = (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+        int ret = uring_enter(ring->ringFd, ring->toSubmit, minComplete, flags);
+        if (ret >= 0) {
+            ring->toSubmit -= (unsigned)ret;
+            if (ring->toSubmit == 0) {
+                return;
+            }
+            /* the kernel took only part of the batch, keep submitting */
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EBUSY) {
+            /* out of resources or completion queue full, make room and retry */
+            (void)UringReap(ring);
+            pg_usleep(1000L);
+            continue;
+        }
+        ereport(PANIC, (errmsg("io_uring_enter failed: %m")));
+    }
+}
+
+static void UringPrepare(struct io_uring_sqe* sqe, const FileIORequest* req)
+{
+    errno_t rc = memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    securec_check(rc, "\0", "\0");
+
+    sqe->fd = req->fd;
+    sqe->off = (__u64)req->offset;
+    switch (req->type) {
+        case FILE_IO_FSYNC:
+            sqe->opcode = IORING_OP_FSYNC;
+            break;
+        case FILE_IO_WRITEBACK:
+            sqe->opcode = IORING_OP_SYNC_FILE_RANGE;
+            sqe->len = (__u32)req->amount;
+            sqe->sync_range_flags = SYNC_FILE_RANGE_WRITE;
+            break;
+        case FILE_IO_PREFETCH:
+            sqe->opcode = IORING_OP_FADVISE;
+            sqe->len = (__u32)req->amount;
+            sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+            break;
+        default:
+            ereport(PANIC, (errmsg("unrecognized file I/O request type %d", (int)req->type)));
+    }
+}
+
+/*
+ * Returns true if io_uring is enabled and this thread has a ring.
+ */
+bool UringEnabled(void)
+{
+    return UringGetContext() != NULL;
+}
+
+/*
+ * Queue one request on the ring of this thread. With wait, the outcome is written to req
+ * by the UringWaitAll() that completes it, so req must stay valid until then. Without
+ * wait the request is fire-and-forget (writeback and prefetch hints) and req may be
+ * reused right away. Returns false if io_uring is not available, or for reads and writes.
+ */
+bool UringQueue(FileIORequest* req, bool wait)
+{
+    if (req->type == FILE_IO_READ || req->type == FILE_IO_WRITE) {
+        return false;
+    }
+
+    UringContext* ring = UringGetContext();
+    if (ring == NULL) {
+        return false;
+    }
+
+    /* never have more requests in flight than the completion queue can hold */
+    while (ring->inflight >= ring->cqEntries) {
+        if (UringReap(ring) == 0) {
+            UringEnter(ring, 1);
+        }
+    }
+
+    /* submission queue full, submit what we have so far */
+    if (ring->sqLocalTail - *ring->sqHead >= ring->sqEntries) {
+        UringEnter(ring, 0);
+    }
+
+    unsigned index = ring->sqLocalTail & *ring->sqMask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    UringPrepare(sqe, req);
+    sqe->user_data = wait ? (__u64)(uintptr_t)req : 0;
+    if (wait) {
+        req->result = -1;
+        req->error = EINPROGRESS;
+    }
+
+    ring->sqArray[index] = index;
+    ring->sqLocalTail++;
+    pg_write_barrier();
+    *ring->sqTail = ring->sqLocalTail;
+    ring->toSubmit++;
+    ring->inflight++;
+    return true;
+}
+
+/*
+ * Submit the queued requests of this thread without waiting for them.
+ */
+void UringSubmitPending(void)
+{
+    UringContext* ring = t_thrd.storage_cxt.UringCxt;
+
+    if (ring == NULL) {
+        return;
+    }
+    if (ring->toSubmit > 0) {
+        UringEnter(ring, 0);
+    }
+    (void)UringReap(ring);
+}
+
+/*
+ * Submit the queued requests of this thread and wait until every request in flight,
+ * including earlier fire-and-forget ones, has completed.
+ */
+void UringWaitAll(void)
+{
+    UringContext* ring = t_thrd.storage_cxt.UringCxt;
+
+    if (ring == NULL) {
+        return;
+    }
+    while (ring->inflight > 0) {
+        if (UringReap(ring) == 0) {
+            UringEnter(ring, 1);
+        }
+    }
+}
+
+#else /* !USE_URING */
+
+bool UringEnabled(void)
+{
+    return false;
+}
+
+bool UringQueue(FileIORequest* req, bool wait)
+{
+    return false;
+}
+
+void UringSubmitPending(void)
+{
+}
+
+void UringWaitAll(void)
+{
+}
+
+#endif /* USE_URING */
@@ -368,7 +368,7 @@ int NumLWLocks(void)
     numLocks += g_instance.attr.attr_storage.max_replication_slots;
 
     /* double write.c needs flush lock */
-    numLocks += 1;                              /* batch flush lock */
+    numLocks += DW_BATCH_FILE_MAX_NUM;          /* flush lock of each batch flush file */
     numLocks += NUM_DW_SINGLE_FLUSH_LOCK + 1;  /* single flush write lock and the get pos lock */
 
     /* for materialized view */
@@ -341,6 +341,11 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
         goto final;
     }
 
+    // Keys of deleted rows are built before any lock is taken, the primary key of a row never changes
+    if (m_deleteSetSize > 0 && GetGlobalConfiguration().m_enableCheckpoint) {
+        GetCheckpointManager()->PrepareDeletes(txMan);
+    }
+
     MOT_LOG_DEBUG("Validate OCC rowCnt=%u RD=%u WR=%u\n", tx->m_rowCnt, tx->m_rowCnt - m_writeSetSize, m_writeSetSize);
     rc = LockHeaders(txMan, numSentinelLock);
     if (rc != RC_OK) {
@@ -400,6 +405,7 @@ void OccTransactionManager::ApplyWrite(TxnManager* txMan)
                 GetCheckpointManager()->ApplyWrite(txMan, access->GetRowFromHeader(), access->m_type);
             }
         }
+        GetCheckpointManager()->RecordDeletes(txMan);
     }
 }
 
@@ -441,6 +447,8 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
                     access->GetTxnRow()->GetTable()->UpdateRowCount(1);
                 } else {
                     // We only set the in the secondary sentinel!
+                    access->m_origSentinel->GetIndex()->StoreCoveringData(
+                        access->m_origSentinel, access->GetRowFromHeader());
                     access->m_origSentinel->SetNextPtr(access->GetRowFromHeader()->GetPrimarySentinel());
                 }
             } else {
@@ -463,7 +471,9 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
                         Row::RowDtor,
                         ROW_SIZE_FROM_POOL(row->GetTable()));
                 } else {
-                    // Set Sentinel for
+                    // Set Sentinel for, covering data is replaced before the entry refers to the new row
+                    access->m_origSentinel->GetIndex()->StoreCoveringData(access->m_origSentinel, access->m_auxRow);
+                    COMPILER_BARRIER
                     access->m_origSentinel->SetNextPtr(access->m_auxRow->GetPrimarySentinel());
                 }
                 // upgrade should not change the reference count!
@@ -24,6 +24,8 @@
 
 #include "mm_gc_manager.h"
 #include "mot_configuration.h"
+#include "session_context.h"
+#include "string_buffer.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(GcManager, GC);
@@ -40,6 +42,71 @@ GcLock g_gcGlobalEpochLock;
 
 GcManager* GcManager::allGcManagers = nullptr;
 
+GcLatencyHistogram GcManager::m_inlineReclaimLatency;
+GcLatencyHistogram GcManager::m_backpressureReclaimLatency;
+GcLatencyHistogram GcManager::m_backgroundReclaimLatency;
+
+constexpr uint32_t GcLatencyHistogram::BUCKET_COUNT;
+
+uint64_t GcLatencyHistogram::GetCount() const
+{
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        count += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t GcLatencyHistogram::GetQuantileMicros(uint32_t permille) const
+{
+    uint64_t total = GetCount();
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = (total * permille + 999) / 1000;
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        count += m_buckets[i].load(std::memory_order_relaxed);
+        if (count >= target) {
+            return (1ULL << i);
+        }
+    }
+    return (1ULL << (BUCKET_COUNT - 1));
+}
+
+void GcLatencyHistogram::Print(const char* name, StringBuffer* stringBuffer) const
+{
+    uint64_t total = GetCount();
+    StringBufferAppend(stringBuffer,
+        "%*s%s: passes=%" PRIu64 ", p50<%" PRIu64 " us, p99<%" PRIu64 " us, p99.9<%" PRIu64 " us, max<%" PRIu64
+        " us\n",
+        PRINT_REPORT_INDENT,
+        "",
+        name,
+        total,
+        GetQuantileMicros(500),
+        GetQuantileMicros(990),
+        GetQuantileMicros(999),
+        GetQuantileMicros(1000));
+    if (total == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t count = m_buckets[i].load(std::memory_order_relaxed);
+        if (count > 0) {
+            uint64_t lowerBound = (i == 0) ? 0 : (1ULL << (i - 1));
+            StringBufferAppend(stringBuffer,
+                "%*s[%" PRIu64 ", %" PRIu64 ") us: %" PRIu64 " (%" PRIu64 "%%)\n",
+                PRINT_REPORT_INDENT * 2,
+                "",
+                lowerBound,
+                (1ULL << i),
+                count,
+                count * 100 / total);
+        }
+    }
+}
+
 inline GcManager::GcManager(GC_TYPE purpose, int getThreadId, int rcuMaxFreeCount)
     : m_rcuFreeCount(rcuMaxFreeCount), m_tid(getThreadId), m_purpose(purpose)
 {}
@@ -115,13 +182,16 @@ GcManager* GcManager::Make(GC_TYPE purpose, int threadId, int rcuMaxFreeCount)
             gc->m_limboSizeLimit = (uint32_t)cfg.m_gcReclaimThresholdBytes;
             gc->m_limboSizeLimitHigh = (uint32_t)cfg.m_gcHighReclaimThresholdBytes;
             gc->m_rcuFreeCount = cfg.m_gcReclaimBatchSize;
+            gc->m_isReclaimOffloaded = cfg.m_gcEnable && cfg.m_gcEnableBackgroundReclaim;
+            gc->m_numaNodeId = (MOTCurrentNumaNodeId == MEM_INVALID_NODE) ? 0 : (int16_t)MOTCurrentNumaNodeId;
             if (threadId == 0) {
-                MOT_LOG_INFO(
-                    "GC PARAMS: isGcEnabled = %s, limboSizeLimit = %d, limboSizeLimitHigh = %d, rcuFreeCount = %d",
+                MOT_LOG_INFO("GC PARAMS: isGcEnabled = %s, limboSizeLimit = %d, limboSizeLimitHigh = %d, "
+                             "rcuFreeCount = %d, backgroundReclaim = %s",
                     gc->m_isGcEnabled ? "true" : "false",
                     gc->m_limboSizeLimit,
                     gc->m_limboSizeLimitHigh,
-                    gc->m_rcuFreeCount);
+                    gc->m_rcuFreeCount,
+                    gc->m_isReclaimOffloaded ? "true" : "false");
             }
         }
     }
@@ -129,7 +199,7 @@ GcManager* GcManager::Make(GC_TYPE purpose, int threadId, int rcuMaxFreeCount)
     return gc;
 }
 
-void GcManager::HardQuiesce(uint32_t numOfElementsToClean)
+void GcManager::HardQuiesce(uint32_t numOfElementsToClean, GcEpochType activeEpoch)
 {
     LimboGroup* emptyHead = nullptr;
     LimboGroup* emptyTail = nullptr;
@@ -143,7 +213,7 @@ void GcManager::HardQuiesce(uint32_t numOfElementsToClean)
         m_totalLimboSizeInBytesByCleanIndex = 0;
     }
 
-    GcEpochType epochBound = g_gcActiveEpoch - 1;
+    GcEpochType epochBound = activeEpoch - 1;
     if (m_limboHead->m_head == m_limboHead->m_tail || GcSignedEpochType(epochBound - m_limboHead->FirstEpoch()) < 0)
         goto done;
 
@@ -181,6 +251,42 @@ done:
     MOT_LOG_DEBUG("threadId = %d cleaned items = %d\n", m_tid, m_rcuFreeCount - count);
 }
 
+void GcManager::OffloadedQuiesce()
+{
+    // Increase Local epoch when the threashold is reached, so the reclaimer can make progress
+    if (m_totalLimboSizeInBytes > m_limboSizeLimit) {
+        m_gcEpoch++;
+    }
+    if (m_gcEpoch > g_gcGlobalEpoch) {
+        SetGlobalEpoch(m_gcEpoch);
+    }
+    m_gcEpoch = 0;
+
+    // Back-pressure: the reclaimer does not keep up with this session, so the session pays for its own garbage
+    if (m_totalLimboSizeInBytes > m_limboSizeLimitHigh) {
+        uint64_t startTime = GetSysClock();
+        m_managerLock.lock();
+        HardQuiesce(m_totalLimboInuseElements);
+        ShrinkMem();
+        m_managerLock.unlock();
+        m_backpressureReclaimLatency.Record(CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime));
+    }
+}
+
+uint32_t GcManager::BackgroundQuiesce(GcEpochType activeEpoch)
+{
+    uint32_t inuseElements = m_totalLimboInuseElements;
+    if ((inuseElements > 0) && (m_performGcEpoch != activeEpoch)) {
+        uint64_t startTime = GetSysClock();
+        // limbo groups are reclaimed in batches so that the owning session is not held for long in GcRecordObject()
+        HardQuiesce(m_rcuFreeCount, activeEpoch);
+        m_backgroundReclaimLatency.Record(CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime));
+    }
+    uint32_t reclaimedElements = inuseElements - m_totalLimboInuseElements;
+    m_managerLock.unlock();
+    return reclaimedElements;
+}
+
 inline unsigned LimboGroup::CleanUntil(GcManager& ti, GcEpochType epochBound, unsigned count)
 {
     EpochType epoch = 0;
@@ -295,6 +401,7 @@ void GcManager::RemoveFromGcList(GcManager* n)
         head = head->m_next;
         allGcManagers = head;
         g_gcGlobalEpochLock.unlock();
+        WaitBackgroundReclaim(n);
         return;
     }
 
@@ -315,9 +422,18 @@ void GcManager::RemoveFromGcList(GcManager* n)
     // Remove node from Linked List
     prev->m_next = prev->m_next->m_next;
     g_gcGlobalEpochLock.unlock();
+    WaitBackgroundReclaim(n);
     return;
 }
 
+void GcManager::WaitBackgroundReclaim(GcManager* n)
+{
+    // Reclaimers lock managers only while they are in the list, so once the lock is acquired here no reclaimer
+    // can still be working on this manager and it can be destroyed
+    n->m_managerLock.lock();
+    n->m_managerLock.unlock();
+}
+
 void GcManager::ReportGcStats()
 {
     MOT_LOG_INFO("----------GC Thd:%d-----------\n", m_tid);
@@ -338,4 +454,19 @@ void GcManager::ReportGcAll()
         ti->ReportGcStats();
     }
 }
+
+void GcManager::ReportGcLatency(LogLevel logLevel)
+{
+    if (!MOT_CHECK_LOG_LEVEL(logLevel)) {
+        return;
+    }
+
+    StringBufferApply([logLevel](StringBuffer* stringBuffer) {
+        StringBufferAppend(stringBuffer, "GC Reclamation Latency Report:\n");
+        m_inlineReclaimLatency.Print("Inline", stringBuffer);
+        m_backpressureReclaimLatency.Print("Back-pressure", stringBuffer);
+        m_backgroundReclaimLatency.Print("Background", stringBuffer);
+        MOT_LOG(logLevel, "\n%s", stringBuffer->m_buffer);
+    });
+}
 }  // namespace MOT
@@ -25,14 +25,17 @@
 #ifndef MM_GC_MANAGER_H
 #define MM_GC_MANAGER_H
 
+#include <atomic>
 #include "global.h"
 #include "spin_lock.h"
 #include "utilities.h"
+#include "cycles.h"
 #include "memory_statistics.h"
 #include "mm_session_api.h"
 
 namespace MOT {
 class GcManager;
+struct StringBuffer;
 
 typedef uint64_t GcEpochType;
 typedef int64_t GcSignedEpochType;
@@ -135,7 +138,61 @@ struct LimboGroup {
 };
 
 static const char* const enGcTypes[] = {
-    stringify(GC_MAIN), stringify(GC_INDEX), stringify(GC_LOG), stringify(GC_CHECKPOINT)};
+    stringify(GC_MAIN), stringify(GC_INDEX), stringify(GC_LOG), stringify(GC_CHECKPOINT), stringify(GC_RECLAIMER)};
+
+/**
+ * @class GcLatencyHistogram
+ * @brief Lock-free histogram of reclamation pass latencies. Bucket zero counts passes shorter than one
+ * micro-second, and bucket i counts passes in the range [2^(i-1), 2^i) micro-seconds. The last bucket
+ * also counts all longer passes.
+ */
+class GcLatencyHistogram {
+public:
+    /** @var The number of histogram buckets. */
+    static constexpr uint32_t BUCKET_COUNT = 24;
+
+    GcLatencyHistogram()
+    {
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            m_buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Records a single reclamation pass.
+     * @param micros The pass latency in micro-seconds.
+     */
+    inline void Record(uint64_t micros)
+    {
+        uint32_t bucket = 0;
+        while ((micros > 0) && (bucket < BUCKET_COUNT - 1)) {
+            micros >>= 1;
+            ++bucket;
+        }
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** @brief Retrieves the total number of recorded passes. */
+    uint64_t GetCount() const;
+
+    /**
+     * @brief Retrieves an upper bound for the latency of the given quantile.
+     * @param permille The requested quantile in units of 0.1 percent (1-1000).
+     * @return The exclusive upper bound in micro-seconds of the bucket containing the quantile.
+     */
+    uint64_t GetQuantileMicros(uint32_t permille) const;
+
+    /**
+     * @brief Prints the histogram into a report.
+     * @param name The histogram name.
+     * @param stringBuffer The report buffer.
+     */
+    void Print(const char* name, StringBuffer* stringBuffer) const;
+
+private:
+    /** @var Pass count per bucket. */
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+};
 
 /**
  * @class GcManager
@@ -163,7 +220,7 @@ public:
     GcManager& operator=(const GcManager&) = delete;
 
     /** @var GC managers types   */
-    enum GC_TYPE : uint8_t { GC_MAIN, GC_INDEX, GC_LOG, GC_CHECKPOINT };
+    enum GC_TYPE : uint8_t { GC_MAIN, GC_INDEX, GC_LOG, GC_CHECKPOINT, GC_RECLAIMER };
 
     /** @var List of all GC Managers */
     static GcManager* allGcManagers;
@@ -202,17 +259,43 @@ public:
     /** @brief remove manager from global list   */
     void RemoveFromGcList(GcManager* ti);
 
+    /** @brief Waits until a background reclaimer is done with a manager removed from the global list */
+    static void WaitBackgroundReclaim(GcManager* n);
+
     /** @brief Print report locally   */
     void ReportGcStats();
 
     /** @brief Print report of all threads   */
     static void ReportGcAll();
 
+    /**
+     * @brief Prints the reclamation latency histograms of all GC managers.
+     * @param logLevel The log level used for printing.
+     */
+    static void ReportGcLatency(LogLevel logLevel);
+
     int GetThreadId() const
     {
         return m_tid;
     }
 
+    int GetNumaNodeId() const
+    {
+        return m_numaNodeId;
+    }
+
+    /** @brief Queries whether limbo groups of this manager are reclaimed by a background reclaimer. */
+    bool IsReclaimOffloaded() const
+    {
+        return m_isReclaimOffloaded;
+    }
+
+    /** @brief Sets whether limbo groups of this manager are reclaimed by a background reclaimer. */
+    void SetReclaimOffloaded(bool isReclaimOffloaded)
+    {
+        m_isReclaimOffloaded = isReclaimOffloaded;
+    }
+
     void SetGcType(GC_TYPE type)
     {
         m_purpose = type;
@@ -257,14 +340,44 @@ public:
         if (m_isGcEnabled == false || m_isTxnStarted == false) {
             return;
         }
-        // Always lock before quicese to allow drop-table/check-point operations
-        if (m_managerLock.try_lock()) {
+        if (m_isReclaimOffloaded) {
+            // reclamation is performed by the background reclaimer of this NUMA node
+            OffloadedQuiesce();
+        } else if (m_managerLock.try_lock()) {
+            // Always lock before quicese to allow drop-table/check-point operations
+            // only transactions that left garbage behind are sampled, otherwise the histogram is all zeros
+            bool sampleLatency = (m_totalLimboInuseElements > 0);
+            uint64_t startTime = sampleLatency ? GetSysClock() : 0;
             RunQuicese();
             m_managerLock.unlock();
+            if (sampleLatency) {
+                m_inlineReclaimLatency.Record(CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime));
+            }
         }
         m_isTxnStarted = false;
     }
 
+    /**
+     * @brief Locks the manager for a background reclamation pass, without waiting for the owning session.
+     * @return True if the manager has limbo groups and was locked.
+     */
+    inline bool TryLockForReclaim()
+    {
+        if (m_isGcEnabled == false || m_limboHead == nullptr) {
+            return false;
+        }
+        return m_managerLock.try_lock();
+    }
+
+    /**
+     * @brief Reclaims limbo groups on behalf of the owning session. Called by the background reclaimer of the
+     * NUMA node to which the session belongs, after the manager was locked with @ref TryLockForReclaim().
+     * The manager is unlocked on return.
+     * @param activeEpoch The minimum active epoch snapshot taken by the reclaimer.
+     * @return The number of reclaimed elements.
+     */
+    uint32_t BackgroundQuiesce(GcEpochType activeEpoch);
+
     /**
      * @brief Perform cleanup after the quiescent barrier
      *        1. Try to increase the global epoch
@@ -371,9 +484,16 @@ public:
         if (m_isGcEnabled == false) {
             return;
         }
+        // the background reclaimer may concurrently consume the limbo groups of this manager
+        if (m_isReclaimOffloaded) {
+            m_managerLock.lock();
+        }
         if (m_limboTail->m_tail + 2 > LimboGroup::CAPACITY) {
             bool res = RefillLimboGroup();
             if (res == false) {
+                if (m_isReclaimOffloaded) {
+                    m_managerLock.unlock();
+                }
                 MOT_REPORT_ERROR(MOT_ERROR_OOM, "GC Operation", "Failed to refill limbo group");
                 return;
             }
@@ -383,6 +503,9 @@ public:
         ++m_totalLimboInuseElements;
         m_totalLimboSizeInBytes += objSize;
         m_totalLimboRetiredSizeInBytes += objSize;  // stats
+        if (m_isReclaimOffloaded) {
+            m_managerLock.unlock();
+        }
         MemoryStatisticsProvider::m_provider->AddGCRetiredBytes(objSize);
     }
 
@@ -504,6 +627,21 @@ private:
     /** @var GC manager type   */
     GC_TYPE m_purpose;
 
+    /** @var The NUMA node of the owning session, used to select the background reclaimer. */
+    int16_t m_numaNodeId;
+
+    /** @var Specifies whether reclamation is offloaded to the background reclaimer. */
+    bool m_isReclaimOffloaded;
+
+    /** @var Latency of reclamation passes performed inline by sessions at transaction end. */
+    static GcLatencyHistogram m_inlineReclaimLatency;
+
+    /** @var Latency of reclamation passes forced on sessions whose limbo exceeded the high threshold. */
+    static GcLatencyHistogram m_backpressureReclaimLatency;
+
+    /** @var Latency of reclamation passes performed by background reclaimers. */
+    static GcLatencyHistogram m_backgroundReclaimLatency;
+
     /** @brief Calculate the minimum epoch among all active GC Managers.
      *  @return The minimum epoch among all active GC Managers.
      */
@@ -523,7 +661,19 @@ private:
     bool Initialize();
 
     /** @brief Clean\reclaim elements from Limbo groups   */
-    void HardQuiesce(uint32_t numOfElementsToClean);
+    inline void HardQuiesce(uint32_t numOfElementsToClean)
+    {
+        HardQuiesce(numOfElementsToClean, g_gcActiveEpoch);
+    }
+
+    /** @brief Clean\reclaim elements from Limbo groups retired before the given active epoch */
+    void HardQuiesce(uint32_t numOfElementsToClean, GcEpochType activeEpoch);
+
+    /**
+     * @brief Transaction end processing when reclamation is offloaded. Advances the epoch like @ref RunQuicese(),
+     * but reclaims inline only when the limbo size exceeds the high threshold (back-pressure).
+     */
+    void OffloadedQuiesce();
 
     /** @brief Remove all elements of elements of a specific index from all Limbo groups and reclaim them */
     void CleanIndexItems(uint32_t indexId, bool dropIndex);
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.cpp
+ *    Background garbage-collector reclaimer threads (one per NUMA node).
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/memory/garbage_collector/mm_gc_reclaimer.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "mm_gc_reclaimer.h"
+#include "mot_engine.h"
+#include "mot_configuration.h"
+#include "session_manager.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(GcReclaimerPool, GC);
+
+struct ReclaimerThreads {
+    std::vector<std::thread> m_vec;
+};
+
+GcReclaimerPool::GcReclaimerPool()
+    : m_workers(nullptr),
+      m_reclaimerCount(GetGlobalConfiguration().m_enableNuma ? GetGlobalConfiguration().m_numaNodes : 1),
+      m_intervalMicros(GetGlobalConfiguration().m_gcBackgroundReclaimIntervalUSec),
+      m_running(false)
+{
+    if (m_reclaimerCount == 0) {
+        m_reclaimerCount = 1;
+    }
+}
+
+GcReclaimerPool::~GcReclaimerPool()
+{
+    Stop();
+}
+
+bool GcReclaimerPool::Start()
+{
+    ReclaimerThreads* threads = new (std::nothrow) ReclaimerThreads();
+    if (threads == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "GC Reclaimer Startup", "Failed to allocate reclaimer thread array");
+        return false;
+    }
+
+    m_running = true;
+    m_workers = (void*)threads;
+    for (uint32_t i = 0; i < m_reclaimerCount; ++i) {
+        threads->m_vec.push_back(std::thread(&GcReclaimerPool::ReclaimerFunc, this, i));
+    }
+
+    MOT_LOG_INFO("Started %u background GC reclaimers (interval: %" PRIu64 " us)", m_reclaimerCount, m_intervalMicros);
+    return true;
+}
+
+void GcReclaimerPool::Stop()
+{
+    if (m_workers == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_running = false;
+    }
+    m_cv.notify_all();
+
+    ReclaimerThreads* threads = reinterpret_cast<ReclaimerThreads*>(m_workers);
+    for (auto& worker : threads->m_vec) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    delete threads;
+    m_workers = nullptr;
+
+    GcManager::ReportGcLatency(LogLevel::LL_INFO);
+    MOT_LOG_INFO("Stopped background GC reclaimers");
+}
+
+bool GcReclaimerPool::WaitNextRound()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    (void)m_cv.wait_for(lock, std::chrono::microseconds(m_intervalMicros), [this]() { return !m_running; });
+    return m_running;
+}
+
+uint64_t GcReclaimerPool::ReclaimRound(uint32_t reclaimerId, GcManager* gcSession, std::vector<GcManager*>& managers)
+{
+    // advance the global epoch first, so that garbage of idle sessions becomes eligible for reclamation
+    gcSession->SetGlobalEpoch(GetGlobalEpoch() + 1);
+    gcSession->GcStartTxn();
+
+    // the global lock is held only to snapshot the active epoch and to lock the served managers: a locked
+    // manager cannot be destroyed (see GcManager::RemoveFromGcList()), so reclamation runs without it
+    managers.clear();
+    g_gcGlobalEpochLock.lock();
+    GcEpochType activeEpoch = g_gcActiveEpoch;
+    for (GcManager* gcManager = GcManager::allGcManagers; gcManager != nullptr; gcManager = gcManager->Next()) {
+        if (gcManager->IsReclaimOffloaded() &&
+            (((uint32_t)gcManager->GetNumaNodeId() % m_reclaimerCount) == reclaimerId) &&
+            gcManager->TryLockForReclaim()) {
+            managers.push_back(gcManager);
+        }
+    }
+    g_gcGlobalEpochLock.unlock();
+
+    uint64_t reclaimedElements = 0;
+    for (GcManager* gcManager : managers) {
+        reclaimedElements += gcManager->BackgroundQuiesce(activeEpoch);
+    }
+
+    // objects retired by reclamation callbacks (e.g. masstree layers) are reclaimed inline by the reclaimer itself
+    gcSession->GcEndTxn();
+    return reclaimedElements;
+}
+
+void GcReclaimerPool::ReclaimerFunc(uint32_t reclaimerId)
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    // bind to the served node before creating the session, so the session memory is node-local as well
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetNodeAffinity((int)reclaimerId)) {
+        MOT_LOG_WARN("Failed to set affinity for GC reclaimer %u, reclamation will not be node-local", reclaimerId);
+    }
+
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("Failed to initialize session context for GC reclaimer %u", reclaimerId);
+        MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        return;
+    }
+
+    // the reclaimer reclaims its own garbage inline, otherwise it would wait on itself
+    GcManager* gcSession = sessionContext->GetTxnManager()->GetGcSession();
+    gcSession->SetGcType(GcManager::GC_RECLAIMER);
+    gcSession->SetReclaimOffloaded(false);
+    MOT_LOG_DEBUG("GC reclaimer %u started", reclaimerId);
+
+    std::vector<GcManager*> managers;
+    while (m_running) {
+        // keep going while there is work to do, otherwise idle until the next round
+        if (ReclaimRound(reclaimerId, gcSession, managers) > 0) {
+            std::this_thread::yield();
+        } else if (!WaitNextRound()) {
+            break;
+        }
+    }
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("GC reclaimer %u stopped", reclaimerId);
+}
+}  // namespace MOT
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.h
+ *    Background garbage-collector reclaimer threads (one per NUMA node).
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/memory/garbage_collector/mm_gc_reclaimer.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MM_GC_RECLAIMER_H
+#define MM_GC_RECLAIMER_H
+
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include "global.h"
+#include "mm_gc_manager.h"
+
+namespace MOT {
+/**
+ * @class GcReclaimerPool
+ * @brief Pool of background threads that reclaim the limbo groups of session GC managers off the transaction
+ * commit path. One reclaimer is started per NUMA node, and each reclaimer serves only the GC managers of sessions
+ * running on its node, so that memory is released back to node-local pools by a node-local thread.
+ */
+class GcReclaimerPool {
+public:
+    GcReclaimerPool();
+    ~GcReclaimerPool();
+
+    /**
+     * @brief Starts all reclaimer threads.
+     * @return True if all threads were started.
+     */
+    bool Start();
+
+    /** @brief Stops all reclaimer threads and waits for them to finish. */
+    void Stop();
+
+private:
+    /**
+     * @brief Reclaimer thread function.
+     * @param reclaimerId The zero-based reclaimer identifier, equal to the NUMA node it serves.
+     */
+    void ReclaimerFunc(uint32_t reclaimerId);
+
+    /**
+     * @brief Runs a single reclamation round over all GC managers served by a reclaimer.
+     * @param reclaimerId The reclaimer identifier.
+     * @param gcSession The GC manager of the reclaimer thread itself.
+     * @param managers Scratch array of the managers locked for this round, reused across rounds.
+     * @return The number of reclaimed elements.
+     */
+    uint64_t ReclaimRound(uint32_t reclaimerId, GcManager* gcSession, std::vector<GcManager*>& managers);
+
+    /**
+     * @brief Waits for the next reclamation round.
+     * @return False if the pool is stopping.
+     */
+    bool WaitNextRound();
+
+    /** @var The reclaimer threads (opaque to avoid including thread header). */
+    void* m_workers;
+
+    /** @var The number of reclaimer threads. */
+    uint32_t m_reclaimerCount;
+
+    /** @var Idle interval between reclamation rounds in micro-seconds. */
+    uint64_t m_intervalMicros;
+
+    /** @var Specifies whether the pool is running. */
+    volatile bool m_running;
+
+    /** @var Synchronizes stop requests. */
+    std::mutex m_lock;
+
+    /** @var Wakes up idle reclaimers when the pool stops. */
+    std::condition_variable m_cv;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* MM_GC_RECLAIMER_H */
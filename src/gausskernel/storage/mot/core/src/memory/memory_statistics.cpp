@@ -35,6 +35,8 @@
 #include "mm_global_api.h"
 #include "mot_error.h"
 #include "mm_api.h"
+#include "mot_engine.h"
+#include "mm_gc_manager.h"
 
 namespace MOT {
 DECLARE_LOGGER(MemoryStatistics, Memory)
@@ -324,5 +326,10 @@ void MemoryStatisticsProvider::OnConfigChange()
 void MemoryStatisticsProvider::PrintStatisticsEx()
 {
     MemPrint("Periodic Status", LogLevel::LL_INFO, MEM_REPORT_SUMMARY);
+    MOTEngine* engine = MOTEngine::GetInstance();
+    if (engine != nullptr && engine->GetTableManager() != nullptr) {
+        engine->GetTableManager()->PrintTablesFragmentation(LogLevel::LL_INFO);
+    }
+    GcManager::ReportGcLatency(LogLevel::LL_INFO);
 }
 }  // namespace MOT
@@ -38,6 +38,8 @@ CompactHandler::CompactHandler(ObjAllocInterface* pool, const char* prefix)
       m_poolsToCompact(0),
       m_compactedPools(nullptr),
       m_curr(nullptr),
+      m_relocatedCount(0),
+      m_releasedPools(0),
       m_logPrefix(prefix)
 {}
 
@@ -49,11 +51,15 @@ void CompactHandler::StartCompaction(CompactTypeT type)
     stats.m_type = PoolStatsT::POOL_STATS_ALL;
 
     m_ctype = type;
+    ReleaseDrainedPools();
     m_orig->GetStats(stats);
     m_orig->PrintStats(stats, m_logPrefix, LogLevel::LL_INFO);
 
     if (stats.m_fragmentationPercent <= 0 && stats.m_freeObjCount < stats.m_perPoolTotalCount) {
         m_compactionNeeded = false;
+        if (m_releasedPools > 0) {
+            MemBufferClearSessionCache();
+        }
         return;
     }
 
@@ -116,17 +122,68 @@ void CompactHandler::EndCompaction()
                 ObjPool* op = p.Get();
                 DEL_FROM_LIST(m_orig->m_listLock, m_orig->m_objList, op);
                 ObjPool::DelObjPool(op, m_orig->m_type, true);
+                ++m_releasedPools;
+            } else if (m_ctype != COMPACT_SIMPLE && m_addrMap.find(p.Get()) != m_addrMap.end()) {
+                // relocated objects are reclaimed by the GC, keep the pool out of the free list until then
+                PUSH(m_orig->m_drainList, p);
             } else {
-                if (m_ctype != COMPACT_SIMPLE)
-                    MOT_LOG_ERROR("Compaction error: pool not empty, re-inserting to free pools");
                 PUSH(m_orig->m_nextFree, p);
             }
             p = tmp;
         }
     }
 
+    // return the released buffers to the buffer heap, so that chunks that became empty go back to the chunk pool
+    if (m_releasedPools > 0) {
+        MemBufferClearSessionCache();
+    }
+
     m_orig->Print(m_logPrefix, LogLevel::LL_INFO);
 
     m_compactionNeeded = false;
 }
+
+void* CompactHandler::AllocCompacted()
+{
+    PoolAllocStateT state = PAS_NONE;
+    void* data = nullptr;
+
+    if (m_curr == nullptr) {
+        m_curr = ObjPool::GetObjPool(m_orig->m_size, m_orig, m_orig->m_type, true);
+        if (m_curr == nullptr) {
+            return nullptr;
+        }
+    }
+
+    m_curr->Alloc(&data, &state);
+
+    if (state == PAS_EMPTY) {
+        ADD_TO_LIST_NOLOCK(m_compactedPools, m_curr);
+        m_curr = nullptr;
+    }
+    return data;
+}
+
+void CompactHandler::ReleaseDrainedPools()
+{
+    ObjPoolPtr p = nullptr;
+    ObjPoolPtr drained = nullptr;
+    do {
+        drained = m_orig->m_drainList;
+    } while (!CAS(m_orig->m_drainList, drained, p));
+
+    p = drained;
+    while (p.Get() != nullptr) {
+        ObjPoolPtr tmp = p->m_objNext;
+        if (p->m_freeCount == p->m_totalCount) {
+            ObjPool* op = p.Get();
+            DEL_FROM_LIST(m_orig->m_listLock, m_orig->m_objList, op);
+            ObjPool::DelObjPool(op, m_orig->m_type, true);
+            ++m_releasedPools;
+        } else {
+            PUSH(m_orig->m_nextFree, p);
+        }
+        p = tmp;
+    }
+}
 }  // namespace MOT
@@ -60,7 +60,8 @@ public:
      * comactionNeeded to true (if indeed)
      */
     void StartCompaction(CompactTypeT type = COMPACT_REALLOC);
-    /** @brief Applies new ObjPools to a general use, and releases empty ObjPools.
+    /** @brief Applies new ObjPools to a general use, and releases empty ObjPools. Compacted ObjPools that still
+     * hold objects waiting for the GC are kept aside, and released by the next compaction.
      */
     void EndCompaction();
 
@@ -83,24 +84,15 @@ public:
         OBJ_RELEASE_START_NOMARK(obj, m_orig->m_size);
 
         if (m_addrMap.find(op.Get()) != m_addrMap.end()) {
-            PoolAllocStateT state = PAS_NONE;
-            void* data = nullptr;
-
-            if (m_curr == nullptr) {
-                m_curr = ObjPool::GetObjPool(m_orig->m_size, m_orig, m_orig->m_type, true);
-            }
-
-            m_curr->Alloc(&data, &state);
-
-            if (state == PAS_EMPTY) {
-                ADD_TO_LIST_NOLOCK(m_compactedPools, m_curr);
-                m_curr = nullptr;
+            void* data = AllocCompacted();
+            if (data == nullptr) {
+                return res;
             }
 
             res = new (data) T(*(const T*)obj);
 
             OBJ_RELEASE_MARK(oix_ptr);
-            state = PAS_NONE;
+            PoolAllocStateT state = PAS_NONE;
             obj->~T();
             op->Release(oix, &state);
         }
@@ -108,6 +100,54 @@ public:
         return res;
     }
 
+    /**
+     * @brief Copies the object into a compacted ObjPool, if it resides in an ObjPool that is being compacted.
+     * @detail Unlike CompactObj(), the original object is left intact. The caller is responsible for releasing it
+     * once it can no longer be accessed by concurrent readers (i.e. through the GC).
+     * @return The new copy of the object, or null pointer if the object is not relocated.
+     */
+    template <typename T>
+    T* RelocateObj(T const* obj)
+    {
+        if (!m_compactionNeeded) {
+            return nullptr;
+        }
+
+        OBJ_RELEASE_START_NOMARK(obj, m_orig->m_size);
+
+        if (m_addrMap.find(op.Get()) == m_addrMap.end()) {
+            return nullptr;
+        }
+
+        void* data = AllocCompacted();
+        if (data == nullptr) {
+            return nullptr;
+        }
+        ++m_relocatedCount;
+        return new (data) T(*obj);
+    }
+
+    /** @brief Queries whether the object resides in an ObjPool that is being compacted. */
+    bool IsCompactedObj(const void* obj)
+    {
+        if (!m_compactionNeeded) {
+            return false;
+        }
+
+        OBJ_RELEASE_START_NOMARK(obj, m_orig->m_size);
+        return (m_addrMap.find(op.Get()) != m_addrMap.end());
+    }
+
+    uint64_t GetRelocatedCount() const
+    {
+        return m_relocatedCount;
+    }
+
+    uint32_t GetReleasedPoolCount() const
+    {
+        return m_releasedPools;
+    }
+
     ObjAllocInterface* m_orig;
     bool m_compactionNeeded;
     CompactTypeT m_ctype;
@@ -117,7 +157,18 @@ public:
     ObjPool* m_compactedPools;
     ObjPool* m_curr;
 
+    uint64_t m_relocatedCount;
+    uint32_t m_releasedPools;
+
     const char* m_logPrefix;
+
+private:
+    /** @brief Allocates a buffer for a compacted object. */
+    void* AllocCompacted();
+
+    /** @brief Releases the drained ObjPools of a previous compaction, or returns them to the free list. */
+    void ReleaseDrainedPools();
+
     DECLARE_CLASS_LOGGER();
 };
 }  // namespace MOT
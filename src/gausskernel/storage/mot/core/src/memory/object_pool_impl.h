@@ -308,6 +308,8 @@ public:
     spin_lock m_listLock;
     ObjPool* m_objList;
     ObjPoolPtr m_nextFree;
+    // pools emptied by compaction, waiting for the GC to reclaim their remaining objects
+    ObjPoolPtr m_drainList;
     uint16_t m_size;
     uint16_t m_oixOffset;
     MemBufferClass m_type;
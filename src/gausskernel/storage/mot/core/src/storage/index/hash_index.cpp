@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a lock-free hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mot_configuration.h"
+#include "mm_global_api.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (!m_valid) {
+        return;
+    }
+
+    if (m_singleItem) {
+        m_node = nullptr;
+    } else {
+        m_node = HashPrimaryIndex::NextLiveNode(m_node);
+        if (m_node == nullptr) {
+            ++m_bucket;
+            m_node = m_index->FirstNodeFrom(m_bucket);
+        }
+    }
+
+    if (m_node == nullptr) {
+        m_valid = false;
+    }
+}
+
+bool HashPrimaryIndex::HashIterator::IsPast(const IndexIterator* rhs) const
+{
+    const HashIterator* other = static_cast<const HashIterator*>(rhs);
+    if (!m_valid || !other->m_valid) {
+        return !m_valid;
+    }
+    if (m_bucket != other->m_bucket) {
+        return (m_bucket > other->m_bucket);
+    }
+
+    // same bucket: nodes are ordered by hash code and key
+    const HashNode* bound = other->m_node;
+    return (m_index->CompareNode(m_node, bound->m_hash, bound->GetKey()->GetKeyBuf()) > 0);
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    // the configured value is already validated, this only protects against direct modification
+    uint32_t bucketCount = GetGlobalConfiguration().m_hashIndexBucketCount;
+    if (bucketCount < MOTConfiguration::MIN_HASH_INDEX_BUCKET_COUNT) {
+        bucketCount = MOTConfiguration::MIN_HASH_INDEX_BUCKET_COUNT;
+    } else if (bucketCount > MOTConfiguration::MAX_HASH_INDEX_BUCKET_COUNT) {
+        bucketCount = MOTConfiguration::MAX_HASH_INDEX_BUCKET_COUNT;
+    }
+    // round down to a power of two, so that bucket selection is a simple mask (both bounds are powers of two)
+    while ((bucketCount & (bucketCount - 1)) != 0) {
+        bucketCount &= (bucketCount - 1);
+    }
+    m_bucketMask = bucketCount - 1;
+    m_segmentCount = bucketCount / BUCKETS_PER_SEGMENT;
+
+    m_nodePool = ObjAllocInterface::GetObjPool(
+        sizeof(HashNode) + sizeof(Key) + ALIGN8(m_keyLength), false, CACHE_LINE_SIZE);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool for index %s",
+            m_name.c_str());
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    size_t dirSize = sizeof(std::atomic<BucketSegment*>) * m_segmentCount;
+    m_segments = (std::atomic<BucketSegment*>*)MemGlobalAllocAligned(dirSize, CACHE_LINE_SIZE);
+    if (m_segments == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate %u bytes for hash index %s directory",
+            (unsigned)dirSize, m_name.c_str());
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    errno_t erc = memset_s(m_segments, dirSize, 0, dirSize);
+    securec_check(erc, "\0", "\0");
+
+    MOT_LOG_DEBUG("Initialized hash index %s with %u buckets", m_name.c_str(), bucketCount);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashPrimaryIndex::DestroyBuckets()
+{
+    if (m_segments != nullptr) {
+        for (uint32_t i = 0; i < m_segmentCount; ++i) {
+            BucketSegment* segment = m_segments[i].load(std::memory_order_relaxed);
+            if (segment != nullptr) {
+                MemGlobalFree(segment);
+            }
+        }
+        MemGlobalFree(m_segments);
+        m_segments = nullptr;
+    }
+
+    // nodes are released in bulk together with their pool
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* keyBuf, uint32_t keyLen)
+{
+    // 64-bit FNV-1a over 8-byte words, followed by a Murmur3 finalizer to spread the bits used by the bucket mask
+    const uint64_t fnvPrime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint32_t i = 0;
+    for (; i + sizeof(uint64_t) <= keyLen; i += sizeof(uint64_t)) {
+        uint64_t word;
+        errno_t erc = memcpy_s(&word, sizeof(word), keyBuf + i, sizeof(word));
+        securec_check(erc, "\0", "\0");
+        hash = (hash ^ word) * fnvPrime;
+    }
+    for (; i < keyLen; ++i) {
+        hash = (hash ^ keyBuf[i]) * fnvPrime;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+std::atomic<uint64_t>* HashPrimaryIndex::GetBucketHead(uint32_t bucket, bool create) const
+{
+    uint32_t segmentId = bucket / BUCKETS_PER_SEGMENT;
+    BucketSegment* segment = m_segments[segmentId].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        if (!create) {
+            return nullptr;
+        }
+
+        BucketSegment* newSegment = (BucketSegment*)MemGlobalAllocAligned(sizeof(BucketSegment), CACHE_LINE_SIZE);
+        if (newSegment == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index Insert", "Failed to allocate %u bytes for bucket segment",
+                (unsigned)sizeof(BucketSegment));
+            return nullptr;
+        }
+        errno_t erc = memset_s(newSegment, sizeof(BucketSegment), 0, sizeof(BucketSegment));
+        securec_check(erc, "\0", "\0");
+
+        // another session might have installed the segment concurrently
+        if (m_segments[segmentId].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel)) {
+            segment = newSegment;
+        } else {
+            MemGlobalFree(newSegment);
+        }
+    }
+
+    return &segment->m_heads[bucket % BUCKETS_PER_SEGMENT];
+}
+
+RC HashPrimaryIndex::Reserve(uint64_t numKeys)
+{
+    // keys are spread evenly between the segments, so smaller loads would leave most segments untouched anyway
+    if (numKeys < m_segmentCount) {
+        return RC_OK;
+    }
+
+    for (uint32_t i = 0; i < m_segmentCount; ++i) {
+        if (GetBucketHead(i * BUCKETS_PER_SEGMENT, true) == nullptr) {
+            return RC_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+    return RC_OK;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::NextLiveNode(const HashNode* node)
+{
+    HashNode* curr = ToNode(node->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (!IsMarked(next)) {
+            break;
+        }
+        curr = ToNode(next);
+    }
+    return curr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FirstNodeFrom(uint32_t& bucket) const
+{
+    while (bucket <= m_bucketMask) {
+        std::atomic<uint64_t>* head = GetBucketHead(bucket, false);
+        if (head == nullptr) {
+            // skip the entire segment
+            bucket = (bucket / BUCKETS_PER_SEGMENT + 1) * BUCKETS_PER_SEGMENT;
+            continue;
+        }
+
+        HashNode* node = ToNode(head->load(std::memory_order_acquire));
+        if (node != nullptr && IsMarked(node->m_next.load(std::memory_order_acquire))) {
+            node = NextLiveNode(node);
+        }
+        if (node != nullptr) {
+            return node;
+        }
+        ++bucket;
+    }
+
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::LastNode(uint32_t& bucket) const
+{
+    uint32_t segmentId = m_segmentCount;
+    while (segmentId > 0) {
+        --segmentId;
+        if (m_segments[segmentId].load(std::memory_order_acquire) == nullptr) {
+            continue;
+        }
+
+        for (uint32_t i = BUCKETS_PER_SEGMENT; i > 0; --i) {
+            bucket = segmentId * BUCKETS_PER_SEGMENT + i - 1;
+            HashNode* node = ToNode(GetBucketHead(bucket, false)->load(std::memory_order_acquire));
+            if (node != nullptr && IsMarked(node->m_next.load(std::memory_order_acquire))) {
+                node = NextLiveNode(node);
+            }
+            if (node == nullptr) {
+                continue;
+            }
+
+            HashNode* next = NextLiveNode(node);
+            while (next != nullptr) {
+                node = next;
+                next = NextLiveNode(node);
+            }
+            return node;
+        }
+    }
+
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::LookupInBucket(
+    std::atomic<uint64_t>* head, uint64_t hash, const uint8_t* keyBuf) const
+{
+    HashNode* curr = ToNode(head->load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        int cmp = CompareNode(curr, hash, keyBuf);
+        if (cmp > 0) {
+            break;
+        }
+        if ((cmp == 0) && !IsMarked(next)) {
+            return curr;
+        }
+        curr = ToNode(next);
+    }
+    return nullptr;
+}
+
+bool HashPrimaryIndex::FindInBucket(std::atomic<uint64_t>* head, uint64_t hash, const uint8_t* keyBuf,
+    std::atomic<uint64_t>*& prev, HashNode*& curr)
+{
+    bool retry = true;
+    while (retry) {
+        retry = false;
+        prev = head;
+        curr = ToNode(prev->load(std::memory_order_acquire));
+        while (curr != nullptr) {
+            uint64_t next = curr->m_next.load(std::memory_order_acquire);
+            if (IsMarked(next)) {
+                // help unlinking a logically deleted node, restart if the predecessor changed meanwhile
+                uint64_t expected = (uint64_t)curr;
+                if (!prev->compare_exchange_strong(expected, next & ~NODE_MARK_BIT, std::memory_order_acq_rel)) {
+                    retry = true;
+                    break;
+                }
+                RetireNode(curr);
+                curr = ToNode(next);
+                continue;
+            }
+
+            int cmp = CompareNode(curr, hash, keyBuf);
+            if (cmp >= 0) {
+                return (cmp == 0);
+            }
+            prev = &curr->m_next;
+            curr = ToNode(next);
+        }
+    }
+    return false;
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateNodeCallBack, m_nodePool->m_size);
+    } else {
+        // no concurrent readers without a GC session (e.g. during truncate), so release immediately
+        m_nodePool->Release(node);
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, m_keyLength);
+    inserted = false;
+
+    std::atomic<uint64_t>* head = GetBucketHead((uint32_t)(hash & m_bucketMask), true);
+    if (head == nullptr) {
+        return nullptr;  // error already reported
+    }
+
+    HashNode* node = (HashNode*)m_nodePool->Alloc();
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index Insert", "Failed to allocate hash node for index %s",
+            m_name.c_str());
+        return nullptr;
+    }
+    node->m_hash = hash;
+    node->m_sentinel = sentinel;
+    Key* nodeKey = new (node->GetKey()) Key((uint16_t)m_keyLength, KeyType::PRIMARY_KEY);
+    nodeKey->FillValue(keyBuf, (uint16_t)m_keyLength, 0);
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (FindInBucket(head, hash, keyBuf, prev, curr)) {
+            // key mapping already exists in unique index
+            m_nodePool->Release(node);
+            return curr->m_sentinel;
+        }
+
+        node->m_next.store((uint64_t)curr, std::memory_order_relaxed);
+        uint64_t expected = (uint64_t)curr;
+        if (prev->compare_exchange_strong(expected, (uint64_t)node, std::memory_order_acq_rel)) {
+            inserted = true;
+            (void)m_itemCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, m_keyLength);
+
+    // Operation does not modify bucket lists, so it is safe to skip marked nodes without unlinking them
+    std::atomic<uint64_t>* head = GetBucketHead((uint32_t)(hash & m_bucketMask), false);
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    HashNode* node = LookupInBucket(head, hash, keyBuf);
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf, m_keyLength);
+
+    std::atomic<uint64_t>* head = GetBucketHead((uint32_t)(hash & m_bucketMask), false);
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (!FindInBucket(head, hash, keyBuf, prev, curr)) {
+            return nullptr;
+        }
+
+        // logical deletion: mark the next pointer of the removed node
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(next)) {
+            continue;
+        }
+        if (!curr->m_next.compare_exchange_strong(next, next | NODE_MARK_BIT, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        Sentinel* sentinel = curr->m_sentinel;
+        (void)m_itemCount.fetch_sub(1, std::memory_order_relaxed);
+
+        // physical deletion: if unlinking fails, another search unlinks (and retires) the node on our behalf
+        uint64_t expected = (uint64_t)curr;
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+            RetireNode(curr);
+        } else {
+            (void)FindInBucket(head, hash, keyBuf, prev, curr);
+        }
+        return sentinel;
+    }
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t bucketBytes = sizeof(std::atomic<BucketSegment*>) * m_segmentCount;
+    for (uint32_t i = 0; i < m_segmentCount; ++i) {
+        if (m_segments[i].load(std::memory_order_relaxed) != nullptr) {
+            bucketBytes += sizeof(BucketSegment);
+        }
+    }
+    res += bucketBytes;
+    netto += bucketBytes;
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    uint32_t bucket = 0;
+    HashNode* node = FirstNodeFrom(bucket);
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, bucket, node, false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash index iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Last(uint32_t pid) const
+{
+    uint32_t bucket = 0;
+    HashNode* node = LastNode(bucket);
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, bucket, node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Last", "Failed to create hash index iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    // only exact match is supported, otherwise an invalid iterator is returned
+    HashNode* node = nullptr;
+    uint32_t bucket = 0;
+    if (matchKey) {
+        const uint8_t* keyBuf = key->GetKeyBuf();
+        uint64_t hash = HashKey(keyBuf, m_keyLength);
+        bucket = (uint32_t)(hash & m_bucketMask);
+        std::atomic<uint64_t>* head = GetBucketHead(bucket, false);
+        if (head != nullptr) {
+            node = LookupInBucket(head, hash, keyBuf);
+        }
+    }
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, bucket, node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash index iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
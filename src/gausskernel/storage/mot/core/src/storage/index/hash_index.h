@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a lock-free hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+
+#include "index.h"
+#include "utilities.h"
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Primary index implementation using a lock-free hash table.
+ * @detail The table is made of a fixed number of buckets, each holding a lock-free linked list of nodes sorted by
+ * hash code and key (Harris-Michael list). Nodes are logically deleted by marking their next pointer and physically
+ * unlinked by the modifying session, which then retires them to the epoch-based garbage collector. Bucket heads are
+ * kept in cache-line aligned segments that are allocated on first use, so that sparsely populated indexes do not pay
+ * for the full bucket array.
+ * The hash index supports only exact match lookups. Iteration order is the internal bucket order, and as such range
+ * scans and ordered scans are not supported (see @ref Index::IsOrdered()).
+ */
+class HashPrimaryIndex : public Index {
+public:
+    /**
+     * @struct HashNode
+     * @brief A single item in a bucket list. The node is followed in memory by a @ref Key object holding a copy of
+     * the indexed key.
+     */
+    struct HashNode {
+        /** @var The next node in the bucket list. The lowest bit is used as a logical deletion mark. */
+        std::atomic<uint64_t> m_next;
+
+        /** @var The hash code of the key. */
+        uint64_t m_hash;
+
+        /** @var The primary sentinel mapped to the key. */
+        Sentinel* m_sentinel;
+
+        /**
+         * @brief Retrieves the key stored in the node.
+         * @return The node key.
+         */
+        inline Key* GetKey() const
+        {
+            return reinterpret_cast<Key*>(const_cast<HashNode*>(this) + 1);
+        }
+    };
+
+private:
+    /** @var The deletion mark bit of a node next pointer. */
+    static constexpr uint64_t NODE_MARK_BIT = 1UL;
+
+    /** @var The number of buckets in a single bucket segment (4 KB per segment). */
+    static constexpr uint32_t BUCKETS_PER_SEGMENT = 512;
+
+    /**
+     * @struct BucketSegment
+     * @brief A cache-line aligned array of bucket list heads.
+     */
+    struct alignas(CACHE_LINE_SIZE) BucketSegment {
+        /** @var The bucket list heads. */
+        std::atomic<uint64_t> m_heads[BUCKETS_PER_SEGMENT];
+    };
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator implementation for a primary hash index.
+     * @detail The iterator either scans the entire index in bucket order, or points to a single item (the result of
+     * an exact match search), in which case it becomes invalid after calling Next().
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param index The iterated index.
+         * @param bucket The bucket of the current node.
+         * @param node The current node, or null pointer if the iterator is invalid.
+         * @param singleItem Specifies whether the iterator points to a single search result.
+         */
+        HashIterator(const HashPrimaryIndex* index, uint32_t bucket, HashNode* node, bool singleItem)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false, node != nullptr),
+              m_index(index),
+              m_bucket(bucket),
+              m_node(node),
+              m_singleItem(singleItem)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_index = nullptr;
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return (m_valid && m_node != nullptr) ? m_node->GetKey() : nullptr;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return GetPrimarySentinel()->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported by hash index.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * @brief Queries whether this iterator moved beyond another iterator, in bucket order.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if this iterator points past the item of the other iterator, otherwise false.
+         */
+        virtual bool IsPast(const IndexIterator* rhs) const;
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The iterated index. */
+        const HashPrimaryIndex* m_index;
+
+        /** @var The bucket of the current node. */
+        uint32_t m_bucket;
+
+        /** @var The current node. */
+        HashNode* m_node;
+
+        /** @var Specifies whether the iterator points to a single search result. */
+        bool m_singleItem;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_segments(nullptr),
+          m_segmentCount(0),
+          m_bucketMask(0),
+          m_itemCount(0),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyBuckets();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index. This may be an estimation.
+     * @detail The count is updated after each insertion and removal, so concurrent readers may see a slightly stale
+     * value.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_itemCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy all buckets and nodes and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyBuckets();
+        m_itemCount.store(0, std::memory_order_relaxed);
+
+        return IndexInitImpl(NULL);
+    }
+
+    /**
+     * @brief Allocates all bucket segments up front if the number of keys about to be inserted is large enough to
+     * populate all of them.
+     * @param numKeys The number of keys about to be inserted.
+     * @return Return code denoting success or failure.
+     */
+    virtual RC Reserve(uint64_t numKeys) override;
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    virtual IndexIterator* Last(uint32_t pid) const;
+
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocating retired nodes.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to the retired node.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Memory pool for hash nodes. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Lazily allocated bucket segments. */
+    std::atomic<BucketSegment*>* m_segments;
+
+    /** @var The number of bucket segments. */
+    uint32_t m_segmentCount;
+
+    /** @var The bucket mask (bucket count minus one). */
+    uint32_t m_bucketMask;
+
+    /** @var The number of keys stored in the index. */
+    std::atomic<uint64_t> m_itemCount;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    static inline bool IsMarked(uint64_t ptr)
+    {
+        return (ptr & NODE_MARK_BIT) != 0;
+    }
+
+    static inline HashNode* ToNode(uint64_t ptr)
+    {
+        return reinterpret_cast<HashNode*>(ptr & ~NODE_MARK_BIT);
+    }
+
+    /**
+     * @brief Computes the hash code of a key buffer.
+     * @param keyBuf The key buffer.
+     * @param keyLen The key length in bytes.
+     * @return The hash code.
+     */
+    static uint64_t HashKey(const uint8_t* keyBuf, uint32_t keyLen);
+
+    /**
+     * @brief Compares a node to a searched item according to the bucket list order (hash code, then key bytes).
+     * @return Negative value if the node precedes the searched item, zero if equal, positive value otherwise.
+     */
+    inline int CompareNode(const HashNode* node, uint64_t hash, const uint8_t* keyBuf) const
+    {
+        if (node->m_hash != hash) {
+            return (node->m_hash < hash) ? -1 : 1;
+        }
+        return memcmp(node->GetKey()->GetKeyBuf(), keyBuf, m_keyLength);
+    }
+
+    /**
+     * @brief Retrieves the head of a bucket list.
+     * @param bucket The bucket number.
+     * @param create Specifies whether to allocate the bucket segment if it does not exist yet.
+     * @return The bucket head, or null pointer if the segment does not exist (or could not be allocated).
+     */
+    std::atomic<uint64_t>* GetBucketHead(uint32_t bucket, bool create) const;
+
+    /**
+     * @brief Searches a bucket list for the first node not preceding the searched item.
+     * @param head The bucket head.
+     * @param hash The searched hash code.
+     * @param keyBuf The searched key buffer.
+     * @param[out] prev The link pointing to the resulting node.
+     * @param[out] curr The resulting node (may be null pointer).
+     * @return True if the resulting node matches the searched item.
+     * @note Logically deleted nodes encountered during the search are unlinked and retired to the GC.
+     */
+    bool FindInBucket(std::atomic<uint64_t>* head, uint64_t hash, const uint8_t* keyBuf,
+        std::atomic<uint64_t>*& prev, HashNode*& curr);
+
+    /**
+     * @brief Searches a bucket list for an item without modifying the list (read-only search).
+     * @return The matching node or null pointer if not found.
+     */
+    HashNode* LookupInBucket(std::atomic<uint64_t>* head, uint64_t hash, const uint8_t* keyBuf) const;
+
+    /**
+     * @brief Retrieves the first live node starting from the given bucket (inclusive).
+     * @param[in,out] bucket The bucket from which to start searching. Receives the bucket of the resulting node.
+     * @return The first live node or null pointer if no such node exists.
+     */
+    HashNode* FirstNodeFrom(uint32_t& bucket) const;
+
+    /**
+     * @brief Retrieves the last live node in bucket order.
+     * @param[out] bucket Receives the bucket of the resulting node.
+     * @return The last live node or null pointer if the index is empty.
+     */
+    HashNode* LastNode(uint32_t& bucket) const;
+
+    /**
+     * @brief Retrieves the next live node following the given node in the same bucket list.
+     * @return The next live node or null pointer if the bucket list end was reached.
+     */
+    static HashNode* NextLiveNode(const HashNode* node);
+
+    /**
+     * @brief Retires an unlinked node to the GC.
+     * @param node The unlinked node.
+     */
+    void RetireNode(HashNode* node);
+
+    /**
+     * @brief Frees all bucket segments and the node pool.
+     */
+    void DestroyBuckets();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -44,6 +44,11 @@ IndexIterator* Index::ReverseBegin(uint32_t pid) const
     return nullptr;
 }
 
+IndexIterator* Index::Last(uint32_t pid) const
+{
+    return nullptr;
+}
+
 IndexIterator* Index::Find(const Key* key, uint32_t pid) const
 {
     bool found = false;
@@ -223,7 +228,7 @@ void Index::Truncate(bool isDrop)
                 "Failed to allocate key pool for index %s after truncation",
                 m_name.c_str());
         }
-        m_sentinelPool = ObjAllocInterface::GetObjPool(sizeof(Sentinel), false);
+        m_sentinelPool = ObjAllocInterface::GetObjPool(GetSentinelObjSize(), false);
         if (m_sentinelPool == nullptr) {
             MOT_REPORT_ERROR(MOT_ERROR_OOM,
                 "Truncate Index",
@@ -308,6 +313,7 @@ Sentinel* Index::IndexInsert(const Key* key, Row* row, uint32_t pid)
             row->SetPrimarySentinel(sentinel);
         } else {
             MOT_ASSERT(row->GetPrimarySentinel() != nullptr);
+            StoreCoveringData(sentinel, row);
             sentinel->SetNextPtr(row->GetPrimarySentinel());
         }
         MOT_ASSERT(sentinel->IsCommited() == true);
@@ -315,6 +321,77 @@ Sentinel* Index::IndexInsert(const Key* key, Row* row, uint32_t pid)
     }
 }
 
+void Index::StoreCoveringData(Sentinel* sentinel, const Row* row) const
+{
+    if (m_numCoveringFields == 0) {
+        return;
+    }
+
+    Table* table = row->GetTable();
+    const uint8_t* rowData = row->GetData();
+    const uint8_t* rowNullBits = rowData + table->GetFieldOffset((uint64_t)0);
+    uint64_t* version = reinterpret_cast<uint64_t*>(reinterpret_cast<uint8_t*>(sentinel) + sizeof(Sentinel));
+    uint8_t* coveringData = reinterpret_cast<uint8_t*>(version + 1);
+    uint32_t offset = BITMAP_GETLEN(m_numCoveringFields);
+
+    // an odd version tells readers the data is being replaced, a new entry may start from any value
+    uint64_t startVersion = (MOT_ATOMIC_LOAD(*version) | 1);
+    MOT_ATOMIC_STORE(*version, startVersion);
+    COMPILER_BARRIER
+
+    errno_t erc = memset_s(coveringData, offset, 0, offset);
+    securec_check(erc, "\0", "\0");
+
+    for (int16_t i = 0; i < m_numCoveringFields; i++) {
+        int16_t colId = m_columnCoveringFields[i];
+        uint32_t length = m_lengthCoveringFields[i];
+        erc = memcpy_s(coveringData + offset, length, rowData + table->GetFieldOffset(colId), length);
+        securec_check(erc, "\0", "\0");
+        // null bits of the row are kept per column (excluding the null bits column itself)
+        if (BITMAP_GET(rowNullBits, (colId - 1))) {
+            BITMAP_SET(coveringData, i);
+        }
+        offset += length;
+    }
+
+    COMPILER_BARRIER
+    MOT_ATOMIC_STORE(*version, startVersion + 1);
+}
+
+bool Index::LoadCoveringData(const Sentinel* sentinel, Row* row) const
+{
+    Table* table = row->GetTable();
+    uint8_t* rowNullBits = row->m_data + table->GetFieldOffset((uint64_t)0);
+    uint64_t nullBitsSize = table->GetFieldSize((uint64_t)0);
+    const uint64_t* version =
+        reinterpret_cast<const uint64_t*>(reinterpret_cast<const uint8_t*>(sentinel) + sizeof(Sentinel));
+    const uint8_t* coveringData = reinterpret_cast<const uint8_t*>(version + 1);
+
+    uint64_t startVersion = MOT_ATOMIC_LOAD(*version);
+    if (startVersion & 1) {
+        return false;
+    }
+    COMPILER_BARRIER
+
+    errno_t erc = memset_s(rowNullBits, nullBitsSize, 0, nullBitsSize);
+    securec_check(erc, "\0", "\0");
+
+    uint32_t offset = BITMAP_GETLEN(m_numCoveringFields);
+    for (int16_t i = 0; i < m_numCoveringFields; i++) {
+        int16_t colId = m_columnCoveringFields[i];
+        uint32_t length = m_lengthCoveringFields[i];
+        erc = memcpy_s(row->m_data + table->GetFieldOffset(colId), length, coveringData + offset, length);
+        securec_check(erc, "\0", "\0");
+        if (BITMAP_GET(coveringData, i)) {
+            BITMAP_SET(rowNullBits, (colId - 1));
+        }
+        offset += length;
+    }
+
+    COMPILER_BARRIER
+    return (MOT_ATOMIC_LOAD(*version) == startVersion);
+}
+
 Row* Index::IndexRead(const Key* key, uint32_t pid) const
 {
     Row* row = nullptr;
@@ -349,7 +426,7 @@ Sentinel* Index::IndexRemove(const Key* key, uint32_t pid)
     return sentinel;
 }
 
-void Index::Compact(Table* table, uint32_t pid)
+void Index::Compact(Table* table, uint32_t pid, GcManager* gc)
 {
     IndexIterator* it = nullptr;
     char ixPrefix[256];
@@ -373,6 +450,12 @@ void Index::Compact(Table* table, uint32_t pid)
         }
 
         if (m_indexOrder == IndexOrder::INDEX_ORDER_PRIMARY) {
+            // relocated rows can be released only after concurrent readers are done with them
+            if (gc == nullptr || !GetGlobalConfiguration().m_gcEnable) {
+                MOT_LOG_INFO("Skipping row compaction of table %s: GC is disabled", table->GetTableName().c_str());
+                break;
+            }
+
             char tabPrefix[256];
             erc = snprintf_s(
                 tabPrefix, sizeof(tabPrefix), sizeof(tabPrefix) - 1, "%s(row pool)", table->GetTableName().c_str());
@@ -392,13 +475,13 @@ void Index::Compact(Table* table, uint32_t pid)
             }
 
             // do compaction
+            uint64_t skipped = 0;
             while (it->IsValid()) {
                 Sentinel* ps = it->GetPrimarySentinel();
                 Row* row = ps->GetData();
-                if (row != nullptr) {
-                    Row* newRow = chRow.CompactObj<Row>(row);
-                    if (newRow != nullptr) {
-                        ps->SetNextPtr(newRow);
+                if (row != nullptr && chRow.IsCompactedObj(row)) {
+                    if (!RelocateRow(table, ps, chRow, pid, gc)) {
+                        ++skipped;
                     }
                 }
                 it->Next();
@@ -406,6 +489,11 @@ void Index::Compact(Table* table, uint32_t pid)
 
             // end compaction
             chRow.EndCompaction();
+            MOT_LOG_INFO("Compaction of table %s: relocated %lu rows (%lu rows skipped), released %u pools",
+                table->GetTableName().c_str(),
+                chRow.GetRelocatedCount(),
+                skipped,
+                chRow.GetReleasedPoolCount());
         }
 
         chSentinel.EndCompaction();
@@ -417,6 +505,33 @@ void Index::Compact(Table* table, uint32_t pid)
     }
 }
 
+bool Index::RelocateRow(Table* table, Sentinel* ps, CompactHandler& chRow, uint32_t pid, GcManager* gc)
+{
+    // the sentinel lock blocks committing writers (and the checkpoint) of this row
+    if (!ps->TryLock(pid)) {
+        return false;
+    }
+
+    bool relocated = false;
+    Row* row = ps->GetData();
+    if (row != nullptr && ps->IsCommited() && !row->m_rowHeader.IsAbsent() && row->m_rowHeader.TryLock()) {
+        // transactions reach the row through the sentinel, so the new row is used by all validations and writes
+        // from now on, while readers that are still copying the old row see the same (unchanged) version
+        Row* newRow = chRow.RelocateObj<Row>(row);
+        if (newRow != nullptr) {
+            newRow->m_rowHeader.Release();
+            ps->SetNextPtr(newRow);
+            relocated = true;
+        }
+        row->m_rowHeader.Release();
+        if (relocated) {
+            gc->GcRecordObject(GetIndexId(), row, nullptr, Row::RowDtor, ROW_SIZE_FROM_POOL(table));
+        }
+    }
+    ps->Release();
+    return relocated;
+}
+
 uint64_t Index::GetIndexSize()
 {
     uint64_t res;
@@ -460,7 +575,11 @@ Index* Index::CloneEmpty()
     clonedIndex->m_name = m_name;
     clonedIndex->m_table = m_table;
     clonedIndex->m_keyPool = ObjAllocInterface::GetObjPool(sizeof(Key) + ALIGN8(m_keyLength), false);
-    clonedIndex->m_sentinelPool = ObjAllocInterface::GetObjPool(sizeof(Sentinel), false);
+    for (int i = 0; i < m_numCoveringFields; i++) {
+        clonedIndex->SetCoveringField(i, m_columnCoveringFields[i], m_lengthCoveringFields[i]);
+    }
+    clonedIndex->SetNumCoveringFields(m_numCoveringFields);
+    clonedIndex->m_sentinelPool = ObjAllocInterface::GetObjPool(clonedIndex->GetSentinelObjSize(), false);
     clonedIndex->m_fake = m_fake;
     clonedIndex->m_indexId = m_indexId;
     clonedIndex->m_isCommited = m_isCommited;
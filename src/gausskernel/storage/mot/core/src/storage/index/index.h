@@ -39,6 +39,8 @@ using namespace std;
 namespace MOT {
 #define NON_UNIQUE_INDEX_SUFFIX_LEN 8
 
+class CompactHandler;
+
 /**
  * @class Index
  * @brief This base class for primary and secondary index.
@@ -108,7 +110,7 @@ public:
                 MOT_ERROR_OOM, "Index Initialization", "Failed to allocate key pool for index %s", name.c_str());
             return RC_MEMORY_ALLOCATION_ERROR;  // safe cleanup during destructor
         }
-        m_sentinelPool = ObjAllocInterface::GetObjPool(sizeof(Sentinel), false);
+        m_sentinelPool = ObjAllocInterface::GetObjPool(GetSentinelObjSize(), false);
         if (m_sentinelPool == nullptr) {
             MOT_REPORT_ERROR(
                 MOT_ERROR_OOM, "Index Initialization", "Failed to allocate sentinel pool for index %s", name.c_str());
@@ -204,6 +206,15 @@ public:
         return m_indexingMethod;
     }
 
+    /**
+     * @brief Queries whether the index keeps its keys ordered, and therefore supports range and ordered scans.
+     * @return True if the index is ordered, false if it supports only exact match lookups.
+     */
+    inline bool IsOrdered() const
+    {
+        return (m_indexingMethod == IndexingMethod::INDEXING_METHOD_TREE);
+    }
+
     /**
      * @brief Retrieves the number of rows stored in the index. This may be an estimation.
      * @return The number of rows stored in the index.
@@ -215,6 +226,17 @@ public:
      */
     virtual RC ReInitIndex() = 0;
 
+    /**
+     * @brief Prepares the index for the insertion of a large number of keys (e.g. bulk load). Indexes that can
+     * pre-allocate their internal structures do so here, instead of allocating them one by one during insertion.
+     * @param numKeys The number of keys about to be inserted.
+     * @return Return code denoting success or failure.
+     */
+    virtual RC Reserve(uint64_t numKeys)
+    {
+        return RC_OK;
+    }
+
     // Iterator API
     /**
      * @brief Create a forward iterator to the first item in the index.
@@ -244,6 +266,18 @@ public:
      */
     virtual IndexIterator* ReverseBegin(uint32_t pid) const;
 
+    /**
+     * @brief Create a forward iterator to the last item in the index, in the iteration order of @ref Begin().
+     *
+     * @detail This API is provided to bound full scans of unordered indexes, which cannot be bounded by searching
+     * for the greatest key. Scans compare their position with the returned iterator (see IndexIterator::IsPast()).
+     *
+     * @param pid The logical identifier of the requesting thread.
+     * @return An iterator to the last item in the index (invalid if the index is empty), or null pointer if this API
+     * is not supported.
+     */
+    virtual IndexIterator* Last(uint32_t pid) const;
+
     /**
      * @brief Searches for a key in the index, returning an iterator to the closest matching key
      * according to the search criteria.
@@ -541,6 +575,95 @@ public:
         return (m_colBitmap && BITMAP_GET(m_colBitmap, colid));
     }
 
+    /**
+     * @brief Adds a column to the covering columns of a secondary index. The values of covering columns are stored
+     * in each index entry, so that queries referring only to these columns can be served without accessing the row.
+     * @param field The zero-based position of the column among the covering columns.
+     * @param orgField The table column identifier.
+     * @param length The size in bytes of the column.
+     */
+    inline void SetCoveringField(const uint16_t& field, const int16_t& orgField, const uint16_t& length)
+    {
+        if (field >= MAX_COVERING_COLUMNS) {
+            return;
+        }
+        m_lengthCoveringFields[field] = length;
+        m_columnCoveringFields[field] = orgField;
+    }
+
+    /**
+     * @brief Sets the number of covering columns. Must be called after all covering columns were set and before the
+     * index is initialized, since the covering data is allocated together with each index entry.
+     * @param num The number of covering columns.
+     */
+    inline void SetNumCoveringFields(uint32_t num)
+    {
+        if (num > MAX_COVERING_COLUMNS) {
+            return;
+        }
+        m_numCoveringFields = num;
+        m_coveringDataLength = 0;
+        if (num > 0) {
+            // version, null bits and the column values
+            uint32_t length = sizeof(uint64_t) + BITMAP_GETLEN(num);
+            for (uint32_t i = 0; i < num; i++) {
+                length += m_lengthCoveringFields[i];
+            }
+            m_coveringDataLength = ALIGN8(length);
+        }
+    }
+
+    inline int16_t GetNumCoveringFields() const
+    {
+        return m_numCoveringFields;
+    }
+
+    inline int16_t const* GetColumnCoveringFields() const
+    {
+        return m_columnCoveringFields;
+    }
+
+    /**
+     * @brief Queries whether index entries hold a copy of covering columns.
+     * @return True if this is a covering index.
+     */
+    inline bool IsCovering() const
+    {
+        return (m_numCoveringFields > 0);
+    }
+
+    /**
+     * @brief Queries whether a table column is stored in the index entries.
+     * @param colid The table column identifier.
+     * @return True if the column is covered by the index.
+     */
+    inline bool IsFieldCovered(int16_t colid) const
+    {
+        for (int16_t i = 0; i < m_numCoveringFields; i++) {
+            if (m_columnCoveringFields[i] == colid) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Copies the covering columns of a row into an index entry. The version at the start of the covering data
+     * is odd while the copy is in progress. Callers must not store into the same entry concurrently.
+     * @param sentinel The index entry.
+     * @param row The row to which the entry refers.
+     */
+    void StoreCoveringData(Sentinel* sentinel, const Row* row) const;
+
+    /**
+     * @brief Copies the covering columns stored in an index entry into a row buffer. Only the covering columns are
+     * valid in the resulting row, and all other columns are reported as null.
+     * @param sentinel The index entry.
+     * @param[out] row The row buffer into which the columns are copied. The table of the row must already be set.
+     * @return False if the entry was being stored meanwhile, in which case the row buffer is not consistent.
+     */
+    bool LoadCoveringData(const Sentinel* sentinel, Row* row) const;
+
     inline Key* CreateNewKey()
     {
         Key* key = m_keyPool->Alloc<Key>(m_keyLength, (IsPrimaryKey() ? KeyType::PRIMARY_KEY : KeyType::SECONDARY_KEY));
@@ -598,6 +721,12 @@ public:
         return m_sentinelPool->m_size;
     }
 
+    /** @brief Retrieves the size of an index entry, including covering data. */
+    inline uint32_t GetSentinelObjSize() const
+    {
+        return sizeof(Sentinel) + m_coveringDataLength;
+    }
+
     inline void SetUnique(bool unique)
     {
         m_unique = unique;
@@ -610,7 +739,15 @@ public:
 
     void Truncate(bool isDrop);
 
-    void Compact(Table* table, uint32_t pid);
+    /**
+     * @brief Compacts the sentinel pool of the index, and in case of a primary index also the row pool of the table.
+     * @detail Rows are relocated online: each row is copied under the lock of its primary sentinel, and the original
+     * row is retired to the GC, so concurrent transactions holding the old row are not affected.
+     * @param table The table to which the index belongs.
+     * @param pid The current thread identifier.
+     * @param gc The GC session used to retire relocated rows.
+     */
+    void Compact(Table* table, uint32_t pid, GcManager* gc);
 
     virtual uint64_t GetIndexSize();
 
@@ -689,6 +826,10 @@ protected:
     int16_t m_columnKeyFields[MAX_KEY_COLUMNS] = {0};
     int16_t m_numKeyFields = 0;
     uint32_t m_numTableFields = 0;
+    uint16_t m_lengthCoveringFields[MAX_COVERING_COLUMNS] = {0};
+    int16_t m_columnCoveringFields[MAX_COVERING_COLUMNS] = {0};
+    int16_t m_numCoveringFields = 0;
+    uint32_t m_coveringDataLength = 0;
     bool m_fake = false;
     bool m_isCommited = false;
     uint8_t* m_colBitmap = nullptr;
@@ -728,6 +869,18 @@ protected:
      */
     virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid) = 0;
 
+private:
+    /**
+     * @brief Relocates a single row during compaction.
+     * @param table The table to which the row belongs.
+     * @param ps The primary sentinel of the row.
+     * @param chRow The row pool compaction handler.
+     * @param pid The current thread identifier.
+     * @param gc The GC session used to retire the original row.
+     * @return True if the row was relocated, or false if it is currently locked by another thread.
+     */
+    bool RelocateRow(Table* table, Sentinel* ps, CompactHandler& chRow, uint32_t pid, GcManager* gc);
+
     DECLARE_CLASS_LOGGER()
 };
 
@@ -24,6 +24,7 @@
 
 #include "index_factory.h"
 #include "masstree_index.h"
+#include "hash_index.h"
 #include "utilities.h"
 
 namespace MOT {
@@ -72,6 +73,10 @@ Index* IndexFactory::CreatePrimaryIndex(IndexingMethod indexingMethod, IndexTree
             result = CreatePrimaryTreeIndex(flavor);
             break;
 
+        case IndexingMethod::INDEXING_METHOD_HASH:
+            result = CreatePrimaryHashIndex();
+            break;
+
         default:
             MOT_REPORT_ERROR(MOT_ERROR_INVALID_ARG,
                 "Create Primary Index",
@@ -119,4 +124,15 @@ Index* IndexFactory::CreatePrimaryTreeIndex(IndexTreeFlavor flavor)
 
     return result;
 }
+
+Index* IndexFactory::CreatePrimaryHashIndex()
+{
+    MOT_LOG_DEBUG("Creating hash index.");
+    Index* result = new (std::nothrow) HashPrimaryIndex();
+    if (result == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Create Primary Hash Index", "Failed to allocate primary hash index: out of memory");
+    }
+
+    return result;
+}
 }  // namespace MOT
@@ -107,6 +107,18 @@ public:
      */
     virtual bool Equals(const IndexIterator* rhs) const = 0;
 
+    /**
+     * @brief Queries whether this index iterator moved beyond another iterator of the same index, in the
+     * iteration order of the index. Used to bound scans over indexes whose iteration order does not follow the key
+     * order (see @ref Index::IsOrdered()).
+     * @param rhs The index iterator with which to compare this iterator.
+     * @return True if this iterator points past the item of the other iterator, otherwise false.
+     */
+    virtual bool IsPast(const IndexIterator* rhs) const
+    {
+        return false;
+    }
+
     /**
      * @brief Serializes the iterator into a buffer.
      * @param serializeFunc The serialization function.
@@ -502,6 +502,33 @@ RC Table::InsertRow(Row* row, TxnManager* txn)
     return txn->InsertRow(row);
 }
 
+RC Table::InsertRowBatch(Row** rows, uint32_t numRows, TxnManager* txn)
+{
+    RC rc = RC_OK;
+    uint32_t numIndexes = GetNumIndexes();
+
+    // each inserted row occupies one access entry per index
+    if (!txn->ReserveAccesses(numRows * numIndexes)) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Insert Row Batch", "Failed to reserve %u row accesses", numRows * numIndexes);
+        rc = RC_MEMORY_ALLOCATION_ERROR;
+    }
+    for (uint16_t i = 0; (rc == RC_OK) && (i < numIndexes); i++) {
+        rc = GetIndex(i)->Reserve(numRows);
+    }
+
+    uint32_t nextRow = 0;
+    while ((rc == RC_OK) && (nextRow < numRows)) {
+        // a failed insert releases the row by itself
+        rc = InsertRow(rows[nextRow++], txn);
+    }
+
+    // release the rows that were not handed over to the transaction
+    for (; nextRow < numRows; nextRow++) {
+        DestroyRow(rows[nextRow]);
+    }
+    return rc;
+}
+
 Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
 {
     MaxKey key;
@@ -596,6 +623,19 @@ Row* Table::RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcMan
     return OutputRow;
 }
 
+void Table::AddCheckpointTombstone(std::string&& key, bool generation)
+{
+    std::lock_guard<spin_lock> lock(m_checkpointTombstonesLock);
+    m_checkpointTombstones[generation ? 1 : 0].push_back(std::move(key));
+}
+
+void Table::TakeCheckpointTombstones(bool generation, std::vector<std::string>& keys)
+{
+    keys.clear();
+    std::lock_guard<spin_lock> lock(m_checkpointTombstonesLock);
+    keys.swap(m_checkpointTombstones[generation ? 1 : 0]);
+}
+
 Row* Table::CreateNewRow()
 {
     Row* row = m_rowPool->Alloc<Row>(this);
@@ -783,11 +823,14 @@ void Table::Truncate(TxnManager* txn)
 void Table::Compact(TxnManager* txn)
 {
     uint32_t pid = txn->GetThdId();
-    // first destroy secondary index data
+    // rows are read concurrently to the compaction, so the GC must take this session into account.
+    // Relocated objects are retired to this session and released by the GC once no reader can
+    // still hold them, pools they keep alive are released by a later compaction.
+    txn->GcSessionStart();
     for (int i = 0; i < m_numIndexes; i++) {
-        GcManager::ClearIndexElements(m_indexes[i]->GetIndexId(), false);
-        m_indexes[i]->Compact(this, pid);
+        m_indexes[i]->Compact(this, pid, txn->GetGcSession());
     }
+    txn->GcSessionEnd();
 }
 
 uint64_t Table::GetTableSize()
@@ -812,6 +855,14 @@ uint64_t Table::GetTableSize()
     return res;
 }
 
+void Table::GetRowPoolStats(PoolStatsSt& stats)
+{
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_rowPool->GetStats(stats);
+}
+
 size_t Table::SerializeItemSize(Column* column)
 {
     size_t ret = SerializableARR<char, Column::MAX_COLUMN_NAME_LEN>::SerializeSize(column->m_name) +
@@ -855,6 +906,11 @@ size_t Table::SerializeItemSize(MOT::Index* index)
                  SerializablePOD<bool>::SerializeSize(index->m_fake) +
                  SerializableARR<uint16_t, MAX_KEY_COLUMNS>::SerializeSize(index->m_lengthKeyFields) +
                  SerializableARR<int16_t, MAX_KEY_COLUMNS>::SerializeSize(index->m_columnKeyFields);
+    if (index->m_numCoveringFields > 0) {
+        ret += SerializablePOD<int16_t>::SerializeSize(index->m_numCoveringFields) +
+               SerializableARR<uint16_t, MAX_COVERING_COLUMNS>::SerializeSize(index->m_lengthCoveringFields) +
+               SerializableARR<int16_t, MAX_COVERING_COLUMNS>::SerializeSize(index->m_columnCoveringFields);
+    }
     return ret;
 }
 
@@ -867,17 +923,26 @@ char* Table::SerializeItem(char* dataOut, MOT::Index* index)
     if (!index->GetUnique()) {
         keyLength -= NON_UNIQUE_INDEX_SUFFIX_LEN;
     }
+    int16_t numKeyFields = index->m_numKeyFields;
+    if (index->m_numCoveringFields > 0) {
+        numKeyFields |= INDEX_META_COVERING_FLAG;
+    }
     dataOut = SerializableSTR::Serialize(dataOut, index->m_name);
     dataOut = SerializablePOD<uint32_t>::Serialize(dataOut, keyLength);
     dataOut = SerializablePOD<IndexOrder>::Serialize(dataOut, index->m_indexOrder);
     dataOut = SerializablePOD<IndexingMethod>::Serialize(dataOut, index->m_indexingMethod);
     dataOut = SerializablePOD<uint64_t>::Serialize(dataOut, index->m_indexExtId);
     dataOut = SerializablePOD<bool>::Serialize(dataOut, index->GetUnique());
-    dataOut = SerializablePOD<int16_t>::Serialize(dataOut, index->m_numKeyFields);
+    dataOut = SerializablePOD<int16_t>::Serialize(dataOut, numKeyFields);
     dataOut = SerializablePOD<uint32_t>::Serialize(dataOut, index->m_numTableFields);
     dataOut = SerializablePOD<bool>::Serialize(dataOut, index->m_fake);
     dataOut = SerializableARR<uint16_t, MAX_KEY_COLUMNS>::Serialize(dataOut, index->m_lengthKeyFields);
     dataOut = SerializableARR<int16_t, MAX_KEY_COLUMNS>::Serialize(dataOut, index->m_columnKeyFields);
+    if (index->m_numCoveringFields > 0) {
+        dataOut = SerializablePOD<int16_t>::Serialize(dataOut, index->m_numCoveringFields);
+        dataOut = SerializableARR<uint16_t, MAX_COVERING_COLUMNS>::Serialize(dataOut, index->m_lengthCoveringFields);
+        dataOut = SerializableARR<int16_t, MAX_COVERING_COLUMNS>::Serialize(dataOut, index->m_columnCoveringFields);
+    }
     return dataOut;
 }
 
@@ -942,6 +1007,15 @@ char* Table::DesrializeMeta(char* dataIn, CommonIndexMeta& meta)
     dataIn = SerializablePOD<bool>::Deserialize(dataIn, meta.m_fake);
     dataIn = SerializableARR<uint16_t, MAX_KEY_COLUMNS>::Deserialize(dataIn, meta.m_lengthKeyFields);
     dataIn = SerializableARR<int16_t, MAX_KEY_COLUMNS>::Deserialize(dataIn, meta.m_columnKeyFields);
+    if (meta.m_numKeyFields & INDEX_META_COVERING_FLAG) {
+        meta.m_numKeyFields &= ~INDEX_META_COVERING_FLAG;
+        dataIn = SerializablePOD<int16_t>::Deserialize(dataIn, meta.m_numCoveringFields);
+        dataIn = SerializableARR<uint16_t, MAX_COVERING_COLUMNS>::Deserialize(dataIn, meta.m_lengthCoveringFields);
+        dataIn = SerializableARR<int16_t, MAX_COVERING_COLUMNS>::Deserialize(dataIn, meta.m_columnCoveringFields);
+    } else {
+        // metadata of an index without covering fields, possibly written before covering indexes existed
+        meta.m_numCoveringFields = 0;
+    }
     MOT_LOG_DEBUG("%s: %s keyLen: %d Unique: %u", __func__, meta.m_name.c_str(), meta.m_keyLength, meta.m_unique);
     return dataIn;
 }
@@ -982,6 +1056,10 @@ RC Table::CreateIndexFromMeta(CommonIndexMeta& meta, bool primary, uint32_t tid,
     }
     ix->SetFakePrimary(meta.m_fake);
     ix->SetNumIndexFields(meta.m_numKeyFields);
+    for (int i = 0; i < meta.m_numCoveringFields; i++) {
+        ix->SetCoveringField(i, meta.m_columnCoveringFields[i], meta.m_lengthCoveringFields[i]);
+    }
+    ix->SetNumCoveringFields(meta.m_numCoveringFields);
     ix->SetTable(this);
     ix->SetExtId(meta.m_indexExtId);
     if (ix->IndexInit(meta.m_keyLength, meta.m_unique, meta.m_name, nullptr) != RC_OK) {
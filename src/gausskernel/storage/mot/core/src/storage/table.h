@@ -30,6 +30,7 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <vector>
 #include <pthread.h>
 #include "global.h"
 #include "sentinel.h"
@@ -41,6 +42,7 @@
 #include "serializable.h"
 #include "object_pool.h"
 #include "mm_gc_manager.h"
+#include "spin_lock.h"
 
 namespace MOT {
 class Row;
@@ -602,6 +604,17 @@ public:
      */
     RC InsertRow(Row* row, TxnManager* txn);
 
+    /**
+     * @brief Inserts a batch of new rows into transactional storage (bulk load). The transaction access set and the
+     * indexes are sized once for the entire batch.
+     * @param rows The new rows to be inserted. The batch takes ownership of all rows, including those that were not
+     * inserted due to an error.
+     * @param numRows The number of rows in the batch.
+     * @param txn The txn manager object.
+     * @return Status of the operation. Insertion stops at the first failed row.
+     */
+    RC InsertRowBatch(Row** rows, uint32_t numRows, TxnManager* txn);
+
     /**
      * @brief Create new row placeholder
      * @return The newly created row.
@@ -779,6 +792,12 @@ public:
      */
     uint64_t GetTableSize();
 
+    /**
+     * @brief Retrieves the statistics of the table row pool, used for reporting memory fragmentation.
+     * @param[out] stats Receives the row pool statistics.
+     */
+    void GetRowPoolStats(PoolStatsSt& stats);
+
     /**
      * @brief Returns index size in memory
      */
@@ -801,6 +820,18 @@ public:
         (void)pthread_rwlock_rdlock(&m_rwLock);
     }
 
+    /**
+     * @brief tries to takes a read lock on the table.
+     * @return True on success, False if the lock could not be acquired.
+     */
+    bool RdTryLock()
+    {
+        if (pthread_rwlock_tryrdlock(&m_rwLock) != 0) {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief tries to takes a write lock on the table.
      * @return True on success, False if the lock could not be acquired.
@@ -850,6 +881,38 @@ public:
 
     Row* RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcManager* gc);
 
+    /**
+     * @brief Records the primary key of a row deleted by a committing transaction, so that the
+     * delete can be carried by the next delta checkpoint.
+     * @param key The primary key buffer of the deleted row (moved into the table).
+     * @param generation The checkpoint generation (available bit) the delete belongs to.
+     */
+    void AddCheckpointTombstone(std::string&& key, bool generation);
+
+    /**
+     * @brief Moves out all the deleted keys recorded for a checkpoint generation.
+     * @param generation The checkpoint generation (available bit).
+     * @param keys Receives the recorded keys.
+     */
+    void TakeCheckpointTombstones(bool generation, std::vector<std::string>& keys);
+
+    /**
+     * @brief Marks that the next checkpoint must write the whole table and not only the changed rows.
+     */
+    inline void SetCheckpointFullImage()
+    {
+        m_checkpointFullImage = true;
+    }
+
+    /**
+     * @brief Checks and clears the full-image mark of the table.
+     * @return True if the next checkpoint must write the whole table.
+     */
+    inline bool TestAndClearCheckpointFullImage()
+    {
+        return m_checkpointFullImage.exchange(false);
+    }
+
 private:
     inline MOT::ObjAllocInterface* GetRowPool()
     {
@@ -931,6 +994,15 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Primary keys of the rows deleted since the last checkpoint, per checkpoint generation. */
+    std::vector<std::string> m_checkpointTombstones[2];
+
+    /** @var Guards the deleted keys lists. */
+    spin_lock m_checkpointTombstonesLock;
+
+    /** @var Specifies whether the next delta checkpoint must write the whole table (e.g. after truncate). */
+    std::atomic<bool> m_checkpointFullImage{false};
+
     DECLARE_CLASS_LOGGER();
 
 public:
@@ -980,8 +1052,21 @@ public:
         uint16_t m_lengthKeyFields[MAX_KEY_COLUMNS];
 
         int16_t m_columnKeyFields[MAX_KEY_COLUMNS];
+
+        int16_t m_numCoveringFields;
+
+        uint16_t m_lengthCoveringFields[MAX_COVERING_COLUMNS];
+
+        int16_t m_columnCoveringFields[MAX_COVERING_COLUMNS];
     };
 
+    /**
+     * @brief Flag set in the serialized number of key fields of an index that has covering fields. The covering
+     * fields are serialized only when it is set, so metadata written before covering indexes existed (and of
+     * indexes without covering fields) keeps the original layout.
+     */
+    static constexpr int16_t INDEX_META_COVERING_FLAG = 0x4000;
+
     /**
      * @brief returns the serialized size of a column
      * @param column the column to work on
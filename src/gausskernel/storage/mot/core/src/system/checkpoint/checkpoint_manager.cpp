@@ -34,6 +34,7 @@
 #include "table.h"
 #include "index.h"
 #include <list>
+#include <map>
 #include <algorithm>
 
 namespace MOT {
@@ -57,7 +58,12 @@ CheckpointManager::CheckpointManager()
       m_id(CheckpointControlFile::invalidId),
       m_inProgressId(CheckpointControlFile::invalidId),
       m_lastReplayLsn(0),
-      m_emptyCheckpoint(false)
+      m_emptyCheckpoint(false),
+      m_deltaEnabled(GetGlobalConfiguration().m_enableDeltaCheckpoint),
+      m_maxDeltaCheckpoints(GetGlobalConfiguration().m_maxDeltaCheckpoints),
+      m_snapshotCsn(0),
+      m_deltaBaseCsn(0),
+      m_deltaChainCsn(0)
 {}
 
 bool CheckpointManager::Initialize()
@@ -109,6 +115,13 @@ bool CheckpointManager::CreateSnapShot()
     // phase that are not yet completed
     WaitPrevPhaseCommittedTxnComplete();
 
+    // On standby, redo transactions might be replayed out of log order by parallel replay workers. Hold back replay
+    // until the snapshot is captured, so that the captured data and the last replay LSN describe a prefix of the log.
+    bool replaySuspended = MOTEngine::GetInstance()->IsRecovering();
+    if (replaySuspended) {
+        GetRecoveryManager()->SuspendRedoReplay();
+    }
+
     // Move to PREPARE phase
     m_lock.WrLock();
     MoveToNextPhase();
@@ -131,6 +144,10 @@ bool CheckpointManager::CreateSnapShot()
     MoveToNextPhase();
     m_lock.WrUnlock();
 
+    if (replaySuspended) {
+        GetRecoveryManager()->ResumeRedoReplay();
+    }
+
     return !m_errorSet;
 }
 
@@ -177,6 +194,12 @@ bool CheckpointManager::BeginCheckpoint()
         CompleteCheckpoint();
     }
 
+    if (m_errorSet) {
+        // No locking required here, as the checkpoint workers have already exited.
+        DiscardTombstones(m_tasksList);
+        ResetDeltaChain();
+    }
+
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
     m_numCpTasks = 0;
@@ -215,6 +238,8 @@ bool CheckpointManager::Abort()
         WaitPrevPhaseCommittedTxnComplete();
 
         // No locking required here, as there no checkpoint workers when the control reaches here.
+        DiscardTombstones(m_tasksList);
+        ResetDeltaChain();
         UnlockAndClearTables(m_tasksList);
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
@@ -447,9 +472,113 @@ void CheckpointManager::FillTasksQueue()
     GetTableManager()->AddTablesToList(m_tasksList);
     m_numCpTasks = m_tasksList.size();
     m_mapfileInfo.clear();
+    m_currentLayer.clear();
+    PrepareDeltaCheckpoint();
     MOT_LOG_DEBUG("CheckpointManager::fillTasksQueue:: got %d tasks", m_tasksList.size());
 }
 
+void CheckpointManager::PrepareDeletes(TxnManager* txnMan)
+{
+    txnMan->m_checkpointDeletes.clear();
+    if (!m_deltaEnabled || MOTEngine::GetInstance()->IsRecovering()) {
+        // checkpoints taken during recovery are always full checkpoints
+        return;
+    }
+
+    MaxKey key;
+    TxnOrderedSet_t& orderedSet = txnMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        const Access* access = raPair.second;
+        if (access->m_type != DEL || !access->m_params.IsPrimarySentinel()) {
+            continue;
+        }
+        Row* origRow = access->GetRowFromHeader();
+        Table* table = origRow->GetTable();
+        Index* index = table->GetPrimaryIndex();
+        key.InitKey(index->GetKeyLength());
+        index->BuildKey(table, origRow, &key);
+        txnMan->m_checkpointDeletes.emplace_back(
+            table, std::string((const char*)key.GetKeyBuf(), key.GetKeyLength()));
+    }
+}
+
+void CheckpointManager::RecordDeletes(TxnManager* txnMan)
+{
+    if (txnMan->m_checkpointDeletes.empty()) {
+        return;
+    }
+
+    // Transactions that started commit in CAPTURE or COMPLETE phase are not part of the current
+    // checkpoint, their deletes belong to the next one (which uses the other available bit).
+    CheckpointPhase startPhase = txnMan->m_checkpointPhase;
+    bool generation = !txnMan->m_checkpointNABit;
+    if (startPhase == CAPTURE || startPhase == COMPLETE) {
+        generation = !generation;
+    }
+
+    for (auto& tombstone : txnMan->m_checkpointDeletes) {
+        tombstone.first->AddCheckpointTombstone(std::move(tombstone.second), generation);
+    }
+    txnMan->m_checkpointDeletes.clear();
+}
+
+void CheckpointManager::PrepareDeltaCheckpoint()
+{
+    // No transaction is committing in RESOLVE phase: all the transactions that are part of this checkpoint
+    // already have a CSN, and all the others will get a higher one.
+    m_snapshotCsn = GetCSNManager().GetCurrentCSN();
+    m_deltaBaseCsn = 0;
+    m_deltaBaseTables.clear();
+
+    if (!m_deltaEnabled || m_deltaChain.empty() || MOTEngine::GetInstance()->IsRecovering()) {
+        return;
+    }
+
+    // the first layer of the chain is the full checkpoint
+    if (m_deltaChain.size() > m_maxDeltaCheckpoints) {
+        MOT_LOG_INFO("Checkpoint %lu: delta chain reached %u checkpoints, taking a full checkpoint",
+            m_inProgressId,
+            m_maxDeltaCheckpoints);
+        return;
+    }
+
+    for (const DeltaLayerEntry& entry : m_deltaChain.back().m_entries) {
+        (void)m_deltaBaseTables.insert(entry.m_tableId);
+    }
+    m_deltaBaseCsn = m_deltaChainCsn;
+    MOT_LOG_INFO("Checkpoint %lu: delta on top of checkpoint %lu (CSN %lu - %lu)",
+        m_inProgressId,
+        m_id,
+        m_deltaBaseCsn,
+        m_snapshotCsn);
+}
+
+uint64_t CheckpointManager::GetDeltaBaseCsn(Table* table)
+{
+    // a full image is written below if the mark is set, so it can be cleared
+    bool fullImage = table->TestAndClearCheckpointFullImage();
+    if (fullImage || m_deltaBaseCsn == 0 || m_deltaBaseTables.count(table->GetTableId()) == 0) {
+        return 0;
+    }
+    return m_deltaBaseCsn;
+}
+
+void CheckpointManager::ResetDeltaChain()
+{
+    m_deltaChain.clear();
+    m_deltaChainCsn = 0;
+}
+
+void CheckpointManager::DiscardTombstones(std::list<Table*>& tables)
+{
+    std::vector<std::string> keys;
+    for (Table* table : tables) {
+        if (table != nullptr) {
+            table->TakeCheckpointTombstones(m_availableBit, keys);
+        }
+    }
+}
+
 void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
 {
     std::list<Table*>::iterator it;
@@ -462,7 +591,8 @@ void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
     tables.clear();
 }
 
-void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
+void CheckpointManager::TaskDone(
+    Table* table, uint32_t numSegs, bool success, uint32_t deltaFlags, uint32_t numTombstones)
 {
     MOT_ASSERT(table);
     if (success) { /* only successful tasks are added to the map file */
@@ -477,6 +607,7 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
             MOT_LOG_DEBUG("TaskDone %lu: %u %u segs", m_inProgressId, entry->m_tableId, numSegs);
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
+            m_currentLayer.push_back({entry->m_tableId, numSegs, deltaFlags, numTombstones});
             m_finishedTasks.push_back(table);
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry");
@@ -502,6 +633,12 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    std::vector<DeltaLayer> deltaChain;
+    if (m_deltaEnabled && !CreateDeltaChain(deltaChain)) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta chain");
+        return;
+    }
+
     if (!CreateCheckpointMap()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create map file");
         return;
@@ -540,6 +677,15 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    // a checkpoint taken during recovery can not serve as a delta base, the CSN of replayed
+    // transactions does not follow the checkpoint phases
+    if (m_deltaEnabled && !MOTEngine::GetInstance()->IsRecovering()) {
+        m_deltaChain.swap(deltaChain);
+        m_deltaChainCsn = m_snapshotCsn;
+    } else {
+        ResetDeltaChain();
+    }
+
     RemoveOldCheckpoints(m_inProgressId);
     MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
 }
@@ -661,6 +807,151 @@ void CheckpointManager::RemoveCheckpointDir(uint64_t checkpointId)
     }
 }
 
+bool CheckpointManager::CreateDeltaChain(std::vector<DeltaLayer>& chain)
+{
+    chain.clear();
+    if (m_deltaBaseCsn != 0) {
+        std::string prevDir;
+        std::string workingDir;
+        if (!CheckpointUtils::SetWorkingDir(prevDir, m_id) ||
+            !CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            MOT_LOG_ERROR("CreateDeltaChain: failed to set working directory");
+            return false;
+        }
+
+        // the layer of the last full image of each table, older layers are not needed
+        std::map<uint32_t, size_t> firstLayer;
+        for (size_t i = 0; i < m_deltaChain.size(); i++) {
+            for (const DeltaLayerEntry& entry : m_deltaChain[i].m_entries) {
+                if (entry.m_flags & CheckpointUtils::DELTA_ENTRY_FULL_IMAGE) {
+                    firstLayer[entry.m_tableId] = i;
+                }
+            }
+        }
+
+        // tables that were dropped or fully written by this checkpoint do not need older layers
+        std::set<uint32_t> deltaTables;
+        for (const DeltaLayerEntry& entry : m_currentLayer) {
+            if (!(entry.m_flags & CheckpointUtils::DELTA_ENTRY_FULL_IMAGE)) {
+                (void)deltaTables.insert(entry.m_tableId);
+            }
+        }
+
+        std::string srcFile;
+        std::string dstFile;
+        for (size_t i = 0; i < m_deltaChain.size(); i++) {
+            uint64_t layerId = m_deltaChain[i].m_checkpointId;
+            DeltaLayer layer{layerId, {}};
+            for (const DeltaLayerEntry& entry : m_deltaChain[i].m_entries) {
+                auto it = firstLayer.find(entry.m_tableId);
+                if (deltaTables.count(entry.m_tableId) == 0 || it == firstLayer.end() || it->second > i) {
+                    continue;
+                }
+
+                for (uint32_t seg = 0; seg <= entry.m_maxSegId; seg++) {
+                    if (layerId == m_id) {
+                        CheckpointUtils::MakeCpFilename(entry.m_tableId, srcFile, prevDir, seg);
+                    } else {
+                        CheckpointUtils::MakeLayerCpFilename(layerId, entry.m_tableId, srcFile, prevDir, seg);
+                    }
+                    CheckpointUtils::MakeLayerCpFilename(layerId, entry.m_tableId, dstFile, workingDir, seg);
+                    if (!CheckpointUtils::LinkFile(srcFile, dstFile)) {
+                        MOT_LOG_ERROR("CreateDeltaChain: failed to link %s", srcFile.c_str());
+                        return false;
+                    }
+                }
+
+                if (entry.m_numTombstones > 0) {
+                    if (layerId == m_id) {
+                        CheckpointUtils::MakeTombstoneFilename(entry.m_tableId, srcFile, prevDir);
+                    } else {
+                        CheckpointUtils::MakeLayerTombstoneFilename(layerId, entry.m_tableId, srcFile, prevDir);
+                    }
+                    CheckpointUtils::MakeLayerTombstoneFilename(layerId, entry.m_tableId, dstFile, workingDir);
+                    if (!CheckpointUtils::LinkFile(srcFile, dstFile)) {
+                        MOT_LOG_ERROR("CreateDeltaChain: failed to link %s", srcFile.c_str());
+                        return false;
+                    }
+                }
+                layer.m_entries.push_back(entry);
+            }
+
+            if (!layer.m_entries.empty()) {
+                chain.push_back(std::move(layer));
+            }
+        }
+    }
+
+    chain.push_back({m_inProgressId, m_currentLayer});
+
+    // a checkpoint without older layers is a regular (full) checkpoint
+    if (chain.size() == 1) {
+        return true;
+    }
+    return CreateDeltaFile(chain);
+}
+
+bool CheckpointManager::CreateDeltaFile(const std::vector<DeltaLayer>& chain)
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeDeltaFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateDeltaFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::DeltaFileHeader deltaFileHeader{CP_MGR_MAGIC, m_snapshotCsn, chain.size()};
+        if (CheckpointUtils::WriteFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+            sizeof(CheckpointUtils::DeltaFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to write delta file's header");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool writeFailed = false;
+        for (const DeltaLayer& layer : chain) {
+            CheckpointUtils::DeltaLayerHeader layerHeader{layer.m_checkpointId, layer.m_entries.size()};
+            size_t entriesSize = layer.m_entries.size() * sizeof(DeltaLayerEntry);
+            if (CheckpointUtils::WriteFile(fd, (char*)&layerHeader, sizeof(CheckpointUtils::DeltaLayerHeader)) !=
+                    sizeof(CheckpointUtils::DeltaLayerHeader) ||
+                (entriesSize > 0 &&
+                    CheckpointUtils::WriteFile(fd, (char*)layer.m_entries.data(), entriesSize) != entriesSize)) {
+                MOT_LOG_ERROR("CreateDeltaFile: failed to write layer %lu", layer.m_checkpointId);
+                writeFailed = true;
+                break;
+            }
+        }
+        if (writeFailed) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to flush delta file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to close delta file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
 bool CheckpointManager::CreateCheckpointMap()
 {
     int fd = -1;
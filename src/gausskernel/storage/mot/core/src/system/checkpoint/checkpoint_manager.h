@@ -33,6 +33,8 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <set>
+#include <vector>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -109,14 +111,36 @@ public:
      */
     void ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Builds the primary keys of the rows deleted by a committing transaction, for the next
+     * delta checkpoint. This is done before the transaction locks its rows.
+     * @param txnMan Transaction's TxnManger pointer.
+     */
+    void PrepareDeletes(TxnManager* txnMan);
+
+    /**
+     * @brief Records the keys prepared by PrepareDeletes() in the checkpoint generation of the transaction.
+     * @param txnMan Transaction's TxnManger pointer.
+     */
+    void RecordDeletes(TxnManager* txnMan);
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
      * @param numSegs number of segments written.
      * @param success Indicates a success or a failure.
+     * @param deltaFlags The delta layer flags of the table.
+     * @param numTombstones number of deleted keys written.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
+    virtual void TaskDone(Table* table, uint32_t numSegs, bool success, uint32_t deltaFlags, uint32_t numTombstones);
+
+    /**
+     * @brief Retrieves the CSN above which rows of the table should be written.
+     * @param table The table's pointer.
+     * @return The snapshot CSN of the previous checkpoint, or zero if all the rows should be written.
+     */
+    virtual uint64_t GetDeltaBaseCsn(Table* table);
 
     virtual bool ShouldStop() const
     {
@@ -199,6 +223,22 @@ public:
         uint32_t m_maxSegId;
     };
 
+    struct DeltaLayerEntry {
+        uint32_t m_tableId;
+        uint32_t m_maxSegId;
+        uint32_t m_flags;
+        uint32_t m_numTombstones;
+    };
+
+    /**
+     * @struct DeltaLayer
+     * @brief The tables data written by one checkpoint of a delta chain.
+     */
+    struct DeltaLayer {
+        uint64_t m_checkpointId;
+        std::vector<DeltaLayerEntry> m_entries;
+    };
+
 private:
     RwLock m_lock;
 
@@ -273,6 +313,30 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // Delta checkpoint is enabled
+    bool m_deltaEnabled;
+
+    // Maximum number of delta checkpoints on top of a full checkpoint
+    uint32_t m_maxDeltaCheckpoints;
+
+    // The CSN of the last transaction included in the current checkpoint
+    uint64_t m_snapshotCsn;
+
+    // Rows with a CSN above this value are written by the current checkpoint (zero for a full checkpoint)
+    uint64_t m_deltaBaseCsn;
+
+    // Snapshot CSN of the last valid checkpoint, if it can serve as a delta base
+    uint64_t m_deltaChainCsn;
+
+    // Layers of the last valid checkpoint, oldest (full) first. Empty if it can not serve as a delta base
+    std::vector<DeltaLayer> m_deltaChain;
+
+    // Tables of the last valid checkpoint (the ones rows may be written as delta)
+    std::set<uint32_t> m_deltaBaseTables;
+
+    // Layer of the current checkpoint, filled as tables are done
+    std::vector<DeltaLayerEntry> m_currentLayer;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
@@ -398,6 +462,38 @@ private:
      * @param checkpointId The checkpoint id to be deleted.
      */
     void RemoveCheckpointDir(uint64_t checkpointId);
+
+    /**
+     * @brief Decides whether the current checkpoint is a delta on top of the last valid
+     * checkpoint. Called in RESOLVE phase, when no transaction is committing.
+     */
+    void PrepareDeltaCheckpoint();
+
+    /**
+     * @brief Links the files of the previous layers of the delta chain into the current checkpoint
+     * directory and writes the delta chain file.
+     * @param chain The returned delta chain of the current checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaChain(std::vector<DeltaLayer>& chain);
+
+    /**
+     * @brief Writes the delta chain file of the current checkpoint.
+     * @param chain The delta chain to write.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFile(const std::vector<DeltaLayer>& chain);
+
+    /**
+     * @brief Drops the delta chain, so the next checkpoint is a full checkpoint.
+     */
+    void ResetDeltaChain();
+
+    /**
+     * @brief Drops the deleted keys recorded for the current checkpoint in tables that were not checkpointed.
+     * @param tables Tables that were not checkpointed.
+     */
+    void DiscardTombstones(std::list<Table*>& tables);
 };
 }  // namespace MOT
 
@@ -141,6 +141,16 @@ bool SeekFile(int fd, uint64_t offset)
     return (rc != -1);
 }
 
+bool LinkFile(std::string srcFileName, std::string dstFileName)
+{
+    int rc = link(srcFileName.c_str(), dstFileName.c_str());
+    if (rc != 0) {
+        MOT_REPORT_SYSTEM_ERROR(
+            link, "N/A", "Failed to link file %s to %s", srcFileName.c_str(), dstFileName.c_str());
+    }
+    return (rc == 0);
+}
+
 bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
@@ -124,6 +124,14 @@ int FlushFile(int fd);
  */
 bool SeekFile(int fd, uint64_t offset);
 
+/**
+ * @brief A wrapper function that creates a hard link to a file.
+ * @param srcFileName The existing file name.
+ * @param dstFileName The new link name.
+ * @return Boolean value denoting success or failure.
+ */
+bool LinkFile(std::string srcFileName, std::string dstFileName);
+
 /**
  * @brief Frees a row's stable version row.
  * @param row The row which stable version needs to be freed.
@@ -180,6 +188,15 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Delta chain file suffix
+static const char* deltaFileSuffix = ".dlt";
+
+// Deleted keys (tombstones) file suffix
+static const char* tombstoneFileSuffix = ".dl";
+
+// Prefix of files linked from previous checkpoints of a delta chain
+static const char* layerFilePrefix = "d";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -261,6 +278,59 @@ inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string&
     fileName.append(cpFileSuffix);
 }
 
+/**
+ * @brief Creates a filename of a checkpoint seg that was linked from a previous checkpoint of a delta chain
+ * @param layerId The id of the checkpoint that created the seg.
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param seg The segment number.
+ */
+inline void MakeLayerCpFilename(
+    uint64_t layerId, uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(layerFilePrefix);
+    fileName.append(std::to_string(layerId));
+    fileName.append("_tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append("_");
+    fileName.append(std::to_string(seg));
+    fileName.append(cpFileSuffix);
+}
+
+/**
+ * @brief Creates a deleted keys (tombstones) filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ */
+inline void MakeTombstoneFilename(uint64_t tableId, std::string& fileName, std::string& workingDir)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append(tombstoneFileSuffix);
+}
+
+/**
+ * @brief Creates a filename of a deleted keys file that was linked from a previous checkpoint of a delta chain
+ * @param layerId The id of the checkpoint that created the file.
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ */
+inline void MakeLayerTombstoneFilename(
+    uint64_t layerId, uint64_t tableId, std::string& fileName, std::string& workingDir)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(layerFilePrefix);
+    fileName.append(std::to_string(layerId));
+    fileName.append("_tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append(tombstoneFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint table metadata filename
  * @param tableId The tabled id that this file contains.
@@ -300,6 +370,19 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a delta chain filename according to the checkpoint id
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeDeltaFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(deltaFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -348,6 +431,20 @@ struct TpcEntryHeader {
     uint64_t m_len;
 };
 
+struct DeltaFileHeader {
+    uint64_t m_magic;
+    uint64_t m_snapshotCsn;
+    uint64_t m_numLayers;
+};
+
+struct DeltaLayerHeader {
+    uint64_t m_checkpointId;
+    uint64_t m_numEntries;
+};
+
+// The layer holds a complete image of the table (rows of older layers are not applied)
+static const uint32_t DELTA_ENTRY_FULL_IMAGE = 0x1;
+
 /**
  * @brief Produces a pretty hex printout of a given buffer to stderr
  * @param msg A text the will be displayed before the hex data printout.
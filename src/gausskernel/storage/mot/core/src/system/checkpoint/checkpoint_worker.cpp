@@ -124,7 +124,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(
+    Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, uint64_t baseCsn)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -165,15 +166,17 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
-                wrote = -1;
-            } else {
-                if (isDeleted == false) {
-                    CheckpointUtils::DestroyStableRow(stableRow);
-                    sentinel->SetStable(nullptr);
+            if (stableRow->GetCommitSequenceNumber() > baseCsn) {
+                if (!Write(buffer, stableRow, fd)) {
+                    wrote = -1;
+                    break;
                 }
                 wrote = 1;
             }
+            if (isDeleted == false) {
+                CheckpointUtils::DestroyStableRow(stableRow);
+                sentinel->SetStable(nullptr);
+            }
             break;
         } else { /* no stable version */
             if (stableRow == nullptr) {
@@ -182,6 +185,10 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
+                if (mainRow->GetCommitSequenceNumber() <= baseCsn) {
+                    // not changed since the previous checkpoint, which already holds this row
+                    break;
+                }
                 if (!Write(buffer, mainRow, fd)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
@@ -272,10 +279,12 @@ void CheckpointWorkerPool::WorkerFunc()
         return;
     }
 
+    std::vector<std::string> tombstones;
     while (true) {
         uint32_t tableId = 0;
         uint64_t exId = 0;
         uint32_t maxSegId = 0;
+        uint64_t baseCsn = 0;
         bool taskSucceeded = false;
 
         if (m_cpManager.ShouldStop()) {
@@ -288,6 +297,10 @@ void CheckpointWorkerPool::WorkerFunc()
                 tableId = table->GetTableId();
                 exId = table->GetTableExId();
 
+                // deletes committed before the snapshot, the list must be drained even for a full image
+                table->TakeCheckpointTombstones(!m_na, tombstones);
+                baseCsn = m_cpManager.GetDeltaBaseCsn(table);
+
                 ErrCodes errCode = WriteTableMetadataFile(table);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
@@ -301,7 +314,8 @@ void CheckpointWorkerPool::WorkerFunc()
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode =
+                    WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, baseCsn, maxSegId, numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -310,6 +324,21 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (baseCsn == 0) {
+                    // a full image of the table, older deletes are irrelevant
+                    tombstones.clear();
+                } else if (!tombstones.empty()) {
+                    errCode = WriteTableTombstonesFile(table, &buffer, tombstones);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: failed to write tombstones file for table %u",
+                            tableId);
+                        m_cpManager.OnError(errCode,
+                            "Failed to write table tombstones file for table - ",
+                            std::to_string(tableId).c_str());
+                        break;
+                    }
+                }
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -317,14 +346,20 @@ void CheckpointWorkerPool::WorkerFunc()
                  * (/1000) is to convert nano seconds to micro seconds
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-                MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu elements)",
+                MOT_LOG_DEBUG("CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu "
+                              "elements, %lu deleted keys, %s)",
                     tableId,
                     deltaUs,
-                    numOps);
+                    numOps,
+                    tombstones.size(),
+                    (baseCsn == 0) ? "full" : "delta");
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            m_cpManager.TaskDone(table,
+                maxSegId,
+                taskSucceeded,
+                (baseCsn == 0) ? CheckpointUtils::DELTA_ENTRY_FULL_IMAGE : 0,
+                (uint32_t)tombstones.size());
 
             if (!taskSucceeded) {
                 break;
@@ -467,7 +502,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint64_t baseCsn, uint32_t& maxSegId,
+    uint64_t& numOps)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -508,7 +544,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, baseCsn);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -598,4 +634,60 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     numOps += currFileOps;
     return ErrCodes::SUCCESS;
 }
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableTombstonesFile(
+    Table* table, Buffer* buffer, const std::vector<std::string>& keys)
+{
+    uint32_t tableId = table->GetTableId();
+    uint64_t exId = table->GetTableExId();
+    int fd = -1;
+
+    std::string fileName;
+    CheckpointUtils::MakeTombstoneFilename(tableId, fileName, m_workingDir);
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to create file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+
+    // same layout as a data file, with key-only entries
+    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, keys.size()};
+    if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+        sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to write file header: %s",
+            fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return ErrCodes::FILE_IO;
+    }
+
+    buffer->Reset();
+    CheckpointUtils::EntryHeader entryHeader = {0};
+    for (const std::string& key : keys) {
+        if (buffer->Size() + sizeof(CheckpointUtils::EntryHeader) + key.length() > buffer->MaxSize() &&
+            !FlushBuffer(fd, buffer)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to write to file: %s",
+                fileName.c_str());
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::FILE_IO;
+        }
+        entryHeader.m_keyLen = (uint16_t)key.length();
+        if (!buffer->Append(&entryHeader, sizeof(CheckpointUtils::EntryHeader)) ||
+            !buffer->Append(key.data(), key.length())) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to write entry to buffer");
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::MEMORY;
+        }
+    }
+
+    if (!FlushBuffer(fd, buffer) || CheckpointUtils::FlushFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to flush file: %s", fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return ErrCodes::FILE_IO;
+    }
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableTombstonesFile: failed to close file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+    return ErrCodes::SUCCESS;
+}
 }  // namespace MOT
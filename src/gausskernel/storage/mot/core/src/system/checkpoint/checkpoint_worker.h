@@ -51,8 +51,18 @@ public:
      * @param table The table's pointer.
      * @param numSegs number of segments written.
      * @param success Indicates a success or a failure.
+     * @param deltaFlags The delta layer flags of the table (CheckpointUtils::DELTA_ENTRY_*).
+     * @param numTombstones number of deleted keys written.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
+    virtual void TaskDone(
+        Table* table, uint32_t numSegs, bool success, uint32_t deltaFlags, uint32_t numTombstones) = 0;
+
+    /**
+     * @brief Retrieves the CSN above which rows of the table should be written.
+     * @param table The table's pointer.
+     * @return The snapshot CSN of the previous checkpoint, or zero if all the rows should be written.
+     */
+    virtual uint64_t GetDeltaBaseCsn(Table* table) = 0;
 
     /**
      * @brief Checks if the thread should terminate it work
@@ -114,9 +124,10 @@ private:
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param baseCsn Rows with a CSN not above this value are not written (delta checkpoint).
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, uint64_t baseCsn);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -167,12 +178,22 @@ private:
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
+     * @param baseCsn Rows with a CSN not above this value are not written (delta checkpoint).
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint64_t baseCsn, uint32_t& maxSegId, uint64_t& numOps);
+
+    /**
+     * @brief Writes the keys of the rows deleted since the previous checkpoint to the table's tombstones file.
+     * @param table The table's pointer.
+     * @param buffer The buffer to fill.
+     * @param keys The deleted keys.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableTombstonesFile(Table* table, Buffer* buffer, const std::vector<std::string>& keys);
 
     bool FlushBuffer(int fd, Buffer* buffer);
 
@@ -23,6 +23,8 @@
  */
 
 #include "table_manager.h"
+#include "string_buffer.h"
+#include "mm_def.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(TableManager, System);
@@ -61,6 +63,58 @@ void TableManager::ClearTablesThreadMemoryCache()
     m_rwLock.RdUnlock();
 }
 
+void TableManager::PrintTablesFragmentation(LogLevel logLevel)
+{
+    if (!MOT_CHECK_LOG_LEVEL(logLevel)) {
+        return;
+    }
+
+    StringBufferApply([this, logLevel](StringBuffer* stringBuffer) {
+        StringBufferAppend(stringBuffer, "Table Fragmentation Report:\n");
+        uint32_t fragmentedCount = 0;
+        uint64_t reclaimableBytes = 0;
+        m_rwLock.RdLock();
+        for (InternalTableMap::iterator it = m_tablesById.begin(); it != m_tablesById.end(); ++it) {
+            // never wait for a table under DDL, its statistics are reported next time
+            Table* table = it->second;
+            if (!table->RdTryLock()) {
+                continue;
+            }
+            PoolStatsSt stats;
+            table->GetRowPoolStats(stats);
+            table->Unlock();
+
+            // only pools that compaction can free are worth reporting
+            if (stats.m_perPoolTotalCount == 0 || stats.m_freeObjCount < stats.m_perPoolTotalCount) {
+                continue;
+            }
+            uint64_t reclaimablePools = stats.m_freeObjCount / stats.m_perPoolTotalCount;
+            uint64_t usedObjCount = stats.m_totalObjCount - stats.m_freeObjCount;
+            StringBufferAppend(stringBuffer,
+                "%*sTable %s: pools=%u (empty=%u), rows=%" PRIu64 ", utilization=%" PRIu64 "%%, reclaimable=%" PRIu64
+                " KB\n",
+                PRINT_REPORT_INDENT,
+                "",
+                table->GetLongTableName().c_str(),
+                stats.m_poolCount,
+                stats.m_poolFreeCount,
+                usedObjCount,
+                usedObjCount * 100 / stats.m_totalObjCount,
+                reclaimablePools * stats.m_poolGrossSize / KILO_BYTE);
+            ++fragmentedCount;
+            reclaimableBytes += reclaimablePools * stats.m_poolGrossSize;
+        }
+        m_rwLock.RdUnlock();
+        StringBufferAppend(stringBuffer,
+            "%*sTotal: %u fragmented tables, %" PRIu64 " MB reclaimable by compaction (VACUUM)\n",
+            PRINT_REPORT_INDENT,
+            "",
+            fragmentedCount,
+            reclaimableBytes / MEGA_BYTE);
+        MOT_LOG(logLevel, "\n%s", stringBuffer->m_buffer);
+    });
+}
+
 void TableManager::ClearAllTables()
 {
     // clear all table maps
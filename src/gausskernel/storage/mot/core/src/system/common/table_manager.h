@@ -200,6 +200,12 @@ public:
     /** @brief Clears all object-pool table caches for the current thread. */
     void ClearTablesThreadMemoryCache();
 
+    /**
+     * @brief Prints the row memory fragmentation of all tables that can be compacted.
+     * @param logLevel The log level used for printing.
+     */
+    void PrintTablesFragmentation(LogLevel logLevel);
+
     /** @brief Clears all tables and all releases all associated resources. */
     void ClearAllTables();
 
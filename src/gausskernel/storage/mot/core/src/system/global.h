@@ -288,6 +288,8 @@ inline void Prefetch(const void* ptr)
 /* Storage Params */
 #define MAX_NUM_INDEXES (10U)
 #define MAX_KEY_COLUMNS (10U)
+#define MAX_COVERING_COLUMNS (2 * MAX_KEY_COLUMNS)  // key columns and included columns
+#define MAX_COVERING_DATA_SIZE (1024U)              // in bytes, per secondary index entry
 #define MAX_TUPLE_SIZE 16384  // in bytes
 
 #define MAX_VARCHAR_LEN 1024
@@ -50,6 +50,7 @@ constexpr RedoLogHandlerType MOTConfiguration::DEFAULT_REDO_LOG_HANDLER_TYPE;
 constexpr uint32_t MOTConfiguration::DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
 constexpr uint32_t MOTConfiguration::MIN_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
 constexpr uint32_t MOTConfiguration::MAX_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_REDO_LOG_COMPRESSION;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_GROUP_COMMIT;
 constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_SIZE;
 constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_SIZE;
@@ -69,10 +70,17 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_MAX_DELTA_CHECKPOINTS;
+constexpr uint32_t MOTConfiguration::MIN_MAX_DELTA_CHECKPOINTS;
+constexpr uint32_t MOTConfiguration::MAX_MAX_DELTA_CHECKPOINTS;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_REDO_REPLAY_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_REDO_REPLAY_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_REDO_REPLAY_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -169,6 +177,11 @@ constexpr const char* MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD;
 constexpr uint64_t MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
+constexpr bool MOTConfiguration::DEFAULT_GC_ENABLE_BACKGROUND_RECLAIM;
+constexpr const char* MOTConfiguration::DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL;
+constexpr uint64_t MOTConfiguration::DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL_USEC;
+constexpr uint64_t MOTConfiguration::MIN_GC_BACKGROUND_RECLAIM_INTERVAL_USEC;
+constexpr uint64_t MOTConfiguration::MAX_GC_BACKGROUND_RECLAIM_INTERVAL_USEC;
 // JIT configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN;
 constexpr bool MOTConfiguration::DEFAULT_FORCE_MOT_PSEUDO_CODEGEN;
@@ -179,6 +192,13 @@ constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_HASH_PRIMARY_INDEX;
+constexpr uint32_t MOTConfiguration::DEFAULT_HASH_INDEX_BUCKET_COUNT;
+constexpr uint32_t MOTConfiguration::MIN_HASH_INDEX_BUCKET_COUNT;
+constexpr uint32_t MOTConfiguration::MAX_HASH_INDEX_BUCKET_COUNT;
+constexpr uint32_t MOTConfiguration::DEFAULT_BULK_INSERT_BATCH_SIZE;
+constexpr uint32_t MOTConfiguration::MIN_BULK_INSERT_BATCH_SIZE;
+constexpr uint32_t MOTConfiguration::MAX_BULK_INSERT_BATCH_SIZE;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -443,6 +463,7 @@ MOTConfiguration::MOTConfiguration()
       m_loggerType(DEFAULT_LOGGER_TYPE),
       m_redoLogHandlerType(DEFAULT_REDO_LOG_HANDLER_TYPE),
       m_asyncRedoLogBufferArrayCount(DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT),
+      m_enableRedoLogCompression(DEFAULT_ENABLE_REDO_LOG_COMPRESSION),
       m_enableGroupCommit(DEFAULT_ENABLE_GROUP_COMMIT),
       m_groupCommitSize(DEFAULT_GROUP_COMMIT_SIZE),
       m_groupCommitTimeoutUSec(DEFAULT_GROUP_COMMIT_TIMEOUT_USEC),
@@ -451,7 +472,10 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_maxDeltaCheckpoints(DEFAULT_MAX_DELTA_CHECKPOINTS),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_redoReplayWorkers(DEFAULT_REDO_REPLAY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -499,12 +523,17 @@ MOTConfiguration::MOTConfiguration()
       m_gcReclaimThresholdBytes(DEFAULT_GC_RECLAIM_THRESHOLD_BYTES),
       m_gcReclaimBatchSize(DEFAULT_GC_RECLAIM_BATCH_SIZE),
       m_gcHighReclaimThresholdBytes(DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES),
+      m_gcEnableBackgroundReclaim(DEFAULT_GC_ENABLE_BACKGROUND_RECLAIM),
+      m_gcBackgroundReclaimIntervalUSec(DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL_USEC),
       m_enableCodegen(DEFAULT_ENABLE_MOT_CODEGEN),
       m_forcePseudoCodegen(DEFAULT_FORCE_MOT_PSEUDO_CODEGEN),
       m_enableCodegenPrint(DEFAULT_ENABLE_MOT_CODEGEN_PRINT),
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_enableHashPrimaryIndex(DEFAULT_ENABLE_HASH_PRIMARY_INDEX),
+      m_hashIndexBucketCount(DEFAULT_HASH_INDEX_BUCKET_COUNT),
+      m_bulkInsertBatchSize(DEFAULT_BULK_INSERT_BATCH_SIZE),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_totalMemoryMb(DEFAULT_TOTAL_MEMORY_MB),
@@ -548,6 +577,7 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseLoggerType(name, "logger_type", value, &m_loggerType)) {
     } else if (ParseRedoLogHandlerType(name, "redo_log_handler_type", value, &m_redoLogHandlerType)) {
     } else if (ParseUint32(name, "async_log_buffer_count", value, &m_asyncRedoLogBufferArrayCount)) {
+    } else if (ParseBool(name, "enable_redo_log_compression", value, &m_enableRedoLogCompression)) {
     } else if (ParseBool(name, "enable_group_commit", value, &m_enableGroupCommit)) {
     } else if (ParseUint64(name, "group_commit_size", value, &m_groupCommitSize)) {
     } else if (ParseUint64(name, "group_commit_timeout_usec", value, &m_groupCommitTimeoutUSec)) {
@@ -556,7 +586,10 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "max_delta_checkpoints", value, &m_maxDeltaCheckpoints)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "redo_replay_workers", value, &m_redoReplayWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -604,6 +637,9 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseBool(name, "enable_hash_primary_index", value, &m_enableHashPrimaryIndex)) {
+    } else if (ParseUint32(name, "hash_index_bucket_count", value, &m_hashIndexBucketCount)) {
+    } else if (ParseUint32(name, "bulk_insert_batch_size", value, &m_bulkInsertBatchSize)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -897,6 +933,7 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT,
         MIN_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT,
         MAX_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT);
+    UPDATE_BOOL_CFG(m_enableRedoLogCompression, "enable_redo_log_compression", DEFAULT_ENABLE_REDO_LOG_COMPRESSION);
 
     // commit configuration
     UPDATE_BOOL_CFG(m_enableGroupCommit, "enable_group_commit", DEFAULT_ENABLE_GROUP_COMMIT);
@@ -936,6 +973,12 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_maxDeltaCheckpoints,
+        "max_delta_checkpoints",
+        DEFAULT_MAX_DELTA_CHECKPOINTS,
+        MIN_MAX_DELTA_CHECKPOINTS,
+        MAX_MAX_DELTA_CHECKPOINTS);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -943,6 +986,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_redoReplayWorkers,
+        "redo_replay_workers",
+        DEFAULT_REDO_REPLAY_WORKERS,
+        MIN_REDO_REPLAY_WORKERS,
+        MAX_REDO_REPLAY_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
@@ -1007,6 +1055,13 @@ void MOTConfiguration::LoadConfig()
         SCALE_BYTES,
         MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES,
         MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES);
+    UPDATE_BOOL_CFG(m_gcEnableBackgroundReclaim, "enable_background_reclaim", DEFAULT_GC_ENABLE_BACKGROUND_RECLAIM);
+    UPDATE_TIME_CFG(m_gcBackgroundReclaimIntervalUSec,
+        "background_reclaim_interval",
+        DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL,
+        SCALE_MICROS,
+        MIN_GC_BACKGROUND_RECLAIM_INTERVAL_USEC,
+        MAX_GC_BACKGROUND_RECLAIM_INTERVAL_USEC);
 
     // JIT configuration
     UPDATE_BOOL_CFG(m_enableCodegen, "enable_mot_codegen", DEFAULT_ENABLE_MOT_CODEGEN);
@@ -1021,6 +1076,17 @@ void MOTConfiguration::LoadConfig()
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
         UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
     }
+    UPDATE_BOOL_CFG(m_enableHashPrimaryIndex, "enable_hash_primary_index", DEFAULT_ENABLE_HASH_PRIMARY_INDEX);
+    UPDATE_INT_CFG(m_hashIndexBucketCount,
+        "hash_index_bucket_count",
+        DEFAULT_HASH_INDEX_BUCKET_COUNT,
+        MIN_HASH_INDEX_BUCKET_COUNT,
+        MAX_HASH_INDEX_BUCKET_COUNT);
+    UPDATE_INT_CFG(m_bulkInsertBatchSize,
+        "bulk_insert_batch_size",
+        DEFAULT_BULK_INSERT_BATCH_SIZE,
+        MIN_BULK_INSERT_BATCH_SIZE,
+        MAX_BULK_INSERT_BATCH_SIZE);
 
     // general configuration
     if (m_loadExtraParams) {
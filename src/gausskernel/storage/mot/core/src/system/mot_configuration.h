@@ -148,6 +148,9 @@ public:
     /** Determines the number of asynchronous redo log buffer arrays. */
     uint32_t m_asyncRedoLogBufferArrayCount;
 
+    /** @var Enables LZ4 compression of redo data before it is written to the XLOG. */
+    bool m_enableRedoLogCompression;
+
     /**********************************************************************/
     // Commit configuration
     /**********************************************************************/
@@ -178,6 +181,12 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Enable delta checkpoint (write only rows changed since the previous checkpoint). */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Maximum number of delta checkpoints taken on top of a full checkpoint. */
+    uint32_t m_maxDeltaCheckpoints;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -185,6 +194,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay redo log on standby (1 means serial replay). */
+    uint32_t m_redoReplayWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -340,6 +352,12 @@ public:
     /** @var The high threshold in bytes for reclamation to be triggered (per-thread). */
     uint64_t m_gcHighReclaimThresholdBytes;
 
+    /** @var Enable/disable reclamation by background reclaimer threads (one per NUMA node). */
+    bool m_gcEnableBackgroundReclaim;
+
+    /** @var The idle interval in micro-seconds between background reclamation rounds. */
+    uint64_t m_gcBackgroundReclaimIntervalUSec;
+
     /**********************************************************************/
     // JIT configuration
     /**********************************************************************/
@@ -364,6 +382,15 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var Specifies whether primary indexes are created as hash indexes (point access only). */
+    bool m_enableHashPrimaryIndex;
+
+    /** @var The number of buckets in each hash index. */
+    uint32_t m_hashIndexBucketCount;
+
+    /** @var The number of rows inserted together in a single batch by COPY into a MOT table (1 disables batching). */
+    uint32_t m_bulkInsertBatchSize;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -428,6 +455,9 @@ public:
     /** @var Default asynchronous redo log buffer array count. */
     static constexpr uint32_t DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT = 24;
 
+    /** @var Default enable redo log compression. */
+    static constexpr bool DEFAULT_ENABLE_REDO_LOG_COMPRESSION = false;
+
     /** @var Default enable group commit. */
     static constexpr bool DEFAULT_ENABLE_GROUP_COMMIT = false;
 
@@ -465,12 +495,25 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default maximum number of delta checkpoints between full checkpoints. */
+    static constexpr uint32_t DEFAULT_MAX_DELTA_CHECKPOINTS = 10;
+    static constexpr uint32_t MIN_MAX_DELTA_CHECKPOINTS = 1;
+    static constexpr uint32_t MAX_MAX_DELTA_CHECKPOINTS = 100;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used to replay redo log. */
+    static constexpr uint32_t DEFAULT_REDO_REPLAY_WORKERS = 1;
+    static constexpr uint32_t MIN_REDO_REPLAY_WORKERS = 1;
+    static constexpr uint32_t MAX_REDO_REPLAY_WORKERS = 64;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
@@ -656,6 +699,15 @@ public:
     static constexpr uint64_t MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 1 * MEGA_BYTE;      // 1 MB
     static constexpr uint64_t MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 64 * MEGA_BYTE;     // 64 MB
 
+    /** @var Enable/disable reclamation by background reclaimer threads. */
+    static constexpr bool DEFAULT_GC_ENABLE_BACKGROUND_RECLAIM = false;
+
+    /** @var The idle interval between background reclamation rounds. */
+    static constexpr const char* DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL = "10 ms";
+    static constexpr uint64_t DEFAULT_GC_BACKGROUND_RECLAIM_INTERVAL_USEC = 10000;
+    static constexpr uint64_t MIN_GC_BACKGROUND_RECLAIM_INTERVAL_USEC = 100;
+    static constexpr uint64_t MAX_GC_BACKGROUND_RECLAIM_INTERVAL_USEC = 1000000;  // 1 second
+
     /** ------------------ Default JIT Configuration ------------ */
     /** @var Default enable JIT compilation and execution. */
     static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN = true;
@@ -678,6 +730,19 @@ public:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var Default enable hash primary index. */
+    static constexpr bool DEFAULT_ENABLE_HASH_PRIMARY_INDEX = false;
+
+    /** @var Default number of buckets in each hash index. */
+    static constexpr uint32_t DEFAULT_HASH_INDEX_BUCKET_COUNT = 1048576;  // 1M buckets
+    static constexpr uint32_t MIN_HASH_INDEX_BUCKET_COUNT = 1024;
+    static constexpr uint32_t MAX_HASH_INDEX_BUCKET_COUNT = 268435456;  // 256M buckets
+
+    /** @var Default number of rows in a bulk insert batch. */
+    static constexpr uint32_t DEFAULT_BULK_INSERT_BATCH_SIZE = 4096;
+    static constexpr uint32_t MIN_BULK_INSERT_BATCH_SIZE = 1;
+    static constexpr uint32_t MAX_BULK_INSERT_BATCH_SIZE = 65536;
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
@@ -45,6 +45,7 @@
 #include "cycles.h"
 #include "debug_utils.h"
 #include "recovery_manager_factory.h"
+#include "mm_gc_reclaimer.h"
 
 // For mtSessionThreadInfo thread local
 #include "kvthread.hh"
@@ -84,7 +85,8 @@ MOTEngine::MOTEngine()
       m_surrogateKeyManager(nullptr),
       m_recoveryManager(nullptr),
       m_redoLogHandler(nullptr),
-      m_checkpointManager(nullptr)
+      m_checkpointManager(nullptr),
+      m_gcReclaimerPool(nullptr)
 {}
 
 MOTEngine::~MOTEngine()
@@ -428,6 +430,16 @@ bool MOTEngine::StartBackgroundTasks()
             MOT_LOG_INFO("Startup: Statistics reporter started");
             m_startBgStack.push(START_STAT_PRINT_PHASE);
         }
+
+        if (GetGlobalConfiguration().m_gcEnable && GetGlobalConfiguration().m_gcEnableBackgroundReclaim) {
+            m_gcReclaimerPool = new (std::nothrow) GcReclaimerPool();
+            result = (m_gcReclaimerPool != nullptr);
+            CHECK_INIT_STATUS(result, "Failed to allocate the background GC reclaimers");
+            m_startBgStack.push(START_GC_RECLAIM_PHASE);
+            result = m_gcReclaimerPool->Start();
+            CHECK_INIT_STATUS(result, "Failed to start the background GC reclaimers");
+            MOT_LOG_INFO("Startup: GC background reclaimers started");
+        }
     } while (0);
 
     if (result) {
@@ -537,6 +549,14 @@ void MOTEngine::StopBackgroundTasks()
 
     while (!m_startBgStack.empty()) {
         switch (m_startBgStack.top()) {
+            case START_GC_RECLAIM_PHASE:
+                if (m_gcReclaimerPool != nullptr) {
+                    m_gcReclaimerPool->Stop();
+                    delete m_gcReclaimerPool;
+                    m_gcReclaimerPool = nullptr;
+                }
+                break;
+
             case START_STAT_PRINT_PHASE:
                 if (GetGlobalConfiguration().m_enableStats) {
                     StatisticsManager::GetInstance().Stop();
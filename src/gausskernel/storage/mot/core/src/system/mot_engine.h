@@ -49,6 +49,7 @@
 namespace MOT {
 class ConfigLoader;
 class RedoLogHandler;
+class GcReclaimerPool;
 
 /** @typedef CpSigFunc Callback for notifying envelope that engine finished checkpoint. */
 typedef void (*CpSigFunc)(void);
@@ -550,6 +551,9 @@ private:
     /** @var The checkpoint manager. */
     CheckpointManager* m_checkpointManager;
 
+    /** @var The background garbage-collector reclaimers (if enabled). */
+    GcReclaimerPool* m_gcReclaimerPool;
+
     /** @var The In-ProcessTransactions container. */
     InProcessTransactions m_inProcessTransactions;
 
@@ -588,7 +592,7 @@ private:
     };
     stack<InitAppPhase> m_initAppStack;
 
-    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_BG_TASK_DONE };
+    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_GC_RECLAIM_PHASE, START_BG_TASK_DONE };
     stack<StartBgTaskPhase> m_startBgStack;
 
     /**
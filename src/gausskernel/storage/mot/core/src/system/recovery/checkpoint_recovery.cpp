@@ -23,6 +23,9 @@
  */
 
 #include <thread>
+#include <map>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
@@ -32,6 +35,8 @@
 namespace MOT {
 DECLARE_LOGGER(CheckpointRecovery, Recovery);
 
+constexpr uint32_t CheckpointRecovery::PROGRESS_REPORT_INTERVAL_SECONDS;
+
 bool CheckpointRecovery::Recover()
 {
     MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
@@ -93,7 +98,14 @@ bool CheckpointRecovery::Recover()
             return false;
         }
 
-        if (!PerformRecovery()) {
+        int deltaFillStat = FillStagesFromDeltaFile();
+        if (deltaFillStat < 0) {
+            MOT_LOG_ERROR("CheckpointRecovery: failed to read delta file");
+            return false;
+        }
+
+        bool recovered = (deltaFillStat > 0) ? PerformDeltaRecovery() : PerformRecovery();
+        if (!recovered) {
             MOT_LOG_ERROR("CheckpointRecovery: perform checkpoint recovery failed");
             return false;
         }
@@ -130,21 +142,73 @@ bool CheckpointRecovery::PerformRecovery()
         m_tableIds.size(),
         m_checkpointId);
 
+    if (!RecoverTablesMetadata()) {
+        return false;
+    }
+
+    uint64_t startTime = (uint64_t)time(nullptr);
+    RunRecoveryWorkers(startTime);
+    ReportProgress(startTime);
+    return true;
+}
+
+bool CheckpointRecovery::PerformDeltaRecovery()
+{
+    MOT_LOG_INFO("CheckpointRecovery: starting to recover %lu tables from delta checkpoint id: %lu (%lu stages)",
+        m_tableIds.size(),
+        m_checkpointId,
+        m_stages.size());
+
+    if (!RecoverTablesMetadata()) {
+        for (auto& stage : m_stages) {
+            ClearTasks(stage);
+        }
+        return false;
+    }
+
+    uint64_t startTime = (uint64_t)time(nullptr);
+    for (auto& stage : m_stages) {
+        if (!m_errorSet) {
+            m_tasksList.swap(stage);
+            RunRecoveryWorkers(startTime);
+        }
+        ClearTasks(m_tasksList);
+        ClearTasks(stage);
+    }
+    m_stages.clear();
+
+    ReportProgress(startTime);
+    return true;
+}
+
+bool CheckpointRecovery::RecoverTablesMetadata()
+{
     for (auto it = m_tableIds.begin(); it != m_tableIds.end(); ++it) {
         if (!RecoverTableMetadata(*it)) {
             MOT_LOG_ERROR("CheckpointRecovery: failed to recover table metadata for table %u", *it);
             return false;
         }
     }
+    return true;
+}
 
+void CheckpointRecovery::RunRecoveryWorkers(uint64_t startTime)
+{
+    // no point in starting more workers than there are segments to load
+    uint32_t numTasks = (uint32_t)m_tasksList.size();
+    uint32_t numWorkers = (m_numWorkers < numTasks) ? m_numWorkers : numTasks;
     std::vector<std::thread> threadPool;
-    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+    for (uint32_t i = 0; i < numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
     }
 
     MOT_LOG_DEBUG("CheckpointRecovery: waiting for all tasks to finish");
+    uint32_t secondsElapsed = 0;
     while (HaveTasks() && m_stopWorkers == false) {
         sleep(1);
+        if (++secondsElapsed % PROGRESS_REPORT_INTERVAL_SECONDS == 0) {
+            ReportProgress(startTime);
+        }
     }
 
     MOT_LOG_DEBUG("CheckpointRecovery: tasks finished (%s)", m_errorSet ? "error" : "ok");
@@ -153,8 +217,26 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
+}
 
-    return true;
+void CheckpointRecovery::ClearTasks(std::list<Task*>& tasks)
+{
+    for (Task* task : tasks) {
+        delete task;
+    }
+    tasks.clear();
+}
+
+void CheckpointRecovery::ReportProgress(uint64_t startTime) const
+{
+    uint64_t elapsed = (uint64_t)time(nullptr) - startTime;
+    uint64_t rows = m_recoveredRows.load();
+    MOT_LOG_INFO("CheckpointRecovery: recovered %u/%u segments, %lu rows in %lu seconds (%lu rows/sec)",
+        m_recoveredTasks.load(),
+        m_numTasks,
+        rows,
+        elapsed,
+        (elapsed > 0) ? (rows / elapsed) : rows);
 }
 
 int CheckpointRecovery::FillTasksFromMapFile()
@@ -208,10 +290,116 @@ int CheckpointRecovery::FillTasksFromMapFile()
     }
 
     CheckpointUtils::CloseFile(fd);
+    m_numTasks = (uint32_t)m_tasksList.size();
     MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
     return 1;
 }
 
+int CheckpointRecovery::FillStagesFromDeltaFile()
+{
+    std::string deltaFile;
+    CheckpointUtils::MakeDeltaFilename(deltaFile, m_workingDir, m_checkpointId);
+    if (!CheckpointUtils::IsFileExists(deltaFile)) {
+        return 0;  // a regular checkpoint
+    }
+
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(deltaFile, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillStagesFromDeltaFile: failed to open delta file '%s'", deltaFile.c_str());
+        return -1;
+    }
+
+    CheckpointUtils::DeltaFileHeader deltaFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+            sizeof(CheckpointUtils::DeltaFileHeader) ||
+        deltaFileHeader.m_magic != CP_MGR_MAGIC) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillStagesFromDeltaFile: failed to verify delta file '%s'", deltaFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return -1;
+    }
+
+    // read all the layers, oldest (full) first
+    std::vector<std::pair<uint64_t, std::vector<CheckpointManager::DeltaLayerEntry>>> layers;
+    for (uint64_t i = 0; i < deltaFileHeader.m_numLayers; i++) {
+        CheckpointUtils::DeltaLayerHeader layerHeader;
+        if (CheckpointUtils::ReadFile(fd, (char*)&layerHeader, sizeof(CheckpointUtils::DeltaLayerHeader)) !=
+            sizeof(CheckpointUtils::DeltaLayerHeader)) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillStagesFromDeltaFile: failed to read layer %lu header", i);
+            CheckpointUtils::CloseFile(fd);
+            return -1;
+        }
+        std::vector<CheckpointManager::DeltaLayerEntry> entries(layerHeader.m_numEntries);
+        size_t entriesSize = layerHeader.m_numEntries * sizeof(CheckpointManager::DeltaLayerEntry);
+        if (entriesSize > 0 && CheckpointUtils::ReadFile(fd, (char*)entries.data(), entriesSize) != entriesSize) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillStagesFromDeltaFile: failed to read layer %lu entries", i);
+            CheckpointUtils::CloseFile(fd);
+            return -1;
+        }
+        layers.emplace_back(layerHeader.m_checkpointId, std::move(entries));
+    }
+    CheckpointUtils::CloseFile(fd);
+
+    // rows of each table are recovered starting at the layer holding its last full image
+    std::map<uint32_t, size_t> firstLayer;
+    for (size_t i = 0; i < layers.size(); i++) {
+        for (const CheckpointManager::DeltaLayerEntry& entry : layers[i].second) {
+            if (entry.m_flags & CheckpointUtils::DELTA_ENTRY_FULL_IMAGE) {
+                firstLayer[entry.m_tableId] = i;
+            }
+        }
+    }
+
+    // the tasks of the recovered checkpoint's own layer are created below
+    ClearTasks(m_tasksList);
+    m_numTasks = 0;
+    for (size_t i = 0; i < layers.size(); i++) {
+        uint64_t layerId = (layers[i].first == m_checkpointId) ? 0 : layers[i].first;
+        std::list<Task*> tombstoneTasks;
+        std::list<Task*> rowTasks;
+        for (const CheckpointManager::DeltaLayerEntry& entry : layers[i].second) {
+            auto it = firstLayer.find(entry.m_tableId);
+            if (m_tableIds.count(entry.m_tableId) == 0 || it == firstLayer.end() || it->second > i) {
+                continue;
+            }
+
+            bool upsert = (it->second < i);
+            Task* recoveryTask = nullptr;
+            if (upsert && entry.m_numTombstones > 0) {
+                recoveryTask = new (std::nothrow) Task(entry.m_tableId, 0, layerId, false, true);
+                if (recoveryTask == nullptr) {
+                    break;
+                }
+                tombstoneTasks.push_back(recoveryTask);
+            }
+            for (uint32_t seg = 0; seg <= entry.m_maxSegId; seg++) {
+                recoveryTask = new (std::nothrow) Task(entry.m_tableId, seg, layerId, upsert);
+                if (recoveryTask == nullptr) {
+                    break;
+                }
+                rowTasks.push_back(recoveryTask);
+            }
+            if (recoveryTask == nullptr) {
+                break;
+            }
+        }
+
+        m_numTasks += (uint32_t)(tombstoneTasks.size() + rowTasks.size());
+        // deletes of a layer are applied before its rows, as a key may be deleted and inserted again
+        if (!tombstoneTasks.empty()) {
+            m_stages.push_back(std::move(tombstoneTasks));
+        }
+        if (!rowTasks.empty()) {
+            m_stages.push_back(std::move(rowTasks));
+        }
+    }
+
+    MOT_LOG_INFO("CheckpointRecovery::FillStagesFromDeltaFile: filled %u tasks from %lu layers (snapshot CSN %lu)",
+        m_numTasks,
+        layers.size(),
+        deltaFileHeader.m_snapshotCsn);
+    return 1;
+}
+
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
 {
     int fd = -1;
@@ -353,19 +541,15 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
             RC_MEMORY_ALLOCATION_ERROR, "CheckpointRecovery::WorkerFunc failed to allocate key data");
     }
 
-    char* entryData = (char*)malloc(MAX_TUPLE_SIZE);
-    if (entryData == nullptr) {
-        MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc: failed to allocate row buffer");
-        checkpointRecovery->OnError(
-            RC_MEMORY_ALLOCATION_ERROR, "CheckpointRecovery::WorkerFunc failed to allocate row buffer");
-    }
+    // segment buffer is allocated on first use, so it is local to the NUMA node of this worker
+    CheckpointRecovery::SegmentBuffer segBuffer;
 
     RC status = RC_OK;
     while (checkpointRecovery->ShouldStopWorkers() == false) {
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            if (!checkpointRecovery->RecoverTableRows(task, keyData, segBuffer, maxCsn, sState, status)) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -381,9 +565,6 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
         }
     }
 
-    if (entryData != nullptr) {
-        free(entryData);
-    }
     if (keyData != nullptr) {
         free(keyData);
     }
@@ -398,8 +579,42 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
     MOT_LOG_DEBUG("CheckpointRecovery::WorkerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
 }
 
+bool CheckpointRecovery::SegmentBuffer::Load(int fd, size_t len)
+{
+    m_len = 0;
+    m_offset = 0;
+    if (len > m_capacity) {
+        char* newData = (char*)malloc(len);
+        if (newData == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Checkpoint Recovery",
+                "Failed to allocate %lu bytes for checkpoint segment buffer",
+                (unsigned long)len);
+            return false;
+        }
+        if (m_data != nullptr) {
+            free(m_data);
+        }
+        m_data = newData;
+        m_capacity = len;
+    }
+
+    // a single read may return less than requested for large files, so we loop until all data is read
+    while (m_len < len) {
+        size_t bytesRead = CheckpointUtils::ReadFile(fd, m_data + m_len, len - m_len);
+        if (bytesRead == (size_t)-1 || bytesRead == 0) {
+            MOT_LOG_ERROR("CheckpointRecovery::SegmentBuffer::Load: failed to read segment (%lu / %lu bytes)",
+                (unsigned long)m_len,
+                (unsigned long)len);
+            return false;
+        }
+        m_len += bytesRead;
+    }
+    return true;
+}
+
 bool CheckpointRecovery::RecoverTableRows(
-    Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
+    Task* task, char* keyData, SegmentBuffer& segBuffer, uint64_t& maxCsn, SurrogateState& sState, RC& status)
 {
     if (task == nullptr) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: no task given");
@@ -417,8 +632,20 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    // files of previous layers in a delta chain are linked into the checkpoint directory with a layer prefix
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    bool isLayerFile = (task->m_layerId != 0 && task->m_layerId != m_checkpointId);
+    if (task->m_tombstones) {
+        if (isLayerFile) {
+            CheckpointUtils::MakeLayerTombstoneFilename(task->m_layerId, tableId, fileName, m_workingDir);
+        } else {
+            CheckpointUtils::MakeTombstoneFilename(tableId, fileName, m_workingDir);
+        }
+    } else if (isLayerFile) {
+        CheckpointUtils::MakeLayerCpFilename(task->m_layerId, tableId, fileName, m_workingDir, seg);
+    } else {
+        CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    }
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -442,26 +669,45 @@ bool CheckpointRecovery::RecoverTableRows(
     if (tableExId != fileHeader.m_exId) {
         MOT_LOG_ERROR(
             "CheckpointRecovery::RecoverTableRows: exId mismatch: my %lu - pkt %lu", tableExId, fileHeader.m_exId);
+        CheckpointUtils::CloseFile(fd);
         return false;
     }
 
     if (IsMemoryLimitReached(m_numWorkers, GetGlobalConfiguration().m_checkpointSegThreshold)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: Memory hard limit reached. Cannot recover datanode");
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    // load the entire segment with large sequential reads, rows are then parsed from memory
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to get size of file: %s", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    if (!segBuffer.Load(fd, (size_t)fileStat.st_size - sizeof(CheckpointUtils::FileHeader))) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to load file: %s", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
         return false;
     }
+    CheckpointUtils::CloseFile(fd);
 
     CheckpointUtils::EntryHeader entry;
+    uint64_t rowsRecovered = 0;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+        char* entryHeader = segBuffer.Consume(sizeof(CheckpointUtils::EntryHeader));
+        if (entryHeader == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
+        errno_t erc =
+            memcpy_s(&entry, sizeof(CheckpointUtils::EntryHeader), entryHeader, sizeof(CheckpointUtils::EntryHeader));
+        securec_check(erc, "\0", "\0");
 
         if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE) {
             MOT_LOG_ERROR(
@@ -474,28 +720,40 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
+        // key is copied to an aligned buffer, row data is copied directly from the segment buffer into the row
+        char* entryKey = segBuffer.Consume(entry.m_keyLen);
+        if (entryKey == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
+        if (entry.m_keyLen > 0) {
+            erc = memcpy_s(keyData, MAX_KEY_SIZE, entryKey, entry.m_keyLen);
+            securec_check(erc, "\0", "\0");
+        }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
+        char* entryData = segBuffer.Consume(entry.m_dataLen);
+        if (entryData == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
 
+        if (task->m_tombstones) {
+            // deleted key, removed from the rows recovered from the previous layers
+            RemoveRow(table, keyData, entry.m_keyLen, MOTCurrThreadId);
+            continue;
+        }
+
+        if (task->m_upsert) {
+            // the row was changed since the previous layer, so the older version is replaced
+            RemoveRow(table, keyData, entry.m_keyLen, MOTCurrThreadId);
+        }
+
         InsertRow(table,
             keyData,
             entry.m_keyLen,
@@ -515,8 +773,13 @@ bool CheckpointRecovery::RecoverTableRows(
         MOT_LOG_DEBUG("Inserted into table %u row with CSN %" PRIu64, tableId, entry.m_csn);
         if (entry.m_csn > maxCsn)
             maxCsn = entry.m_csn;
+        ++rowsRecovered;
+    }
+
+    m_recoveredRows += rowsRecovered;
+    if (status == RC_OK) {
+        ++m_recoveredTasks;
     }
-    CheckpointUtils::CloseFile(fd);
 
     MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
         MOTCurrThreadId,
@@ -593,6 +856,17 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     }
 }
 
+void CheckpointRecovery::RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    Sentinel* sentinel = table->GetPrimaryIndex()->IndexReadSentinel(&key, tid);
+    if (sentinel != nullptr && sentinel->GetData() != nullptr) {
+        // no GC while recovering, the row and its sentinels are destroyed immediately
+        (void)table->RemoveRow(sentinel->GetData(), tid, nullptr);
+    }
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
@@ -27,7 +27,9 @@
 
 #include <set>
 #include <list>
+#include <vector>
 #include <mutex>
+#include <atomic>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
@@ -43,7 +45,10 @@ public:
           m_numWorkers(GetGlobalConfiguration().m_checkpointRecoveryWorkers),
           m_stopWorkers(false),
           m_errorSet(false),
-          m_errorCode(RC_OK)
+          m_errorCode(RC_OK),
+          m_numTasks(0),
+          m_recoveredTasks(0),
+          m_recoveredRows(0)
     {}
 
     ~CheckpointRecovery()
@@ -72,11 +77,71 @@ public:
      * segment file number.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint64_t layerId = 0, bool upsert = false,
+            bool tombstones = false)
+            : m_tableId(tableId), m_segId(segId), m_layerId(layerId), m_upsert(upsert), m_tombstones(tombstones)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+
+        /** @var The checkpoint that wrote the file, in a delta chain (zero for the recovered checkpoint). */
+        uint64_t m_layerId;
+
+        /** @var Rows replace existing rows with the same key (delta layer). */
+        bool m_upsert;
+
+        /** @var The file holds keys of deleted rows. */
+        bool m_tombstones;
+    };
+
+    /**
+     * @struct SegmentBuffer
+     * @brief A per-worker buffer holding the entire contents of the checkpoint segment file being recovered, so
+     * that the segment is loaded with a few large reads instead of several small reads per row.
+     */
+    struct SegmentBuffer {
+        SegmentBuffer() : m_data(nullptr), m_capacity(0), m_len(0), m_offset(0)
+        {}
+
+        ~SegmentBuffer()
+        {
+            if (m_data != nullptr) {
+                free(m_data);
+                m_data = nullptr;
+            }
+        }
+
+        /**
+         * @brief Loads the remainder of a file into the buffer, growing the buffer if required.
+         * @param fd The file descriptor to read from (positioned after the file header).
+         * @param len The number of bytes to read.
+         * @return Boolean value denoting success or failure.
+         */
+        bool Load(int fd, size_t len);
+
+        /**
+         * @brief Consumes the next bytes from the loaded segment.
+         * @param len The number of bytes to consume.
+         * @return A pointer to the consumed bytes, or null if not enough bytes are left.
+         */
+        inline char* Consume(size_t len)
+        {
+            if (m_len - m_offset < len) {
+                return nullptr;
+            }
+            char* result = m_data + m_offset;
+            m_offset += len;
+            return result;
+        }
+
+        char* m_data;
+
+        size_t m_capacity;
+
+        size_t m_len;
+
+        size_t m_offset;
     };
 
     /**
@@ -89,7 +154,7 @@ public:
      * @brief Reads and inserts rows from a checkpoint file
      * @param task The task (tableid / segment) to recover from.
      * @param keyData A key buffer.
-     * @param entryData A row buffer..
+     * @param segBuffer The worker's segment buffer.
      * @param maxCsn The returned maxCsn encountered during the recovery.
      * @param sState Surrogate key state structure that will be filled.
      * during the recovery.
@@ -97,7 +162,7 @@ public:
      * @return Boolean value denoting success or failure.
      */
     bool RecoverTableRows(
-        Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
+        Task* task, char* keyData, SegmentBuffer& segBuffer, uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
     uint64_t GetLsn() const
     {
@@ -127,14 +192,53 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads the checkpoint delta chain file (if exists) and fills the
+     * recovery stages with the tasks of each layer.
+     * @return Int value where 0 indicates a regular (full) checkpoint,
+     * -1 denotes an error has occurred and 1 means a success.
+     */
+    int FillStagesFromDeltaFile();
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
      */
     uint32_t HaveTasks();
 
+    /**
+     * @brief Clears and frees all the tasks in a tasks list.
+     * @param tasks The tasks list.
+     */
+    static void ClearTasks(std::list<Task*>& tasks);
+
+    /**
+     * @brief Prints the progress of the recovery (segments and rows recovered so far, and the row rate).
+     * @param startTime The time in which data recovery started.
+     */
+    void ReportProgress(uint64_t startTime) const;
+
     bool PerformRecovery();
 
+    /**
+     * @brief Recovers a delta checkpoint: the layers of the chain are applied in order,
+     * each one after the previous layer was completely recovered.
+     * @return Boolean value denoting success or failure.
+     */
+    bool PerformDeltaRecovery();
+
+    /**
+     * @brief Creates the tables from their metadata files.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverTablesMetadata();
+
+    /**
+     * @brief Runs the recovery workers until the tasks queue is empty.
+     * @param startTime The time in which data recovery started.
+     */
+    void RunRecoveryWorkers(uint64_t startTime);
+
     /**
      * @brief Recovers the in process two phase commit related transactions
      * from the checkpoint data file.
@@ -165,6 +269,15 @@ private:
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
         uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief Removes a row (if exists) from the database in a non transactional manner.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param tid the thread id of the recovering thread.
+     */
+    void RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid);
+
     /**
      * @brief performs table creation.
      * @param data the table's data
@@ -213,6 +326,21 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    /** @var Tasks of a delta checkpoint, a stage is recovered only after the previous one completed. */
+    std::vector<std::list<Task*>> m_stages;
+
+    /** @var Total number of segment tasks to recover. */
+    uint32_t m_numTasks;
+
+    /** @var Number of segment tasks recovered so far. */
+    std::atomic<uint32_t> m_recoveredTasks;
+
+    /** @var Number of rows recovered so far. */
+    std::atomic<uint64_t> m_recoveredRows;
+
+    /** @var Interval in seconds between progress reports. */
+    static constexpr uint32_t PROGRESS_REPORT_INTERVAL_SECONDS = 10;
 };
 }  // namespace MOT
 
@@ -70,6 +70,19 @@ bool InProcessTransactions::InsertLogSegment(LogSegment* segment)
     return true;
 }
 
+RedoLogTransactionSegments* InProcessTransactions::PopTransaction(uint64_t id)
+{
+    RedoLogTransactionSegments* segments = nullptr;
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_map.find(id);
+    if (it != m_map.end()) {
+        segments = it->second;
+        m_map.erase(it);
+        m_numEntries--;
+    }
+    return segments;
+}
+
 bool InProcessTransactions::FindTransactionId(uint64_t externalId, uint64_t& internalId, bool pop)
 {
     internalId = 0;
@@ -42,6 +42,13 @@ public:
 
     bool FindTransactionId(uint64_t externalId, uint64_t& internalId, bool pop = true);
 
+    /**
+     * @brief Removes a transaction from the map and transfers ownership of its segments to the caller.
+     * @param id The internal transaction id.
+     * @return The transaction segments or null pointer if not found.
+     */
+    RedoLogTransactionSegments* PopTransaction(uint64_t id);
+
     template <typename T>
     RC ForUniqueTransaction(uint64_t id, const T& func)
     {
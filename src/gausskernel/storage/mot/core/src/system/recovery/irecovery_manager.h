@@ -105,6 +105,17 @@ public:
     virtual void AddSurrogateArrayToList(SurrogateState& surrogate) = 0;
     virtual void SetCsn(uint64_t csn) = 0;
 
+    /**
+     * @brief Waits for replay of all redo dispatched so far, and holds back
+     * replay of later redo until ResumeRedoReplay() is called.
+     */
+    virtual void SuspendRedoReplay() = 0;
+
+    /**
+     * @brief Resumes redo replay held back by SuspendRedoReplay().
+     */
+    virtual void ResumeRedoReplay() = 0;
+
 protected:
     // constructor
     IRecoveryManager()
@@ -62,6 +62,23 @@ bool RecoveryManager::Initialize()
         return false;
     }
 
+    // parallel redo replay workers are started on first use, only when replaying redo
+    uint32_t replayWorkers = GetGlobalConfiguration().m_redoReplayWorkers;
+    if (replayWorkers > 1) {
+        auto replayLambda = [this](RedoLogTransactionSegments* segments, uint64_t id, SurrogateState& sState) -> RC {
+            RC status = RedoTransaction(segments, id, sState);
+            if (status != RC_OK) {
+                m_errorSet = true;
+            }
+            return status;
+        };
+        m_replayPool = new (std::nothrow) RedoReplayPool(replayWorkers, replayLambda);
+        if (m_replayPool == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Recovery Manager Initialization", "Failed to allocate redo replay pool");
+            return false;
+        }
+    }
+
     m_initialized = true;
     return m_initialized;
 }
@@ -95,6 +112,11 @@ bool RecoveryManager::RecoverDbStart()
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // wait for all dispatched transactions, workers add their surrogate state to the list when they stop
+    if (m_replayPool != nullptr) {
+        m_replayPool->Stop();
+    }
+
     if (ApplyInProcessTransactions() != RC_OK) {
         MOT_LOG_ERROR("applyInProcessTransactions failed!");
         return false;
@@ -126,6 +148,10 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    if (m_replayPool != nullptr) {
+        m_replayPool->Stop();
+    }
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -224,23 +250,20 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
 {
     RC status = RC_OK;
     if (rState != RecoveryOps::RecoveryOpState::ABORT) {
+        RedoReplayPool* replayPool = GetReplayPool();
+        if (replayPool != nullptr && rState == RecoveryOps::RecoveryOpState::COMMIT) {
+            return DispatchRecoveredTransaction(internalTransactionId);
+        }
+
         auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
-            RC redoStatus = RC_OK;
-            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
-            uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                redoStatus = RedoSegment(segment, csn, id, RecoveryOps::RecoveryOpState::COMMIT);
-                if (redoStatus != RC_OK) {
-                    MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
-                    return redoStatus;
-                }
-            }
-            return redoStatus;
+            return RedoTransaction(segments, id, m_sState);
+        };
+        auto redoLambda = [internalTransactionId, &operateLambda]() -> RC {
+            return MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
+                internalTransactionId, operateLambda);
         };
 
-        status = MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
-            internalTransactionId, operateLambda);
+        status = (replayPool != nullptr) ? replayPool->RunExclusive(redoLambda) : redoLambda();
     }
     if (status != RC_OK) {
         MOT_LOG_ERROR("OperateOnRecoveredTransaction: wal recovery failed");
@@ -249,8 +272,109 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
-RC RecoveryManager::RedoSegment(
-    LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
+RC RecoveryManager::RedoTransaction(
+    RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState)
+{
+    RC status = RC_OK;
+    LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+    uint64_t csn = segment->m_controlBlock.m_csn;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        segment = segments->GetSegment(i);
+        status = RedoSegment(segment, csn, transactionId, RecoveryOps::RecoveryOpState::COMMIT, sState);
+        if (status != RC_OK) {
+            MOT_LOG_ERROR("RedoTransaction failed with rc %d", status);
+            return status;
+        }
+    }
+    return status;
+}
+
+bool RecoveryManager::DispatchRecoveredTransaction(uint64_t internalTransactionId)
+{
+    RedoLogTransactionSegments* segments =
+        MOTEngine::GetInstance()->GetInProcessTransactions().PopTransaction(internalTransactionId);
+    if (segments == nullptr) {
+        return true;
+    }
+
+    // all transactions of a table are replayed in log order by the same worker, so changes to a row are never
+    // reordered. table ids are assigned sequentially, so they spread evenly between the workers
+    uint64_t tableId = 0;
+    if (GetSingleTableId(segments, tableId)) {
+        m_replayPool->Dispatch((uint32_t)(tableId % m_replayPool->GetWorkerCount()), segments, internalTransactionId);
+        return true;
+    }
+
+    RC status = m_replayPool->RunExclusive([this, segments, internalTransactionId]() -> RC {
+        return RedoTransaction(segments, internalTransactionId, m_sState);
+    });
+    delete segments;
+    if (status != RC_OK) {
+        MOT_LOG_ERROR("DispatchRecoveredTransaction: wal recovery failed");
+        return false;
+    }
+    return true;
+}
+
+bool RecoveryManager::GetSingleTableId(RedoLogTransactionSegments* segments, uint64_t& tableId)
+{
+    tableId = 0;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        LogSegment* segment = segments->GetSegment(i);
+        if (segment->IsTwoPhase()) {
+            return false;
+        }
+
+        uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+        uint8_t* operationData = (uint8_t*)(segment->m_data);
+        while (operationData < endPosition) {
+            uint64_t opTableId = 0;
+            uint32_t opLength = 0;
+            if (!RecoveryOps::InspectRowOperation(operationData, opTableId, opLength)) {
+                return false;
+            }
+            if (opTableId != 0) {
+                if (tableId != 0 && tableId != opTableId) {
+                    return false;
+                }
+                tableId = opTableId;
+            }
+            operationData += opLength;
+        }
+    }
+    return true;
+}
+
+RedoReplayPool* RecoveryManager::GetReplayPool()
+{
+    if (m_replayPool == nullptr || !MOTEngine::GetInstance()->IsRecovering()) {
+        return nullptr;
+    }
+
+    // fall back to serial replay if the workers cannot be started (start is retried on next transaction)
+    if (!m_replayPool->IsStarted() && !m_replayPool->Start()) {
+        MOT_LOG_WARN("Failed to start redo replay workers, redo is replayed serially");
+        return nullptr;
+    }
+    return m_replayPool;
+}
+
+void RecoveryManager::SuspendRedoReplay()
+{
+    if (m_replayPool != nullptr) {
+        m_replayPool->Freeze();
+    }
+}
+
+void RecoveryManager::ResumeRedoReplay()
+{
+    if (m_replayPool != nullptr) {
+        m_replayPool->Unfreeze();
+    }
+}
+
+RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId,
+    RecoveryOps::RecoveryOpState rState, SurrogateState& sState)
 {
     RC status = RC_OK;
     bool is2pcRecovery = !MOTEngine::GetInstance()->IsRecovering();
@@ -260,8 +384,8 @@ RC RecoveryManager::RedoSegment(
     bool wasCommit = false;
 
     while (operationData < endPosition) {
-        // redo log recovery - single threaded
-        if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
+        // redo log recovery - one chunk per replay worker
+        if (IsRecoveryMemoryLimitReached(GetGlobalConfiguration().m_redoReplayWorkers)) {
             status = RC_ERROR;
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             break;
@@ -280,7 +404,7 @@ RC RecoveryManager::RedoSegment(
 
         if (!is2pcRecovery) {
             operationData += RecoveryOps::RecoverLogOperation(
-                MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status, wasCommit);
+                MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, sState, status, wasCommit);
             // check operation result status
             if (status != RC_OK) {
                 MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_LIMIT, "Recover Redo Segment", "Failed to recover redo segment");
@@ -292,16 +416,16 @@ RC RecoveryManager::RedoSegment(
             }
         } else {
             operationData += RecoveryOps::TwoPhaseRecoverOp(
-                MOTCurrTxn, rState, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status);
+                MOTCurrTxn, rState, operationData, csn, transactionId, MOTCurrThreadId, sState, status);
         }
         if (status != RC_OK) {
             break;
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (!is2pcRecovery && csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
+    // segments might be replayed concurrently by several redo replay workers
+    if (!is2pcRecovery) {
+        SetCsn(csn);
     }
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
@@ -309,24 +433,22 @@ RC RecoveryManager::RedoSegment(
     return status;
 }
 
-bool RecoveryManager::LogStats::FindIdx(uint64_t tableId, uint64_t& id)
+RecoveryManager::LogStats::Entry* RecoveryManager::LogStats::FindEntry(uint64_t tableId)
 {
-    id = m_numEntries;
     std::map<uint64_t, uint64_t>::iterator it;
     std::lock_guard<spin_lock> lock(m_slock);
     it = m_idToIdx.find(tableId);
     if (it == m_idToIdx.end()) {
         Entry* newEntry = new (std::nothrow) Entry(tableId);
         if (newEntry == nullptr) {
-            return false;
+            return nullptr;
         }
         m_tableStats.push_back(newEntry);
         m_idToIdx.insert(std::pair<uint64_t, uint64_t>(tableId, m_numEntries));
         m_numEntries++;
-    } else {
-        id = it->second;
+        return newEntry;
     }
-    return true;
+    return m_tableStats[it->second];
 }
 
 void RecoveryManager::LogStats::Print()
@@ -432,6 +554,13 @@ RC RecoveryManager::ApplyInProcessTransaction(uint64_t internalTransactionId)
         return status;
     };
 
+    RedoReplayPool* replayPool = GetReplayPool();
+    if (replayPool != nullptr) {
+        return replayPool->RunExclusive([internalTransactionId, &applyLambda]() -> RC {
+            return MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
+                internalTransactionId, applyLambda);
+        });
+    }
     return MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
         internalTransactionId, applyLambda);
 }
@@ -36,6 +36,7 @@
 #include "surrogate_state.h"
 #include "checkpoint_recovery.h"
 #include "recovery_ops.h"
+#include "redo_replay_pool.h"
 
 namespace MOT {
 /**
@@ -57,11 +58,17 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_replayPool(nullptr)
     {}
 
     ~RecoveryManager() override
-    {}
+    {
+        if (m_replayPool != nullptr) {
+            delete m_replayPool;
+            m_replayPool = nullptr;
+        }
+    }
 
     /**
      * @brief Performs the necessary tasks to initialize the object.
@@ -145,8 +152,12 @@ public:
 
     inline void SetLastReplayLsn(uint64_t replayLsn) override
     {
-        if (m_lastReplayLsn < replayLsn) {
-            m_lastReplayLsn = replayLsn;
+        // transactions might be replayed concurrently by several redo replay workers
+        uint64_t currentLsn = m_lastReplayLsn;
+        while (currentLsn < replayLsn) {
+            if (m_lastReplayLsn.compare_exchange_weak(currentLsn, replayLsn)) {
+                break;
+            }
         }
     }
 
@@ -155,6 +166,18 @@ public:
         return m_lastReplayLsn;
     }
 
+    /**
+     * @brief Waits until all redo transactions dispatched so far were replayed, and holds back replay of later
+     * transactions until @ref ResumeRedoReplay() is called. Used by checkpoint on standby, so that the captured data
+     * reflects exactly a prefix of the redo log.
+     */
+    void SuspendRedoReplay() override;
+
+    /**
+     * @brief Resumes replay of redo transactions held back by @ref SuspendRedoReplay().
+     */
+    void ResumeRedoReplay() override;
+
     /**
      * @class LogStats
      * @brief A per-table recovery stats collector
@@ -203,25 +226,25 @@ public:
 
         void IncInsert(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncInsert();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncInsert();
             }
         }
 
         void IncUpdate(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncUpdate();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncUpdate();
             }
         }
 
         void IncDelete(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncDelete();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncDelete();
             }
         }
 
@@ -237,13 +260,13 @@ public:
 
     private:
         /**
-         * @brief Returns a table id array index. it will create
-         * a new table entry if necessary.
+         * @brief Returns the stats entry of a table. it will create
+         * a new table entry if necessary. Safe to call from concurrent
+         * redo replay workers.
          * @param tableId The id of the table.
-         * @param id The returned array index.
-         * @return Boolean value denoting success or failure.
+         * @return The table entry, or null pointer if allocation failed.
          */
-        bool FindIdx(uint64_t tableId, uint64_t& id);
+        Entry* FindEntry(uint64_t tableId);
 
         std::map<uint64_t, uint64_t> m_idToIdx;
 
@@ -261,8 +284,6 @@ public:
     std::map<uint64_t, RecoveryOps::TableInfo*> m_preCommitedTables;
 
 private:
-    static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
-
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -270,9 +291,43 @@ private:
      * @param csn the segment's csn
      * @param transactionId the transaction id of the segment
      * @param rState the operation to perform on the segment.
+     * @param sState the surrogate state of the redoing thread.
      * @return RC value denoting the operation's status
      */
-    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState);
+    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState,
+        SurrogateState& sState);
+
+    /**
+     * @brief performs a redo on all the segments of a committed transaction.
+     * @param segments the transaction segments.
+     * @param transactionId the internal transaction id.
+     * @param sState the surrogate state of the redoing thread.
+     * @return RC value denoting the operation's status
+     */
+    RC RedoTransaction(RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState);
+
+    /**
+     * @brief dispatches a committed transaction to the redo replay pool. Transactions
+     * that modify rows of a single table are replayed by the worker owning that table,
+     * all others are replayed exclusively on the current thread.
+     * @param internalTransactionId the internal transaction id.
+     * @return Boolean value denoting success or failure.
+     */
+    bool DispatchRecoveredTransaction(uint64_t internalTransactionId);
+
+    /**
+     * @brief retrieves the single table modified by a transaction.
+     * @param segments the transaction segments.
+     * @param[out] tableId the table id, or zero if the transaction does not modify any rows.
+     * @return False if the transaction contains DDL or modifies more than one table.
+     */
+    static bool GetSingleTableId(RedoLogTransactionSegments* segments, uint64_t& tableId);
+
+    /**
+     * @brief returns the redo replay pool, starting it on first use.
+     * @return The redo replay pool, or null pointer if redo is replayed serially.
+     */
+    RedoReplayPool* GetReplayPool();
 
     /**
      * @brief inserts a segment in to the in-process transactions map
@@ -347,7 +402,7 @@ private:
 
     uint64_t m_lsn;
 
-    uint64_t m_lastReplayLsn;
+    std::atomic<uint64_t> m_lastReplayLsn;
 
     std::atomic<uint32_t> m_tid;
 
@@ -372,6 +427,9 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    /** @var Parallel redo replay workers (used only if more than one worker is configured). */
+    RedoReplayPool* m_replayPool;
 };
 }  // namespace MOT
 
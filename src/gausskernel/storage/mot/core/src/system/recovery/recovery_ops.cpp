@@ -1122,6 +1122,68 @@ RC RecoveryOps::BeginTransaction(TxnManager* txn, uint64_t replayLsn)
     return RC_OK;
 }
 
+bool RecoveryOps::InspectRowOperation(uint8_t* data, uint64_t& tableId, uint32_t& length)
+{
+    uint64_t exId = 0;
+    uint64_t rowLength = 0;
+    uint64_t rowId = 0;
+    uint16_t keyLength = 0;
+    uint8_t* start = data;
+
+    OperationCode opCode = *static_cast<OperationCode*>((void*)data);
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+        case REMOVE_ROW:
+        case UPDATE_ROW:
+            data += sizeof(OperationCode);
+            Extract(data, tableId);
+            Extract(data, exId);
+            break;
+        case COMMIT_TX:
+        case COMMIT_PREPARED_TX:
+        case PARTIAL_REDO_TX:
+        case PREPARE_TX:
+        case ROLLBACK_TX:
+        case ROLLBACK_PREPARED_TX:
+            tableId = 0;
+            length = sizeof(EndSegmentBlock);
+            return true;
+        default:
+            return false;
+    }
+
+    if (opCode == CREATE_ROW) {
+        Extract(data, rowId);
+    }
+    Extract(data, keyLength);
+    data += keyLength;
+    if (opCode == CREATE_ROW || opCode == OVERWRITE_ROW) {
+        Extract(data, rowLength);
+        data += rowLength;
+    } else if (opCode == UPDATE_ROW) {
+        // the size of the column data depends on the table definition
+        Table* table = GetTableManager()->GetTableByExternal(exId);
+        if (table == nullptr) {
+            return false;
+        }
+        uint16_t numColumns = table->GetFieldCount() - 1;
+        BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+        BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+        BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+        BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+        while (!updatedColumnsIt.End()) {
+            if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+            }
+            validColumnsIt.Next();
+            updatedColumnsIt.Next();
+        }
+    }
+    length = (uint32_t)(data - start);
+    return true;
+}
+
 RC RecoveryOps::CommitTransaction(TxnManager* txn, uint64_t csn)
 {
     txn->SetCommitSequenceNumber(csn);
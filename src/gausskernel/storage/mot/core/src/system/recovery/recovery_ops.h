@@ -119,6 +119,17 @@ public:
      */
     static RC BeginTransaction(TxnManager* txn, uint64_t replayLsn = 0);
 
+    /**
+     * @brief Inspects a single redo operation without applying it.
+     * @param data the operation buffer.
+     * @param[out] tableId the internal id of the table modified by a row operation, or zero for an end of
+     * transaction operation.
+     * @param[out] length the number of bytes occupied by the operation.
+     * @return False if this is not a row or end of transaction operation (i.e. DDL), or if the table of a row update
+     * operation could not be found.
+     */
+    static bool InspectRowOperation(uint8_t* data, uint64_t& tableId, uint32_t& length);
+
 private:
     /**
      * @brief performs an insert operation of a data buffer.
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_pool.cpp
+ *    Pool of worker threads replaying committed redo transactions in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_pool.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <thread>
+#include <vector>
+#include "redo_replay_pool.h"
+#include "mot_engine.h"
+#include "mot_configuration.h"
+#include "session_manager.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(RedoReplayPool, Recovery);
+
+struct ReplayThreads {
+    std::vector<std::thread> m_vec;
+};
+
+RedoReplayPool::RedoReplayPool(uint32_t workerCount, const ReplayFunc& replayFunc)
+    : m_workers(nullptr),
+      m_queues(nullptr),
+      m_workerCount(workerCount),
+      m_replayFunc(replayFunc),
+      m_running(false),
+      m_frozen(false),
+      m_frozenSeq(0),
+      m_lastSeq(0),
+      m_completed(0)
+{}
+
+RedoReplayPool::~RedoReplayPool()
+{
+    Stop();
+}
+
+bool RedoReplayPool::Start()
+{
+    if (m_workers != nullptr) {
+        return true;
+    }
+
+    ReplayThreads* threads = new (std::nothrow) ReplayThreads();
+    if (threads == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Replay Startup", "Failed to allocate replay thread array");
+        return false;
+    }
+
+    m_queues = new (std::nothrow) ReplayWorker[m_workerCount];
+    if (m_queues == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Replay Startup", "Failed to allocate %u replay queues", m_workerCount);
+        delete threads;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_running = true;
+        m_frozen = false;
+        m_lastSeq = 0;
+        m_completed = 0;
+    }
+    m_workers = (void*)threads;
+    for (uint32_t i = 0; i < m_workerCount; ++i) {
+        threads->m_vec.push_back(std::thread(&RedoReplayPool::WorkerFunc, this, i));
+    }
+
+    MOT_LOG_INFO("Started %u redo replay workers", m_workerCount);
+    return true;
+}
+
+void RedoReplayPool::Stop()
+{
+    if (m_workers == nullptr) {
+        return;
+    }
+
+    {
+        // workers drain their queues before exiting
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_running = false;
+        m_frozen = false;
+        for (uint32_t i = 0; i < m_workerCount; ++i) {
+            m_queues[i].m_cv.notify_all();
+        }
+    }
+
+    ReplayThreads* threads = reinterpret_cast<ReplayThreads*>(m_workers);
+    for (auto& worker : threads->m_vec) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    delete threads;
+    m_workers = nullptr;
+    delete[] m_queues;
+    m_queues = nullptr;
+
+    MOT_LOG_INFO("Stopped redo replay workers, %" PRIu64 " transactions replayed", m_completed);
+}
+
+void RedoReplayPool::Dispatch(uint32_t workerId, RedoLogTransactionSegments* segments, uint64_t transactionId)
+{
+    ReplayWorker& worker = m_queues[workerId];
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_doneCv.wait(lock, [&worker]() { return worker.m_queue.size() < MAX_WORKER_QUEUE_SIZE; });
+    worker.m_queue.push_back({segments, transactionId, ++m_lastSeq});
+    worker.m_cv.notify_one();
+}
+
+RC RedoReplayPool::RunExclusive(const std::function<RC()>& func)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    uint64_t seq = ++m_lastSeq;
+    m_doneCv.wait(lock, [this, seq]() { return m_completed == seq - 1 && (!m_frozen || seq <= m_frozenSeq); });
+    lock.unlock();
+
+    RC result = func();
+
+    lock.lock();
+    ++m_completed;
+    m_doneCv.notify_all();
+    return result;
+}
+
+void RedoReplayPool::Freeze()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (!m_running) {
+        return;
+    }
+    m_frozen = true;
+    m_frozenSeq = m_lastSeq;
+    m_doneCv.wait(lock, [this]() { return m_completed == m_frozenSeq; });
+}
+
+void RedoReplayPool::Unfreeze()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_frozen) {
+        return;
+    }
+    m_frozen = false;
+    for (uint32_t i = 0; i < m_workerCount; ++i) {
+        m_queues[i].m_cv.notify_all();
+    }
+    m_doneCv.notify_all();
+}
+
+void RedoReplayPool::WorkerFunc(uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOTEngine* engine = MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        // keep draining the queue, the replay function reports the missing transaction
+        MOT_LOG_ERROR("Failed to initialize session context for redo replay worker %u", workerId);
+    }
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(MOTCurrThreadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo replay worker %u, replay performance may be affected", workerId);
+    }
+
+    SurrogateState sState;
+    ReplayWorker& worker = m_queues[workerId];
+    MOT_LOG_DEBUG("Redo replay worker %u started", workerId);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true) {
+        worker.m_cv.wait(lock, [this, &worker]() { return !m_running || CanReplay(worker); });
+        if (!CanReplay(worker)) {
+            // stop clears the frozen state, so the queue is empty
+            break;
+        }
+
+        ReplayTask task = worker.m_queue.front();
+        worker.m_queue.pop_front();
+        lock.unlock();
+
+        if (m_replayFunc(task.m_segments, task.m_transactionId, sState) != RC_OK) {
+            MOT_LOG_ERROR(
+                "Redo replay worker %u failed to replay transaction %" PRIu64, workerId, task.m_transactionId);
+        }
+        delete task.m_segments;
+
+        lock.lock();
+        ++m_completed;
+        m_doneCv.notify_all();
+    }
+    lock.unlock();
+
+    if (sState.IsValid() && !sState.IsEmpty()) {
+        GetRecoveryManager()->AddSurrogateArrayToList(sState);
+    }
+
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("Redo replay worker %u stopped", workerId);
+}
+}  // namespace MOT
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_pool.h
+ *    Pool of worker threads replaying committed redo transactions in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_pool.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef REDO_REPLAY_POOL_H
+#define REDO_REPLAY_POOL_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "global.h"
+#include "surrogate_state.h"
+#include "redo_log_transaction_segments.h"
+
+namespace MOT {
+/**
+ * @class RedoReplayPool
+ * @brief Replays committed redo transactions on a set of worker threads.
+ * @detail Each transaction is assigned a sequence number in dispatch (log) order, and is queued to a single worker
+ * chosen by the caller. Each worker replays its queue in FIFO order, so transactions dispatched to the same worker
+ * are replayed in log order. Transactions that cannot be replayed in parallel are executed exclusively by the caller
+ * thread, after all previously dispatched transactions have completed (see @ref RunExclusive()).
+ * The pool can be frozen at a point in the log (see @ref Freeze()), such that the set of replayed transactions is
+ * exactly a prefix of the log until the pool is unfrozen.
+ */
+class RedoReplayPool {
+public:
+    /**
+     * @typedef ReplayFunc
+     * @brief Replays a single transaction. The worker surrogate state is passed as the last argument.
+     */
+    typedef std::function<RC(RedoLogTransactionSegments*, uint64_t, SurrogateState&)> ReplayFunc;
+
+    RedoReplayPool(uint32_t workerCount, const ReplayFunc& replayFunc);
+    ~RedoReplayPool();
+
+    /**
+     * @brief Starts all worker threads.
+     * @return True if all threads were started.
+     */
+    bool Start();
+
+    /** @brief Replays all queued transactions, then stops all worker threads and waits for them to finish. */
+    void Stop();
+
+    inline bool IsStarted() const
+    {
+        return m_workers != nullptr;
+    }
+
+    inline uint32_t GetWorkerCount() const
+    {
+        return m_workerCount;
+    }
+
+    /**
+     * @brief Queues a transaction for replay by a worker. Blocks while the worker queue is full.
+     * @param workerId The worker to replay the transaction.
+     * @param segments The transaction segments. Ownership is transferred to the pool.
+     * @param transactionId The internal transaction id.
+     */
+    void Dispatch(uint32_t workerId, RedoLogTransactionSegments* segments, uint64_t transactionId);
+
+    /**
+     * @brief Executes a function on the caller thread after all previously dispatched transactions have been
+     * replayed, and before any transaction dispatched later. Used for transactions that cannot be replayed in
+     * parallel (DDL, multi-table transactions).
+     * @param func The function to execute.
+     * @return The function result.
+     */
+    RC RunExclusive(const std::function<RC()>& func);
+
+    /**
+     * @brief Waits until all transactions dispatched so far have been replayed, and holds back any transaction
+     * dispatched later until @ref Unfreeze() is called.
+     */
+    void Freeze();
+
+    /** @brief Releases transactions held back by @ref Freeze(). */
+    void Unfreeze();
+
+private:
+    /**
+     * @struct ReplayTask
+     * @brief A single transaction queued for replay.
+     */
+    struct ReplayTask {
+        RedoLogTransactionSegments* m_segments;
+
+        uint64_t m_transactionId;
+
+        uint64_t m_seq;
+    };
+
+    /**
+     * @struct ReplayWorker
+     * @brief The replay queue of a single worker.
+     */
+    struct ReplayWorker {
+        std::deque<ReplayTask> m_queue;
+
+        std::condition_variable m_cv;
+    };
+
+    /** @var Maximum number of transactions queued on a single worker before dispatch blocks. */
+    static constexpr size_t MAX_WORKER_QUEUE_SIZE = 1024;
+
+    /**
+     * @brief Worker thread function.
+     * @param workerId The zero-based worker identifier.
+     */
+    void WorkerFunc(uint32_t workerId);
+
+    /** @brief Queries whether the head of a worker queue may be replayed. Must be called under pool lock. */
+    inline bool CanReplay(const ReplayWorker& worker) const
+    {
+        return !worker.m_queue.empty() && (!m_frozen || worker.m_queue.front().m_seq <= m_frozenSeq);
+    }
+
+    /** @var The worker threads (opaque to avoid including thread header). */
+    void* m_workers;
+
+    /** @var The worker queues. */
+    ReplayWorker* m_queues;
+
+    /** @var The number of worker threads. */
+    uint32_t m_workerCount;
+
+    /** @var The transaction replay function. */
+    ReplayFunc m_replayFunc;
+
+    /** @var Specifies whether the pool is running. */
+    bool m_running;
+
+    /** @var Specifies whether the pool is frozen. */
+    bool m_frozen;
+
+    /** @var The last sequence number that may be replayed while the pool is frozen. */
+    uint64_t m_frozenSeq;
+
+    /** @var The last sequence number assigned to a transaction. */
+    uint64_t m_lastSeq;
+
+    /** @var The number of transactions whose replay completed. */
+    uint64_t m_completed;
+
+    /** @var Synchronizes all pool state. */
+    std::mutex m_lock;
+
+    /** @var Notifies on replay completion and queue space. */
+    std::condition_variable m_doneCv;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* REDO_REPLAY_POOL_H */
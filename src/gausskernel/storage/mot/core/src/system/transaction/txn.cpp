@@ -82,6 +82,11 @@ RC TxnManager::InsertRow(Row* row)
     return result;
 }
 
+bool TxnManager::ReserveAccesses(uint32_t count)
+{
+    return m_accessMgr->ReserveAccessSet(count);
+}
+
 Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSentinel, RC& rc)
 {
     rc = RC_OK;
@@ -121,6 +126,40 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
     }
 }
 
+Row* TxnManager::CoveringRowLookup(const AccessType type, Sentinel* const& originalSentinel, RC& rc)
+{
+    rc = RC_OK;
+    // index-only reads are served only for read-committed reads through a covering secondary index
+    if (unlikely(originalSentinel == nullptr)) {
+        return nullptr;
+    }
+    if (type != AccessType::RD || GetTxnIsoLevel() != READ_COMMITED || !originalSentinel->GetIndex()->IsCovering()) {
+        return RowLookup(type, originalSentinel, rc);
+    }
+    GcSessionStart();
+
+    Row* local_row = nullptr;
+    RC res = AccessLookup(type, originalSentinel, local_row);
+
+    switch (res) {
+        case RC::RC_LOCAL_ROW_DELETED:
+            return nullptr;
+        case RC::RC_LOCAL_ROW_FOUND:
+            return local_row;
+        case RC::RC_LOCAL_ROW_NOT_FOUND:
+            if (likely(originalSentinel->IsCommited() == true)) {
+                return m_accessMgr->GetReadCommitedCoveringRow(originalSentinel);
+            } else {
+                return nullptr;
+            }
+        case RC::RC_MEMORY_ALLOCATION_ERROR:
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            return nullptr;
+        default:
+            return nullptr;
+    }
+}
+
 RC TxnManager::AccessLookup(const AccessType type, Sentinel* const& originalSentinel, Row*& localRow)
 {
     return m_accessMgr->AccessLookup(type, originalSentinel, localRow);
@@ -368,6 +407,7 @@ void TxnManager::Cleanup()
     }
     m_txnDdlAccess->Reset();
     m_checkpointPhase = CheckpointPhase::NONE;
+    m_checkpointDeletes.clear();
     m_csn = CSNManager::INVALID_CSN;
     m_occManager.CleanUp();
     m_err = RC_OK;
@@ -1163,6 +1203,8 @@ RC TxnManager::TruncateTable(Table* table)
                 table->m_primaryIndex = index_copy;
         }
         m_txnDdlAccess->Add(ddl_access);
+        // rows removed by truncate are not tracked, so a delta checkpoint cannot be applied on top of older data
+        table->SetCheckpointFullImage();
     }
 
     return res;
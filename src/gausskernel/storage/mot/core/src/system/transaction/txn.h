@@ -30,7 +30,10 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "global.h"
 #include "redo_log.h"
@@ -248,6 +251,14 @@ public:
      */
     RC InsertRow(Row* row);
 
+    /**
+     * @brief Makes room in the transaction access set for a number of additional row accesses, ahead of inserting a
+     * batch of rows.
+     * @param count The number of additional row accesses.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReserveAccesses(uint32_t count);
+
     InsItem* GetNextInsertItem(Index* index = nullptr);
     Key* GetTxnKey(Index* index);
 
@@ -286,6 +297,18 @@ public:
      */
     Row* RowLookup(const AccessType type, Sentinel* const& originalSentinel, RC& rc);
 
+    /**
+     * @brief Searches for a row through a secondary index sentinel, serving read-committed reads of covering indexes
+     * from the data stored in the index entry (index-only read).
+     * @detail Only the columns covered by the index are valid in the returned row. Any other kind of access falls
+     * back to a regular row lookup.
+     * @param type The purpose for retrieving the row.
+     * @param originalSentinel The secondary index sentinel.
+     * @param[out] rc Return code denoting success or failure.
+     * @return The row or null pointer if none was found.
+     */
+    Row* CoveringRowLookup(const AccessType type, Sentinel* const& originalSentinel, RC& rc);
+
     /**
      * @brief Searches for a row in the local cache by a row.
      * @detail Rows may be updated concurrently, so the cache layer needs to be
@@ -546,6 +569,9 @@ private:
     /** @var Checkpoint not available capture during being transaction. */
     volatile bool m_checkpointNABit;
 
+    /** @var Primary keys of the rows deleted by the committing transaction, kept for the delta checkpoint. */
+    std::vector<std::pair<Table*, std::string>> m_checkpointDeletes;
+
     /** @var CSN taken at the commit stage. */
     uint64_t m_csn;
 
@@ -34,6 +34,9 @@ namespace MOT {
 IMPLEMENT_CLASS_LOGGER(TxnInsertAction, TxMan);
 IMPLEMENT_CLASS_LOGGER(TxnAccess, TxMan);
 
+/** @define Number of attempts to copy the covering data of an index entry before reading the row itself. */
+#define COVERING_READ_RETRIES 8
+
 TxnAccess::TxnAccess()
     : m_accessesSetBuff(nullptr),
       m_rowCnt(0),
@@ -200,10 +203,24 @@ void TxnAccess::DestroyAccess(Access* access)
     }
 }
 
-bool TxnAccess::ReallocAccessSet()
+bool TxnAccess::ReserveAccessSet(uint32_t count)
+{
+    uint64_t new_array_size = m_accessSetSize;
+    while (new_array_size <= (uint64_t)m_rowCnt + count) {
+        new_array_size *= ACCESS_SET_EXTEND_FACTOR;
+    }
+    if (new_array_size == m_accessSetSize) {
+        return true;
+    }
+    return ReallocAccessSet(new_array_size);
+}
+
+bool TxnAccess::ReallocAccessSet(uint64_t new_array_size)
 {
     bool rc = true;
-    uint64_t new_array_size = m_accessSetSize * ACCESS_SET_EXTEND_FACTOR;
+    if (new_array_size == 0) {
+        new_array_size = m_accessSetSize * ACCESS_SET_EXTEND_FACTOR;
+    }
     MOT_LOG_DEBUG("Increasing  Access Size! from %d to %lu", m_accessSetSize, new_array_size);
 
     uint32_t alloc_size = sizeof(Access*) * new_array_size;
@@ -699,6 +716,34 @@ Row* TxnAccess::GetReadCommitedRow(Sentinel* sentinel)
     } else
         return nullptr;
 }
+
+Row* TxnAccess::GetReadCommitedCoveringRow(Sentinel* sentinel)
+{
+    Sentinel* primarySentinel = reinterpret_cast<Sentinel*>(sentinel->GetPrimarySentinel());
+    if (unlikely(primarySentinel == nullptr)) {
+        return nullptr;
+    }
+    Row* row = primarySentinel->GetData();
+    // the covered columns cannot be updated, so only visibility of the primary row needs to be checked
+    if (row == nullptr || row->IsAbsentRow()) {
+        return nullptr;
+    }
+    m_rowZero->m_table = row->GetTable();
+    // an upgrade insert re-stores the covering data in place, so retry while the version shows a concurrent store
+    for (int retry = 0; retry < COVERING_READ_RETRIES; retry++) {
+        if (sentinel->GetIndex()->LoadCoveringData(sentinel, m_rowZero)) {
+            COMPILER_BARRIER
+            if (likely(sentinel->GetPrimarySentinel() == primarySentinel)) {
+                return m_rowZero;
+            }
+            break;
+        }
+        PAUSE
+    }
+    // the entry kept changing, or was re-bound to another row while we were reading it, so read the row itself
+    return GetReadCommitedRow(sentinel);
+}
+
 RC TxnAccess::GenerateDeletes(Access* element)
 {
     RC rc = RC_OK;
@@ -187,6 +187,13 @@ public:
      */
     Row* GetReadCommitedRow(Sentinel* sentinel);
 
+    /**
+     * @brief For Read-Commited index-only reads we return the covered columns stored in the index entry
+     * @param sentinel The secondary index sentinel of a covering index
+     * @return row zero with the covered columns, or null pointer if the row was deleted
+     */
+    Row* GetReadCommitedCoveringRow(Sentinel* sentinel);
+
     /**
      * @brief Undo insert operation if possible after delete
      * @param element Current row to be deleted
@@ -208,6 +215,14 @@ public:
         ReleaseAccess(access);
     }
 
+    /**
+     * @brief Makes room in the access set for a number of additional row accesses in a single allocation, instead
+     * of growing it repeatedly (used when inserting a batch of rows).
+     * @param count The number of additional row accesses.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReserveAccessSet(uint32_t count);
+
     TxnInsertAction* GetInsertMgr() const
     {
         return m_insertManager;
@@ -319,8 +334,11 @@ private:
         DestroyAccess(ac);
     }
 
-    /** @brief Doubles the size of the access set. */
-    bool ReallocAccessSet();
+    /**
+     * @brief Grows the access set.
+     * @param new_array_size The new access set size, or zero to double the current size.
+     */
+    bool ReallocAccessSet(uint64_t new_array_size = 0);
 
     /** @brief Doubles the size of the access set. */
     void ShrinkAccessSet();
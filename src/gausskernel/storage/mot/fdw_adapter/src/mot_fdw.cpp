@@ -509,6 +509,10 @@ static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index*
 {
     bool res = false;
 
+    // unordered (hash) indexes cannot provide any ordering
+    if (!ix->IsOrdered())
+        return res;
+
     if (ord->m_order == SORTDIR_ENUM::SORTDIR_NONE)
         ord->m_order = SORT_STRATEGY(pathKey->pk_strategy);
     else if (ord->m_order != SORT_STRATEGY(pathKey->pk_strategy))
@@ -848,7 +852,9 @@ static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es)
 
         // index name
         appendStringInfoSpaces(es->str, es->indent);
-        ExplainPropertyText("->  Index Scan on", festate->m_bestIx->m_ix->GetName().c_str(), es);
+        ExplainPropertyText(MOTAdaptor::IsIndexOnlyScan(festate) ? "->  Index Only Scan on" : "->  Index Scan on",
+            festate->m_bestIx->m_ix->GetName().c_str(),
+            es);
         es->indent += 2;
 
         // details for index
@@ -909,6 +915,7 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
             break;
         }
     }
+    festate->m_indexOnly = MOTAdaptor::IsIndexOnlyScan(festate);
 }
 
 static void MOTBeginForeignModify(
@@ -974,7 +981,9 @@ static TupleTableSlot* IterateForeignScanStopAtFirst(
     MOTAdaptor::CreateKeyBuffer(node->ss.ss_currentRelation, festate, 0);
     MOT::Sentinel* Sentinel =
         festate->m_bestIx->m_ix->IndexReadSentinel(&festate->m_stateKey[0], festate->m_currTxn->GetThdId());
-    MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
+    MOT::Row* currRow = festate->m_indexOnly
+                            ? festate->m_currTxn->CoveringRowLookup(festate->m_internalCmdOper, Sentinel, rc)
+                            : festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
 
     if (currRow != NULL) {
         MOTAdaptor::UnpackRow(
@@ -1061,7 +1070,9 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
 
     do {
         MOT::Sentinel* Sentinel = festate->m_cursor[0]->GetPrimarySentinel();
-        currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
+        currRow = festate->m_indexOnly
+                      ? festate->m_currTxn->CoveringRowLookup(festate->m_internalCmdOper, Sentinel, rc)
+                      : festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
         if (currRow == NULL) {
             if (rc != MOT::RC_OK) {
                 if (MOT_IS_SEVERE()) {
@@ -1386,6 +1397,10 @@ static TupleTableSlot* MOTExecForeignInsert(
 
     if (MOTAdaptor::m_engine->IsSoftMemoryLimitReached() && fdwState != nullptr) {
         CleanQueryStatesOnError(fdwState->m_currTxn);
+        if (fdwState->m_insertBatchCount > 0) {
+            // pending batch rows must still be released on rollback
+            fdwState->m_currTxn->m_queryState[(uint64_t)fdwState] = (uint64_t)fdwState;
+        }
     }
 
     isMemoryLimitReached();
@@ -1407,6 +1422,10 @@ static TupleTableSlot* MOTExecForeignInsert(
         fdwState->m_attrsModified = (uint8_t*)palloc0(len);
         errno_t erc = memset_s(fdwState->m_attrsUsed, len, 0xff, len);
         securec_check(erc, "\0", "\0");
+        // no modify plan, so this is COPY: rows are inserted in batches and the last one is flushed at end of modify
+        if (resultRelInfo->ri_projectReturning == nullptr) {
+            MOTAdaptor::InitInsertBatch(fdwState);
+        }
         resultRelInfo->ri_FdwState = fdwState;
     }
 
@@ -1549,6 +1568,29 @@ static void MOTEndForeignModify(EState* estate, ResultRelInfo* resultRelInfo)
 {
     MOTFdwStateSt* fdwState = (MOTFdwStateSt*)resultRelInfo->ri_FdwState;
 
+    if (fdwState == nullptr) {
+        return;
+    }
+
+    if (fdwState->m_insertBatch != nullptr) {
+        MOT::RC rc = MOTAdaptor::FlushInsertBatch(fdwState);
+        if (rc != MOT::RC_OK) {
+            if (MOT_IS_SEVERE()) {
+                MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTEndForeignModify", "Failed to insert row batch");
+                MOT_LOG_ERROR_STACK("Failed to insert row batch");
+            }
+            elog(DEBUG2, "Abort parent transaction from MOT batch insert, id %lu", fdwState->m_txnId);
+            MOT::TxnManager* txn = fdwState->m_currTxn;
+            ReleaseFdwState(fdwState);
+            resultRelInfo->ri_FdwState = NULL;
+            CleanQueryStatesOnError(txn);
+            report_pg_error(rc,
+                (void*)(txn->m_errIx != nullptr ? txn->m_errIx->GetName().c_str() : "unknown"),
+                (void*)txn->m_errMsgBuf);
+            return;
+        }
+    }
+
     if (fdwState->m_allocInScan == false) {
         ReleaseFdwState(fdwState);
         resultRelInfo->ri_FdwState = NULL;
@@ -1719,7 +1761,7 @@ static void MOTXactCallback(XactEvent event, void* arg)
         MOTAdaptor::RollbackPrepared();
         txn->SetTxnState(MOT::TxnState::TXN_ROLLBACK);
     } else if (event == XACT_EVENT_PREROLLBACK_CLEANUP) {
-        CleanQueryStatesOnError(txn);
+        CleanQueryStatesOnRollback(txn);
     }
 }
 
@@ -33,10 +33,11 @@
 #include "mot_engine.h"
 #include "recovery_manager.h"
 #include "miscadmin.h"
+#include "lz4.h"
 
 bool IsValidEntry(uint8 code)
 {
-    return code == MOT_REDO_DATA;
+    return code == MOT_REDO_DATA || code == MOT_REDO_COMPRESSED_DATA;
 }
 
 void RedoTransactionCommit(TransactionId xid, void* arg)
@@ -67,13 +68,52 @@ void MOTRedo(XLogReaderState* record)
     char* data = XLogRecGetData(record);
     size_t len = XLogRecGetDataLen(record);
     uint64_t lsn = record->EndRecPtr;
+    char* rawData = nullptr;
     if (!IsValidEntry(recordType)) {
         elog(ERROR, "MOTRedo: invalid op code %u", recordType);
     }
+    if (recordType == MOT_REDO_COMPRESSED_DATA) {
+        rawData = DecompressRedoData(data, len);
+        data = rawData;
+        len = ((MOTCompressedRedoHeader*)XLogRecGetData(record))->m_rawSize;
+    }
     if (MOT::GetRecoveryManager()->IsErrorSet() || !MOT::GetRecoveryManager()->ApplyRedoLog(lsn, data, len)) {
         // we treat errors fatally.
         ereport(FATAL, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("MOT recovery failed.")));
     }
+    if (rawData != nullptr) {
+        free(rawData);
+    }
+}
+
+char* DecompressRedoData(const char* data, size_t len)
+{
+    MOTCompressedRedoHeader header;
+    if (len < sizeof(MOTCompressedRedoHeader)) {
+        ereport(FATAL, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("MOTRedo: invalid compressed redo record length")));
+    }
+    errno_t erc = memcpy_s(&header, sizeof(MOTCompressedRedoHeader), data, sizeof(MOTCompressedRedoHeader));
+    securec_check(erc, "\0", "\0");
+
+    char* rawData = (char*)malloc(header.m_rawSize);
+    if (rawData == nullptr) {
+        ereport(FATAL,
+            (errcode(ERRCODE_OUT_OF_MEMORY),
+                errmsg("MOTRedo: failed to allocate %u bytes for decompressed redo data", header.m_rawSize)));
+    }
+    int rawSize = LZ4_decompress_safe(data + sizeof(MOTCompressedRedoHeader),
+        rawData,
+        (int)(len - sizeof(MOTCompressedRedoHeader)),
+        (int)header.m_rawSize);
+    if (rawSize < 0 || (uint32_t)rawSize != header.m_rawSize) {
+        free(rawData);
+        ereport(FATAL,
+            (errcode(ERRCODE_DATA_CORRUPTED),
+                errmsg("MOTRedo: failed to decompress redo record (expected %u bytes, got %d)",
+                    header.m_rawSize,
+                    rawSize)));
+    }
+    return rawData;
 }
 
 uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t size)
@@ -83,6 +123,10 @@ uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t
 
 uint64_t XLOGLogger::AddToLog(uint8_t* data, uint32_t size)
 {
+    if (MOT::GetGlobalConfiguration().m_enableRedoLogCompression && size >= MOT_REDO_COMPRESSION_MIN_SIZE) {
+        return AddCompressedToLog(data, size);
+    }
+
     START_CRIT_SECTION();
     XLogBeginInsert();
     XLogRegisterData((char*)data, size);
@@ -91,6 +135,41 @@ uint64_t XLOGLogger::AddToLog(uint8_t* data, uint32_t size)
     return size;
 }
 
+uint64_t XLOGLogger::AddCompressedToLog(uint8_t* data, uint32_t size)
+{
+    // compression buffer must be allocated outside the critical section
+    int bound = LZ4_compressBound((int)size);
+    char* compressed = (bound > 0) ? (char*)malloc(bound) : nullptr;
+    int compressedSize = 0;
+    if (compressed != nullptr) {
+        compressedSize = LZ4_compress_default((const char*)data, compressed, (int)size, bound);
+    }
+
+    // fall back to plain redo data if compression failed or did not pay off
+    if (compressedSize <= 0 || (uint32_t)compressedSize + sizeof(MOTCompressedRedoHeader) >= size) {
+        if (compressed != nullptr) {
+            free(compressed);
+        }
+        START_CRIT_SECTION();
+        XLogBeginInsert();
+        XLogRegisterData((char*)data, size);
+        XLogInsert(RM_MOT_ID, MOT_REDO_DATA);
+        END_CRIT_SECTION();
+        return size;
+    }
+
+    MOTCompressedRedoHeader header;
+    header.m_rawSize = size;
+    START_CRIT_SECTION();
+    XLogBeginInsert();
+    XLogRegisterData((char*)&header, sizeof(MOTCompressedRedoHeader));
+    XLogRegisterData(compressed, (uint32)compressedSize);
+    XLogInsert(RM_MOT_ID, MOT_REDO_COMPRESSED_DATA);
+    END_CRIT_SECTION();
+    free(compressed);
+    return sizeof(MOTCompressedRedoHeader) + compressedSize;
+}
+
 void XLOGLogger::FlushLog()
 {}
 
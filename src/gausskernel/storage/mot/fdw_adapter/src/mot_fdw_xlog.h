@@ -35,9 +35,28 @@
  */
 const int MOT_REDO_DATA = 0x10;
 
+/* LZ4 compressed redo data, prefixed with MOTCompressedRedoHeader */
+const int MOT_REDO_COMPRESSED_DATA = 0x20;
+
+/* redo data smaller than this is not worth compressing */
+const uint32_t MOT_REDO_COMPRESSION_MIN_SIZE = 256;
+
+struct MOTCompressedRedoHeader {
+    /* size of the redo data before compression */
+    uint32_t m_rawSize;
+};
+
 MOT::TxnCommitStatus GetTransactionStateCallback(uint64_t transactionId);
 void RedoTransactionCommit(TransactionId xid, void* arg);
 
+/**
+ * @brief Decompresses the payload of a MOT_REDO_COMPRESSED_DATA record. Errors are treated fatally.
+ * @param data The record data (header followed by compressed redo data).
+ * @param len The record data length.
+ * @return The decompressed redo data, which the caller must free.
+ */
+char* DecompressRedoData(const char* data, size_t len);
+
 class XLOGLogger : public MOT::ILogger {
 public:
     inline XLOGLogger()
@@ -50,6 +69,9 @@ public:
     void FlushLog();
     void CloseLog();
     void ClearLog();
+
+private:
+    uint64_t AddCompressedToLog(uint8_t* data, uint32_t size);
 };
 
 #endif /* MOT_FDW_XLOG_H */
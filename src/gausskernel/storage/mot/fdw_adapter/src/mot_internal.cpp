@@ -647,6 +647,18 @@ MOT::RC MOTAdaptor::InsertRow(MOTFdwStateSt* fdwState, TupleTableSlot* slot)
     newRowData = const_cast<uint8_t*>(row->GetData());
     PackRow(slot, table, fdwState->m_attrsUsed, newRowData);
 
+    if (fdwState->m_insertBatch != nullptr) {
+        if (fdwState->m_insertBatchCount == 0) {
+            // the state may have been dropped from the query states, but pending rows must be released on rollback
+            fdwState->m_currTxn->m_queryState[(uint64_t)fdwState] = (uint64_t)fdwState;
+        }
+        fdwState->m_insertBatch[fdwState->m_insertBatchCount++] = row;
+        if (fdwState->m_insertBatchCount < fdwState->m_insertBatchSize) {
+            return MOT::RC_OK;
+        }
+        return FlushInsertBatch(fdwState);
+    }
+
     MOT::RC res = table->InsertRow(row, fdwState->m_currTxn);
     if ((res != MOT::RC_OK) && (res != MOT::RC_UNIQUE_VIOLATION)) {
         MOT_REPORT_ERROR(
@@ -655,6 +667,48 @@ MOT::RC MOTAdaptor::InsertRow(MOTFdwStateSt* fdwState, TupleTableSlot* slot)
     return res;
 }
 
+void MOTAdaptor::InitInsertBatch(MOTFdwStateSt* fdwState)
+{
+    uint32_t batchSize = MOT::GetGlobalConfiguration().m_bulkInsertBatchSize;
+    if (batchSize > 1) {
+        fdwState->m_insertBatch = (MOT::Row**)palloc(sizeof(MOT::Row*) * batchSize);
+        fdwState->m_insertBatchSize = batchSize;
+        fdwState->m_insertBatchCount = 0;
+    }
+}
+
+MOT::RC MOTAdaptor::FlushInsertBatch(MOTFdwStateSt* fdwState)
+{
+    if (fdwState->m_insertBatchCount == 0) {
+        return MOT::RC_OK;
+    }
+
+    EnsureSafeThreadAccessInline();
+    fdwState->m_currTxn->SetTransactionId(fdwState->m_txnId);
+    MOT::Table* table = fdwState->m_table;
+    uint32_t numRows = fdwState->m_insertBatchCount;
+
+    // the batch owns the rows from here on, also on failure
+    fdwState->m_insertBatchCount = 0;
+    MOT::RC res = table->InsertRowBatch(fdwState->m_insertBatch, numRows, fdwState->m_currTxn);
+    if ((res != MOT::RC_OK) && (res != MOT::RC_UNIQUE_VIOLATION)) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Insert Row Batch",
+            "Failed to insert batch of %u new rows for table %s",
+            numRows,
+            table->GetLongTableName().c_str());
+    }
+    return res;
+}
+
+void MOTAdaptor::DiscardInsertBatch(MOTFdwStateSt* fdwState)
+{
+    for (uint32_t i = 0; i < fdwState->m_insertBatchCount; i++) {
+        fdwState->m_table->DestroyRow(fdwState->m_insertBatch[i]);
+    }
+    fdwState->m_insertBatchCount = 0;
+}
+
 MOT::RC MOTAdaptor::UpdateRow(MOTFdwStateSt* fdwState, TupleTableSlot* slot, MOT::Row* currRow)
 {
     EnsureSafeThreadAccessInline();
@@ -812,6 +866,19 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             MOT::Index* ix = festate->m_table->GetPrimaryIndex();
             uint16_t keyLength = ix->GetKeyLength();
 
+            // unordered primary index: scan forward in bucket order, up to the last item found at open time, as
+            // there is no greatest key to search for
+            if (!ix->IsOrdered()) {
+                festate->m_forwardDirectionScan = true;
+                festate->m_cursor[0] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
+                festate->m_cursor[1] = ix->Last(festate->m_currTxn->GetThdId());
+                // without the end cursor the scan is not bounded, so fail instead of scanning past it
+                if (festate->m_cursor[1] == nullptr) {
+                    report_pg_error(MOT::RC_MEMORY_ALLOCATION_ERROR);
+                }
+                break;
+            }
+
             if (festate->m_order == SORTDIR_ENUM::SORTDIR_ASC) {
                 fIx = 0;
                 bIx = 1;
@@ -1072,6 +1139,62 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
     }
 }
 
+void MOTAdaptor::SetCoveringFields(IndexStmt* stmt, MOT::Table* table, MOT::Index* index)
+{
+    // the key columns are covered as well, so that index-only scans can project them
+    uint32_t count = 0;
+    uint32_t dataSize = 0;
+    const int16_t* keyColumns = index->GetColumnKeyFields();
+    for (int16_t i = 0; i < index->GetNumFields(); i++) {
+        MOT::Column* col = table->GetField(keyColumns[i]);
+        index->SetCoveringField(count++, keyColumns[i], col->m_size);
+        dataSize += col->m_size;
+    }
+
+    ListCell* lc = nullptr;
+    foreach (lc, stmt->indexIncludingParams) {
+        IndexElem* ielem = (IndexElem*)lfirst(lc);
+        uint64_t colid = table->GetFieldId((ielem->name != nullptr ? ielem->name : ielem->indexcolname));
+        if (colid == (uint64_t)-1) {  // invalid column
+            delete index;
+            ereport(ERROR,
+                (errmodule(MOD_MOT),
+                    errcode(ERRCODE_INVALID_COLUMN_DEFINITION),
+                    errmsg("Can't create index on field"),
+                    errdetail("Specified included column not found in table definition")));
+            return;
+        }
+        if (index->IsFieldCovered((int16_t)colid)) {
+            continue;
+        }
+        if (count == MAX_COVERING_COLUMNS) {
+            delete index;
+            ereport(ERROR,
+                (errmodule(MOD_MOT),
+                    errcode(ERRCODE_FDW_TOO_MANY_INDEX_COLUMNS),
+                    errmsg("Can't create index"),
+                    errdetail("Number of key and included columns exceeds max allowed %u", MAX_COVERING_COLUMNS)));
+            return;
+        }
+        MOT::Column* col = table->GetField(colid);
+        index->SetCoveringField(count++, (int16_t)colid, col->m_size);
+        dataSize += col->m_size;
+    }
+
+    if (dataSize > MAX_COVERING_DATA_SIZE) {
+        delete index;
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_INVALID_COLUMN_DEFINITION),
+                errmsg("Can't create index"),
+                errdetail("Size of key and included columns %u exceeds max allowed %u",
+                    dataSize,
+                    MAX_COVERING_DATA_SIZE)));
+        return;
+    }
+    index->SetNumCoveringFields(count);
+}
+
 MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
 {
     MOT::RC res;
@@ -1107,6 +1230,10 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     // check if we have primary and delete previous definition
     if (stmt->primary) {
         index_order = MOT::IndexOrder::INDEX_ORDER_PRIMARY;
+        // primary key may be served by a hash index (point access only) if configured
+        if (MOT::GetGlobalConfiguration().m_enableHashPrimaryIndex) {
+            indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+        }
     }
 
     index = MOT::IndexFactory::CreateIndex(index_order, indexing_method, flavor);
@@ -1173,6 +1300,11 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
 
     index->SetNumIndexFields(count);
 
+    // included columns turn a secondary index into a covering index, the primary index always reaches the row
+    if (!stmt->primary && stmt->indexIncludingParams != NIL) {
+        SetCoveringFields(stmt, table, index);
+    }
+
     if ((res = index->IndexInit(keyLength, stmt->unique, stmt->idxname, nullptr)) != MOT::RC_OK) {
         delete index;
         report_pg_error(res);
@@ -1752,6 +1884,27 @@ void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start
     festate->m_bestIx->m_ix->AdjustKey(&festate->m_stateKey[start], pattern);
 }
 
+bool MOTAdaptor::IsIndexOnlyScan(MOTFdwStateSt* festate)
+{
+    // plain reads through a covering index, that do not need the row itself (i.e. no ctid for modify)
+    if (festate->m_bestIx == nullptr || festate->m_cmdOper != CMD_SELECT || festate->m_hasForUpdate ||
+        festate->m_ctidNum != 0) {
+        return false;
+    }
+
+    MOT::Index* ix = festate->m_bestIx->m_ix;
+    if (ix == nullptr || !ix->IsCovering()) {
+        return false;
+    }
+
+    for (int i = 0; i < festate->m_numAttrs; i++) {
+        if (BITMAP_GET(festate->m_attrsUsed, i) && !ix->IsFieldCovered(i + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
 {
     bool res = false;
@@ -1770,6 +1923,11 @@ bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
         const MOT::Key* endKey = nullptr;
         MOT::Index* ix = (festate->m_bestIx != nullptr ? festate->m_bestIx->m_ix : festate->m_table->GetPrimaryIndex());
 
+        // the iteration order of an unordered index does not follow the key order
+        if (!ix->IsOrdered()) {
+            return festate->m_cursor[0]->IsPast(festate->m_cursor[1]);
+        }
+
         startKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[0]->GetKey());
         endKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[1]->GetKey());
         if (startKey != nullptr && endKey != nullptr) {
@@ -2225,6 +2383,11 @@ void ReleaseFdwState(MOTFdwStateSt* state)
     if (state->m_attrsModified != NULL)
         pfree(state->m_attrsModified);
 
+    if (state->m_insertBatch != nullptr) {
+        MOTAdaptor::DiscardInsertBatch(state);
+        pfree(state->m_insertBatch);
+    }
+
     state->m_table = NULL;
     pfree(state);
 }
@@ -155,7 +155,13 @@ struct MOTFdwState_St {
     bool m_cursorOpened = false;
     MOT::MaxKey m_stateKey[2];
     bool m_forwardDirectionScan;
+    bool m_indexOnly;
     MOT::AccessType m_internalCmdOper;
+
+    // bulk insert (COPY) batch of packed rows not yet inserted
+    MOT::Row** m_insertBatch = nullptr;
+    uint32_t m_insertBatchSize = 0;
+    uint32_t m_insertBatchCount = 0;
 };
 
 class MOTAdaptor {
@@ -221,6 +227,11 @@ public:
     static MOT::RC UpdateRow(MOTFdwStateSt* fdwState, TupleTableSlot* slot, MOT::Row* currRow);
     static MOT::RC DeleteRow(MOTFdwStateSt* fdwState, TupleTableSlot* slot);
 
+    // bulk insert helpers
+    static void InitInsertBatch(MOTFdwStateSt* fdwState);
+    static MOT::RC FlushInsertBatch(MOTFdwStateSt* fdwState);
+    static void DiscardInsertBatch(MOTFdwStateSt* fdwState);
+
     /* Convertors */
     inline static void PGNumericToMOT(const Numeric n, MOT::DecimalSt& d)
     {
@@ -273,6 +284,7 @@ public:
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
     static bool IsScanEnd(MOTFdwStateSt* festate);
+    static bool IsIndexOnlyScan(MOTFdwStateSt* festate);
     static void CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start);
 
     // planning helpers
@@ -316,6 +328,12 @@ private:
 
     static void ValidateCreateIndex(IndexStmt* index, MOT::Table* table, MOT::TxnManager* txn);
 
+    /**
+     * @brief Sets the covering columns (key columns followed by included columns) of a secondary index.
+     * NOTE: On failure, index object will be deleted and ereport will be done.
+     */
+    static void SetCoveringFields(IndexStmt* stmt, MOT::Table* table, MOT::Index* index);
+
     static void VarcharToMOTKey(MOT::Column* col, ExprState* expr, Datum datum, Oid type, uint8_t* data, size_t len,
         KEY_OPER oper, uint8_t fill);
     static void FloatToMOTKey(MOT::Column* col, ExprState* expr, Datum datum, uint8_t* data);
@@ -391,6 +409,19 @@ inline void CleanQueryStatesOnError(MOT::TxnManager* txn)
     }
 }
 
+inline void CleanQueryStatesOnRollback(MOT::TxnManager* txn)
+{
+    if (txn != nullptr) {
+        for (auto& itr : txn->m_queryState) {
+            MOTFdwStateSt* state = (MOTFdwStateSt*)itr.second;
+            if (state != nullptr) {
+                MOTAdaptor::DiscardInsertBatch(state);
+            }
+        }
+        CleanQueryStatesOnError(txn);
+    }
+}
+
 MOTFdwStateSt* InitializeFdwState(void* fdwState, List** fdwExpr, uint64_t exTableID);
 void* SerializeFdwState(MOTFdwStateSt* state);
 void ReleaseFdwState(MOTFdwStateSt* state);
@@ -377,6 +377,11 @@ double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // unordered (hash) index can serve only a full key exact match
+    if (!m_ix->IsOrdered() && !(m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT && m_end == -1)) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
@@ -411,6 +416,10 @@ bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    if (!m_ix->IsOrdered()) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
@@ -119,6 +119,7 @@ extern JitContext* CloneJitContext(JitContext* sourceJitContext)
     result->m_innerIndex = sourceJitContext->m_innerIndex;
     result->m_innerIndexId = sourceJitContext->m_innerIndexId;
     result->m_subQueryCount = sourceJitContext->m_subQueryCount;
+    result->m_indexOnlyScan = sourceJitContext->m_indexOnlyScan;
 
     // clone sub-query tuple descriptor array
     MOT_LOG_TRACE("Cloning %u sub-query data items", (unsigned)sourceJitContext->m_subQueryCount);
@@ -209,10 +209,14 @@ struct JitContext {
     /** @var The number of full query executions. */
     uint64_t m_queryCount;  // L1 offset 40
 
+    /*---------------------- Index-only Execution -------------------*/
+    /** @var Specifies whether all columns used by the query are covered by the scanned index (constant). */
+    uint64_t m_indexOnlyScan;  // L1 offset 48
+
     /*---------------------- Debug execution state -------------------*/
     /** @var The number of times this context was invoked for execution. */
 #ifdef MOT_JIT_DEBUG
-    uint64_t m_execCount;  // L1 offset 48
+    uint64_t m_execCount;  // L1 offset 56
 #endif
 };
 
@@ -149,6 +149,7 @@ static void ProcessJitResult(MOT::RC result, JitContext* jitContext, int newScan
             case JIT_COMMAND_SELECT:
             case JIT_COMMAND_RANGE_SELECT:
             case JIT_COMMAND_FULL_SELECT:
+            case JIT_COMMAND_AGGREGATE_RANGE_SELECT:
             case JIT_COMMAND_POINT_JOIN:
             case JIT_COMMAND_RANGE_JOIN:
             case JIT_COMMAND_COMPOUND_SELECT:
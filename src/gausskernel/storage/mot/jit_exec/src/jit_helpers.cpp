@@ -846,10 +846,16 @@ MOT::Row* getRowFromIterator(
 
     MOT_LOG_DEBUG("getRowFromIterator(): Retrieving row from iterator %p", itr);
     MOT::TxnManager* curr_txn = u_sess->mot_cxt.jit_txn;
+    JitExec::JitContext* jit_context = u_sess->mot_cxt.jit_context;
+    bool index_only = (jit_context != nullptr) && jit_context->m_indexOnlyScan && (jit_context->m_index == index);
     do {
-        // get row from iterator using primary sentinel
+        // get row from iterator using primary sentinel (or just the covered columns in index-only scans)
         MOT::Sentinel* sentinel = itr->GetPrimarySentinel();
-        row = curr_txn->RowLookup((MOT::AccessType)access_mode, sentinel, rc);
+        if (index_only) {
+            row = curr_txn->CoveringRowLookup((MOT::AccessType)access_mode, sentinel, rc);
+        } else {
+            row = curr_txn->RowLookup((MOT::AccessType)access_mode, sentinel, rc);
+        }
         if (row == NULL) {
             MOT_LOG_DEBUG("getRowFromIterator(): Encountered NULL row during scan, advancing iterator");
             itr->Next();
@@ -2214,10 +2214,10 @@ void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate* aggreg
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         llvm::Value* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_result_column_id, avg_value);
     } else {
         llvm::Value* count_value = AddGetAggValue(ctx);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_result_column_id, count_value);
     }
 
     // we take the opportunity to cleanup as well
@@ -880,6 +880,9 @@ static JitContext* JitRangeSelectCodegen(const Query* query, const char* query_s
     JitCommandType cmdType =
         (plan->_index_scan._scan_type == JIT_INDEX_SCAN_FULL) ? JIT_COMMAND_FULL_SELECT : JIT_COMMAND_RANGE_SELECT;
     JitContext* jit_context = FinalizeCodegen(ctx, max_arg, cmdType);
+    if (jit_context != nullptr) {
+        jit_context->m_indexOnlyScan = JitPlanIsIndexOnly(plan) ? 1 : 0;
+    }
 
     // cleanup
     DestroyCodeGenContext(ctx);
@@ -955,9 +958,22 @@ static JitContext* JitAggregateRangeSelectCodegen(
     // if row disqualified due to DISTINCT operator then go back to loop test block
     buildAggregateRow(ctx, &plan->_aggregate, row, JIT_WHILE_COND_BLOCK());
 
-    // if a limit clause exists, then increment limit counter and check if reached limit
-    if (plan->_limit_count > 0) {
+    // group columns are bound by equals operator on the index, so any aggregated row can supply them
+    if (plan->_aggregate._group_by &&
+        !selectRowColumns(ctx, row, &plan->_select_exprs, &max_arg, JIT_RANGE_SCAN_MAIN)) {
+        MOT_LOG_TRACE("Failed to generate jitted code for aggregate range SELECT query: failed to select group "
+                      "columns");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // the limit counter also tells a grouped aggregate whether any row was aggregated
+    if ((plan->_limit_count > 0) || plan->_aggregate._group_by) {
         AddIncrementStateLimitCounter(ctx);
+    }
+
+    // if a limit clause exists, then check if reached limit
+    if (plan->_limit_count > 0) {
         JIT_IF_BEGIN(limit_count_reached)
         llvm::Value* current_limit_count = AddGetStateLimitCounter(ctx);
         JIT_IF_EVAL_CMP(current_limit_count, JIT_CONST(plan->_limit_count), JIT_ICMP_EQ);
@@ -971,6 +987,20 @@ static JitContext* JitAggregateRangeSelectCodegen(
     IssueDebugLog("Reached end of aggregate range select loop");
     AddDestroyCursor(ctx, &cursor);
 
+    // a grouped aggregate over an empty range yields no group at all
+    if (plan->_aggregate._group_by) {
+        JIT_IF_BEGIN(empty_group)
+        llvm::Value* aggregated_count = AddGetStateLimitCounter(ctx);
+        JIT_IF_EVAL_CMP(aggregated_count, JIT_CONST(0), JIT_ICMP_EQ);
+        IssueDebugLog("No row aggregated, reporting empty group");
+        if (plan->_aggregate._distinct) {
+            AddDestroyDistinctSet(ctx, plan->_aggregate._element_type);
+        }
+        AddSetScanEnded(ctx, 1);
+        JIT_RETURN_CONST(MOT::RC_LOCAL_ROW_NOT_FOUND);
+        JIT_IF_END()
+    }
+
     // wrap up aggregation and write to result tuple
     buildAggregateResult(ctx, &plan->_aggregate);
 
@@ -988,6 +1018,9 @@ static JitContext* JitAggregateRangeSelectCodegen(
 
     // wrap up
     JitContext* jit_context = FinalizeCodegen(ctx, max_arg, JIT_COMMAND_AGGREGATE_RANGE_SELECT);
+    if (jit_context != nullptr) {
+        jit_context->m_indexOnlyScan = JitPlanIsIndexOnly(plan) ? 1 : 0;
+    }
 
     // cleanup
     DestroyCodeGenContext(ctx);
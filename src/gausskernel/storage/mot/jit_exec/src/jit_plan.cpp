@@ -86,7 +86,8 @@ static bool countWhereClauseEqualsLeaves(Query* query, MOT::Table* table, MOT::I
         return false;                                                            \
     }
 
-static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink)
+static bool CheckQueryAttributes(
+    const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink, bool allowGroupBy = false)
 {
     checkJittableAttribute(query, hasWindowFuncs);
     checkJittableAttribute(query, hasDistinctOn);
@@ -94,7 +95,9 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
     checkJittableAttribute(query, hasModifyingCTE);
 
     checkJittableClause(query, returningList);
-    checkJittableClause(query, groupClause);
+    if (!allowGroupBy) {
+        checkJittableClause(query, groupClause);
+    }
     checkJittableClause(query, groupingSets);
     checkJittableClause(query, havingQual);
     checkJittableClause(query, windowClause);
@@ -260,6 +263,44 @@ static bool prepareSelectExpressions(Query* query, JitSelectExprArray* expr_arra
     return result;
 }
 
+static int getGroupColumnCount(const Query* query)
+{
+    int count = 0;
+    ListCell* lc = nullptr;
+
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (!target_entry->resjunk && (target_entry->expr->type != T_Aggref)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static bool prepareGroupByExpressions(Query* query, JitSelectExprArray* expr_array)
+{
+    MOT_LOG_TRACE("Preparing group by expressions");
+    int expr_count = getGroupColumnCount(query);
+    MOT_LOG_TRACE("Counted %d selected group columns", expr_count);
+    if (expr_count == 0) {
+        // group columns are not selected, only the aggregated value is returned
+        return true;
+    }
+
+    bool result = false;
+    if (!allocSelectExprArray(expr_array, expr_count)) {
+        MOT_LOG_TRACE("Failed to allocate select expression array with %d items", expr_count);
+    } else {
+        if (!getSelectExpressions(query, expr_array)) {
+            MOT_LOG_TRACE("Failed to collect group column expressions");
+            freeSelectExprArray(expr_array);
+        } else {
+            result = true;
+        }
+    }
+    return result;
+}
+
 static bool prepareRangeSearchExpressions(
     Query* query, MOT::Table* table, MOT::Index* index, JitIndexScan* index_scan, JoinClauseType join_clause_type)
 {
@@ -770,35 +811,106 @@ static bool getTargetEntryAggregateOperator(Query* query, TargetEntry* target_en
 
 static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
 {
-    bool result = false;
-
-    // if an aggregate operator is specified, then only one column can exist
+    // if an aggregate operator is specified, then only one column can exist, unless the query has a GROUP BY
+    // clause, in which case all other target entries must be group columns
     // so we check all target entries, and if one of them specifies an aggregate operator, then
-    // it must be the only target entry in the query
+    // it must be the only aggregate target entry in the query
     ListCell* lc = nullptr;
 
     bool aggregate_found = false;
+    bool has_group_by = (query->groupClause != nullptr);
     int entry_count = list_length(query->targetList);
 
     foreach (lc, query->targetList) {
         TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
         if (target_entry->expr->type == T_Aggref) {
             // found an aggregate target entry
+            if (aggregate_found) {
+                MOT_LOG_TRACE("getAggregateOperator(): Disqualifying query - more than one aggregate target entry");
+                return false;
+            }
             aggregate_found = true;
-            if (entry_count != 1) {
+            if ((entry_count != 1) && !has_group_by) {
                 MOT_LOG_TRACE(
                     "getAggregateOperator(): Disqualifying query - aggregate must specify only 1 target entry");
+                return false;
+            }
+            if (!getTargetEntryAggregateOperator(query, target_entry, aggregate)) {
+                return false;
             }
-            result = getTargetEntryAggregateOperator(query, target_entry, aggregate);
+            aggregate->_result_column_id = target_entry->resno - 1;
+        } else if (has_group_by && (target_entry->ressortgroupref == 0)) {
+            MOT_LOG_TRACE("getAggregateOperator(): Disqualifying query - target entry %d is not a group column",
+                (int)target_entry->resno);
+            return false;
         }
     }
 
-    if (!aggregate_found) {
-        // it is fine not to have an aggregate clause
-        result = true;
+    if (has_group_by) {
+        if (!aggregate_found) {
+            MOT_LOG_TRACE("getAggregateOperator(): Disqualifying query - GROUP BY clause without aggregate");
+            return false;
+        }
+        aggregate->_group_by = true;
     }
 
-    return result;
+    // it is fine not to have an aggregate clause
+    return true;
+}
+
+static bool isGroupByIndexBound(const Query* query, const JitRangeSelectPlan* plan)
+{
+    // all group columns must be bound with equals operator on the scanned index, so at most one group is produced
+    const JitIndexScan* index_scan = &plan->_index_scan;
+    int equals_count = 0;
+    switch (index_scan->_scan_type) {
+        case JIT_INDEX_SCAN_POINT:
+        case JIT_INDEX_SCAN_CLOSED:
+            equals_count = index_scan->_column_count;
+            break;
+
+        case JIT_INDEX_SCAN_OPEN:
+        case JIT_INDEX_SCAN_SEMI_OPEN:
+            equals_count = index_scan->_column_count - 1;
+            break;
+
+        default:
+            break;
+    }
+
+    ListCell* lc = nullptr;
+    foreach (lc, query->groupClause) {
+        SortGroupClause* sgc = (SortGroupClause*)lfirst(lc);
+        TargetEntry* target_entry = getRefTargetEntry(query->targetList, (int)sgc->tleSortGroupRef);
+        if ((target_entry == nullptr) || (target_entry->expr->type != T_Var)) {
+            MOT_LOG_TRACE("isGroupByIndexBound(): Unsupported non-column group expression");
+            return false;
+        }
+
+        Var* var_expr = (Var*)target_entry->expr;
+        MOT::Table* table = getRealTable(query, var_expr->varno, var_expr->varattno);
+        if (table != index_scan->_table) {
+            MOT_LOG_TRACE("isGroupByIndexBound(): Group column does not belong to the scanned table");
+            return false;
+        }
+        int column_id = getRealColumnId(query, var_expr->varno, var_expr->varattno, table);
+
+        bool bound = false;
+        for (int i = 0; (i < equals_count) && !bound; ++i) {
+            const JitColumnExpr* search_expr = &index_scan->_search_exprs._exprs[i];
+            if (!search_expr->_join_expr && (search_expr->_table_column_id == column_id)) {
+                bound = true;
+            }
+        }
+        if (!bound) {
+            MOT_LOG_TRACE("isGroupByIndexBound(): Group column %d is not bound by equals operator on index %d",
+                column_id,
+                index_scan->_index_id);
+            return false;
+        }
+    }
+
+    return true;
 }
 
 static double evaluatePlan(const JitRangeSelectPlan* plan)
@@ -958,6 +1070,11 @@ static JitRangeScanPlan* JitPrepareRangeScanPlan(Query* query, MOT::Table* table
         table->GetTableName().c_str(),
         index_id,
         index->GetName().c_str());
+    if (!index->IsOrdered()) {
+        MOT_LOG_TRACE("Cannot prepare range scan plan: index %s is unordered", index->GetName().c_str());
+        return nullptr;
+    }
+
     JitRangeScanPlan* plan = (JitRangeScanPlan*)MOT::MemSessionAlloc(alloc_size);
     if (plan == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
@@ -1021,7 +1138,7 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
 
     // the limit count and aggregation can be inferred regardless of plan
     int limit_count = 0;
-    JitAggregate aggregate = {JIT_AGGREGATE_NONE, 0, 0, nullptr, 0, 0, 0, false};
+    JitAggregate aggregate = {JIT_AGGREGATE_NONE, 0, 0, nullptr, 0, 0, 0, false, 0, false};
     if (!getLimitCount(query, &limit_count) || !getAggregateOperator(query, &aggregate)) {
         MOT_LOG_TRACE(
             "JitPrepareRangeSelectPlan(): Disqualifying query - unsupported scan limit count or aggregate operation");
@@ -1033,6 +1150,11 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
     size_t alloc_size = sizeof(JitRangeSelectPlan);
 
     for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        if (!table->GetIndex(index_id)->IsOrdered()) {
+            MOT_LOG_TRACE("Skipping unordered index %d for range select plan", index_id);
+            continue;
+        }
+
         MOT_LOG_TRACE("Attempting to prepare plan with index %d", index_id);
         JitRangeSelectPlan* next_plan = (JitRangeSelectPlan*)JitPrepareRangeScanPlan(
             query, table, index_id, alloc_size, JIT_COMMAND_SELECT, join_clause_type);
@@ -1052,8 +1174,20 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
             break;
         }
 
-        // verify sort order is valid (if one is specified)
-        if (!isPlanSortOrderValid(query, next_plan)) {
+        if (aggregate._group_by && !prepareGroupByExpressions(query, &next_plan->_select_exprs)) {
+            MOT_LOG_TRACE(
+                "Failed to prepare range select plan with index %d: failed to prepare group by expressions", index_id);
+            JitDestroyPlan((JitPlan*)next_plan);
+            clean_plan = true;
+            break;
+        }
+
+        // verify grouped aggregate yields at most one group with this index
+        if (aggregate._group_by && !isGroupByIndexBound(query, next_plan)) {
+            MOT_LOG_TRACE("Disqualifying plan - GROUP BY columns are not bound by index %d", index_id);
+            JitDestroyPlan((JitPlan*)next_plan);
+        } else if (!isPlanSortOrderValid(query, next_plan)) {
+            // verify sort order is valid (if one is specified)
             MOT_LOG_TRACE("Disqualifying plan - Query sort order is incompatible with index");
             JitDestroyPlan((JitPlan*)next_plan);
         } else {
@@ -1151,8 +1285,7 @@ static JitPlan* JitPrepareSimplePlan(Query* query)
                     plan = JitPrepareRangeUpdatePlan(query, table);
                 }
             } else if (query->commandType == CMD_SELECT) {
-                if (!CheckQueryAttributes(
-                        query, true, true, false)) {  // range select can specify sort clause or aggregate clause
+                if (!CheckQueryAttributes(query, true, true, false, true)) {  // range select can sort or aggregate
                     MOT_LOG_TRACE(
                         "JitPrepareSimplePlan(): Disqualifying range select query - Invalid query attributes");
                 } else {
@@ -1764,6 +1897,73 @@ extern bool JitPlanHasSort(JitPlan* plan)
     return result;
 }
 
+static bool isExprCovered(const JitExpr* expr, const MOT::Index* index)
+{
+    bool result = true;
+    switch (expr->_expr_type) {
+        case JIT_EXPR_TYPE_VAR:
+            result = index->IsFieldCovered(((JitVarExpr*)expr)->_column_id);
+            break;
+
+        case JIT_EXPR_TYPE_OP: {
+            JitOpExpr* op_expr = (JitOpExpr*)expr;
+            for (int i = 0; result && (i < op_expr->_arg_count); ++i) {
+                result = isExprCovered(op_expr->_args[i], index);
+            }
+            break;
+        }
+
+        case JIT_EXPR_TYPE_FUNC: {
+            JitFuncExpr* func_expr = (JitFuncExpr*)expr;
+            for (int i = 0; result && (i < func_expr->_arg_count); ++i) {
+                result = isExprCovered(func_expr->_args[i], index);
+            }
+            break;
+        }
+
+        case JIT_EXPR_TYPE_BOOL: {
+            JitBoolExpr* bool_expr = (JitBoolExpr*)expr;
+            for (int i = 0; result && (i < bool_expr->_arg_count); ++i) {
+                result = isExprCovered(bool_expr->_args[i], index);
+            }
+            break;
+        }
+
+        default:
+            // constants, parameters and sub-queries do not refer to the scanned row
+            break;
+    }
+    return result;
+}
+
+extern bool JitPlanIsIndexOnly(JitRangeSelectPlan* plan)
+{
+    MOT::Index* index = plan->_index_scan._table->GetIndex(plan->_index_scan._index_id);
+    if ((index == nullptr) || !index->IsCovering()) {
+        return false;
+    }
+
+    for (int i = 0; i < plan->_select_exprs._count; ++i) {
+        if (!index->IsFieldCovered(plan->_select_exprs._exprs[i]._column_expr->_column_id)) {
+            return false;
+        }
+    }
+
+    const JitFilterArray* filters = &plan->_index_scan._filters;
+    for (int i = 0; i < filters->_filter_count; ++i) {
+        if (!isExprCovered(filters->_scan_filters[i]._lhs_operand, index) ||
+            !isExprCovered(filters->_scan_filters[i]._rhs_operand, index)) {
+            return false;
+        }
+    }
+
+    if ((plan->_aggregate._aggreaget_op != JIT_AGGREGATE_NONE) &&
+        !index->IsFieldCovered(plan->_aggregate._table_column_id)) {
+        return false;
+    }
+    return true;
+}
+
 static void JitDestroyInsertPlan(JitInsertPlan* plan)
 {
     freeExprArray(&plan->_insert_exprs);
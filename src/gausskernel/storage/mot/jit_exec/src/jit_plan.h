@@ -231,6 +231,12 @@ extern bool JitPlanHasDistinct(JitPlan* plan);
 /** @brief Queries whether a plan has an ORDER BY specifier. */
 extern bool JitPlanHasSort(JitPlan* plan);
 
+/**
+ * @brief Queries whether a range select plan can be served by its index alone, that is whether all columns used by
+ * the query are covered by the scanned index.
+ */
+extern bool JitPlanIsIndexOnly(JitRangeSelectPlan* plan);
+
 /**
  * @brief Explains how a plan is to be executed.
  * @param query The parsed SQL query for which the jitted plan is to be explained.
@@ -1477,6 +1477,11 @@ bool getSelectExpressions(Query* query, JitSelectExprArray* select_exprs)
             MOT_LOG_TRACE("getSelectExpressions(): Skipping resjunk target entry");
             continue;
         }
+        if (target_entry->expr->type == T_Aggref) {
+            // aggregated value is written separately, only group columns are selected along with it
+            MOT_LOG_TRACE("getSelectExpressions(): Skipping aggregate target entry");
+            continue;
+        }
         if (i < select_exprs->_count) {
             JitExpr* sub_expr = parseExpr(query, target_entry->expr, 0, 0);
             if (sub_expr == nullptr) {
@@ -430,13 +430,13 @@ struct JitIndexScan {
 
 /** @struct Specifies aggregation parameters. */
 struct JitAggregate {
-    /** @var An aggregate function (if one is specified then only one select expression should exist). */
+    /** @var An aggregate function (if one is specified then all other select expressions are group columns). */
     JitAggregateOperator _aggreaget_op;
 
     /** @var The aggregate function identifier. */
     int _func_id;
 
-    /** @var The table column id to aggregate (we always aggregate into slot tuple column id 0). */
+    /** @var The table column id to aggregate. */
     int _table_column_id;
 
     /** @var The table to which the aggregated column belongs (required if this is in JOIN). */
@@ -453,6 +453,15 @@ struct JitAggregate {
 
     /** @var Specifies whether this is a distinct aggregation. */
     bool _distinct;
+
+    /** @var The zero-based slot tuple column id into which the aggregated value is written. */
+    int _result_column_id;
+
+    /**
+     * @var Specifies whether the aggregation has a GROUP BY clause. Grouped aggregation is supported only when all
+     * group columns are bound with equals operator on the scanned index, so the scan yields at most one group.
+     */
+    bool _group_by;
 };
 
 /** @struct Specifies join of an outer column with an inner column. */
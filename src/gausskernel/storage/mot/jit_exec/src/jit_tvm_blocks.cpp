@@ -2174,11 +2174,11 @@ void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate* aggrega
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         Instruction* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_result_column_id, avg_value);
     } else {
         Expression* count_expr = AddGetAggValue(ctx);
         Instruction* count_value = buildExpression(ctx, count_expr);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_result_column_id, count_value);
     }
 
     // we take the opportunity to cleanup as well
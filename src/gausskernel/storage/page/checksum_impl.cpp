@@ -16,13 +16,22 @@
 #include "knl/knl_variable.h"
 #include "storage/checksum_impl.h"
 
+#if defined(__x86_64__) && defined(__GNUC__) && defined(HAVE__GET_CPUID)
+#define USE_AVX2_CHECKSUM_WITH_RUNTIME_CHECK
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define USE_NEON_CHECKSUM
+#include <arm_neon.h>
+#endif
+
 static inline uint32 pg_checksum_init(uint32 seed, uint32 value)
 {
     CHECKSUM_COMP(seed, value);
     return seed;
 }
 
-uint32 pg_checksum_block(char* data, uint32 size)
+static uint32 pg_checksum_block_generic(char* data, uint32 size)
 {
     uint32 sums[N_SUMS];
     uint32* dataArr = (uint32*)data;
@@ -60,6 +69,159 @@ uint32 pg_checksum_block(char* data, uint32 size)
     return result;
 }
 
+#ifdef USE_AVX2_CHECKSUM_WITH_RUNTIME_CHECK
+
+/* number of partial checksums held in one 256-bit register */
+#define N_SUMS_AVX2 (N_SUMS / 8)
+
+__attribute__((target("avx2"))) static inline __m256i pg_checksum_comp_avx2(__m256i checksum, __m256i value)
+{
+    __m256i tmp = _mm256_xor_si256(checksum, value);
+    return _mm256_xor_si256(_mm256_mullo_epi32(tmp, _mm256_set1_epi32(FNV_PRIME)), _mm256_srli_epi32(tmp, 17));
+}
+
+/*
+ * Same algorithm as pg_checksum_block_generic, with the 32 partial checksums
+ * kept in four 256-bit registers. The page is only 4-byte aligned, so all
+ * loads are unaligned.
+ */
+__attribute__((target("avx2"))) static uint32 pg_checksum_block_avx2(char* data, uint32 size)
+{
+    __m256i sums[N_SUMS_AVX2];
+    uint32 partial[N_SUMS];
+    const char* dataEnd = data + size;
+    uint32 result = 0;
+    uint32 j;
+
+    Assert((size % (sizeof(uint32) * N_SUMS)) == 0);
+
+    for (j = 0; j < N_SUMS_AVX2; j++) {
+        sums[j] = _mm256_loadu_si256((const __m256i*)&g_checksumBaseOffsets[j * 8]);
+    }
+
+    for (; data < dataEnd; data += sizeof(uint32) * N_SUMS) {
+        for (j = 0; j < N_SUMS_AVX2; j++) {
+            sums[j] = pg_checksum_comp_avx2(sums[j], _mm256_loadu_si256((const __m256i*)data + j));
+        }
+    }
+
+    /* two rounds of zeroes for additional mixing */
+    for (j = 0; j < N_SUMS_AVX2; j++) {
+        sums[j] = pg_checksum_comp_avx2(sums[j], _mm256_setzero_si256());
+        sums[j] = pg_checksum_comp_avx2(sums[j], _mm256_setzero_si256());
+        _mm256_storeu_si256((__m256i*)&partial[j * 8], sums[j]);
+    }
+
+    for (j = 0; j < N_SUMS; j++) {
+        result ^= partial[j];
+    }
+
+    return result;
+}
+
+static bool pg_checksum_avx2_available(void)
+{
+    unsigned int exx[4] = {0, 0, 0, 0};
+
+    /* the OS must save the YMM registers, see XGETBV in the Intel SDM */
+    __get_cpuid(1, &exx[0], &exx[1], &exx[2], &exx[3]);
+    if ((exx[2] & (1 << 27)) == 0 || (exx[2] & (1 << 28)) == 0) { /* OSXSAVE, AVX */
+        return false;
+    }
+    unsigned int xcr0Low;
+    unsigned int xcr0High;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 0x6) != 0x6) {
+        return false;
+    }
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return false;
+    }
+    __cpuid_count(7, 0, exx[0], exx[1], exx[2], exx[3]);
+    return (exx[1] & (1 << 5)) != 0; /* AVX2 */
+}
+
+/*
+ * This gets called on the first call. It replaces the function pointer
+ * so that subsequent calls are routed directly to the chosen implementation.
+ */
+static uint32 pg_checksum_block_choose(char* data, uint32 size);
+
+static uint32 (*pg_checksum_block_impl)(char* data, uint32 size) = pg_checksum_block_choose;
+
+static uint32 pg_checksum_block_choose(char* data, uint32 size)
+{
+    if (pg_checksum_avx2_available()) {
+        pg_checksum_block_impl = pg_checksum_block_avx2;
+    } else {
+        pg_checksum_block_impl = pg_checksum_block_generic;
+    }
+
+    return pg_checksum_block_impl(data, size);
+}
+
+uint32 pg_checksum_block(char* data, uint32 size)
+{
+    return pg_checksum_block_impl(data, size);
+}
+
+#elif defined(USE_NEON_CHECKSUM)
+
+/* number of partial checksums held in one 128-bit register */
+#define N_SUMS_NEON (N_SUMS / 4)
+
+static inline uint32x4_t pg_checksum_comp_neon(uint32x4_t checksum, uint32x4_t value)
+{
+    uint32x4_t tmp = veorq_u32(checksum, value);
+    return veorq_u32(vmulq_n_u32(tmp, FNV_PRIME), vshrq_n_u32(tmp, 17));
+}
+
+/*
+ * Same algorithm as pg_checksum_block_generic, with the 32 partial checksums
+ * kept in eight 128-bit registers. NEON is mandatory on aarch64, so there is
+ * no runtime check.
+ */
+uint32 pg_checksum_block(char* data, uint32 size)
+{
+    uint32x4_t sums[N_SUMS_NEON];
+    const uint32* dataArr = (const uint32*)data;
+    const uint32* dataEnd = (const uint32*)(data + size);
+    uint32 result = 0;
+    uint32 j;
+
+    Assert((size % (sizeof(uint32) * N_SUMS)) == 0);
+
+    for (j = 0; j < N_SUMS_NEON; j++) {
+        sums[j] = vld1q_u32(&g_checksumBaseOffsets[j * 4]);
+    }
+
+    for (; dataArr < dataEnd; dataArr += N_SUMS) {
+        for (j = 0; j < N_SUMS_NEON; j++) {
+            sums[j] = pg_checksum_comp_neon(sums[j], vld1q_u32(dataArr + j * 4));
+        }
+    }
+
+    /* two rounds of zeroes for additional mixing, then xor fold */
+    for (j = 0; j < N_SUMS_NEON; j++) {
+        sums[j] = pg_checksum_comp_neon(sums[j], vdupq_n_u32(0));
+        sums[j] = pg_checksum_comp_neon(sums[j], vdupq_n_u32(0));
+        result ^= vgetq_lane_u32(sums[j], 0) ^ vgetq_lane_u32(sums[j], 1) ^ vgetq_lane_u32(sums[j], 2) ^
+                  vgetq_lane_u32(sums[j], 3);
+    }
+
+    return result;
+}
+
+#else
+
+uint32 pg_checksum_block(char* data, uint32 size)
+{
+    return pg_checksum_block_generic(data, size);
+}
+
+#endif
+
 /*
  * Compute the checksum for a Postgres page.  The page must be aligned on a
  * 4-byte boundary.
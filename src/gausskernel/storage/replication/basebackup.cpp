@@ -32,6 +32,7 @@
 #include "access/xlog.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
+#include "storage/page_compression.h"
 #include "storage/pmsignal.h"
 #include "storage/checksum.h"
 #ifdef ENABLE_MOT
@@ -1012,6 +1013,10 @@ bool IsSkipPath(const char * pathName)
         return true;
     if (strcmp(pathName, "./global/pg_dw.build") == 0)
         return true;
+    /* the other batch flush dw files, global/pg_dw_<n> */
+    if (strncmp(pathName, "./global/pg_dw_", strlen("./global/pg_dw_")) == 0 &&
+        pathName[strlen("./global/pg_dw_")] >= '0' && pathName[strlen("./global/pg_dw_")] <= '9')
+        return true;
     if (strcmp(pathName, "./global/config_exec_params") == 0)
         return true;
 
@@ -1635,6 +1640,10 @@ static bool sendFile(char *readfilename, char *tarfilename, struct stat *statbuf
     }
 
     isNeedCheck = is_row_data_file(readfilename, &segNo);
+    /* segments of compressed relations hold chunks rather than pages, and address files neither */
+    if (isNeedCheck && IsPageCompressedFile(readfilename)) {
+        isNeedCheck = false;
+    }
     ereport(DEBUG1, (errmsg("sendFile, filename is %s, isNeedCheck is %d", readfilename, isNeedCheck)));
 
     /* make sure data file size is integer multiple of BLCKSZ and change statbuf if needed */
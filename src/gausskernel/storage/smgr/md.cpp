@@ -29,11 +29,14 @@
 #include "portability/instr_time.h"
 #include "postmaster/bgwriter.h"
 #include "postmaster/pagewriter.h"
+#include "storage/barrier.h"
 #include "storage/fd.h"
 #include "storage/buf/bufmgr.h"
 #include "storage/relfilenode.h"
 #include "storage/copydir.h"
+#include "storage/page_compression.h"
 #include "storage/smgr.h"
+#include "storage/uring.h"
 #include "utils/aiomem.h"
 #include "utils/hsearch.h"
 #include "utils/memutils.h"
@@ -44,6 +47,9 @@
 #define FSYNCS_PER_ABSORB 10
 #define UNLINKS_PER_ABSORB 10
 
+/* number of segments mdsync_batch() fsyncs with one io_uring batch */
+#define FSYNCS_PER_BATCH 64
+
 /*
  * Special values for the segno arg to RememberFsyncRequest.
  *
@@ -108,11 +114,17 @@
  *  segment, we assume that any subsequent segments are inactive.
  *
  *  All MdfdVec objects are palloc'd in the MdCxt memory context.
+ *
+ *  Segments of a main fork created with page compression also have the
+ *  address file of the segment mapped at mdfd_pcmap (see page_compression.h).
+ *  The segment file then holds chunks instead of blocks, and the number of
+ *  blocks in the segment is read from the address file, not from the file size.
  */
 typedef struct _MdfdVec {
-    File mdfd_vfd;               /* fd number in fd.c's pool */
-    BlockNumber mdfd_segno;      /* segment number, from 0 */
-    struct _MdfdVec *mdfd_chain; /* next segment, or NULL */
+    File mdfd_vfd;                   /* fd number in fd.c's pool */
+    BlockNumber mdfd_segno;          /* segment number, from 0 */
+    struct _MdfdVec *mdfd_chain;     /* next segment, or NULL */
+    PageCompressHeader *mdfd_pcmap;  /* mapped address file, or NULL */
 } MdfdVec;
 
 /*
@@ -171,6 +183,9 @@ static MdfdVec *_mdfd_getseg(SMgrRelation reln, ForkNumber forkno, BlockNumber b
 static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
 static MdfdVec *_mdcreate(ForkNumber forkNum, bool isRedo, const RelFileNodeBackend &rnode);
 static void _mdcreatebucket(SMgrRelation reln, ForkNumber forkNum, bool isRedo);
+static int _mdread_compressed(const MdfdVec *seg, BlockNumber blocknum, char *buffer);
+static int _mdwrite_compressed(const MdfdVec *seg, BlockNumber blocknum, const char *buffer, uint32 wait_event_info);
+static void _mdextend_compressed_nblocks(const MdfdVec *seg, BlockNumber nblocks);
 
 /*
  *	mdinit() -- Initialize private state for magnetic disk storage manager.
@@ -280,6 +295,46 @@ void mdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
     Assert(reln->md_fd[forkNum] == NULL);
     reln->md_fd[forkNum] = _mdcreate(forkNum, isRedo, reln->smgr_rnode);
 }
+
+/*
+ *  mdcreatecompressed() -- Set up page compression for a main fork just
+ *      created by mdcreate().
+ *
+ * If isRedo is true, it's okay for the address file to exist already.
+ */
+void mdcreatecompressed(SMgrRelation reln, uint8 algorithm, bool isRedo)
+{
+    MdfdVec *v = mdopen(reln, MAIN_FORKNUM, EXTENSION_FAIL);
+    char *path = NULL;
+
+    Assert(algorithm != PAGE_COMPRESS_NONE);
+    ADIO_RUN()
+    {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("page compression is not supported when enable_adio_function is on")));
+    }
+    ADIO_END();
+
+    if (v->mdfd_pcmap != NULL) {
+        if (!isRedo) {
+            ereport(ERROR, (errcode(ERRCODE_DUPLICATE_FILE), errmsg("relation \"%s\" is already compressed",
+                                                                    relpath(reln->smgr_rnode, MAIN_FORKNUM))));
+        }
+        reln->smgr_compress = algorithm;
+        return;
+    }
+
+    path = relpath(reln->smgr_rnode, MAIN_FORKNUM);
+    v->mdfd_pcmap = PageCompressMapAddrFile(path, true, algorithm);
+    reln->smgr_compress = algorithm;
+
+    /* nothing else syncs the header of a relation that is never written to */
+    if (PageCompressSyncAddrFile(v->mdfd_pcmap) < 0) {
+        ereport(data_sync_elevel(ERROR), (errcode_for_file_access(), errmsg("could not fsync file \"%s%s\": %m",
+                                                                            path, PCA_SUFFIX)));
+    }
+    pfree(path);
+}
 /*
  *	mdcreate() -- Create a new relation on magnetic disk.
  *
@@ -440,6 +495,19 @@ static void mdunlinkfork(const RelFileNodeBackend &rnode, ForkNumber forkNum, bo
         register_unlink(rnode);
     }
 
+    /*
+     * The address files of a compressed relation are removed right away. The
+     * truncated first segment is all that's needed to keep the relfilenode
+     * from being reused before the next checkpoint.
+     */
+    if (forkNum == MAIN_FORKNUM) {
+        char *pcapath = PageCompressAddrFilePath(path);
+        if (unlink(pcapath) < 0 && errno != ENOENT) {
+            ereport(WARNING, (errcode_for_file_access(), errmsg("could not remove file \"%s\": %m", pcapath)));
+        }
+        pfree(pcapath);
+    }
+
     /*
      * Delete any additional segments.
      */
@@ -462,6 +530,13 @@ static void mdunlinkfork(const RelFileNodeBackend &rnode, ForkNumber forkNum, bo
                 }
                 break;
             }
+            if (forkNum == MAIN_FORKNUM) {
+                char *pcapath = PageCompressAddrFilePath(segpath);
+                if (unlink(pcapath) < 0 && errno != ENOENT) {
+                    ereport(WARNING, (errcode_for_file_access(), errmsg("could not remove file \"%s\": %m", pcapath)));
+                }
+                pfree(pcapath);
+            }
         }
         pfree(segpath);
     }
@@ -504,18 +579,23 @@ void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
 
     v = _mdfd_getseg(reln, forknum, blocknum, skipFsync, EXTENSION_CREATE);
 
-    seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+    if (v->mdfd_pcmap != NULL) {
+        nbytes = _mdwrite_compressed(v, blocknum, buffer, WAIT_EVENT_DATA_FILE_EXTEND);
+    } else {
+        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
-    /*
-     * Note: because caller usually obtained blocknum by calling mdnblocks,
-     * which did a seek(SEEK_END), this seek is often redundant and will be
-     * optimized away by fd.c.	It's not redundant, however, if there is a
-     * partial page at the end of the file. In that case we want to try to
-     * overwrite the partial page with a full page.  It's also not redundant
-     * if bufmgr.c had to dump another buffer of the same file to make room
-     * for the new page's buffer.
-     */
-    if ((nbytes = FilePWrite(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_EXTEND)) != BLCKSZ) {
+        /*
+         * Note: because caller usually obtained blocknum by calling mdnblocks,
+         * which did a seek(SEEK_END), this seek is often redundant and will be
+         * optimized away by fd.c.	It's not redundant, however, if there is a
+         * partial page at the end of the file. In that case we want to try to
+         * overwrite the partial page with a full page.  It's also not redundant
+         * if bufmgr.c had to dump another buffer of the same file to make room
+         * for the new page's buffer.
+         */
+        nbytes = FilePWrite(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_EXTEND);
+    }
+    if (nbytes != BLCKSZ) {
         if (nbytes < 0) {
             ereport(ERROR,
                     (errcode_for_file_access(), errmsg("could not extend file \"%s\": %m", FilePathName(v->mdfd_vfd)),
@@ -534,6 +614,98 @@ void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
     Assert(_mdnblocks(reln, forknum, v) <= ((BlockNumber)RELSEG_SIZE));
 }
 
+/*
+ *  mdzeroextend() -- Add nblocks zero-filled blocks to the specified relation.
+ *
+ *      Like mdextend(), but adds several blocks starting at blocknum in one go,
+ *      without going through a page buffer.  Within each segment the space is
+ *      allocated by a single fallocate() call; on filesystems that can't do that
+ *      we fall back to writing zero pages one at a time.
+ */
+void mdzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, int nblocks, bool skipFsync)
+{
+    MdfdVec *v = NULL;
+    BlockNumber curblocknum = blocknum;
+    int remblocks = nblocks;
+
+    Assert(nblocks > 0);
+    Assert(reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID);
+
+    /* see mdextend(): we mustn't create a block whose number is InvalidBlockNumber */
+    if ((uint64)blocknum + (uint64)nblocks >= (uint64)InvalidBlockNumber) {
+        ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                        errmsg("cannot extend file \"%s\" beyond %u blocks", relpath(reln->smgr_rnode, forknum),
+                               InvalidBlockNumber)));
+    }
+
+    while (remblocks > 0) {
+        BlockNumber segstartblock = curblocknum % ((BlockNumber)RELSEG_SIZE);
+        off_t seekpos = (off_t)BLCKSZ * segstartblock;
+        int numblocks;
+
+        /* never cross a segment boundary in one call */
+        if (segstartblock + (BlockNumber)remblocks > (BlockNumber)RELSEG_SIZE) {
+            numblocks = (int)((BlockNumber)RELSEG_SIZE - segstartblock);
+        } else {
+            numblocks = remblocks;
+        }
+
+        v = _mdfd_getseg(reln, forknum, curblocknum, skipFsync, EXTENSION_CREATE);
+
+        if (v->mdfd_pcmap != NULL) {
+            /* zero pages of a compressed segment take no chunks */
+            _mdextend_compressed_nblocks(v, segstartblock + (BlockNumber)numblocks);
+            if (!skipFsync && !SmgrIsTemp(reln)) {
+                register_dirty_segment(reln, forknum, v);
+            }
+        } else if (FileFallocate(v->mdfd_vfd, seekpos, (off_t)BLCKSZ * numblocks, WAIT_EVENT_DATA_FILE_EXTEND) != 0) {
+            char *zerobuf = NULL;
+            errno_t errorno = EOK;
+
+            if (errno != EOPNOTSUPP && errno != ENOSYS) {
+                ereport(ERROR, (errcode_for_file_access(),
+                                errmsg("could not extend file \"%s\" by %d blocks: %m", FilePathName(v->mdfd_vfd),
+                                       numblocks),
+                                errhint("Check free disk space.")));
+            }
+
+            ADIO_RUN()
+            {
+                zerobuf = (char *)adio_align_alloc(BLCKSZ);
+                errorno = memset_s(zerobuf, BLCKSZ, 0, BLCKSZ);
+                securec_check_c(errorno, "", "");
+            }
+            ADIO_ELSE()
+            {
+                zerobuf = (char *)palloc0(BLCKSZ);
+            }
+            ADIO_END();
+
+            /* mdextend() registers the dirty segment itself */
+            for (int i = 0; i < numblocks; i++) {
+                mdextend(reln, forknum, curblocknum + (BlockNumber)i, zerobuf, skipFsync);
+            }
+
+            ADIO_RUN()
+            {
+                adio_align_free(zerobuf);
+            }
+            ADIO_ELSE()
+            {
+                pfree(zerobuf);
+            }
+            ADIO_END();
+        } else if (!skipFsync && !SmgrIsTemp(reln)) {
+            register_dirty_segment(reln, forknum, v);
+        }
+
+        Assert(_mdnblocks(reln, forknum, v) <= ((BlockNumber)RELSEG_SIZE));
+
+        remblocks -= numblocks;
+        curblocknum += (BlockNumber)numblocks;
+    }
+}
+
 /*
  *  mdopen() -- Open the specified relation.
  *
@@ -548,6 +720,7 @@ void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
 static MdfdVec *mdopen(SMgrRelation reln, ForkNumber forknum, ExtensionBehavior behavior)
 {
     MdfdVec *mdfd = NULL;
+    PageCompressHeader *pcmap = NULL;
     char *path = NULL;
     File fd;
     RelFileNodeForkNum filenode;
@@ -592,6 +765,27 @@ static MdfdVec *mdopen(SMgrRelation reln, ForkNumber forknum, ExtensionBehavior
         }
     }
 
+    /* only a compressed relation has an address file, look for one if the relcache has not said */
+    if (forknum == MAIN_FORKNUM && !SmgrIsTemp(reln) && reln->smgr_compress != PAGE_COMPRESS_NONE) {
+        PG_TRY();
+        {
+            pcmap = PageCompressMapAddrFile(path, false, PAGE_COMPRESS_NONE);
+        }
+        PG_CATCH();
+        {
+            FileClose(fd);
+            PG_RE_THROW();
+        }
+        PG_END_TRY();
+
+        if (pcmap != NULL && g_instance.attr.attr_storage.enable_adio_function) {
+            PageCompressUnmapAddrFile(pcmap);
+            FileClose(fd);
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                            errmsg("cannot open compressed relation \"%s\" when enable_adio_function is on", path)));
+        }
+    }
+
     pfree(path);
 
     reln->md_fd[forknum] = mdfd = _fdvec_alloc();
@@ -599,6 +793,7 @@ static MdfdVec *mdopen(SMgrRelation reln, ForkNumber forknum, ExtensionBehavior
     mdfd->mdfd_vfd = fd;
     mdfd->mdfd_segno = 0;
     mdfd->mdfd_chain = NULL;
+    mdfd->mdfd_pcmap = pcmap;
     Assert(_mdnblocks(reln, forknum, mdfd) <= ((BlockNumber)RELSEG_SIZE));
 
     return mdfd;
@@ -630,6 +825,9 @@ void mdclose(SMgrRelation reln, ForkNumber forknum)
         if (v->mdfd_vfd >= 0) {
             FileClose(v->mdfd_vfd);
         }
+        if (v->mdfd_pcmap != NULL) {
+            PageCompressUnmapAddrFile(v->mdfd_pcmap);
+        }
 
         /* Now free vector */
         v = v->mdfd_chain;
@@ -640,16 +838,48 @@ void mdclose(SMgrRelation reln, ForkNumber forknum)
 /*
  *	mdprefetch() -- Initiate asynchronous read of the specified block of a relation
  *      Currently, don't prefetch a bucket dir.
+ *
+ * A prefetch is only a hint, so a missing file or segment is silently skipped.
+ * _mdfd_getseg() is not used because during recovery it pads out missing
+ * segments, and the redo dispatcher prefetches ahead of the workers that own
+ * those files.
  */
 void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
 {
 #ifdef USE_PREFETCH
     off_t seekpos;
     MdfdVec *v = NULL;
+    BlockNumber targetseg = blocknum / ((BlockNumber)RELSEG_SIZE);
 
     Assert(reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID);
 
-    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    v = mdopen(reln, forknum, EXTENSION_RETURN_NULL);
+    while (v != NULL && v->mdfd_segno < targetseg) {
+        if (v->mdfd_chain == NULL) {
+            v->mdfd_chain = _mdfd_openseg(reln, forknum, v->mdfd_segno + 1, 0);
+        }
+        v = v->mdfd_chain;
+    }
+    if (v == NULL) {
+        return;
+    }
+
+    if (v->mdfd_pcmap != NULL) {
+        PageCompressAddr *addr = GetPageCompressAddr(v->mdfd_pcmap, blocknum);
+        int nchunks = Min(addr->nchunks, PC_MAX_CHUNKS);
+
+        /* prefetch each run of contiguous chunks of the block */
+        for (int i = 0; i < nchunks;) {
+            int run = 1;
+            while (i + run < nchunks && addr->chunknos[i + run] == addr->chunknos[i] + (uint32)run) {
+                run++;
+            }
+            (void)FilePrefetch(v->mdfd_vfd, PageCompressChunkOffset(addr->chunknos[i]), run * PC_CHUNK_SIZE,
+                               WAIT_EVENT_DATA_FILE_PREFETCH);
+            i += run;
+        }
+        return;
+    }
 
     seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
@@ -700,9 +930,12 @@ void mdwriteback(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, Bl
         Assert(nflush >= 1);
         Assert(nflush <= nblocks);
 
-        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+        /* the chunks of a compressed segment are not in block order; leave them to the checkpoint */
+        if (v->mdfd_pcmap == NULL) {
+            seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
-        FileWriteback(v->mdfd_vfd, seekpos, (off_t)BLCKSZ * nflush);
+            FileWriteback(v->mdfd_vfd, seekpos, (off_t)BLCKSZ * nflush);
+        }
 
         nblocks -= nflush;
         blocknum += nflush;
@@ -1018,9 +1251,13 @@ bool mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char *b
 
     v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
 
-    seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+    if (v->mdfd_pcmap != NULL) {
+        nbytes = _mdread_compressed(v, blocknum, buffer);
+    } else {
+        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
-    nbytes = FilePRead(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_READ);
+        nbytes = FilePRead(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_READ);
+    }
 
     TRACE_POSTGRESQL_SMGR_MD_READ_DONE(forknum, blocknum, reln->smgr_rnode.node.spcNode, reln->smgr_rnode.node.dbNode,
                                        reln->smgr_rnode.node.relNode, reln->smgr_rnode.backend, nbytes, BLCKSZ);
@@ -1154,11 +1391,15 @@ void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
 
     v = _mdfd_getseg(reln, forknum, blocknum, skipFsync, EXTENSION_FAIL);
 
-    seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+    if (v->mdfd_pcmap != NULL) {
+        nbytes = _mdwrite_compressed(v, blocknum, buffer, WAIT_EVENT_DATA_FILE_WRITE);
+    } else {
+        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
-    Assert(seekpos < (off_t)BLCKSZ * RELSEG_SIZE);
+        Assert(seekpos < (off_t)BLCKSZ * RELSEG_SIZE);
 
-    nbytes = FilePWrite(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_WRITE);
+        nbytes = FilePWrite(v->mdfd_vfd, buffer, BLCKSZ, seekpos, WAIT_EVENT_DATA_FILE_WRITE);
+    }
 
     TRACE_POSTGRESQL_SMGR_MD_WRITE_DONE(forknum, blocknum, reln->smgr_rnode.node.spcNode, reln->smgr_rnode.node.dbNode,
                                         reln->smgr_rnode.node.relNode, reln->smgr_rnode.backend, nbytes, BLCKSZ);
@@ -1338,6 +1579,15 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
                 ereport(ERROR, (errcode_for_file_access(),
                                 errmsg("could not truncate file \"%s\": %m", FilePathName(v->mdfd_vfd))));
             }
+            if (v->mdfd_pcmap != NULL) {
+                /* all chunks are gone with the data, so start the address file over */
+                errno_t rc = memset_s((char *)v->mdfd_pcmap + SizeOfPageCompressHeader,
+                                      SizeOfPageCompressAddrFile - SizeOfPageCompressHeader, 0,
+                                      SizeOfPageCompressAddrFile - SizeOfPageCompressHeader);
+                securec_check(rc, "", "");
+                pg_atomic_write_u32(&v->mdfd_pcmap->nblocks, 0);
+                pg_atomic_write_u32(&v->mdfd_pcmap->allocated_chunks, 0);
+            }
 
             if (!SmgrIsTemp(reln)) {
                 register_dirty_segment(reln, forknum, v);
@@ -1346,6 +1596,9 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
             v = v->mdfd_chain;
             Assert(ov != reln->md_fd[forknum]); /* we never drop the 1st segment */
             FileClose(ov->mdfd_vfd);
+            if (ov->mdfd_pcmap != NULL) {
+                PageCompressUnmapAddrFile(ov->mdfd_pcmap);
+            }
             pfree(ov);
         } else if (prior_blocks + ((BlockNumber)RELSEG_SIZE) > nblocks) {
             /*
@@ -1358,7 +1611,19 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
              */
             BlockNumber last_seg_blocks = nblocks - prior_blocks;
 
-            if (FileTruncate(v->mdfd_vfd, (off_t)last_seg_blocks * BLCKSZ, WAIT_EVENT_DATA_FILE_TRUNCATE) < 0) {
+            if (v->mdfd_pcmap != NULL) {
+                /*
+                 * Chunks are not in block order, so the file can't be cut. The
+                 * blocks truncated away keep their chunks for reuse when the
+                 * relation grows again.
+                 */
+                BlockNumber seg_blocks = pg_atomic_read_u32(&v->mdfd_pcmap->nblocks);
+
+                pg_atomic_write_u32(&v->mdfd_pcmap->nblocks, last_seg_blocks);
+                for (BlockNumber blkno = last_seg_blocks; blkno < seg_blocks; blkno++) {
+                    GetPageCompressAddr(v->mdfd_pcmap, blkno)->nchunks = 0;
+                }
+            } else if (FileTruncate(v->mdfd_vfd, (off_t)last_seg_blocks * BLCKSZ, WAIT_EVENT_DATA_FILE_TRUNCATE) < 0) {
                 ereport(ERROR, (errcode_for_file_access(), errmsg("could not truncate file \"%s\" to %u blocks: %m",
                                                                   FilePathName(v->mdfd_vfd), nblocks)));
             }
@@ -1401,7 +1666,8 @@ void mdimmedsync(SMgrRelation reln, ForkNumber forknum)
     v = mdopen(reln, forknum, EXTENSION_FAIL);
 
     while (v != NULL) {
-        if (FileSync(v->mdfd_vfd, WAIT_EVENT_DATA_FILE_IMMEDIATE_SYNC) < 0) {
+        if (FileSync(v->mdfd_vfd, WAIT_EVENT_DATA_FILE_IMMEDIATE_SYNC) < 0 ||
+            (v->mdfd_pcmap != NULL && PageCompressSyncAddrFile(v->mdfd_pcmap) < 0)) {
             ereport(data_sync_elevel(ERROR),
                     (errcode_for_file_access(), errmsg("could not fsync file \"%s\": %m", FilePathName(v->mdfd_vfd))));
         }
@@ -1409,6 +1675,83 @@ void mdimmedsync(SMgrRelation reln, ForkNumber forknum)
     }
 }
 
+/*
+ * mdsync_batch() -- fsync the requested segments of a relation fork in batches
+ *
+ * Used by mdsync() with io_uring, so the fsyncs of a batch run concurrently. Returns
+ * the set of segments that were synced. Segments that could not be opened, or whose
+ * fsync failed because they may have been deleted meanwhile, are left to the retry
+ * loop of mdsync(). Any other fsync failure is reported right away: retrying an
+ * fsync that failed could falsely report success.
+ */
+static Bitmapset *mdsync_batch(const RelFileNode &rnode, ForkNumber forknum, const Bitmapset *requests,
+                               int *processed, uint64 *longest, uint64 *total_elapsed)
+{
+    FileIORequest reqs[FSYNCS_PER_BATCH];
+    int segnos[FSYNCS_PER_BATCH];
+    PageCompressHeader *pcmaps[FSYNCS_PER_BATCH];
+    Bitmapset *synced = NULL;
+    int segno = -1;
+
+    do {
+        int nreqs = 0;
+        instr_time sync_start, sync_end;
+
+        /* as in mdsync(), keep the fsync request queue from overflowing */
+        AbsorbFsyncRequests();
+
+        while (nreqs < FSYNCS_PER_BATCH && (segno = bms_next_member(requests, segno)) >= 0) {
+            SMgrRelation reln = smgropen(rnode, InvalidBackendId, GetColumnNum(forknum));
+            MdfdVec *seg = _mdfd_getseg(reln, forknum, (BlockNumber)segno * (BlockNumber)RELSEG_SIZE, false,
+                                        EXTENSION_RETURN_NULL);
+            if (seg == NULL) {
+                continue;
+            }
+            errno_t rc = memset_s(&reqs[nreqs], sizeof(FileIORequest), 0, sizeof(FileIORequest));
+            securec_check(rc, "\0", "\0");
+            reqs[nreqs].type = FILE_IO_FSYNC;
+            reqs[nreqs].file = seg->mdfd_vfd;
+            pcmaps[nreqs] = seg->mdfd_pcmap;
+            segnos[nreqs] = segno;
+            nreqs++;
+        }
+        if (nreqs == 0) {
+            break;
+        }
+
+        INSTR_TIME_SET_CURRENT(sync_start);
+        FileBatchIO(reqs, nreqs, WAIT_EVENT_DATA_FILE_SYNC);
+        INSTR_TIME_SET_CURRENT(sync_end);
+        INSTR_TIME_SUBTRACT(sync_end, sync_start);
+        uint64 elapsed = INSTR_TIME_GET_MICROSEC(sync_end);
+
+        /* the fsyncs of a batch overlap, so each one is accounted with the time of the batch */
+        for (int i = 0; i < nreqs; i++) {
+            if (reqs[i].result >= 0 && pcmaps[i] != NULL && PageCompressSyncAddrFile(pcmaps[i]) < 0) {
+                reqs[i].result = -1;
+                reqs[i].error = errno;
+            }
+            if (reqs[i].result >= 0) {
+                synced = bms_add_member(synced, segnos[i]);
+                *longest = Max(*longest, elapsed);
+                (*processed)++;
+                if (u_sess->attr.attr_common.log_checkpoints) {
+                    ereport(DEBUG1, (errmsg("checkpoint sync: number=%d file=%s time=%.3f msec (batch of %d)",
+                                            *processed, FilePathName(reqs[i].file), (double)elapsed / 1000, nreqs)));
+                }
+            } else if (!FILE_POSSIBLY_DELETED(reqs[i].error)) {
+                errno = reqs[i].error;
+                ereport(data_sync_elevel(ERROR), (errcode_for_file_access(),
+                                                  errmsg("could not fsync file \"%s\": %m",
+                                                         FilePathName(reqs[i].file))));
+            }
+        }
+        *total_elapsed += elapsed;
+    } while (segno >= 0);
+
+    return synced;
+}
+
 /*
  *  mdsync() -- Sync previous writes to stable storage.
  */
@@ -1513,11 +1856,19 @@ void mdsync(void)
          */
         for (forknum = 0; forknum < (int)(entry->max_requests); forknum++) {
             Bitmapset *requests = entry->requests[forknum];
+            Bitmapset *synced = NULL;
             int segno;
 
             entry->requests[forknum] = NULL;
             entry->canceled[forknum] = false;
 
+            /* With io_uring, fsync in batches first; the loop below is left with the failures */
+            if (u_sess->attr.attr_storage.enableFsync && UringEnabled()) {
+                synced = mdsync_batch(entry->rnode, (ForkNumber)forknum, requests, &processed, &longest,
+                                      &total_elapsed);
+                absorb_counter = FSYNCS_PER_ABSORB;
+            }
+
             while ((segno = bms_first_member(requests)) >= 0) {
                 int failures;
 
@@ -1526,7 +1877,7 @@ void mdsync(void)
                  * file at all.  (We delay checking until this point so that
                  * changing fsync on the fly behaves sensibly.)
                  */
-                if (!u_sess->attr.attr_storage.enableFsync) {
+                if (!u_sess->attr.attr_storage.enableFsync || bms_is_member(segno, synced)) {
                     continue;
                 }
 
@@ -1582,7 +1933,8 @@ void mdsync(void)
 
                     INSTR_TIME_SET_CURRENT(sync_start);
 
-                    if (seg != NULL && FileSync(seg->mdfd_vfd, WAIT_EVENT_DATA_FILE_SYNC) >= 0) {
+                    if (seg != NULL && FileSync(seg->mdfd_vfd, WAIT_EVENT_DATA_FILE_SYNC) >= 0 &&
+                        (seg->mdfd_pcmap == NULL || PageCompressSyncAddrFile(seg->mdfd_pcmap) == 0)) {
                         /* Success; update statistics about sync timing */
                         INSTR_TIME_SET_CURRENT(sync_end);
                         sync_diff = sync_end;
@@ -1639,6 +1991,7 @@ void mdsync(void)
                 } /* end retry loop */
             }
             bms_free(requests);
+            bms_free(synced);
         }
 
         /*
@@ -2136,6 +2489,7 @@ static char *_mdfd_segpath(const SMgrRelation reln, ForkNumber forknum, BlockNum
 static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber segno, int oflags)
 {
     MdfdVec *v = NULL;
+    PageCompressHeader *pcmap = NULL;
     int fd;
     char *fullpath = NULL;
     RelFileNodeForkNum filenode;
@@ -2153,12 +2507,30 @@ static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber
     /* open the file */
     fd = DataFileIdOpenFile(fullpath, filenode, O_RDWR | PG_BINARY | oflags, 0600);
 
-    pfree(fullpath);
-
     if (fd < 0) {
+        pfree(fullpath);
         return NULL;
     }
 
+    /*
+     * Every segment of a compressed relation has its own address file. It is
+     * created along with the segment, or after a crash in between the two.
+     */
+    if (segno > 0 && reln->md_fd[forknum] != NULL && reln->md_fd[forknum]->mdfd_pcmap != NULL) {
+        PG_TRY();
+        {
+            pcmap = PageCompressMapAddrFile(fullpath, true, reln->md_fd[forknum]->mdfd_pcmap->algorithm);
+        }
+        PG_CATCH();
+        {
+            FileClose(fd);
+            PG_RE_THROW();
+        }
+        PG_END_TRY();
+    }
+
+    pfree(fullpath);
+
     /* allocate an mdfdvec entry for it */
     v = _fdvec_alloc();
 
@@ -2166,6 +2538,7 @@ static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forknum, BlockNumber
     v->mdfd_vfd = fd;
     v->mdfd_segno = segno;
     v->mdfd_chain = NULL;
+    v->mdfd_pcmap = pcmap;
     Assert(_mdnblocks(reln, forknum, v) <= ((BlockNumber)RELSEG_SIZE));
 
     /* all done */
@@ -2274,6 +2647,10 @@ static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdV
 {
     off_t len;
 
+    if (seg->mdfd_pcmap != NULL) {
+        return (BlockNumber)pg_atomic_read_u32(&seg->mdfd_pcmap->nblocks);
+    }
+
     len = FileSeek(seg->mdfd_vfd, 0L, SEEK_END);
     if (len < 0) {
         ereport(ERROR, (errcode_for_file_access(),
@@ -2342,5 +2719,115 @@ static MdfdVec *_mdcreate(ForkNumber forkNum, bool isRedo, const RelFileNodeBack
     ret->mdfd_vfd = fd;
     ret->mdfd_segno = 0;
     ret->mdfd_chain = NULL;
+    ret->mdfd_pcmap = NULL;
     return ret;
 }
+
+/*
+ * Raise the number of blocks in a compressed segment to at least nblocks.
+ */
+static void _mdextend_compressed_nblocks(const MdfdVec *seg, BlockNumber nblocks)
+{
+    uint32 cur = pg_atomic_read_u32(&seg->mdfd_pcmap->nblocks);
+
+    Assert(nblocks <= (BlockNumber)RELSEG_SIZE);
+    while (cur < nblocks) {
+        if (pg_atomic_compare_exchange_u32(&seg->mdfd_pcmap->nblocks, &cur, nblocks)) {
+            break;
+        }
+    }
+}
+
+/*
+ * Read a block of a compressed segment into buffer. Returns BLCKSZ on success,
+ * -1 with errno set on a read error, and less than BLCKSZ if the block is past
+ * the end of the segment or its image is damaged, like a short read would.
+ */
+static int _mdread_compressed(const MdfdVec *seg, BlockNumber blocknum, char *buffer)
+{
+    PageCompressAddr addr = *GetPageCompressAddr(seg->mdfd_pcmap, blocknum);
+    char compbuf[BLCKSZ];
+    int nbytes;
+    errno_t rc;
+
+    if (blocknum % ((BlockNumber)RELSEG_SIZE) >= pg_atomic_read_u32(&seg->mdfd_pcmap->nblocks)) {
+        return 0;
+    }
+
+    /* a block inside the segment that was never written reads as zeroes, as a hole in a plain file would */
+    if (addr.nchunks == 0) {
+        rc = memset_s(buffer, BLCKSZ, 0, BLCKSZ);
+        securec_check(rc, "", "");
+        return BLCKSZ;
+    }
+    if (addr.nchunks > addr.allocated_chunks || addr.allocated_chunks > PC_MAX_CHUNKS) {
+        return 0;
+    }
+
+    /* read each run of contiguous chunks in one go */
+    for (int i = 0; i < addr.nchunks;) {
+        int run = 1;
+        while (i + run < addr.nchunks && addr.chunknos[i + run] == addr.chunknos[i] + (uint32)run) {
+            run++;
+        }
+        nbytes = FilePRead(seg->mdfd_vfd, compbuf + i * PC_CHUNK_SIZE, run * PC_CHUNK_SIZE,
+                           PageCompressChunkOffset(addr.chunknos[i]), WAIT_EVENT_DATA_FILE_READ);
+        if (nbytes != run * PC_CHUNK_SIZE) {
+            return (nbytes < 0) ? nbytes : i * PC_CHUNK_SIZE + nbytes;
+        }
+        i += run;
+    }
+
+    if (!PageDecompressPage(compbuf, addr.nchunks, buffer)) {
+        return 0;
+    }
+    return BLCKSZ;
+}
+
+/*
+ * Write a block of a compressed segment, giving it more chunks if its new image
+ * needs them. Returns BLCKSZ on success, otherwise what FilePWrite() returned
+ * for the failed write.
+ */
+static int _mdwrite_compressed(const MdfdVec *seg, BlockNumber blocknum, const char *buffer, uint32 wait_event_info)
+{
+    PageCompressHeader *map = seg->mdfd_pcmap;
+    PageCompressAddr *addr = GetPageCompressAddr(map, blocknum);
+    char compbuf[BLCKSZ];
+    int nchunks;
+    int nbytes;
+
+    nchunks = PageCompressPage(buffer, compbuf, (uint8)map->algorithm);
+
+    if (nchunks > addr->allocated_chunks) {
+        uint32 need = (uint32)(nchunks - addr->allocated_chunks);
+        uint32 first = pg_atomic_fetch_add_u32(&map->allocated_chunks, need) + 1;
+
+        /* blocks never give chunks back, so a segment can't need more than this */
+        Assert(first + need - 1 <= (uint32)RELSEG_SIZE * PC_MAX_CHUNKS);
+        for (uint32 i = 0; i < need; i++) {
+            addr->chunknos[addr->allocated_chunks + i] = first + i;
+        }
+        addr->allocated_chunks = (uint8)nchunks;
+    }
+
+    for (int i = 0; i < nchunks;) {
+        int run = 1;
+        while (i + run < nchunks && addr->chunknos[i + run] == addr->chunknos[i] + (uint32)run) {
+            run++;
+        }
+        nbytes = FilePWrite(seg->mdfd_vfd, compbuf + i * PC_CHUNK_SIZE, run * PC_CHUNK_SIZE,
+                            PageCompressChunkOffset(addr->chunknos[i]), wait_event_info);
+        if (nbytes != run * PC_CHUNK_SIZE) {
+            return (nbytes < 0) ? nbytes : i * PC_CHUNK_SIZE + nbytes;
+        }
+        i += run;
+    }
+
+    /* publish the new image only once all of it is written */
+    pg_write_barrier();
+    addr->nchunks = (uint8)nchunks;
+    _mdextend_compressed_nblocks(seg, blocknum % ((BlockNumber)RELSEG_SIZE) + 1);
+
+    return BLCKSZ;
+}
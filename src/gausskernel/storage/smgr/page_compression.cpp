@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * page_compression.cpp
+ *        Page compression and address files of compressed row relations
+ *
+ * The address file of a segment is mapped shared, so that every backend sees
+ * the chunk allocations of the others without going through the buffer
+ * manager. It is flushed with msync() whenever md.cpp syncs the segment.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/smgr/page_compression.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lz4.h"
+#include "storage/barrier.h"
+#include "storage/fd.h"
+#include "storage/page_compression.h"
+
+uint8 PageCompressAlgorithmByName(const char* name)
+{
+    if (name == NULL || pg_strcasecmp(name, "none") == 0) {
+        return PAGE_COMPRESS_NONE;
+    }
+    if (pg_strcasecmp(name, "lz4") == 0) {
+        return PAGE_COMPRESS_LZ4;
+    }
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("invalid value for option \"compresstype\": \"%s\"", name),
+        errdetail("Valid values are \"none\" and \"lz4\".")));
+    return PAGE_COMPRESS_NONE;
+}
+
+/*
+ * Compress a page into dst, which must hold BLCKSZ bytes, and return the number
+ * of chunks the image takes.
+ */
+int PageCompressPage(const char* page, char* dst, uint8 algorithm)
+{
+    PageCompressData* pcdata = (PageCompressData*)dst;
+    int len = 0;
+    int nchunks;
+    errno_t rc;
+
+    Assert(algorithm == PAGE_COMPRESS_LZ4);
+
+    /* only worth compressing if at least one chunk is saved */
+    len = LZ4_compress_default(page, pcdata->data, BLCKSZ,
+        (int)((PC_MAX_CHUNKS - 1) * PC_CHUNK_SIZE - offsetof(PageCompressData, data)));
+    if (len > 0) {
+        pcdata->size = (uint32)len;
+        nchunks = (int)((offsetof(PageCompressData, data) + len + PC_CHUNK_SIZE - 1) / PC_CHUNK_SIZE);
+        Assert(nchunks < PC_MAX_CHUNKS);
+        return nchunks;
+    }
+
+    rc = memcpy_s(dst, BLCKSZ, page, BLCKSZ);
+    securec_check(rc, "", "");
+    return PC_MAX_CHUNKS;
+}
+
+/*
+ * Rebuild a page from the image read from its nchunks chunks. Returns false if
+ * the image is damaged.
+ */
+bool PageDecompressPage(const char* src, int nchunks, char* page)
+{
+    const PageCompressData* pcdata = (const PageCompressData*)src;
+    errno_t rc;
+
+    if (nchunks == PC_MAX_CHUNKS) {
+        rc = memcpy_s(page, BLCKSZ, src, BLCKSZ);
+        securec_check(rc, "", "");
+        return true;
+    }
+
+    if (nchunks <= 0 || nchunks > PC_MAX_CHUNKS ||
+        pcdata->size > (uint32)(nchunks * PC_CHUNK_SIZE - offsetof(PageCompressData, data))) {
+        return false;
+    }
+
+    return LZ4_decompress_safe(pcdata->data, page, (int)pcdata->size, BLCKSZ) == BLCKSZ;
+}
+
+/* palloc'd name of the address file of a segment file */
+char* PageCompressAddrFilePath(const char* segpath)
+{
+    size_t len = strlen(segpath) + strlen(PCA_SUFFIX) + 1;
+    char* path = (char*)palloc(len);
+    errno_t rc = sprintf_s(path, len, "%s%s", segpath, PCA_SUFFIX);
+    securec_check_ss(rc, "", "");
+    return path;
+}
+
+/*
+ * Map the address file of a segment. Returns NULL if the segment has none and
+ * create is false. A newly created file is initialized for algorithm.
+ */
+PageCompressHeader* PageCompressMapAddrFile(const char* segpath, bool create, uint8 algorithm)
+{
+    char* path = PageCompressAddrFilePath(segpath);
+    PageCompressHeader* map = NULL;
+    struct stat st;
+    int fd;
+
+    fd = BasicOpenFile(path, O_RDWR | PG_BINARY | (create ? O_CREAT : 0), S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        if (errno == ENOENT && !create) {
+            pfree(path);
+            return NULL;
+        }
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not open file \"%s\": %m", path)));
+    }
+
+    if (fstat(fd, &st) < 0) {
+        int save_errno = errno;
+        (void)close(fd);
+        errno = save_errno;
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not stat file \"%s\": %m", path)));
+    }
+    if ((Size)st.st_size < SizeOfPageCompressAddrFile && ftruncate(fd, (off_t)SizeOfPageCompressAddrFile) < 0) {
+        int save_errno = errno;
+        (void)close(fd);
+        errno = save_errno;
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not extend file \"%s\": %m", path)));
+    }
+
+    map = (PageCompressHeader*)mmap(NULL, SizeOfPageCompressAddrFile, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        int save_errno = errno;
+        (void)close(fd);
+        errno = save_errno;
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not map file \"%s\": %m", path)));
+    }
+    (void)close(fd);
+
+    if (map->magic == 0 && !create) {
+        /* creation did not get as far as the header, redo of the creation will finish it */
+        (void)munmap(map, SizeOfPageCompressAddrFile);
+        pfree(path);
+        return NULL;
+    } else if (map->magic == 0) {
+        map->algorithm = algorithm;
+        pg_atomic_write_u32(&map->nblocks, 0);
+        pg_atomic_write_u32(&map->allocated_chunks, 0);
+        pg_write_barrier();
+        map->magic = PC_MAGIC;
+    } else if (map->magic != PC_MAGIC || map->algorithm != PAGE_COMPRESS_LZ4) {
+        (void)munmap(map, SizeOfPageCompressAddrFile);
+        ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("invalid page compression address file \"%s\"", path)));
+    }
+
+    /*
+     * The pages of the mapping reach disk independently of each other, so after
+     * a crash the chunk counter may lag behind the chunks already given out.
+     */
+    if (t_thrd.xlog_cxt.InRecovery) {
+        uint32 maxchunk = 0;
+        uint32 cur = pg_atomic_read_u32(&map->allocated_chunks);
+
+        for (BlockNumber blkno = 0; blkno < (BlockNumber)RELSEG_SIZE; blkno++) {
+            PageCompressAddr* addr = GetPageCompressAddr(map, blkno);
+            int nchunks = Min(addr->allocated_chunks, PC_MAX_CHUNKS);
+            for (int i = 0; i < nchunks; i++) {
+                maxchunk = Max(maxchunk, addr->chunknos[i]);
+            }
+        }
+        while (cur < maxchunk) {
+            if (pg_atomic_compare_exchange_u32(&map->allocated_chunks, &cur, maxchunk)) {
+                break;
+            }
+        }
+    }
+
+    pfree(path);
+    return map;
+}
+
+void PageCompressUnmapAddrFile(PageCompressHeader* map)
+{
+    if (munmap(map, SizeOfPageCompressAddrFile) != 0) {
+        ereport(WARNING, (errcode_for_file_access(), errmsg("could not unmap page compression address file: %m")));
+    }
+}
+
+int PageCompressSyncAddrFile(PageCompressHeader* map)
+{
+    return msync(map, SizeOfPageCompressAddrFile, MS_SYNC);
+}
+
+/*
+ * Is path a segment of a compressed relation, or an address file? Such files
+ * do not hold one page per BLCKSZ bytes.
+ */
+bool IsPageCompressedFile(const char* path)
+{
+    size_t len = strlen(path);
+    size_t suffixlen = strlen(PCA_SUFFIX);
+    char pcapath[MAXPGPATH];
+    struct stat st;
+    errno_t rc;
+
+    if (len >= suffixlen && strcmp(path + len - suffixlen, PCA_SUFFIX) == 0) {
+        return true;
+    }
+
+    rc = snprintf_s(pcapath, MAXPGPATH, MAXPGPATH - 1, "%s%s", path, PCA_SUFFIX);
+    securec_check_ss(rc, "", "");
+    return stat(pcapath, &st) == 0;
+}
@@ -49,6 +49,8 @@ typedef struct f_smgr {
     void (*smgr_unlink)(const RelFileNodeBackend &rnode, ForkNumber forknum, bool isRedo);
     void (*smgr_extend)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char *buffer,
                         bool skipFsync);
+    void (*smgr_zeroextend)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, int nblocks,
+                            bool skipFsync);
     void (*smgr_prefetch)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
     bool (*smgr_read)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
     void (*smgr_write)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char *buffer, bool skipFsync);
@@ -72,6 +74,7 @@ static const f_smgr smgrsw[] = {
       mdexists,
       mdunlink,
       mdextend,
+      mdzeroextend,
       mdprefetch,
       mdread,
       mdwrite,
@@ -150,6 +153,7 @@ static void _smgr_init(SMgrRelation reln, int col = 0)
     reln->smgr_targblock = InvalidBlockNumber;
     reln->smgr_fsm_nblocks = InvalidBlockNumber;
     reln->smgr_vm_nblocks = InvalidBlockNumber;
+    reln->smgr_compress = SMGR_COMPRESS_UNKNOWN;
 
     reln->smgr_which = 0; /* we only have md.c at present */
 
@@ -582,6 +586,19 @@ void smgrcreate(SMgrRelation reln, ForkNumber forknum, bool isRedo)
     (*(smgrsw[which].smgr_create))(reln, (ForkNumber)forknum, isRedo);
 }
 
+/*
+ *  smgrcreatecompressed() -- Create the main fork of a relation whose pages
+ *      are stored compressed with the given algorithm.
+ *
+ * Only md.cpp knows how to store compressed pages, so this does not go
+ * through smgrsw.
+ */
+void smgrcreatecompressed(SMgrRelation reln, uint8 algorithm, bool isRedo)
+{
+    smgrcreate(reln, MAIN_FORKNUM, isRedo);
+    mdcreatecompressed(reln, algorithm, isRedo);
+}
+
 void smgrcreatebuckets(SMgrRelation reln, ForkNumber forknum, bool isRedo)
 {
     int which = reln->smgr_which;
@@ -736,6 +753,18 @@ void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, con
     (*(smgrsw[reln->smgr_which].smgr_extend))(reln, forknum, blocknum, buffer, skipFsync);
 }
 
+/*
+ *	smgrzeroextend() -- Add nblocks zero-filled blocks to a file.
+ *
+ *		Like smgrextend(), but extends the relation by several blocks at
+ *		once, starting at blocknum, without the caller supplying the page
+ *		images.  Intended for pre-extending a relation ahead of inserts.
+ */
+void smgrzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, int nblocks, bool skipFsync)
+{
+    (*(smgrsw[reln->smgr_which].smgr_zeroextend))(reln, forknum, blocknum, nblocks, skipFsync);
+}
+
 /*
  *	smgrprefetch() -- Initiate asynchronous read of the specified block of a relation.
  */
@@ -240,6 +240,14 @@ inline bool dw_enabled()
         g_instance.attr.attr_storage.enableIncrementalCheckpoint && g_instance.attr.attr_storage.enable_double_write);
 }
 
+/**
+ * number of batch flush files in use, one for each page writer thread
+ */
+inline uint32 dw_batch_file_num()
+{
+    return (uint32)Min(g_instance.attr.attr_storage.pagewriter_thread_num, (int)DW_BATCH_FILE_MAX_NUM);
+}
+
 /**
  * flush the buffers identified by the buf_id in buf_id_arr to double write file
  * a token_id is returned, thus double write wish the caller to return it after the
@@ -249,6 +257,12 @@ inline bool dw_enabled()
  */
 void dw_perform_batch_flush(uint32 size, CkptSortItem *dirty_buf_list, ThrdDwCxt* thrd_dw_cxt);
 
+/**
+ * get the name of the batch flush file
+ * @param file_id the batch flush file id, 0 for DW_FILE_NAME
+ */
+void dw_get_batch_file_name(uint32 file_id, char *file_name, size_t len);
+
 /**
  * truncate the pages in double write file after ckpt or before exit
  * wait for tokens, thus all the relative data file flush and fsync request forwarded
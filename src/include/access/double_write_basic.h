@@ -36,6 +36,13 @@ static const char DW_FILE_NAME[] = "global/pg_dw";
 static const char SINGLE_DW_FILE_NAME[] = "global/pg_dw_single";
 static const char DW_BUILD_FILE_NAME[] = "global/pg_dw.build";
 
+/*
+ * Each page writer thread owns one batch flush file. File 0 keeps the name DW_FILE_NAME, the others
+ * are named after DW_BATCH_FILE_NAME_FMT. The limit matches the maximum of pagewriter_thread_num.
+ */
+static const char DW_BATCH_FILE_NAME_FMT[] = "global/pg_dw_%u";
+static const uint32 DW_BATCH_FILE_MAX_NUM = 8;
+
 static const uint32 DW_TRY_WRITE_TIMES = 8;
 #ifndef WIN32
 static const int DW_FILE_FLAG = (O_RDWR | O_SYNC | O_DIRECT | PG_BINARY);
@@ -83,6 +83,7 @@ uint32 GetRedoWorkerCount();
 bool IsMultiThreadRedoRunning();
 bool IsExtremeRtoRunning();
 void DispatchRedoRecord(XLogReaderState* record, List* expectedTLIs, TimestampTz recordXTime);
+void RedoPrefetchRecordBlocks(XLogReaderState* record);
 void GetThreadNameIfMultiRedo(int argc, char* argv[], char** threadNamePtr);
 
 PGPROC* MultiRedoThreadPidGetProc(ThreadId pid);
@@ -19,9 +19,21 @@
 #include "access/heapam.h"
 #include "access/itup.h"
 #include "access/tupdesc.h"
+#include "utils/atomic.h"
 
 #define PARALLEL_SCAN_GAP 100
 
+/*
+ * Blocks of a relation handed out to the smp workers of a parallel seq scan,
+ * PARALLEL_SCAN_GAP blocks at a time. Workers that get through their blocks
+ * faster take more of them, instead of each one reading every dop'th chunk.
+ */
+typedef struct ParallelBlockAllocator {
+    int plan_node_id;           /* seq scan the allocator belongs to */
+    BlockNumber nblocks;        /* blocks to scan, as seen by the first worker */
+    pg_atomic_uint32 nextchunk; /* next chunk to hand out */
+} ParallelBlockAllocator;
+
 /* ----------------------------------------------------------------
  *				 Scan State Information
  * ----------------------------------------------------------------
@@ -42,6 +54,7 @@ typedef struct HeapScanDescData {
     /* these fields only used in page-at-a-time mode and for bitmap scans */
     int rs_mindex;                                   /* marked tuple's saved index */
     int dop;                                         /* scan parallel degree */
+    ParallelBlockAllocator* rs_parallel;             /* shared block allocator of a parallel scan, or NULL */
     /* put decompressed tuple data into rs_ctbuf be careful  , when malloc memory  should give extra mem for
      *xs_ctbuf_hdr. t_bits which is varlength arr
      */
@@ -102,6 +102,12 @@ typedef enum WalLevel {
     WAL_LEVEL_LOGICAL
 } WalLevel;
 
+/* Possible values of wal_compression */
+typedef enum WalCompression {
+    WAL_COMPRESSION_OFF = 0,
+    WAL_COMPRESSION_LZ4
+} WalCompression;
+
 #define XLogArchivingActive() \
     (u_sess->attr.attr_common.XLogArchiveMode && g_instance.attr.attr_storage.wal_level >= WAL_LEVEL_ARCHIVE)
 #define XLogArchiveCommandSet() (u_sess->attr.attr_storage.XLogArchiveCommand[0] != '\0')
@@ -150,6 +150,8 @@ typedef struct {
     char* bkp_image;
     uint16 hole_offset;
     uint16 hole_length;
+    uint16 bimg_len;    /* bytes of bkp_image stored in the record */
+    uint8 bimg_method;  /* BKPIMAGE_COMPRESS_xxx */
 
     /* Buffer holding the rmgr-specific data associated with this block */
     bool has_data;
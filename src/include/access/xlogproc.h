@@ -167,6 +167,8 @@ typedef struct {
     uint16 extra_flag;
     uint16 hole_offset;
     uint16 hole_length; /* image position */
+    uint16 bimg_len;    /* stored image length */
+    uint8 bimg_method;  /* image compression method */
     uint16 data_len;    /* data length */
     XLogRecPtr last_lsn;
     char* bkp_image;
@@ -194,7 +196,8 @@ typedef enum {
     BLOCK_DDL_CLOG_ZERO,
     BLOCK_DDL_CLOG_TRUNCATE,
     BLOCK_DDL_MULTIXACT_OFF_ZERO,
-    BLOCK_DDL_MULTIXACT_MEM_ZERO
+    BLOCK_DDL_MULTIXACT_MEM_ZERO,
+    BLOCK_DDL_CREATE_COMPRESSED_RELNODE
 } XLogBlockDdlInfoEnum;
 
 typedef struct {
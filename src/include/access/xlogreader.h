@@ -50,7 +50,8 @@ extern struct XLogRecord* XLogReadRecord(
 extern bool XLogRecGetBlockTag(
     XLogReaderState* record, uint8 block_id, RelFileNode* rnode, ForkNumber* forknum, BlockNumber* blknum);
 extern bool XLogRecGetBlockLastLsn(XLogReaderState* record, uint8 block_id, XLogRecPtr* lsn);
-extern char* XLogRecGetBlockImage(XLogReaderState* record, uint8 block_id, uint16* hole_offset, uint16* hole_length);
+extern char* XLogRecGetBlockImage(XLogReaderState* record, uint8 block_id, uint16* hole_offset, uint16* hole_length,
+    uint16* bimg_len = NULL, uint8* bimg_method = NULL);
 
 /* Invalidate read state */
 extern void XLogReaderInvalReadState(XLogReaderState* state);
@@ -80,7 +81,8 @@ extern bool DecodeXLogRecord(XLogReaderState* state, XLogRecord* record, char**
 #define XLogRecHasBlockRef(decoder, block_id) ((decoder)->blocks[block_id].in_use)
 #define XLogRecHasBlockImage(decoder, block_id) ((decoder)->blocks[block_id].has_image)
 
-extern void RestoreBlockImage(const char* bkp_image, uint16 hole_offset, uint16 hole_length, char* page);
+extern bool RestoreBlockImage(const char* bkp_image, uint16 hole_offset, uint16 hole_length, uint16 bimg_len,
+    uint8 bimg_method, char* page);
 extern char* XLogRecGetBlockData(XLogReaderState* record, uint8 block_id, Size* len);
 extern bool allocate_recordbuf(XLogReaderState* state, uint32 reclength);
 extern bool XlogFileIsExisted(const char* workingPath, XLogRecPtr inputLsn, TimeLineID timeLine);
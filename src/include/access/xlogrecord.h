@@ -39,6 +39,8 @@
 #define XLR_SPECIAL_REL_UPDATE 0x01
 /* If xlog record contains bucket node id */
 #define XLR_REL_HAS_BUCKET     0x02
+/* If every full-page image in the record carries an XLogRecordBlockCompressHeader */
+#define XLR_BKP_COMPRESSED     0x04
 
 /*
  * Header info for block data appended to an XLOG record.
@@ -87,12 +89,30 @@ typedef struct XLogRecordBlockImageHeader {
 
 #define SizeOfXLogRecordBlockImageHeader sizeof(XLogRecordBlockImageHeader)
 
+/*
+ * When the record has XLR_BKP_COMPRESSED set, each XLogRecordBlockImageHeader
+ * is followed by this header. 'length' is the number of image bytes actually
+ * stored in the record, and 'method' tells how they were produced from the
+ * BLCKSZ - hole_length bytes of the page. Images that do not shrink are kept
+ * as they are, with method BKPIMAGE_COMPRESS_NONE.
+ */
+typedef struct XLogRecordBlockCompressHeader {
+    uint16 length; /* number of image bytes stored */
+    uint8 method;  /* BKPIMAGE_COMPRESS_xxx */
+} XLogRecordBlockCompressHeader;
+
+#define SizeOfXLogRecordBlockCompressHeader (offsetof(XLogRecordBlockCompressHeader, method) + sizeof(uint8))
+
+#define BKPIMAGE_COMPRESS_NONE 0
+#define BKPIMAGE_COMPRESS_LZ4 1
+
 /*
  * Maximum size of the header for a block reference. This is used to size a
  * temporary buffer for constructing the header.
  */
-#define MaxSizeOfXLogRecordBlockHeader \
-    (SizeOfXLogRecordBlockHeader + SizeOfXLogRecordBlockImageHeader + sizeof(RelFileNode) + sizeof(BlockNumber))
+#define MaxSizeOfXLogRecordBlockHeader                                                                      \
+    (SizeOfXLogRecordBlockHeader + SizeOfXLogRecordBlockImageHeader + SizeOfXLogRecordBlockCompressHeader + \
+        sizeof(RelFileNode) + sizeof(BlockNumber))
 
 /*
  * XLogRecordDataHeaderShort/Long are used for the "main data" portion of
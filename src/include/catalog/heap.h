@@ -20,6 +20,7 @@
 #include "catalog/indexing.h"
 #include "utils/partcache.h"
 #include "utils/partitionmap.h"
+#include "storage/page_compression.h"
 
 #define PSORT_RESERVE_COLUMN	"tid"
 #define CHCHK_PSORT_RESERVE_COLUMN(attname)		(strcmp(PSORT_RESERVE_COLUMN, (attname)) == 0)
@@ -80,7 +81,8 @@ extern Relation heap_create(const char *relname,
 			int8 row_compress,
 			Oid ownerid,
 			bool skip_create_storage,
-			TableAmType tam_type);
+			TableAmType tam_type,
+			uint8 page_compress = PAGE_COMPRESS_NONE);
 
 extern bool heap_is_matview_init_state(Relation rel);
 
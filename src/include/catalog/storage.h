@@ -18,6 +18,7 @@
 #include "storage/buf/block.h"
 #include "storage/relfilenode.h"
 #include "storage/lmgr.h"
+#include "storage/page_compression.h"
 #include "utils/relcache.h"
 #include "utils/partcache.h"
 #include "utils/rel.h"
@@ -26,7 +27,8 @@
 #define DFS_STOR_FLAG  -1
 
 extern void RelationCreateStorage(RelFileNode rnode, char relpersistence, Oid ownerid, Oid bucketOid = InvalidOid,
-                                  Oid relfilenode=InvalidOid, Relation rel = NULL);
+                                  Oid relfilenode=InvalidOid, Relation rel = NULL,
+                                  uint8 pageCompress = PAGE_COMPRESS_NONE);
 extern void RelationDropStorage(Relation rel, bool isDfsTruncate = false);
 extern void RelationPreserveStorage(RelFileNode rnode, bool atCommit);
 extern void RelationTruncate(Relation rel, BlockNumber nblocks);
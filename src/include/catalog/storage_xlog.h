@@ -29,22 +29,31 @@
 /* XLOG gives us high 4 bits */
 #define XLOG_SMGR_CREATE	0x10
 #define XLOG_SMGR_TRUNCATE	0x20
+#define XLOG_SMGR_CREATE_COMPRESSED	0x30
 
 typedef struct xl_smgr_create {
 	RelFileNodeOld rnode;
 	ForkNumber	forkNum;
 } xl_smgr_create;
 
+/* creation of the main fork of a relation that stores its pages compressed */
+typedef struct xl_smgr_create_compressed {
+	xl_smgr_create create;
+	uint8		algorithm;
+} xl_smgr_create_compressed;
+
 typedef struct xl_smgr_truncate {
 	BlockNumber blkno;
 	RelFileNodeOld rnode;
 } xl_smgr_truncate;
 
 extern void log_smgrcreate(RelFileNode *rnode, ForkNumber forkNum, const oidvector* bucketlist = NULL);
+extern void log_smgrcreate_compressed(RelFileNode *rnode, uint8 algorithm);
 
 extern void smgr_redo(XLogReaderState *record);
 extern void smgr_desc(StringInfo buf, XLogReaderState *record);
 extern void smgr_redo_create(RelFileNode rnode, ForkNumber forkNum, char *data);
+extern void smgr_redo_create_compressed(RelFileNode rnode, char *data);
 extern void xlog_block_smgr_redo_truncate(RelFileNode rnode, BlockNumber blkno, XLogRecPtr lsn);
 
 #endif   /* STORAGE_XLOG_H */
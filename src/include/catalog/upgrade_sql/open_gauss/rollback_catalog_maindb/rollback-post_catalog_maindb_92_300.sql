@@ -0,0 +1 @@
+DROP FUNCTION IF EXISTS pg_catalog.local_redo_prefetch_stat();
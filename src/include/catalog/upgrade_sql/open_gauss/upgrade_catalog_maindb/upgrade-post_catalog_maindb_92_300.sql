@@ -0,0 +1,9 @@
+DROP FUNCTION IF EXISTS pg_catalog.local_redo_prefetch_stat();
+SET LOCAL inplace_upgrade_next_system_object_oids=IUO_PROC, 4397;
+CREATE FUNCTION pg_catalog.local_redo_prefetch_stat
+(
+OUT hits pg_catalog.int8,
+OUT misses pg_catalog.int8,
+OUT skips pg_catalog.int8,
+OUT distance pg_catalog.int4
+) RETURNS record LANGUAGE INTERNAL VOLATILE as 'local_redo_prefetch_stat';
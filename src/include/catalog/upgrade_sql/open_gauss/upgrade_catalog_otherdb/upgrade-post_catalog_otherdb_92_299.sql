@@ -0,0 +1,13 @@
+DROP FUNCTION IF EXISTS pg_catalog.local_buffer_strategy_stat();
+SET LOCAL inplace_upgrade_next_system_object_oids=IUO_PROC, 4395;
+CREATE FUNCTION pg_catalog.local_buffer_strategy_stat
+(
+OUT policy pg_catalog.text,
+OUT probation_hits pg_catalog.int8,
+OUT protected_hits pg_catalog.int8,
+OUT ghost_hits pg_catalog.int8,
+OUT misses pg_catalog.int8,
+OUT probation_evictions pg_catalog.int8,
+OUT protected_evictions pg_catalog.int8,
+OUT protected_percent pg_catalog.int4
+) RETURNS record LANGUAGE INTERNAL VOLATILE as 'local_buffer_strategy_stat';
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * rowexprcodegen.h
+ *        Declarations of code generation for row engine scans
+ *
+ * IDENTIFICATION
+ *        src/include/codegen/rowexprcodegen.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef LLVM_ROW_EXPR_H
+#define LLVM_ROW_EXPR_H
+
+#include "codegen/gscodegen.h"
+#include "nodes/execnodes.h"
+
+namespace dorado {
+
+/*
+ * RowExprCodeGen generates the qual and the tuple deforming of a row table
+ * scan. Both work on the tts_values/tts_isnull arrays of the scan slot.
+ */
+class RowExprCodeGen : public BaseObject {
+public:
+    /*
+     * Brief        : Check whether a plan qual could be codegened.
+     * Description  : Supported are Var op Const comparisons on int2, int4, int8,
+     *                float4 and float8 columns of the scan tuple, IS [NOT] NULL
+     *                on such columns and AND/OR/NOT over them.
+     * Input        : qual, the implicitly ANDed plan qual.
+     *                desc, the tuple descriptor of the scan tuple.
+     * Output       : natts, the last attribute the qual reads.
+     * Return Value : Return true if the qual could be codegened.
+     * Notes        : None.
+     */
+    static bool QualJittable(List* qual, TupleDesc desc, int* natts);
+
+    /*
+     * Brief        : Generate the qual as bool f(Datum* values, bool* isnull).
+     * Description  : The result follows ExecQual with resultForNull false.
+     * Input        : qual, the implicitly ANDed plan qual.
+     *                desc, the tuple descriptor of the scan tuple.
+     * Output       : natts, the last attribute the qual reads.
+     * Return Value : Return the LLVM function, or NULL if not jittable.
+     * Notes        : None.
+     */
+    static llvm::Function* QualCodeGen(List* qual, TupleDesc desc, int* natts);
+
+    /*
+     * Brief        : Count the leading attributes the deform function can handle.
+     * Description  : Only fixed-length attributes are handled, so the offset of
+     *                every one of them depends on the null bitmap alone.
+     * Input        : desc, the tuple descriptor of the scan tuple.
+     *                natts, the attributes needed by the scan.
+     * Output       : None.
+     * Return Value : Return the number of attributes to deform.
+     * Notes        : None.
+     */
+    static int DeformJittableAttrs(TupleDesc desc, int natts);
+
+    /*
+     * Brief        : Generate the deforming of the first natts attributes.
+     * Description  : long f(char* tp, bits8* bp, Datum* values, bool* isnull)
+     *                returns the offset following the last attribute. bp is
+     *                NULL if the tuple has no null bitmap.
+     * Input        : desc, the tuple descriptor of the scan tuple.
+     *                natts, as returned by DeformJittableAttrs.
+     * Output       : None.
+     * Return Value : Return the LLVM function.
+     * Notes        : None.
+     */
+    static llvm::Function* DeformCodeGen(TupleDesc desc, int natts);
+
+private:
+    static bool ExprJittable(Expr* node, TupleDesc desc, int* natts);
+
+    static void ExprCodeGen(
+        Expr* node, GsCodeGen::LlvmBuilder* builder, llvm::Value* values, llvm::Value* isnull,
+        llvm::Value** resval, llvm::Value** resnull);
+
+    static void VarCodeGen(
+        Var* var, GsCodeGen::LlvmBuilder* builder, llvm::Value* values, llvm::Value* isnull,
+        llvm::Value** resval, llvm::Value** resnull);
+
+    static llvm::Value* FloatCmpCodeGen(
+        Oid opno, GsCodeGen::LlvmBuilder* builder, llvm::Value* lhs, llvm::Value* rhs);
+};
+}  // namespace dorado
+
+#endif /* LLVM_ROW_EXPR_H */
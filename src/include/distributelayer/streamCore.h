@@ -62,6 +62,9 @@ struct StreamState;
 class StreamObj;
 class StreamNodeGroup;
 struct SyncController;
+struct ParallelBlockAllocator;
+struct SonicSharedHashTable;
+struct SharedBloomFilter;
 
 typedef bool (*scanStreamFun)(StreamState* node);
 typedef bool (*deserializeStreamFun)(StreamState* node);
@@ -377,6 +380,15 @@ public:
     /* Controller list for recursive */
     List* m_syncControllers;
 
+    /* Block allocators of parallel seq scans */
+    List* m_parallelBlockAllocators;
+
+    /* Hash tables shared by the smp threads of Sonic hash joins */
+    List* m_sonicSharedHashTables;
+
+    /* Runtime bloom filters shared by the smp threads */
+    List* m_sharedBloomFilters;
+
     MemoryContext m_streamRuntimeContext;
 
     /* Save the first error data of producer thread */
@@ -401,6 +413,15 @@ public:
     SyncController* GetSyncController(int controller_plannodeid);
     void MarkSyncControllerStopFlagAll();
 
+    /* Get the block allocator shared by the smp workers of a parallel seq scan. */
+    ParallelBlockAllocator* GetParallelBlockAllocator(int plan_node_id, BlockNumber nblocks);
+
+    /* Get the hash table shared by the smp threads of a Sonic hash join. */
+    SonicSharedHashTable* GetSonicSharedHashTable(int plan_node_id, int nthreads);
+
+    /* Get the runtime bloom filter shared by the smp threads. */
+    SharedBloomFilter* GetSharedBloomFilter(int filter_index);
+
     inline pthread_mutex_t* GetStreamMutext()
     {
         return &m_mutex;
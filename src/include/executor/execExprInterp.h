@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * execExprInterp.h
+ *        Flattened step programs for row engine expressions
+ *
+ * ExecInitExpr builds the usual ExprState tree and, when enable_flat_expr is on,
+ * also compiles the root of it into a linear array of steps. Each step writes its
+ * result into a Datum/isnull pair owned by the step that consumes it, so that
+ * evaluating the expression is a single loop over the array instead of one
+ * indirect call per node. Subtrees the compiler does not handle are kept as a
+ * single step that evaluates them through their ExprState.
+ *
+ * IDENTIFICATION
+ *        src/include/executor/execExprInterp.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef EXEC_EXPR_INTERP_H
+#define EXEC_EXPR_INTERP_H
+
+#include "nodes/execnodes.h"
+
+/* slots a Var step can read from */
+typedef enum ExprStepSlot {
+    EEOP_SLOT_SCAN = 0,
+    EEOP_SLOT_INNER,
+    EEOP_SLOT_OUTER,
+    EEOP_SLOT_COUNT
+} ExprStepSlot;
+
+typedef enum ExprStepOp {
+    EEOP_DONE = 0,            /* return the value of the program */
+    EEOP_FETCHSOME,           /* deform a slot up to the last attribute the program reads */
+    EEOP_VAR,                 /* user attribute of a deformed slot */
+    EEOP_CONST,               /* constant value */
+    EEOP_FUNCEXPR,            /* call of a non-strict function */
+    EEOP_FUNCEXPR_STRICT,     /* call of a strict function, NULL on any NULL argument */
+    EEOP_VAR_OP_CONST,        /* strict binary function of a Var and a non-NULL Const */
+    EEOP_BOOL_AND_STEP_FIRST, /* one argument of AND, in order */
+    EEOP_BOOL_AND_STEP,
+    EEOP_BOOL_AND_STEP_LAST,
+    EEOP_BOOL_OR_STEP_FIRST,  /* one argument of OR, in order */
+    EEOP_BOOL_OR_STEP,
+    EEOP_BOOL_OR_STEP_LAST,
+    EEOP_BOOL_NOT,
+    EEOP_NULLTEST_ISNULL,
+    EEOP_NULLTEST_ISNOTNULL,
+    EEOP_EVAL_SUBTREE,        /* subtree evaluated through its ExprState */
+    EEOP_LAST
+} ExprStepOp;
+
+typedef struct ExprStep {
+    int opcode;      /* an ExprStepOp */
+    Datum* resvalue; /* where to store the result */
+    bool* resnull;
+    union {
+        struct {
+            int slot; /* an ExprStepSlot */
+            int last; /* attributes to deform */
+            bool checked;
+        } fetch;
+        struct {
+            int slot;
+            int attnum;
+            Oid vartype;
+        } var;
+        struct {
+            Datum value;
+            bool isnull;
+        } constval;
+        struct {
+            FunctionCallInfo fcinfo;
+            int nargs;
+        } func;
+        struct {
+            FunctionCallInfo fcinfo; /* arg[1] holds the constant */
+            int slot;
+            int attnum;
+            Oid vartype;
+        } varopconst;
+        struct {
+            bool* anynull; /* shared by the steps of one AND/OR */
+            int jumpdone;  /* step to continue at once the result is known */
+        } boolexpr;
+        struct {
+            ExprState* state;
+        } subtree;
+    } d;
+} ExprStep;
+
+typedef struct ExprStepProgram {
+    ExprStep* steps;
+    int nsteps;
+    int maxsteps;
+    Datum resvalue; /* result of the whole expression */
+    bool resnull;
+} ExprStepProgram;
+
+extern void ExecCompileExprSteps(ExprState* state);
+
+#endif /* EXEC_EXPR_INTERP_H */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * execRuntimeFilter.h
+ *        Bloom filters pushed down from hash joins into row and column table scans
+ *
+ * The planner marks the scans below the outer side of a hash join whose join key
+ * they produce, giving each filter an index into es_bloom_filter.bfarray. Once
+ * the hash join has built its table it stores the filter there, and the scan
+ * starts dropping the rows, or whole CUs, whose key the filter excludes.
+ *
+ * A scan below a local stream runs in another smp thread, with its own EState.
+ * For it the hash join threads also publish their filters to the stream node
+ * group, where they are unioned. The scan uses the union once every thread of
+ * the hash join has published, as each of them may have hashed only part of
+ * the inner rows.
+ *
+ * IDENTIFICATION
+ *        src/include/executor/execRuntimeFilter.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef EXEC_RUNTIME_FILTER_H
+#define EXEC_RUNTIME_FILTER_H
+
+#include "nodes/execnodes.h"
+#include "utils/atomic.h"
+
+/* a filter shared by the smp threads of a stream node group */
+typedef struct SharedBloomFilter {
+    int filter_index;             /* index into es_bloom_filter.bfarray */
+    int nbuilders;                /* smp threads of the hash join, set by the first one to publish */
+    int nbuilt;                   /* threads that have published */
+    bool invalid;                 /* a published filter could not be merged */
+    MemoryContext context;        /* shared context the union lives in */
+    filter::BloomFilter* filter;  /* union of the published filters */
+    pg_atomic_uint32 ready;       /* nonzero once every thread has published */
+} SharedBloomFilter;
+
+/* the filters a scan applies to the join keys it produces */
+typedef struct ScanRuntimeFilter {
+    int nfilters;
+    int nready;                       /* filters found so far */
+    AttrNumber* attnos;               /* scan attribute each filter applies to */
+    Oid* atttypes;
+    int32* atttypmods;
+    int* filterIndex;                 /* index into es_bloom_filter.bfarray */
+    filter::BloomFilter** filters;    /* NULL until the filter is built */
+    SharedBloomFilter** shared;       /* entry for a filter built by other smp threads */
+} ScanRuntimeFilter;
+
+extern ScanRuntimeFilter* ExecInitScanRuntimeFilter(ScanState* node);
+extern bool ExecScanRuntimeFilterReady(ScanState* node);
+extern void ExecReScanScanRuntimeFilter(ScanState* node);
+extern bool ExecScanRuntimeFilterTuple(ScanState* node, TupleTableSlot* slot);
+extern bool ExecRuntimeFilterInclude(const filter::BloomFilter* bf, Oid atttype, Datum value);
+extern bool ExecRuntimeFilterMinMax(const filter::BloomFilter* bf, Oid atttype, Datum min, Datum max);
+extern void ExecPublishRuntimeFilter(PlanState* join, int filter_index, filter::BloomFilter* bf);
+
+#endif /* EXEC_RUNTIME_FILTER_H */
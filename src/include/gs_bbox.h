@@ -74,7 +74,7 @@ extern BlacklistItem g_blacklist_items[];
 /* t_thrd.shemem_ptr_cxt.XLogCtl->pages */
 #define BBOX_BLACKLIST_XLOG_BUFFER (BBOX_ENABLED && (BBOX_BLACKLIST & BLACKLIST_ITEM_MASK(XLOG_BUFFER)))
 
-/* g_instance.dw_batch_cxt.buf */
+/* ThrdDwCxt.dw_buf of page writer and bgwriter threads */
 #define BBOX_BLACKLIST_DW_BUFFER (BBOX_ENABLED && (BBOX_BLACKLIST & BLACKLIST_ITEM_MASK(DW_BUFFER)))
 
 /* t_thrd.walsender_cxt.output_xlog_message*/
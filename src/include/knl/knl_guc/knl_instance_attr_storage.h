@@ -42,12 +42,15 @@
 
 typedef struct knl_instance_attr_storage {
     bool wal_log_hints;
+    bool enable_wal_insert_staging;
     bool EnableHotStandby;
     bool enable_mix_replication;
     bool IsRoachStandbyCluster;
     bool enable_gtm_free;
     bool comm_cn_dn_logic_conn;
     bool enable_adio_function;
+    bool enable_uring_io;
+    bool enable_lockfree_buffer_lookup;
     bool enable_access_server_directory;
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
@@ -75,9 +78,11 @@ typedef struct knl_instance_attr_storage {
     int recovery_redo_workers_per_paser_worker;
     int pagewriter_thread_num;
     int bgwriter_thread_num;
+    int uring_queue_depth;
     int real_recovery_parallelism;
 	int batch_redo_num;
     int remote_read_mode;
+    int buffer_replacement_policy;
     int advance_xlog_file_num;
     int gtm_option;
     int enable_update_max_page_flush_lsn;
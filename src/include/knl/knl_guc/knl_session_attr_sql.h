@@ -50,9 +50,11 @@ typedef struct knl_session_attr_sql {
     bool enable_bloom_filter;
     bool enable_codegen;
     bool enable_codegen_print;
+    bool enable_flat_expr;
     bool enable_sonic_optspill;
     bool enable_sonic_hashjoin;
     bool enable_sonic_hashagg;
+    bool enable_sonic_shared_hashjoin;
     bool enable_upsert_to_merge;
     bool enable_csqual_pushdown;
     bool enable_change_hjcost;
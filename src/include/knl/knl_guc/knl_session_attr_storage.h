@@ -170,12 +170,14 @@ typedef struct knl_session_attr_storage {
     int resource_track_log;
     int guc_synchronous_commit;
     int sync_method;
+    int wal_compression;
     int autovacuum_mode;
     int cstore_insert_mode;
     int pageWriterSleep;
     bool enable_cbm_tracking;
     bool enable_copy_server_files;
     int target_rto;
+    int recovery_prefetch_distance;
     int time_to_target_rpo;
     bool enable_twophase_commit;
     /*
@@ -443,6 +443,7 @@ typedef struct knl_g_dw_context {
     char* buf;
     dw_file_head_t* file_head;
     bool contain_hashbucket;
+    uint32 file_id;             /* batch flush file id, 0 for the single flush context */
 
     /* single flush dw extras information */
     single_slot_pos *single_flush_pos;     /* dw single flush slot */
@@ -487,6 +488,9 @@ typedef struct {
     uint32 speed_according_seg;
     XLogRecPtr local_max_lsn;
     uint64    oldest_segment;
+    uint64 prefetch_hit;  /* referenced blocks already resident or in flight */
+    uint64 prefetch_miss; /* referenced blocks prefetched by the dispatcher */
+    uint64 prefetch_skip; /* referenced blocks not prefetched */
 } RedoPerf;
 
 
@@ -779,7 +783,7 @@ typedef struct knl_instance_context {
     knl_g_ckpt_context ckpt_cxt;
     knl_g_ckpt_context* ckpt_cxt_ctl;
     knl_g_bgwriter_context bgwriter_cxt;
-    struct knl_g_dw_context dw_batch_cxt;
+    struct knl_g_dw_context dw_batch_cxt[DW_BATCH_FILE_MAX_NUM];
     struct knl_g_dw_context dw_single_cxt;
     knl_g_shmem_context shmem_cxt;
     knl_g_executor_context exec_cxt;
@@ -616,6 +616,10 @@ typedef struct knl_t_xlog_context {
     int lockToTry;
     uint64 cachedPage;
     char* cachedPos;
+    /* moving staged WAL records into the WAL buffers, see GatherStagedXLog() */
+    bool gatheringStagedXLog;
+    /* ... while holding a WAL insertion lock, so progress is advertised on it */
+    bool gatheringWithInsertLock;
 #ifdef WIN32
     unsigned int deletedcounter;
 #endif
@@ -2271,6 +2275,8 @@ typedef struct knl_t_storage_context {
     char* BufferBlocks;
     struct WritebackContext* BackendWritebackContext;
     struct HTAB* SharedBufHash;
+    struct BufLookupHintSet* SharedBufHint;
+    uint32 SharedBufHintMask;
     struct HTAB* BufFreeListHash;
     struct BufferDesc* InProgressBuf;
     /* local state for StartBufferIO and related functions */
@@ -2282,6 +2288,9 @@ typedef struct knl_t_storage_context {
     int InProgressAioDispatchCount;
     struct BufferDesc* InProgressAioBuf;
     int InProgressAioType;
+    /* io_uring instance of this thread, see storage/uring.h */
+    struct UringContext* UringCxt;
+    bool UringUnavailable;
     /*
      * When btree split, it will record two xlog:
      * 1. page split
@@ -323,6 +323,8 @@ typedef struct ProjectionInfo {
  * will be added to the actual machine code.
  */
 typedef ScalarVector* (*vecqual_func)(ExprContext* econtext);
+typedef bool (*rowqual_func)(Datum* values, bool* isnull);
+typedef long (*rowdeform_func)(char* tp, bits8* bp, Datum* values, bool* isnull);
 
 /* ----------------
  *	  JunkFilter
@@ -721,6 +723,8 @@ struct ExprState {
     ScalarVector tmpVector;
 
     Oid resultType;
+
+    struct ExprStepProgram* steps; /* step program run by evalfunc, if compiled */
 };
 
 /* ----------------
@@ -1518,6 +1522,7 @@ typedef struct SampleScanParams {
  */
 struct ScanState;
 struct SeqScanAccessor;
+struct ScanRuntimeFilter;
 
 /*
  * prototypes from functions in execScan.c
@@ -1548,6 +1553,11 @@ typedef struct ScanState {
     bool isSampleScan;               /* identify is it table sample scan or not. */
     SampleScanParams sampleScanInfo; /* TABLESAMPLE params include type/seed/repeatable. */
     ExecScanAccessMtd ScanNextMtd;
+    rowqual_func jitted_rowqual;     /* LLVM function pointer to point to the codegened plan qual */
+    int jitted_rowqual_natts;        /* attributes read by jitted_rowqual */
+    rowdeform_func jitted_deform;    /* LLVM function pointer to point to the codegened tuple deforming */
+    int jitted_deform_natts;         /* attributes deformed by jitted_deform */
+    ScanRuntimeFilter* ss_runtimeFilter; /* bloom filters pushed down from hash joins */
 } ScanState;
 
 /*
@@ -34,6 +34,7 @@ typedef struct ThrdDwCxt {
     uint16 write_pos;
     volatile int dw_page_idx;      /* -1 means data files have been flushed. */
     bool contain_hashbucket;
+    uint32 dw_file_id;             /* batch flush dw file this thread writes to */
 } ThrdDwCxt;
 
 typedef struct PageWriterProc {
@@ -42,13 +43,13 @@ typedef struct PageWriterProc {
     volatile uint32 end_loc;
     volatile bool need_flush;
     volatile uint32 actual_flush_num;
+    ThrdDwCxt thrd_dw_cxt;
 } PageWriterProc;
 
 typedef struct PageWriterProcs {
     PageWriterProc* writer_proc;
     volatile int num;             /* number of pagewriter thread */
     pg_atomic_uint32 running_num; /* number of pagewriter thread which flushing dirty page */
-    ThrdDwCxt thrd_dw_cxt;
 } PageWriterProcs;
 
 typedef struct DirtyPageQueueSlot {
@@ -304,6 +304,17 @@ extern void StrategyNotifyBgWriter(int bgwprocno);
 extern Size StrategyShmemSize(void);
 extern void StrategyInitialize(bool init);
 
+/* buffers a victim search passed over, see StrategyBufferIsCandidate() */
+typedef struct StrategySweepStats {
+    uint32 visited;
+    uint32 protected_seen;
+} StrategySweepStats;
+
+extern bool StrategyBufferIsCandidate(uint32* buf_state, StrategySweepStats* sweep);
+extern void StrategyReportSweep(const StrategySweepStats* sweep);
+extern void StrategyRecordHit(BufferDesc* buf);
+extern uint32 StrategyReplaceBuffer(uint32 old_buf_state, uint32 old_hash, uint32 new_hash);
+
 /* buf_table.c */
 extern Size BufTableShmemSize(int size);
 extern void InitBufTable(int size);
@@ -312,6 +323,10 @@ extern int BufTableLookup(BufferTag* tagPtr, uint32 hashcode);
 extern int BufTableInsert(BufferTag* tagPtr, uint32 hashcode, int buf_id);
 extern void BufTableDelete(BufferTag* tagPtr, uint32 hashcode);
 
+/* lock-free lookup hint table, see buf_table.cpp */
+#define BUF_HINT_MAX_CANDIDATES 4
+extern int BufTableHintLookup(uint32 hashcode, int* buf_ids);
+
 /* localbuf.c */
 extern void LocalPrefetchBuffer(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum);
 extern BufferDesc* LocalBufferAlloc(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum, bool* foundPtr);
@@ -40,6 +40,23 @@ typedef enum BufferAccessStrategyType {
     BAS_VACUUM     /* VACUUM */
 } BufferAccessStrategyType;
 
+/* Possible values of buffer_replacement_policy */
+typedef enum BufferReplacementPolicy {
+    BUFFER_POLICY_CLOCK, /* clock sweep over all unpinned buffers */
+    BUFFER_POLICY_2Q     /* evict from probation, keep re-referenced buffers protected */
+} BufferReplacementPolicy;
+
+/* Counters of the 2Q replacement policy, see StrategyGetStats() */
+typedef struct BufferStrategyStats {
+    uint64 probation_hits;
+    uint64 protected_hits;
+    uint64 ghost_hits;
+    uint64 misses;
+    uint64 probation_evictions;
+    uint64 protected_evictions;
+    uint32 protected_percent;
+} BufferStrategyStats;
+
 /* Possible modes for ReadBufferExtended() */
 typedef enum {
     RBM_NORMAL,                /* Normal read */
@@ -198,6 +215,7 @@ struct WritebackContext;
  * prototypes for functions in bufmgr.c
  */
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum);
+extern bool PrefetchBufferWithoutRelcache(const RelFileNode& rnode, ForkNumber forkNum, BlockNumber blockNum);
 extern void PageRangePrefetch(
     Relation reln, ForkNumber forkNum, BlockNumber blockNum, int32 n, uint32 flags, uint32 col);
 extern void PageListPrefetch(
@@ -291,6 +309,7 @@ extern void AtProcExit_LocalBuffers(void);
 /* in freelist.c */
 extern BufferAccessStrategy GetAccessStrategy(BufferAccessStrategyType btype);
 extern void FreeAccessStrategy(BufferAccessStrategy strategy);
+extern void StrategyGetStats(BufferStrategyStats* stats);
 
 /* dirty page manager */
 extern int ckpt_buforder_comparator(const void* pa, const void* pb);
@@ -73,9 +73,11 @@
  * Vectorization of the algorithm requires 32bit x 32bit -> 32bit integer
  * multiplication instruction. As of 2013 the corresponding instruction is
  * available on x86 SSE4.1 extensions (pmulld) and ARM NEON (vmul.i32).
- * Vectorization requires a compiler to do the vectorization for us. For recent
- * GCC versions the flags -msse4.1 -funroll-loops -ftree-vectorize are enough
- * to achieve vectorization.
+ * The portable implementation relies on the compiler to do the vectorization
+ * for us. For recent GCC versions the flags -msse4.1 -funroll-loops
+ * -ftree-vectorize are enough to achieve vectorization. checksum_impl.cpp also
+ * carries explicit AVX2 (chosen at runtime on x86-64) and NEON (aarch64)
+ * versions, which compute the same result.
  *
  * The optimal amount of parallelism to use depends on CPU specific instruction
  * latency, SIMD instruction width, throughput and the amount of registers
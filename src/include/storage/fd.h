@@ -64,6 +64,30 @@ typedef struct DataFileIdCacheEntry {
 
 enum FileExistStatus { FILE_EXIST, FILE_NOT_EXIST, FILE_NOT_REG };
 
+typedef enum FileIOType {
+    FILE_IO_READ,      /* pread() */
+    FILE_IO_WRITE,     /* pwrite() */
+    FILE_IO_FSYNC,     /* fsync() */
+    FILE_IO_WRITEBACK, /* sync_file_range(SYNC_FILE_RANGE_WRITE) */
+    FILE_IO_PREFETCH   /* posix_fadvise(POSIX_FADV_WILLNEED) */
+} FileIOType;
+
+/*
+ * One request of a FileBatchIO() batch. buffer and amount are ignored by FILE_IO_FSYNC.
+ * On completion result holds what the equivalent system call would have returned, with
+ * the errno of a failed request in error. fd is the kernel fd, filled in by FileBatchIO().
+ */
+typedef struct FileIORequest {
+    FileIOType type;
+    File file;
+    int fd;
+    char* buffer;
+    off_t offset;
+    off_t amount;
+    int result;
+    int error;
+} FileIORequest;
+
 /*
  * prototypes for functions in fd.c
  */
@@ -93,6 +117,9 @@ extern int FileWrite(File file, const char* buffer, int amount, off_t offset);
 //
 extern int FilePRead(File file, char* buffer, int amount, off_t offset, uint32 wait_event_info = 0);
 extern int FilePWrite(File file, const char* buffer, int amount, off_t offset, uint32 wait_event_info = 0);
+extern int FileFallocate(File file, off_t offset, off_t amount, uint32 wait_event_info = 0);
+extern void FileBatchIO(FileIORequest* reqs, int count, uint32 wait_event_info = 0);
+extern void FileSubmitPendingIO(void);
 
 extern int AllocateSocket(const char* ipaddr, int port);
 extern int FreeSocket(int sockfd);
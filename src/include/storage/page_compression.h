@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * page_compression.h
+ *        On-disk layout of row relations created with the compresstype option
+ *
+ * The main fork of such a relation keeps its usual segment files, but a segment
+ * no longer stores block N at offset N * BLCKSZ. It is divided into chunks of
+ * PC_CHUNK_SIZE bytes, and every block is stored, compressed, in as many chunks as
+ * it needs. Each segment file has a companion address file, named after it with
+ * PCA_SUFFIX appended, which md.cpp maps into memory. The address file holds the
+ * number of blocks in the segment and, for every block, the chunks it occupies.
+ *
+ * Chunks given to a block are kept by it when the block is rewritten or truncated
+ * away, so a segment never needs more chunks than an uncompressed one would.
+ *
+ * IDENTIFICATION
+ *        src/include/storage/page_compression.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef PAGE_COMPRESSION_H
+#define PAGE_COMPRESSION_H
+
+#include "storage/buf/block.h"
+#include "utils/atomic.h"
+
+#define PCA_SUFFIX "_pca"
+
+#define PC_CHUNK_SIZE (BLCKSZ / 8)
+#define PC_MAX_CHUNKS (BLCKSZ / PC_CHUNK_SIZE)
+
+#define PC_MAGIC 0x70636131 /* "pca1" */
+
+/* values of the compresstype reloption, and of PageCompressHeader.algorithm */
+#define PAGE_COMPRESS_NONE 0
+#define PAGE_COMPRESS_LZ4 1
+
+typedef struct PageCompressHeader {
+    uint32 magic;
+    uint32 algorithm;
+    pg_atomic_uint32 nblocks;          /* blocks in the segment */
+    pg_atomic_uint32 allocated_chunks; /* chunks handed out in the segment file */
+} PageCompressHeader;
+
+typedef struct PageCompressAddr {
+    uint8 nchunks;          /* chunks holding the current image, 0 for a zero page */
+    uint8 allocated_chunks; /* chunks owned by the block */
+    uint16 reserved;
+    uint32 chunknos[PC_MAX_CHUNKS]; /* chunk numbers, counting from 1 */
+} PageCompressAddr;
+
+/*
+ * A compressed image starts with its length. An image that does not save at
+ * least one chunk is stored as is, in PC_MAX_CHUNKS chunks.
+ */
+typedef struct PageCompressData {
+    uint32 size;
+    char data[FLEXIBLE_ARRAY_MEMBER];
+} PageCompressData;
+
+#define SizeOfPageCompressHeader MAXALIGN(sizeof(PageCompressHeader))
+#define SizeOfPageCompressAddrFile \
+    (SizeOfPageCompressHeader + sizeof(PageCompressAddr) * (Size)RELSEG_SIZE)
+
+#define GetPageCompressAddr(map, blkno) \
+    ((PageCompressAddr*)((char*)(map) + SizeOfPageCompressHeader) + ((blkno) % ((BlockNumber)RELSEG_SIZE)))
+
+#define PageCompressChunkOffset(chunkno) ((off_t)((chunkno) - 1) * PC_CHUNK_SIZE)
+
+extern uint8 PageCompressAlgorithmByName(const char* name);
+extern int PageCompressPage(const char* page, char* dst, uint8 algorithm);
+extern bool PageDecompressPage(const char* src, int nchunks, char* page);
+
+extern char* PageCompressAddrFilePath(const char* segpath);
+extern PageCompressHeader* PageCompressMapAddrFile(const char* segpath, bool create, uint8 algorithm);
+extern void PageCompressUnmapAddrFile(PageCompressHeader* map);
+extern int PageCompressSyncAddrFile(PageCompressHeader* map);
+extern bool IsPageCompressedFile(const char* path);
+
+#endif /* PAGE_COMPRESSION_H */
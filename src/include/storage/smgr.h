@@ -64,6 +64,13 @@ typedef struct SMgrRelationData {
     int smgr_bcmarry_size;
     BlockNumber* smgr_bcm_nblocks; /* last known size of bcm fork */
 
+    /*
+     * Page compression algorithm of the main fork, set by the relcache from
+     * the reloptions. SMGR_COMPRESS_UNKNOWN makes md.cpp look for an address
+     * file instead.
+     */
+    uint8 smgr_compress;
+
     /* additional public fields may someday exist here */
 
     /*
@@ -89,6 +96,8 @@ typedef SMgrRelationData* SMgrRelation;
 
 #define SmgrIsTemp(smgr) RelFileNodeBackendIsTemp((smgr)->smgr_rnode)
 
+#define SMGR_COMPRESS_UNKNOWN 0xFF
+
 extern void smgrinit(void);
 extern SMgrRelation smgropen(const RelFileNode& rnode, BackendId backend, int col = 0, const oidvector* bucketlist  = NULL);
 extern bool smgrexists(SMgrRelation reln, ForkNumber forknum);
@@ -98,9 +107,11 @@ extern void smgrclose(SMgrRelation reln);
 extern void smgrcloseall(void);
 extern void smgrclosenode(const RelFileNodeBackend& rnode);
 extern void smgrcreate(SMgrRelation reln, ForkNumber forknum, bool isRedo );
+extern void smgrcreatecompressed(SMgrRelation reln, uint8 algorithm, bool isRedo);
 extern void smgrdounlink(SMgrRelation reln, bool isRedo);
 extern void smgrdounlinkfork(SMgrRelation reln, ForkNumber forknum, bool isRedo);
 extern void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern void smgrzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, int nblocks, bool skipFsync);
 extern void smgrprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern bool smgrread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void smgrwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
@@ -121,11 +132,13 @@ extern void AtEOXact_SMgr(void);
 extern void mdinit(void);
 extern void mdclose(SMgrRelation reln, ForkNumber forknum);
 extern void mdcreate(SMgrRelation reln, ForkNumber forknum, bool isRedo);
+extern void mdcreatecompressed(SMgrRelation reln, uint8 algorithm, bool isRedo);
 extern void smgrcreatebuckets(SMgrRelation reln, ForkNumber forknum, bool isRedo);
 
 extern bool mdexists(SMgrRelation reln, ForkNumber forknum);
 extern void mdunlink(const RelFileNodeBackend& rnode, ForkNumber forknum, bool isRedo);
 extern void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern void mdzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, int nblocks, bool skipFsync);
 extern void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern bool mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
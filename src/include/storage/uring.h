@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * uring.h
+ *        io_uring submission layer beneath the virtual file descriptors of fd.cpp
+ *
+ * Every thread owns one ring, created on first use when enable_uring_io is on. Requests
+ * are queued on the ring and handed to the kernel in a single io_uring_enter() call per
+ * batch. Only fsyncs, writeback flushes and prefetch hints are queued; reads and writes
+ * stay synchronous.
+ *
+ * IDENTIFICATION
+ *        src/include/storage/uring.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef URING_H
+#define URING_H
+
+#include "storage/fd.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define USE_URING
+#endif
+#endif
+
+extern bool UringEnabled(void);
+extern bool UringQueue(FileIORequest* req, bool wait);
+extern void UringSubmitPending(void);
+extern void UringWaitAll(void);
+
+#endif /* URING_H */
@@ -324,6 +324,7 @@ typedef struct StdRdOptions {
     char* string_optimize; /* string optimize for streaming contquery table */
     char* version;
     char* wait_clean_gpi; /* pg_partition system catalog wait gpi-clean or not */
+    char* compresstype; /* page compression algorithm of a row table */
     /* item for online expand */
     char* append_mode;
     char* start_ctid_internal;
@@ -471,6 +472,7 @@ typedef struct StdRdOptions {
                 bucketlist = searchHashBucketByOid(relation->rd_bucketoid);                        \
             }                                                                                            \
             smgrsetowner(&((relation)->rd_smgr), smgropen((relation)->rd_node, (relation)->rd_backend, 0, bucketlist)); \
+            RelationInitSmgrCompress(relation);                                                          \
             }                                                                                             \
     } while (0)
 
@@ -52,6 +52,7 @@ typedef enum {
 #include "catalog/pg_hashbucket.h"
 #include "catalog/catalog.h"
 #include "catalog/pg_namespace.h"
+#include "storage/page_compression.h"
 #include "utils/partitionmap_gs.h"
 #include "rel.h"
 
@@ -211,6 +212,21 @@ typedef struct RelationMetaData {
 #define RelationIsTableAccessMethodUStoreType(_reloptions) \
     pg_strcasecmp(RelationGetTableAccessMethodType(_reloptions), TABLE_ACCESS_METHOD_USTORE) == 0
 
+/*
+ * RelationGetPageCompressType
+ * 	Returns the compresstype option, the page compression algorithm of a row table
+ */
+#define RelationGetPageCompressType(_reloptions) \
+    StdRdOptionsGetStringData(_reloptions, compresstype, "none")
+
+/*
+ * RelationGetPageCompress
+ * 	Returns the page compression algorithm of a relation, PAGE_COMPRESS_NONE if it has none
+ */
+#define RelationGetPageCompress(relation)                                                                 \
+    (((relation)->rd_rel->relkind == RELKIND_RELATION)                                                   \
+         ? PageCompressAlgorithmByName(RelationGetPageCompressType((relation)->rd_options))              \
+         : PAGE_COMPRESS_NONE)
 
 /*
  * @Description: get TableAmType type from Relation's reloptions data.
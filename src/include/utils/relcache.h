@@ -122,6 +122,7 @@ extern void RelationCacheInvalidate(void);
 extern void RelationCacheInvalidateBuckets();
 
 extern void RelationCloseSmgrByOid(Oid relationId);
+extern void RelationInitSmgrCompress(Relation relation);
 extern Oid  RelationGetBucketOid(Relation relation);
 
 extern void AtEOXact_RelationCache(bool isCommit);
@@ -26,6 +26,7 @@
 #ifndef SRC_INCLUDE_VECTORSONIC_VSONICHASHJOIN_H_
 #define SRC_INCLUDE_VECTORSONIC_VSONICHASHJOIN_H_
 
+#include "utils/atomic.h"
 #include "vectorsonic/vsonichash.h"
 #include "vectorsonic/vsonicpartition.h"
 
@@ -42,6 +43,25 @@ struct BatchPos {
     int rowIdx;
 };
 
+typedef enum {
+    SONIC_SHARED_HASH_INIT = 0, /* no thread has started the build */
+    SONIC_SHARED_HASH_BUILDING, /* one thread is building the table */
+    SONIC_SHARED_HASH_DONE      /* the table is built and may be probed */
+} SonicSharedHashStatus;
+
+/*
+ * Build side hash table shared by the smp threads of a Sonic hash join.
+ * It lives in the stream node group, so it outlives the thread that built it.
+ */
+struct SonicSharedHashTable {
+    int plan_node_id;
+    pg_atomic_uint32 status; /* a SonicSharedHashStatus */
+    pg_atomic_uint32 nusers; /* threads that may still probe the table */
+    MemoryContext context;   /* shared context holding the table */
+    SonicHashMemPartition* partition;
+    int64 rows;
+};
+
 class SonicHashJoin : public SonicHash {
 public:
     SonicHashJoin(int size, VecHashJoinState* node);
@@ -68,6 +88,15 @@ private:
 
     void initHashFmgr();
 
+    bool sharedBuildEnable();
+
+    /* shared build functions */
+    void initSharedBuild();
+
+    void attachSharedHashTable();
+
+    void releaseSharedHashTable();
+
     /* binding function pointer. */
     template <bool complicateJoinKey>
     void bindingFp();
@@ -97,6 +126,8 @@ private:
 
     void judgeMemoryOverflow(uint64 hash_head_size);
 
+    void judgeSharedMemoryOverflow(uint64 hash_head_size);
+
     void calcHashContextSize(MemoryContext ctx, uint64* allocateSize, uint64* freeSize);
 
     void calcDatumArrayExpandSize();
@@ -216,6 +247,9 @@ private:
     /* runtime state */
     VecHashJoinState* m_runtime;
 
+    /* hash table shared by the smp threads, NULL if every thread builds its own */
+    SonicSharedHashTable* m_sharedTable;
+
     /* where we put data */
     char* m_next;
 
@@ -0,0 +1,54 @@
+#!/bin/sh
+
+source ./util.sh
+
+# update churn from short sessions, so that sessions leave the GC while the reclaimer serves them
+function churn() {
+  for i in $(seq 1 50)
+  do
+    gsql -d $db -p $dn1_primary_port -c "update gc_t1 set val = val + 1 where id % 8 = $1;" > /dev/null 2>&1
+    gsql -d $db -p $dn1_primary_port -c "delete from gc_t2 where id % 8 = $1; insert into gc_t2 select id, 'row ' || id from gc_t1 where id % 8 = $1;" > /dev/null 2>&1
+  done
+}
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_mot_conf "enable_background_reclaim" "true"
+  set_mot_conf "background_reclaim_interval" "1 ms"
+  start_cluster
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists gc_t1; create FOREIGN table gc_t1(id int primary key, val int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists gc_t2; create FOREIGN table gc_t2(id int primary key, txt varchar(100)) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into gc_t1 select generate_series(1, 8000), 0;"
+  gsql -d $db -p $dn1_primary_port -c "insert into gc_t2 select generate_series(1, 8000), 'row';"
+
+  for i in 0 1 2 3 4 5 6 7
+  do
+    churn $i &
+  done
+  wait
+
+  check_result $dn1_primary_port "select count(*), sum(val) from gc_t1;" "8000|400000"
+  check_result $dn1_primary_port "select count(*), count(distinct txt) from gc_t2;" "8000|8000"
+
+  # the server keeps serving after the churn, and restarts cleanly
+  kill_primary
+  start_primary
+  check_result $dn1_primary_port "select count(*), sum(val) from gc_t1;" "8000|400000"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists gc_t1;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists gc_t2;"
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
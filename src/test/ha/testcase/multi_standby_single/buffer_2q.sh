@@ -0,0 +1,87 @@
+#!/bin/sh
+# under buffer_replacement_policy = 2q, pages read once by a large scan are evicted before the
+# repeatedly used working set, so the working set stays resident across the scan
+
+source ./util.sh
+
+function set_policy() {
+  # $1 clock or 2q, $2 shared_buffers
+  kill_cluster
+  gs_guc set -Z datanode -D $primary_data_dir -c "buffer_replacement_policy = $1"
+  gs_guc set -Z datanode -D $primary_data_dir -c "shared_buffers = $2"
+  start_cluster
+}
+
+function read_hot() {
+  check_result $dn1_primary_port "set enable_seqscan = off; select count(*), sum(val) from q_hot where id > 0;" "20000|200010000"
+}
+
+function read_cold() {
+  # index scan, so the pages go through the shared buffer policy instead of a bulk read ring
+  check_result $dn1_primary_port "set enable_seqscan = off; set enable_bitmapscan = off; select count(*) from q_cold where id > 0;" "400000"
+}
+
+function stat_value() {
+  gsql -d $db -p $dn1_primary_port -m -t -A -c "select $1 from local_buffer_strategy_stat();"
+}
+
+function test_1()
+{
+  set_default
+  set_policy 2q 32MB
+  check_detailed_instance
+  check_result $dn1_primary_port "select policy from local_buffer_strategy_stat();" "2q"
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists q_hot; create table q_hot(id int, val int, pad char(200));"
+  gsql -d $db -p $dn1_primary_port -c "insert into q_hot select g, g, 'x' from generate_series(1, 20000) g;"
+  gsql -d $db -p $dn1_primary_port -c "create index q_hot_id on q_hot (id);"
+  # about three times shared_buffers
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists q_cold; create table q_cold(id int, pad char(200));"
+  gsql -d $db -p $dn1_primary_port -c "insert into q_cold select g, 'x' from generate_series(1, 400000) g;"
+  gsql -d $db -p $dn1_primary_port -c "create index q_cold_id on q_cold (id);"
+
+  # a working set referenced again and again is promoted to the protected queue
+  for i in 1 2 3 4 5
+  do
+    read_hot
+  done
+  if [ $(stat_value "protected_hits") -le 0 ]; then
+    echo "protected queue $failed_keyword"
+    exit 1
+  fi
+
+  read_cold
+  if [ $(stat_value "probation_evictions") -le 0 ]; then
+    echo "probation eviction $failed_keyword"
+    exit 1
+  fi
+  if [ $(stat_value "protected_percent between 0 and 100") != "t" ]; then
+    echo "protected percent $failed_keyword"
+    exit 1
+  fi
+
+  # the working set survived the scan: rereading it misses on a small part of its pages only
+  misses_before=$(stat_value "misses")
+  read_hot
+  misses_after=$(stat_value "misses")
+  echo "working set misses after the scan: $((misses_after - misses_before))"
+  if [ $((misses_after - misses_before)) -ge 300 ]; then
+    echo "scan resistance $failed_keyword"
+    exit 1
+  fi
+
+  # the default policy gives the same data and keeps no counters
+  set_policy clock 2GB
+  read_hot
+  read_cold
+  check_result $dn1_primary_port "select policy, protected_hits, ghost_hits from local_buffer_strategy_stat();" "clock|0|0"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists q_hot; DROP TABLE if exists q_cold;"
+}
+
+test_1
+tear_down
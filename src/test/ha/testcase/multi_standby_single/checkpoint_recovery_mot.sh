@@ -0,0 +1,59 @@
+#!/bin/sh
+
+source ./util.sh
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_mot_conf "checkpoint_recovery_workers" "4"
+  start_cluster
+  check_detailed_instance
+
+  # one table larger than a checkpoint segment (16MB) and several small ones, so that recovery
+  # has more segment tasks than workers
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists ckpt_big; create FOREIGN table ckpt_big(id int primary key, val int, pad char(200)) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into ckpt_big select generate_series(1, 200000), 1, 'x';"
+  for i in 1 2 3 4 5 6
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists ckpt_small$i; create FOREIGN table ckpt_small$i(id int primary key, val text) SERVER mot_server;"
+    gsql -d $db -p $dn1_primary_port -c "insert into ckpt_small$i select generate_series(1, 1000), 'v' || $i;"
+  done
+  gsql -d $db -p $dn1_primary_port -c "delete from ckpt_big where id % 10 = 0;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # restart the primary from the checkpoint only
+  kill_primary
+  start_primary
+
+  check_result $dn1_primary_port "select count(*), sum(id) from ckpt_big where pad = 'x';" "180000|18000000000"
+  check_result $dn1_primary_port "select count(*) from ckpt_big where id = 10;" "0"
+  check_result $dn1_primary_port "select val from ckpt_big where id = 199999;" "1"
+  for i in 1 2 3 4 5 6
+  do
+    check_result $dn1_primary_port "select count(*), sum(id), max(val) from ckpt_small$i;" "1000|500500|v$i"
+  done
+
+  # the primary key of the recovered rows is usable
+  gsql -d $db -p $dn1_primary_port -c "insert into ckpt_big values (1, 0, 'y');" 2>&1 | grep "duplicate key"
+  if [ $? -ne 0 ]; then
+    echo "unique check after recovery $failed_keyword"
+    exit 1
+  fi
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists ckpt_big;"
+  for i in 1 2 3 4 5 6
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists ckpt_small$i;"
+  done
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
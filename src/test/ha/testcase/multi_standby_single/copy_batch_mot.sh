@@ -0,0 +1,61 @@
+#!/bin/sh
+
+source ./util.sh
+
+function copy_rows() {
+  # $1 first id, $2 last id
+  seq $1 $2 | awk '{print $1 "," $1 % 10}' | gsql -d $db -p $dn1_primary_port -c "copy copy_t1 from stdin delimiter ',';"
+}
+
+function test_batch_size()
+{
+  # $1 bulk_insert_batch_size
+  kill_cluster
+  reset_mot_conf
+  set_mot_conf "bulk_insert_batch_size" "$1"
+  start_cluster
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists copy_t1; create FOREIGN table copy_t1(id int primary key, val int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "create index copy_t1_val on copy_t1 (val);"
+  copy_rows 1 1000
+  check_result $dn1_primary_port "select count(*), sum(id), sum(val) from copy_t1;" "1000|500500|4500"
+  check_result $dn1_primary_port "select count(*) from copy_t1 where val = 3;" "100"
+
+  # a duplicate key fails the whole COPY, both inside a batch and against committed rows
+  printf "2001,1\n2002,2\n2001,3\n" | gsql -d $db -p $dn1_primary_port -c "copy copy_t1 from stdin delimiter ',';"
+  copy_rows 990 1010
+  check_result $dn1_primary_port "select count(*) from copy_t1;" "1000"
+
+  # rows of a rolled back COPY are discarded
+  seq 3001 3500 | awk '{print $1 "," $1 % 10}' > ./copy_t1.csv
+  gsql -d $db -p $dn1_primary_port -c "start transaction; copy copy_t1 from '$(pwd)/copy_t1.csv' delimiter ','; rollback;"
+  check_result $dn1_primary_port "select count(*) from copy_t1;" "1000"
+  gsql -d $db -p $dn1_primary_port -c "copy copy_t1 from '$(pwd)/copy_t1.csv' delimiter ',';"
+  rm -f ./copy_t1.csv
+  check_result $dn1_primary_port "select count(*), sum(id) from copy_t1;" "1500|2125750"
+
+  sleep 5
+  check_result $dn1_standby_port "select count(*), sum(id) from copy_t1;" "1500|2125750"
+  check_result $dn1_standby_port "select count(*) from copy_t1 where val = 3;" "150"
+}
+
+function test_1()
+{
+  set_default
+  # a batch size of 1 disables batching, 7 leaves a partial last batch
+  test_batch_size 1
+  test_batch_size 7
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists copy_t1;"
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
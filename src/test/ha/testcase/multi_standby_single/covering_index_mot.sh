@@ -0,0 +1,42 @@
+#!/bin/sh
+
+source ./util.sh
+
+function check_indexes() {
+  # $1 port
+  check_result $1 "select count(*), count(b) from cov_t1 where a = 7;" "10|8"
+  check_result $1 "select string_agg(b, ',' order by b) from cov_t1 where a = 3 and b < 'b3';" "b103"
+  check_result $1 "select count(*) from cov_t1 where c = 55;" "1"
+  check_result $1 "select count(*), count(d) from cov_t1 where e = 4;" "100|100"
+}
+
+function test_1()
+{
+  set_default
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists cov_t1; create FOREIGN table cov_t1(id int primary key, a int not null, b varchar(20), c int, d int, e int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into cov_t1 select g, g % 100, case when g % 7 = 0 then null else 'b' || g end, g, g, g % 10 from generate_series(1, 1000) g;"
+  # a covering index and a plain index, both written to the checkpoint
+  gsql -d $db -p $dn1_primary_port -c "create index cov_t1_a on cov_t1 (a) include (b);"
+  gsql -d $db -p $dn1_primary_port -c "create index cov_t1_c on cov_t1 (c);"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  # a covering index created after the checkpoint is recovered from the redo of CREATE INDEX
+  gsql -d $db -p $dn1_primary_port -c "create index cov_t1_e on cov_t1 (e) include (d);"
+
+  sleep 5
+  check_indexes $dn1_standby_port
+
+  kill_primary
+  start_primary
+  check_indexes $dn1_primary_port
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists cov_t1;"
+}
+
+test_1
+tear_down
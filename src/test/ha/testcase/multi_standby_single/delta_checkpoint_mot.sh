@@ -0,0 +1,74 @@
+#!/bin/sh
+
+source ./util.sh
+
+function check_contents() {
+  check_result $dn1_primary_port "select count(*), sum(id), sum(val) from delta_t1;" "8000|44004000|6001"
+  check_result $dn1_primary_port "select count(*) from delta_t1 where id between 2001 and 4000;" "0"
+  check_result $dn1_primary_port "select val from delta_t1 where id = 9999;" "3"
+  check_result $dn1_primary_port "select count(*) from delta_t2;" "0"
+  check_result $dn1_primary_port "select count(*), max(val) from delta_t3;" "100|new"
+}
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_mot_conf "enable_delta_checkpoint" "true"
+  set_mot_conf "max_delta_checkpoints" "3"
+  start_cluster
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t1; create FOREIGN table delta_t1(id int primary key, val int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t2; create FOREIGN table delta_t2(id int primary key) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t3; create FOREIGN table delta_t3(id int primary key, val text) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t1 select generate_series(1, 8000), 0;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t2 select generate_series(1, 500);"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t3 select generate_series(1, 100), 'old';"
+  # full checkpoint
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # first delta: updates, deletes and inserts
+  gsql -d $db -p $dn1_primary_port -c "update delta_t1 set val = 1 where id <= 2000;"
+  gsql -d $db -p $dn1_primary_port -c "delete from delta_t1 where id between 2001 and 4000;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t1 select generate_series(8001, 10000), 2;"
+  gsql -d $db -p $dn1_primary_port -c "delete from delta_t2;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # second delta: a key deleted and inserted again, a truncated table
+  gsql -d $db -p $dn1_primary_port -c "delete from delta_t1 where id = 9999;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t1 values (9999, 3);"
+  gsql -d $db -p $dn1_primary_port -c "update delta_t1 set val = 2 where id = 9998;"
+  gsql -d $db -p $dn1_primary_port -c "truncate delta_t3;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_t3 select generate_series(1, 100), 'new';"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # recover from the full checkpoint and both deltas
+  kill_primary
+  start_primary
+  check_contents
+
+  # more checkpoints than max_delta_checkpoints roll over to a new full checkpoint
+  for i in 1 2 3 4
+  do
+    gsql -d $db -p $dn1_primary_port -c "update delta_t1 set val = val where id = $i;"
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  done
+  kill_primary
+  start_primary
+  check_contents
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t1;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t2;"
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_t3;"
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
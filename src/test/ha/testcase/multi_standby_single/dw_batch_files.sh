@@ -0,0 +1,72 @@
+#!/bin/sh
+# each page writer thread double writes through its own batch file, global/pg_dw and global/pg_dw_<n>
+
+source ./util.sh
+
+function set_pagewriters() {
+  # $1 pagewriter_thread_num
+  kill_cluster
+  gs_guc set -Z datanode -D $primary_data_dir -c "enable_incremental_checkpoint = on"
+  gs_guc set -Z datanode -D $primary_data_dir -c "enable_double_write = on"
+  gs_guc set -Z datanode -D $primary_data_dir -c "pagewriter_thread_num = $1"
+  start_cluster
+}
+
+function check_dw_files() {
+  # $1 expected number of batch files
+  if [ -f $primary_data_dir/global/pg_dw ] && [ $(ls $primary_data_dir/global | grep -c "^pg_dw_[0-9]*$") -eq $(($1 - 1)) ]; then
+    echo "check success: $1 batch dw files"
+  else
+    echo "check $failed_keyword: $1 batch dw files, found $(ls $primary_data_dir/global | grep "^pg_dw")"
+    exit 1
+  fi
+}
+
+function update_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "update dw_t1 set val = val + 1 where id % 4 = $1;" > /dev/null 2>&1
+  done
+}
+
+function test_1()
+{
+  set_default
+  set_pagewriters 4
+  check_detailed_instance
+  check_dw_files 4
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists dw_t1; create table dw_t1(id int, val int, pad char(500));"
+  gsql -d $db -p $dn1_primary_port -c "insert into dw_t1 select g, 0, 'x' from generate_series(1, 100000) g;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  for i in 0 1 2 3
+  do
+    update_workload $i &
+  done
+  wait
+  check_result $dn1_primary_port "select count(*), sum(val) from dw_t1;" "100000|2000000"
+  # the dw statistics sum over all batch files
+  check_result $dn1_primary_port "select total_writes > 0 from local_double_write_stat();" "t"
+
+  # pages torn by the crash are restored from every batch file
+  kill_primary
+  start_primary
+  check_result $dn1_primary_port "select count(*), sum(val) from dw_t1;" "100000|2000000"
+  check_dw_files 4
+
+  # files beyond the new thread count are recovered, then removed; 2 is also the default
+  set_pagewriters 2
+  check_dw_files 2
+  check_result $dn1_primary_port "select count(*), sum(val) from dw_t1;" "100000|2000000"
+  sleep 5
+  check_result $dn1_standby_port "select count(*), sum(val) from dw_t1;" "100000|2000000"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists dw_t1;"
+}
+
+test_1
+tear_down
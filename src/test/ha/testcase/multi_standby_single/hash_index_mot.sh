@@ -0,0 +1,70 @@
+#!/bin/sh
+
+source ./util.sh
+
+function check_count() {
+  # $1 port, $2 query, $3 expected value
+  if [ $(gsql -d $db -p $1 -m -t -A -c "$2") -eq $3 ]; then
+    echo "check success: $2"
+  else
+    echo "check $failed_keyword: $2, expected $3"
+    exit 1
+  fi
+}
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_mot_conf "enable_hash_primary_index" "true"
+  set_mot_conf "hash_index_bucket_count" "1024"
+  start_cluster
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists hash_t1; create FOREIGN table hash_t1(id int primary key, val int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into hash_t1 select generate_series(1, 5000), 0;"
+  check_count $dn1_primary_port "select count(*) from hash_t1;" 5000
+
+  # a full scan of a hash index must stop at the last key present when the scan started,
+  # otherwise inserting into the scanned table never terminates
+  timeout 60 gsql -d $db -p $dn1_primary_port -c "insert into hash_t1 select id + 5000, val + 1 from hash_t1;"
+  if [ $? -ne 0 ]; then
+    echo "self insert $failed_keyword"
+    exit 1
+  fi
+  check_count $dn1_primary_port "select count(*) from hash_t1;" 10000
+  check_count $dn1_primary_port "select count(*) from hash_t1 where val = 1;" 5000
+
+  # point lookups, updates and deletes by exact key
+  check_count $dn1_primary_port "select val from hash_t1 where id = 7777;" 1
+  gsql -d $db -p $dn1_primary_port -c "update hash_t1 set val = 2 where id = 42;"
+  check_count $dn1_primary_port "select val from hash_t1 where id = 42;" 2
+  gsql -d $db -p $dn1_primary_port -c "delete from hash_t1 where id > 9000;"
+  check_count $dn1_primary_port "select count(*) from hash_t1;" 9000
+  check_count $dn1_primary_port "select count(*) from hash_t1 where id = 9500;" 0
+
+  # duplicate keys are still rejected
+  gsql -d $db -p $dn1_primary_port -c "insert into hash_t1 values (1, 0);" 2>&1 | grep "duplicate key"
+  if [ $? -ne 0 ]; then
+    echo "unique check $failed_keyword"
+    exit 1
+  fi
+
+  # range predicates on the primary key fall back to a full scan
+  check_count $dn1_primary_port "select count(*) from hash_t1 where id between 100 and 199;" 100
+
+  sleep 2
+  check_count $dn1_standby_port "select count(*) from hash_t1;" 9000
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists hash_t1;"
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
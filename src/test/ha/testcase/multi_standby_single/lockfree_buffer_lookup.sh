@@ -0,0 +1,79 @@
+#!/bin/sh
+# shared buffer lookups go through the lock-free hint table when enable_lockfree_buffer_lookup is on;
+# a small shared_buffers keeps evicting and retagging buffers, so stale hints are hit all the time
+
+source ./util.sh
+
+function set_lookup() {
+  # $1 on or off, $2 shared_buffers
+  kill_cluster
+  for element in $primary_data_dir $standby_data_dir
+  do
+    gs_guc set -Z datanode -D $element -c "enable_lockfree_buffer_lookup = $1"
+    gs_guc set -Z datanode -D $element -c "shared_buffers = $2"
+  done
+  start_cluster
+}
+
+function update_workload() {
+  for i in $(seq 1 50)
+  do
+    gsql -d $db -p $dn1_primary_port -c "update lf_t1 set val = val + 1 where id % 100 = $1;" > /dev/null 2>&1
+  done
+}
+
+function read_workload() {
+  for i in $(seq 1 50)
+  do
+    # index lookups of pages that are resident, evicted or being read in by other sessions
+    if [ "$(gsql -d $db -p $dn1_primary_port -m -t -A -c "select count(*) from lf_t1 where id between $i * 1000 and $i * 1000 + 999;")" != "1000" ]; then
+      echo "read $failed_keyword" >> ./results/lockfree_buffer_lookup.err
+    fi
+    gsql -d $db -p $dn1_primary_port -c "select count(*) from lf_t2;" > /dev/null 2>&1
+  done
+}
+
+function test_1()
+{
+  set_default
+  set_lookup on 32MB
+  check_detailed_instance
+  check_result $dn1_primary_port "show enable_lockfree_buffer_lookup;" "on"
+  rm -f ./results/lockfree_buffer_lookup.err
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists lf_t1; create table lf_t1(id int, val int, pad char(200));"
+  gsql -d $db -p $dn1_primary_port -c "insert into lf_t1 select g, 0, 'x' from generate_series(0, 99999) g;"
+  gsql -d $db -p $dn1_primary_port -c "create index lf_t1_id on lf_t1 (id);"
+  # larger than shared_buffers, scanned to push the pages of lf_t1 out
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists lf_t2; create table lf_t2(id int, pad char(500));"
+  gsql -d $db -p $dn1_primary_port -c "insert into lf_t2 select g, 'x' from generate_series(1, 100000) g;"
+
+  for i in 1 2 3 4
+  do
+    update_workload $i &
+    read_workload &
+  done
+  wait
+
+  if [ -f ./results/lockfree_buffer_lookup.err ]; then
+    echo "concurrent lookups $failed_keyword"
+    exit 1
+  fi
+  check_result $dn1_primary_port "select count(*), sum(val) from lf_t1;" "100000|200000"
+  check_result $dn1_primary_port "select sum(val) from lf_t1 where id % 100 in (1, 2, 3, 4);" "200000"
+  sleep 5
+  check_result $dn1_standby_port "select count(*), sum(val) from lf_t1;" "100000|200000"
+
+  # the same pages through the locked lookup only
+  set_lookup off 2GB
+  check_result $dn1_primary_port "select count(*), sum(val) from lf_t1;" "100000|200000"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists lf_t1; DROP TABLE if exists lf_t2;"
+}
+
+test_1
+tear_down
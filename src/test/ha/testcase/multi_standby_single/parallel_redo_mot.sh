@@ -0,0 +1,90 @@
+#!/bin/sh
+
+source ./util.sh
+
+# workload on one table, so that its transactions are dispatched to a single replay worker
+function table_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "update redo_t$1 set val = val + 1 where id % 20 = $i % 20;" > /dev/null 2>&1
+    gsql -d $db -p $dn1_primary_port -c "delete from redo_t$1 where id = $i; insert into redo_t$1 values ($i, 1000 + $i);" > /dev/null 2>&1
+  done
+}
+
+# transactions spanning two tables and DDL, which are replayed serially
+function cross_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "start transaction; update redo_t1 set val = val - 1 where id = 500 + $i; update redo_t2 set val = val + 1 where id = 500 + $i; commit;" > /dev/null 2>&1
+  done
+  gsql -d $db -p $dn1_primary_port -c "create index redo_t3_val on redo_t3 (val);" > /dev/null 2>&1
+}
+
+function table_digest() {
+  # $1 port, $2 table
+  gsql -d $db -p $1 -m -t -A -c "select count(*) || ':' || sum(id) || ':' || sum(val) from $2;"
+}
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_mot_conf "redo_replay_workers" "4"
+  start_cluster
+  check_detailed_instance
+
+  for t in 1 2 3 4
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists redo_t$t; create FOREIGN table redo_t$t(id int primary key, val int) SERVER mot_server;"
+    gsql -d $db -p $dn1_primary_port -c "insert into redo_t$t select generate_series(1, 2000), 0;"
+  done
+
+  for t in 1 2 3 4
+  do
+    table_workload $t &
+  done
+  cross_workload &
+  wait
+  gsql -d $db -p $dn1_primary_port -c "drop foreign table redo_t4;"
+
+  sleep 10
+  for t in 1 2 3
+  do
+    primary_digest=$(table_digest $dn1_primary_port redo_t$t)
+    standby_digest=$(table_digest $dn1_standby_port redo_t$t)
+    if [ "$primary_digest" == "$standby_digest" ]; then
+      echo "redo_t$t replayed: $standby_digest"
+    else
+      echo "redo_t$t replay $failed_keyword: primary $primary_digest standby $standby_digest"
+      exit 1
+    fi
+  done
+  if [ $(gsql -d $db -p $dn1_standby_port -m -t -A -c "select count(*) from pg_class where relname = 'redo_t3_val';") -ne 1 ]; then
+    echo "create index replay $failed_keyword"
+    exit 1
+  fi
+
+  # crash recovery replays with the same workers
+  expected_digest=$(table_digest $dn1_primary_port redo_t1)
+  kill_primary
+  start_primary
+  if [ "$(table_digest $dn1_primary_port redo_t1)" != "$expected_digest" ]; then
+    echo "crash recovery replay $failed_keyword"
+    exit 1
+  fi
+}
+
+function tear_down()
+{
+  sleep 1
+  for t in 1 2 3 4
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists redo_t$t;"
+  done
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,63 @@
+#!/bin/sh
+
+source ./util.sh
+
+# prints the number of WAL bytes generated by a fixed MOT workload on the primary
+function redo_bytes() {
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists redo_t1; create FOREIGN table redo_t1(id int primary key, val int, txt text) SERVER mot_server;" > /dev/null
+  start_lsn=$(gsql -d $db -p $dn1_primary_port -m -t -A -c "select pg_current_xlog_location();")
+  gsql -d $db -p $dn1_primary_port -c "insert into redo_t1 select generate_series(1, 20000), 0, repeat('abcdefgh', 64);" > /dev/null
+  gsql -d $db -p $dn1_primary_port -c "update redo_t1 set val = 1, txt = repeat('ijklmnop', 64) where id % 2 = 0;" > /dev/null
+  gsql -d $db -p $dn1_primary_port -c "delete from redo_t1 where id % 4 = 0;" > /dev/null
+  gsql -d $db -p $dn1_primary_port -m -t -A -c "select pg_xlog_location_diff(pg_current_xlog_location(), '$start_lsn');"
+}
+
+function check_contents() {
+  # $1 port
+  check_result $1 "select count(*), sum(id), sum(val) from redo_t1;" "15000|150000000|5000"
+  check_result $1 "select count(*) from redo_t1 where txt = repeat('ijklmnop', 64);" "5000"
+  check_result $1 "select count(*) from redo_t1 where id % 4 = 0;" "0"
+}
+
+function test_1()
+{
+  set_default
+  check_detailed_instance
+  plain_bytes=$(redo_bytes)
+  echo "redo bytes without compression: $plain_bytes"
+
+  kill_cluster
+  set_mot_conf "enable_redo_log_compression" "true"
+  start_cluster
+  check_detailed_instance
+  compressed_bytes=$(redo_bytes)
+  echo "redo bytes with compression: $compressed_bytes"
+
+  if [ $(($compressed_bytes * 2)) -lt $plain_bytes ]; then
+    echo "redo compression success"
+  else
+    echo "redo compression $failed_keyword"
+    exit 1
+  fi
+
+  # the standby replays compressed records
+  sleep 5
+  check_contents $dn1_standby_port
+
+  # crash recovery replays compressed records
+  kill_primary
+  start_primary
+  check_contents $dn1_primary_port
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists redo_t1;"
+  kill_cluster
+  reset_mot_conf
+  start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,72 @@
+#!/bin/sh
+# with recovery_prefetch_distance, the parallel redo dispatcher prefetches the data blocks of the
+# records it decodes; the standby, started with cold buffers, must replay to the same data
+
+source ./util.sh
+
+function set_prefetch() {
+  # $1 recovery_prefetch_distance
+  kill_cluster
+  gs_guc set -Z datanode -D $standby_data_dir -c "recovery_max_workers = 4"
+  gs_guc set -Z datanode -D $standby_data_dir -c "recovery_prefetch_distance = $1"
+  start_cluster
+}
+
+function update_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "update pf_t1 set val = val + 1 where id % 97 = ($1 * 20 + $i) % 97;" > /dev/null 2>&1
+  done
+}
+
+function test_1()
+{
+  set_default
+  set_prefetch 64
+  check_detailed_instance
+  check_result $dn1_standby_port "select distance from local_redo_prefetch_stat();" "64"
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_t1; create table pf_t1(id int, val int, pad char(200));"
+  gsql -d $db -p $dn1_primary_port -c "insert into pf_t1 select g, 0, 'x' from generate_series(1, 200000) g;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # restart the standby so the blocks the updates touch are not in its buffers
+  kill_standby
+  start_standby
+  for i in 1 2 3 4
+  do
+    update_workload $i &
+  done
+  # records that drop relation files between prefetched blocks
+  for i in $(seq 1 10)
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_drop; create table pf_drop(id int); insert into pf_drop select generate_series(1, 10000);" > /dev/null 2>&1
+  done
+  wait
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_drop;"
+
+  expected=$(gsql -d $db -p $dn1_primary_port -m -t -A -c "select count(*) || '|' || sum(val) from pf_t1;")
+  sleep 10
+  check_result $dn1_standby_port "select count(*) || '|' || sum(val) from pf_t1;" "$expected"
+  check_result $dn1_standby_port "select misses > 0, hits + misses + skips > 0 from local_redo_prefetch_stat();" "t|t"
+
+  # nothing is prefetched with the default distance
+  set_prefetch 0
+  gsql -d $db -p $dn1_primary_port -c "update pf_t1 set val = val + 1 where id % 97 = 0;"
+  sleep 5
+  check_result $dn1_standby_port "select hits + misses + skips from local_redo_prefetch_stat();" "0"
+  expected=$(gsql -d $db -p $dn1_primary_port -m -t -A -c "select count(*) || '|' || sum(val) from pf_t1;")
+  check_result $dn1_standby_port "select count(*) || '|' || sum(val) from pf_t1;" "$expected"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists pf_t1;"
+  kill_cluster
+  gs_guc set -Z datanode -D $standby_data_dir -c "recovery_max_workers = 1"
+  start_cluster
+}
+
+test_1
+tear_down
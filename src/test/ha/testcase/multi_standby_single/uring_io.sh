@@ -0,0 +1,72 @@
+#!/bin/sh
+# data file fsyncs, writebacks and prefetches go through io_uring when enable_uring_io is on,
+# and fall back to synchronous calls where io_uring is not available; both must give the same data
+
+source ./util.sh
+
+function check_tables() {
+  # $1 port
+  check_result $1 "select count(*), sum(id), sum(val) from uring_t1;" "200000|20000100000|900000"
+  check_result $1 "set enable_seqscan = off; set enable_indexscan = off; set effective_io_concurrency = 16; select count(*), sum(id) from uring_t1 where val = 3;" "20000|1999960000"
+  check_result $1 "select count(*) from pg_class where relname like 'uring_small%';" "100"
+  for i in 1 64 65 100
+  do
+    check_result $1 "select id from uring_small$i;" "$i"
+  done
+}
+
+function set_uring() {
+  # $1 on or off, $2 queue depth
+  for element in $primary_data_dir $standby_data_dir
+  do
+    gs_guc set -Z datanode -D $element -c "enable_uring_io = $1"
+    gs_guc set -Z datanode -D $element -c "uring_queue_depth = $2"
+  done
+}
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  set_uring on 32
+  start_cluster
+  check_detailed_instance
+  check_result $dn1_primary_port "show enable_uring_io;" "on"
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists uring_t1; create table uring_t1(id int, val int, pad char(100));"
+  gsql -d $db -p $dn1_primary_port -c "insert into uring_t1 select g, g % 10, 'x' from generate_series(1, 200000) g;"
+  gsql -d $db -p $dn1_primary_port -c "create index uring_t1_val on uring_t1 (val);"
+  # more dirty relations than one fsync batch of the checkpoint
+  for i in $(seq 1 100)
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists uring_small$i; create table uring_small$i(id int); insert into uring_small$i values ($i);" > /dev/null 2>&1
+  done
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  check_tables $dn1_primary_port
+
+  # data files synced by the checkpoint survive a crash
+  kill_primary
+  start_primary
+  check_tables $dn1_primary_port
+  sleep 5
+  check_tables $dn1_standby_port
+
+  # the same data reads back without io_uring
+  kill_cluster
+  set_uring off 256
+  start_cluster
+  check_tables $dn1_primary_port
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists uring_t1;"
+  for i in $(seq 1 100)
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists uring_small$i;" > /dev/null 2>&1
+  done
+}
+
+test_1
+tear_down
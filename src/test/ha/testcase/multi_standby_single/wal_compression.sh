@@ -0,0 +1,59 @@
+#!/bin/sh
+# full-page images are stored LZ4 compressed in WAL under wal_compression = lz4,
+# and restored from there by crash recovery and by standby replay
+
+source ./util.sh
+
+function set_full_page_writes() {
+  kill_cluster
+  for element in $primary_data_dir $standby_data_dir
+  do
+    gs_guc set -Z datanode -D $element -c "enable_incremental_checkpoint = $1"
+    gs_guc set -Z datanode -D $element -c "full_page_writes = $2"
+  done
+  start_cluster
+}
+
+function update_wal_bytes() {
+  # $1 wal_compression, $2 value written; WAL bytes of touching every page once after a checkpoint
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;" > /dev/null
+  start_lsn=$(gsql -d $db -p $dn1_primary_port -m -t -A -c "select pg_current_xlog_insert_location();")
+  gsql -d $db -p $dn1_primary_port -c "set wal_compression = $1; update fpi_t1 set val = $2;" > /dev/null
+  gsql -d $db -p $dn1_primary_port -m -t -A -c "select pg_xlog_location_diff(pg_current_xlog_insert_location(), '$start_lsn');"
+}
+
+function test_1()
+{
+  set_default
+  set_full_page_writes off on
+  check_detailed_instance
+
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists fpi_t1; create table fpi_t1(id int, val int, pad char(500)) with (fillfactor = 50);"
+  gsql -d $db -p $dn1_primary_port -c "insert into fpi_t1 select g, 0, 'x' from generate_series(1, 20000) g;"
+
+  plain_bytes=$(update_wal_bytes off 1)
+  lz4_bytes=$(update_wal_bytes lz4 2)
+  echo "WAL bytes with full-page images: $plain_bytes plain, $lz4_bytes lz4"
+  if [ $(echo "$lz4_bytes * 2 < $plain_bytes" | bc) -ne 1 ]; then
+    echo "wal compression $failed_keyword"
+    exit 1
+  fi
+  check_result $dn1_primary_port "select count(*), sum(val) from fpi_t1;" "20000|40000"
+
+  # no checkpoint since the compressed images were logged, so recovery restores them
+  kill_primary
+  start_primary
+  check_result $dn1_primary_port "select count(*), sum(val), count(distinct pad) from fpi_t1;" "20000|40000|1"
+  sleep 5
+  check_result $dn1_standby_port "select count(*), sum(val), count(distinct pad) from fpi_t1;" "20000|40000|1"
+}
+
+function tear_down()
+{
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists fpi_t1;"
+  set_full_page_writes on on
+}
+
+test_1
+tear_down
@@ -0,0 +1,83 @@
+#!/bin/sh
+# with enable_wal_insert_staging, WAL records are staged in per NUMA node rings and gathered in LSN order;
+# small wal_buffers keep the rings full, and multi-page records and xlog switches bypass them
+
+source ./util.sh
+
+function set_staging() {
+  # $1 on or off, $2 wal_buffers
+  kill_cluster
+  for element in $primary_data_dir $standby_data_dir
+  do
+    gs_guc set -Z datanode -D $element -c "enable_wal_insert_staging = $1"
+    gs_guc set -Z datanode -D $element -c "wal_buffers = $2"
+  done
+  start_cluster
+}
+
+function insert_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "insert into stage_t$1 select g, $i, repeat('x', 500) from generate_series(1, 500) g;" > /dev/null 2>&1
+  done
+}
+
+function switch_workload() {
+  for i in $(seq 1 20)
+  do
+    gsql -d $db -p $dn1_primary_port -c "select pg_switch_xlog();" > /dev/null 2>&1
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;" > /dev/null 2>&1
+  done
+}
+
+function check_tables() {
+  # $1 port
+  for t in 1 2 3 4
+  do
+    check_result $1 "select count(*), sum(val), count(distinct id) from stage_t$t;" "10000|105000|500"
+  done
+}
+
+function test_1()
+{
+  set_default
+  set_staging on 64kB
+  check_detailed_instance
+  check_result $dn1_primary_port "show enable_wal_insert_staging;" "on"
+
+  for t in 1 2 3 4
+  do
+    # the index splits log records with several full-page images, larger than a quarter of the ring
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists stage_t$t; create table stage_t$t(id int, val int, pad text); create index stage_t${t}_pad on stage_t$t (id, pad);"
+  done
+  for t in 1 2 3 4
+  do
+    insert_workload $t &
+  done
+  switch_workload &
+  wait
+
+  check_tables $dn1_primary_port
+  sleep 5
+  check_tables $dn1_standby_port
+
+  # the WAL gathered from the rings replays after a crash
+  kill_primary
+  start_primary
+  check_tables $dn1_primary_port
+
+  set_staging off 16MB
+  check_tables $dn1_primary_port
+}
+
+function tear_down()
+{
+  sleep 1
+  for t in 1 2 3 4
+  do
+    gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists stage_t$t;"
+  done
+}
+
+test_1
+tear_down
@@ -449,3 +449,32 @@ function check_cascade_detailed_instance(){
   check_dn_state "datanode1_standby" "db_state" "Normal" 1
   check_dn_state "datanode2_standby" "db_state" "Normal" 1
 }
+
+# append "name = value" to mot.conf of every datanode, takes effect on the next start
+function set_mot_conf() {
+  cluster_dns=($primary_data_dir $standby_data_dir $standby2_data_dir $standby3_data_dir $standby4_data_dir)
+  for element in ${cluster_dns[@]}
+  do
+    echo "$1 = $2 # ha test" >> $element/mot.conf
+  done
+}
+
+# remove every setting added by set_mot_conf
+function reset_mot_conf() {
+  cluster_dns=($primary_data_dir $standby_data_dir $standby2_data_dir $standby3_data_dir $standby4_data_dir)
+  for element in ${cluster_dns[@]}
+  do
+    sed -i '/# ha test$/d' $element/mot.conf
+  done
+}
+
+# check that a query returns the expected value, fail the test otherwise
+function check_result() {
+  # $1 port, $2 query, $3 expected value
+  if [ "$(gsql -d $db -p $1 -m -t -A -c "$2")" == "$3" ]; then
+    echo "check success: $2"
+  else
+    echo "check $failed_keyword: $2, expected $3"
+    exit 1
+  fi
+}
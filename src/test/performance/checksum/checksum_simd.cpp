@@ -0,0 +1,161 @@
+/* -------------------------------------------------------------------------
+ *
+ * checksum_simd.cpp
+ *    Checks the SIMD page checksum against the scalar one, and times both.
+ *
+ *    checksum_simd verify [pages]    compare on random pages at every 4-byte alignment
+ *    checksum_simd bench [rounds]    time both over a set of random pages
+ *
+ * The SIMD version is the one pg_checksum_block() uses on this machine: AVX2 on
+ * x86-64 (if the CPU has it), NEON on aarch64. checksum_simd_neon_emulation is
+ * the same program with the NEON version built over neon_emulation/arm_neon.h,
+ * so the NEON code is compiled and checked on x86-64 too.
+ *
+ * IDENTIFICATION
+ *    src/test/performance/checksum/checksum_simd.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef CHECKSUM_NEON_EMULATION
+/*
+ * The system headers are read above for the real target. Switch the target to
+ * aarch64 only for checksum_impl.cpp itself, so that it takes its NEON branch
+ * and its <arm_neon.h> is the emulation one.
+ */
+#undef __x86_64__
+#define __aarch64__ 1
+#define __ARM_NEON 1
+#endif
+
+#include "checksum_impl.cpp"
+
+#define PAGE_ALIGNMENTS 8 /* pages start at every 4-byte offset of a 32-byte line */
+#define BENCH_PAGES 64
+#define DEFAULT_VERIFY_PAGES 100000
+#define DEFAULT_BENCH_ROUNDS 20000
+
+#ifdef USE_ASSERT_CHECKING
+void ExceptionalCondition(const char* conditionName, const char* errorType, const char* fileName, int lineNumber)
+{
+    fprintf(stderr, "%s(\"%s\", File: \"%s\", Line: %d)\n", errorType, conditionName, fileName, lineNumber);
+    abort();
+}
+#endif
+
+static const char* simd_name(void)
+{
+#if defined(USE_AVX2_CHECKSUM_WITH_RUNTIME_CHECK)
+    return pg_checksum_avx2_available() ? "avx2" : "none (no avx2 on this cpu)";
+#elif defined(CHECKSUM_NEON_EMULATION)
+    return "neon (emulated)";
+#elif defined(USE_NEON_CHECKSUM)
+    return "neon";
+#else
+    return "none";
+#endif
+}
+
+static void fill_random(char* buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (char)(random() & 0xFF);
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int verify(long npages)
+{
+    char* buf = (char*)malloc(BLCKSZ + sizeof(uint32) * PAGE_ALIGNMENTS);
+    long failures = 0;
+
+    for (long n = 0; n < npages; n++) {
+        char* page = buf + sizeof(uint32) * (n % PAGE_ALIGNMENTS);
+
+        /* random pages, plus some all-zero and all-one pages */
+        if (n % 1000 == 1) {
+            memset(page, 0, BLCKSZ);
+        } else if (n % 1000 == 2) {
+            memset(page, 0xFF, BLCKSZ);
+        } else {
+            fill_random(page, BLCKSZ);
+        }
+
+        uint32 simd = pg_checksum_block(page, BLCKSZ);
+        uint32 scalar = pg_checksum_block_generic(page, BLCKSZ);
+        if (simd != scalar) {
+            fprintf(stderr, "page %ld at offset %ld: simd checksum %08x, scalar %08x\n", n,
+                (long)(sizeof(uint32) * (n % PAGE_ALIGNMENTS)), simd, scalar);
+            failures++;
+        }
+    }
+    free(buf);
+
+    printf("simd: %s, %ld pages, %ld mismatches\n", simd_name(), npages, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+static int bench(long rounds)
+{
+    char* pages = (char*)malloc((size_t)BLCKSZ * BENCH_PAGES);
+    volatile uint32 sink = 0;
+    double start;
+    double scalarNs;
+    double simdNs;
+
+    fill_random(pages, (size_t)BLCKSZ * BENCH_PAGES);
+    /* resolve the implementation before timing */
+    sink ^= pg_checksum_block(pages, BLCKSZ);
+
+    start = now_ns();
+    for (long r = 0; r < rounds; r++) {
+        for (int i = 0; i < BENCH_PAGES; i++) {
+            sink ^= pg_checksum_block_generic(pages + (size_t)BLCKSZ * i, BLCKSZ);
+        }
+    }
+    scalarNs = (now_ns() - start) / ((double)rounds * BENCH_PAGES);
+
+    start = now_ns();
+    for (long r = 0; r < rounds; r++) {
+        for (int i = 0; i < BENCH_PAGES; i++) {
+            sink ^= pg_checksum_block(pages + (size_t)BLCKSZ * i, BLCKSZ);
+        }
+    }
+    simdNs = (now_ns() - start) / ((double)rounds * BENCH_PAGES);
+    free(pages);
+
+    printf("simd: %s, block size %d\n", simd_name(), BLCKSZ);
+    printf("scalar: %8.1f ns/block %8.2f GB/s\n", scalarNs, BLCKSZ / scalarNs);
+    printf("simd:   %8.1f ns/block %8.2f GB/s (%.0f%% of scalar time)\n", simdNs, BLCKSZ / simdNs,
+        simdNs * 100.0 / scalarNs);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || (strcmp(argv[1], "verify") != 0 && strcmp(argv[1], "bench") != 0)) {
+        fprintf(stderr, "usage: %s verify [pages] | bench [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    /* fixed seed, so that a mismatch can be reproduced */
+    srandom(20201017);
+    if (strcmp(argv[1], "verify") == 0) {
+        return verify(argc > 2 ? atol(argv[2]) : DEFAULT_VERIFY_PAGES);
+    }
+    return bench(argc > 2 ? atol(argv[2]) : DEFAULT_BENCH_ROUNDS);
+}
@@ -0,0 +1,50 @@
+/* -------------------------------------------------------------------------
+ *
+ * arm_neon.h
+ *    The NEON intrinsics used by the page checksum, on top of GCC vector
+ *    extensions, so that its NEON version builds on any architecture.
+ *
+ *    checksum_simd_neon_emulation puts this directory first on the include
+ *    path, so checksum_impl.cpp gets this file for <arm_neon.h>; see
+ *    checksum_simd.cpp.
+ *
+ * IDENTIFICATION
+ *    src/test/performance/checksum/neon_emulation/arm_neon.h
+ *
+ * -------------------------------------------------------------------------
+ */
+#ifndef NEON_EMULATION_ARM_NEON_H
+#define NEON_EMULATION_ARM_NEON_H
+
+typedef uint32 uint32x4_t __attribute__((vector_size(16)));
+
+static inline uint32x4_t veorq_u32(uint32x4_t a, uint32x4_t b)
+{
+    return a ^ b;
+}
+
+static inline uint32x4_t vmulq_n_u32(uint32x4_t a, uint32 b)
+{
+    return a * b;
+}
+
+/* the shift count of vshrq_n_u32 must be a constant, as with NEON */
+#define vshrq_n_u32(a, n) ((uint32x4_t)((a) >> (n)))
+
+static inline uint32x4_t vld1q_u32(const uint32* ptr)
+{
+    uint32x4_t v;
+
+    __builtin_memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+
+static inline uint32x4_t vdupq_n_u32(uint32 value)
+{
+    uint32x4_t v = {value, value, value, value};
+    return v;
+}
+
+#define vgetq_lane_u32(v, lane) ((uint32)(v)[(lane)])
+
+#endif /* NEON_EMULATION_ARM_NEON_H */
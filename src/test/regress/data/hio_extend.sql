@@ -0,0 +1,2 @@
+\setrandom k 1 1000
+insert into hio_extend select :k, g, repeat('x', 200) from generate_series(1, 50) g;
@@ -0,0 +1,11 @@
+\setrandom w 1 4
+\setrandom d 1 10
+\setrandom o 1 50
+select w, d, sum(amount) from mot_jit_agg where w = :w and d = :d group by w, d;
+select sum(amount), d, w from mot_jit_agg where w = :w and d = :d group by w, d;
+select count(*) from mot_jit_agg where w = :w and d = :d and o > :o;
+select max(amount) from mot_jit_agg where w = :w and d = :d and o <= :o;
+select w, d, avg(amount) from mot_jit_agg where w = :w and d = :d and o between 5 and :o group by w, d;
+select w, d, min(amount) from mot_jit_agg where w = 100 and d = :d group by w, d;
+select sum(amount), 1 from mot_jit_agg where w = :w and d = :d;
+select count(*) from mot_jit_agg a, mot_jit_dist b where b.w = :w and b.d = :d and a.w = b.w and a.d = b.d;
@@ -0,0 +1,9 @@
+-- parameters|query, run by mot_jit_check with and without MOT JIT
+2 3|select w, d, sum(amount) from mot_jit_agg where w = $1 and d = $2 group by w, d
+4 10|select sum(amount), d, w from mot_jit_agg where w = $1 and d = $2 group by w, d
+1 1 40|select count(*) from mot_jit_agg where w = $1 and d = $2 and o > $3
+3 7 25|select max(amount) from mot_jit_agg where w = $1 and d = $2 and o <= $3
+1 2 14|select w, d, avg(amount) from mot_jit_agg where w = $1 and d = $2 and o between 5 and $3 group by w, d
+1|select w, d, min(amount) from mot_jit_agg where w = 100 and d = $1 group by w, d
+2 2|select sum(amount), 1 from mot_jit_agg where w = $1 and d = $2
+3 4|select count(*) from mot_jit_agg a, mot_jit_dist b where b.w = $1 and b.d = $2 and a.w = b.w and a.d = b.d
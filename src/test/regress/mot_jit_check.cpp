@@ -0,0 +1,162 @@
+/*-------------------------------------------------------------------------
+ *
+ * mot_jit_check --- compare MOT JIT results with the regular executor
+ *
+ * MOT queries are JIT compiled only when they are parsed through the
+ * extended query protocol, which psql never uses.  This client reads a
+ * file of parameterized queries, runs each one as a protocol-level
+ * prepared statement (JIT on) and as an SQL PREPARE/EXECUTE (JIT off),
+ * prints the JIT result and reports whether both results are the same.
+ *
+ * Each line of the query file holds the parameter values, separated by
+ * spaces, then a '|' and the query text, using $1, $2, ... for the
+ * parameters.  Empty lines and lines starting with "--" are skipped.
+ *
+ * src/test/regress/mot_jit_check.cpp
+ *
+ *-------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "libpq-fe.h"
+
+#define MAX_LINE_LEN 1024
+#define MAX_PARAMS 16
+#define EXEC_COUNT 3
+
+static void exit_nicely(PGconn* conn)
+{
+    PQfinish(conn);
+    exit(1);
+}
+
+static PGresult* check_result(PGconn* conn, PGresult* res, ExecStatusType expected, const char* what)
+{
+    if (PQresultStatus(res) != expected) {
+        fprintf(stderr, "%s failed: %s", what, PQerrorMessage(conn));
+        PQclear(res);
+        exit_nicely(conn);
+    }
+    return res;
+}
+
+static void print_rows(PGresult* res)
+{
+    for (int i = 0; i < PQntuples(res); i++) {
+        for (int j = 0; j < PQnfields(res); j++) {
+            printf("%s%s", (j > 0) ? "|" : "", PQgetisnull(res, i, j) ? "null" : PQgetvalue(res, i, j));
+        }
+        printf("\n");
+    }
+}
+
+static bool same_rows(PGresult* a, PGresult* b)
+{
+    if (PQntuples(a) != PQntuples(b) || PQnfields(a) != PQnfields(b)) {
+        return false;
+    }
+    for (int i = 0; i < PQntuples(a); i++) {
+        for (int j = 0; j < PQnfields(a); j++) {
+            if (PQgetisnull(a, i, j) != PQgetisnull(b, i, j) ||
+                strcmp(PQgetvalue(a, i, j), PQgetvalue(b, i, j)) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void check_query(PGconn* conn, int queryno, char* line)
+{
+    char* query = strchr(line, '|');
+    const char* params[MAX_PARAMS];
+    int nparams = 0;
+    char name[32];
+    char sql[MAX_LINE_LEN * 2];
+    PGresult* jit = NULL;
+    PGresult* res = NULL;
+
+    if (query == NULL) {
+        fprintf(stderr, "query %d: missing '|' after the parameters\n", queryno);
+        exit_nicely(conn);
+    }
+    *query++ = '\0';
+    for (char* tok = strtok(line, " "); tok != NULL; tok = strtok(NULL, " ")) {
+        if (nparams == MAX_PARAMS) {
+            fprintf(stderr, "query %d: too many parameters\n", queryno);
+            exit_nicely(conn);
+        }
+        params[nparams++] = tok;
+    }
+
+    /* the query is JIT compiled when the protocol-level Parse message is handled */
+    snprintf(name, sizeof(name), "jit_%d", queryno);
+    PQclear(check_result(conn, PQprepare(conn, name, query, 0, NULL), PGRES_COMMAND_OK, "prepare"));
+    for (int i = 0; i < EXEC_COUNT; i++) {
+        PQclear(jit);
+        jit = check_result(conn, PQexecPrepared(conn, name, nparams, params, NULL, NULL, 0), PGRES_TUPLES_OK,
+            "execute prepared");
+    }
+
+    /* SQL PREPARE is not JIT compiled, so EXECUTE runs the regular executor */
+    snprintf(sql, sizeof(sql), "PREPARE nojit_%d AS %s", queryno, query);
+    PQclear(check_result(conn, PQexec(conn, sql), PGRES_COMMAND_OK, "PREPARE"));
+    int len = snprintf(sql, sizeof(sql), "EXECUTE nojit_%d", queryno);
+    for (int i = 0; i < nparams; i++) {
+        len += snprintf(sql + len, sizeof(sql) - len, "%s%s", (i > 0) ? ", " : "(", params[i]);
+    }
+    snprintf(sql + len, sizeof(sql) - len, "%s", (nparams > 0) ? ")" : "");
+    res = check_result(conn, PQexec(conn, sql), PGRES_TUPLES_OK, "EXECUTE");
+
+    bool same = same_rows(jit, res);
+    printf("query %d: %d row(s), %s\n", queryno, PQntuples(jit),
+        same ? "same as without JIT" : "DIFFERENT from without JIT");
+    print_rows(jit);
+    if (!same) {
+        printf("without JIT:\n");
+        print_rows(res);
+    }
+    PQclear(jit);
+    PQclear(res);
+}
+
+int main(int argc, char** argv)
+{
+    const char* conninfo = NULL;
+    FILE* file = NULL;
+    PGconn* conn = NULL;
+    char line[MAX_LINE_LEN];
+    int queryno = 0;
+
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s CONNINFO QUERYFILE\n", argv[0]);
+        exit(1);
+    }
+    conninfo = argv[1];
+
+    file = fopen(argv[2], "r");
+    if (file == NULL) {
+        fprintf(stderr, "could not open file \"%s\"\n", argv[2]);
+        exit(1);
+    }
+
+    conn = PQconnectdb(conninfo);
+    if (PQstatus(conn) != CONNECTION_OK) {
+        fprintf(stderr, "connection to database failed: %s", PQerrorMessage(conn));
+        fclose(file);
+        exit_nicely(conn);
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || strncmp(line, "--", 2) == 0) {
+            continue;
+        }
+        check_query(conn, ++queryno, line);
+    }
+
+    fclose(file);
+    PQfinish(conn);
+    return 0;
+}
@@ -0,0 +1,46 @@
+--
+-- enable_flat_expr evaluates row expressions as step programs; every query
+-- below must return the same rows with it on and off
+--
+create table flat_expr_t (id int, a int, b int, c text, d bool);
+insert into flat_expr_t values (1, 0, 1, 'a', true), (2, 1, null, 'bb', false), (3, 2, 3, null, null),
+    (4, null, 4, 'dddd', true), (5, 5, 5, 'eeeee', null), (6, null, null, null, false);
+
+set enable_flat_expr = on;
+-- NULL handling
+select id, a + 1 as a1, a + b as ab, a = 2 as a_eq, b < 3 as b_lt, length(c) as len, c || 'x' as cx from flat_expr_t order by id;
+-- strict functions
+select id, int4pl(a, b) as pl, abs(a - b) as diff, upper(c) as up from flat_expr_t order by id;
+-- AND/OR stop at the first deciding argument
+select id, a <> 0 and 10 / a > 1 as and_sc, a = 0 or 10 / a > 1 as or_sc, a > 1 and b > 1 as and3, a > 1 or b > 1 as or3, not (a > 1) as not3 from flat_expr_t order by id;
+-- NullTest and BooleanTest
+select id, a is null as a_null, c is not null as c_nn, d is true as d_true, d is not false as d_nf, d is unknown as d_unk, (a > 1) is not true as gt_nt from flat_expr_t order by id;
+-- CASE
+select id, case when a is null then 'null' when a > 1 then 'big' else 'small' end as size, case b when 1 then 'one' when 3 then 'three' else 'other' end as bname from flat_expr_t order by id;
+-- Var op Const quals
+select id from flat_expr_t where a = 2 order by id;
+select id from flat_expr_t where b < 4 order by id;
+select id from flat_expr_t where c = 'bb' order by id;
+select id from flat_expr_t where a <> 0 and 10 / a > 1 order by id;
+select id from flat_expr_t where d or a is null order by id;
+
+set enable_flat_expr = off;
+-- NULL handling
+select id, a + 1 as a1, a + b as ab, a = 2 as a_eq, b < 3 as b_lt, length(c) as len, c || 'x' as cx from flat_expr_t order by id;
+-- strict functions
+select id, int4pl(a, b) as pl, abs(a - b) as diff, upper(c) as up from flat_expr_t order by id;
+-- AND/OR stop at the first deciding argument
+select id, a <> 0 and 10 / a > 1 as and_sc, a = 0 or 10 / a > 1 as or_sc, a > 1 and b > 1 as and3, a > 1 or b > 1 as or3, not (a > 1) as not3 from flat_expr_t order by id;
+-- NullTest and BooleanTest
+select id, a is null as a_null, c is not null as c_nn, d is true as d_true, d is not false as d_nf, d is unknown as d_unk, (a > 1) is not true as gt_nt from flat_expr_t order by id;
+-- CASE
+select id, case when a is null then 'null' when a > 1 then 'big' else 'small' end as size, case b when 1 then 'one' when 3 then 'three' else 'other' end as bname from flat_expr_t order by id;
+-- Var op Const quals
+select id from flat_expr_t where a = 2 order by id;
+select id from flat_expr_t where b < 4 order by id;
+select id from flat_expr_t where c = 'bb' order by id;
+select id from flat_expr_t where a <> 0 and 10 / a > 1 order by id;
+select id from flat_expr_t where d or a is null order by id;
+
+reset enable_flat_expr;
+drop table flat_expr_t;
@@ -0,0 +1,73 @@
+--
+-- hash join bloom filters are pushed into the scans of the probe side, but
+-- never below a Limit or a window function. The planner only places them in
+-- smp plans.
+--
+create function bf_explain(query text) returns setof text language plpgsql as $$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (costs off) ' || query loop
+        if ln like '%Seq Scan on%' or ln like '%CStore Scan on%' or ln like '%Bloom Filter%' then
+            return next ltrim(ln, ' ->');
+        end if;
+    end loop;
+end;
+$$;
+create table bf_probe_row (a int, b int);
+create table bf_build_row (a int);
+create table bf_probe_col (a int, b int) with (orientation = column);
+create table bf_build_col (a int) with (orientation = column);
+insert into bf_probe_row select i, i % 10 from generate_series(1, 10000) i;
+insert into bf_build_row select i from generate_series(5000, 5010) i;
+insert into bf_probe_col select * from bf_probe_row;
+insert into bf_build_col select * from bf_build_row;
+analyze bf_probe_row;
+analyze bf_build_row;
+analyze bf_probe_col;
+analyze bf_build_col;
+set enable_nestloop = off;
+set enable_mergejoin = off;
+set query_dop = 2;
+set enable_bloom_filter = on;
+-- the filter is attached to the probe scan, and not below the LIMIT or the window function
+select * from bf_explain('select count(*), sum(p.a) from bf_probe_row p join bf_build_row b on p.a = b.a');
+select * from bf_explain('select count(*) from (select a from bf_probe_row order by a limit 100) p join bf_build_row b on p.a = b.a');
+select * from bf_explain('select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_row) p join bf_build_row b on p.a = b.a');
+select * from bf_explain('select count(*), sum(p.a) from bf_probe_col p join bf_build_col b on p.a = b.a');
+select * from bf_explain('select count(*) from (select a from bf_probe_col order by a limit 100) p join bf_build_col b on p.a = b.a');
+select * from bf_explain('select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_col) p join bf_build_col b on p.a = b.a');
+-- the filter may drop probe rows of a plain scan
+select count(*), sum(p.a) from bf_probe_row p join bf_build_row b on p.a = b.a;
+-- a LIMIT over the probe scan must see the rows without a match
+select count(*) from (select a from bf_probe_row order by a limit 100) p join bf_build_row b on p.a = b.a;
+-- so must a window function
+select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_row) p join bf_build_row b on p.a = b.a;
+-- the filter may drop probe rows of a plain scan
+select count(*), sum(p.a) from bf_probe_col p join bf_build_col b on p.a = b.a;
+-- a LIMIT over the probe scan must see the rows without a match
+select count(*) from (select a from bf_probe_col order by a limit 100) p join bf_build_col b on p.a = b.a;
+-- so must a window function
+select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_col) p join bf_build_col b on p.a = b.a;
+set enable_bloom_filter = off;
+-- the filter may drop probe rows of a plain scan
+select count(*), sum(p.a) from bf_probe_row p join bf_build_row b on p.a = b.a;
+-- a LIMIT over the probe scan must see the rows without a match
+select count(*) from (select a from bf_probe_row order by a limit 100) p join bf_build_row b on p.a = b.a;
+-- so must a window function
+select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_row) p join bf_build_row b on p.a = b.a;
+-- the filter may drop probe rows of a plain scan
+select count(*), sum(p.a) from bf_probe_col p join bf_build_col b on p.a = b.a;
+-- a LIMIT over the probe scan must see the rows without a match
+select count(*) from (select a from bf_probe_col order by a limit 100) p join bf_build_col b on p.a = b.a;
+-- so must a window function
+select count(*), sum(p.rn) from (select a, row_number() over (order by a) as rn from bf_probe_col) p join bf_build_col b on p.a = b.a;
+reset enable_bloom_filter;
+reset query_dop;
+reset enable_mergejoin;
+reset enable_nestloop;
+drop table bf_probe_row;
+drop table bf_build_row;
+drop table bf_probe_col;
+drop table bf_build_col;
+drop function bf_explain(text);
@@ -0,0 +1,61 @@
+--
+-- LLVM generated quals and tuple deforming for row table seq scans; every
+-- query below must return the same rows with enable_codegen on and off
+--
+create table llvm_rowscan_t (id int4 not null, i2 int2, i4 int4, i8 int8, f4 float4, f8 float8, t text, tail int4);
+insert into llvm_rowscan_t select i,
+    case when i % 7 = 0 then null else i % 100 end,
+    case when i % 11 = 0 then null else i - 500 end,
+    case when i % 13 = 0 then null else i * 10000000000 end,
+    case when i % 17 = 0 then null else i / 4.0 end,
+    case when i % 19 = 0 then 'NaN' when i % 23 = 0 then null else i - 500.5 end,
+    'row' || i, i
+    from generate_series(1, 1000) i;
+-- older tuples have fewer attributes than the descriptor
+alter table llvm_rowscan_t add column extra int4;
+insert into llvm_rowscan_t select i,
+    case when i % 7 = 0 then null else i % 100 end,
+    case when i % 11 = 0 then null else i - 500 end,
+    case when i % 13 = 0 then null else i * 10000000000 end,
+    case when i % 17 = 0 then null else i / 4.0 end,
+    case when i % 19 = 0 then 'NaN' when i % 23 = 0 then null else i - 500.5 end,
+    'row' || i, i, i - 1005
+    from generate_series(1001, 1010) i;
+set codegen_cost_threshold = 0;
+set enable_codegen = on;
+select count(*), sum(id) from llvm_rowscan_t where i2 = 42;
+select count(*), sum(id) from llvm_rowscan_t where i4 < 0 and i4 >= -100;
+select count(*), sum(id) from llvm_rowscan_t where i8 > 5000000000000;
+select count(*), sum(id) from llvm_rowscan_t where f4 <= 100.5;
+select count(*), sum(id) from llvm_rowscan_t where f8 > 0;
+select count(*), sum(id) from llvm_rowscan_t where f8 < 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where f8 = 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where f8 <> 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where id >= 990;
+select count(*), sum(id) from llvm_rowscan_t where i2 is null or i4 is null;
+select count(*), sum(id) from llvm_rowscan_t where not (i4 > 0);
+select count(*), sum(id) from llvm_rowscan_t where i2 is not null and not (f4 > 10 or f8 < 0);
+select count(*), sum(id) from llvm_rowscan_t where i4 > 0 and tail = id;
+select count(*), sum(id) from llvm_rowscan_t where extra is null;
+select count(*), sum(id) from llvm_rowscan_t where extra > 0 or i2 < 3;
+select sum(i2), sum(i4), sum(i8), count(f4), max(f4), min(f8) from llvm_rowscan_t;
+set enable_codegen = off;
+select count(*), sum(id) from llvm_rowscan_t where i2 = 42;
+select count(*), sum(id) from llvm_rowscan_t where i4 < 0 and i4 >= -100;
+select count(*), sum(id) from llvm_rowscan_t where i8 > 5000000000000;
+select count(*), sum(id) from llvm_rowscan_t where f4 <= 100.5;
+select count(*), sum(id) from llvm_rowscan_t where f8 > 0;
+select count(*), sum(id) from llvm_rowscan_t where f8 < 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where f8 = 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where f8 <> 'NaN';
+select count(*), sum(id) from llvm_rowscan_t where id >= 990;
+select count(*), sum(id) from llvm_rowscan_t where i2 is null or i4 is null;
+select count(*), sum(id) from llvm_rowscan_t where not (i4 > 0);
+select count(*), sum(id) from llvm_rowscan_t where i2 is not null and not (f4 > 10 or f8 < 0);
+select count(*), sum(id) from llvm_rowscan_t where i4 > 0 and tail = id;
+select count(*), sum(id) from llvm_rowscan_t where extra is null;
+select count(*), sum(id) from llvm_rowscan_t where extra > 0 or i2 < 3;
+select sum(i2), sum(i4), sum(i8), count(f4), max(f4), min(f8) from llvm_rowscan_t;
+reset enable_codegen;
+reset codegen_cost_threshold;
+drop table llvm_rowscan_t;
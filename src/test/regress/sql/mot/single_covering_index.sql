@@ -0,0 +1,30 @@
+--
+-- Covering secondary indexes: queries that refer only to key and included columns are served from the index
+--
+drop foreign table if exists mot_cov;
+create foreign table mot_cov (id int not null, a int not null, b varchar(20), c int, primary key (id)) server mot_server;
+create index mot_cov_a on mot_cov (a) include (b);
+insert into mot_cov select g, g % 100, case when g % 7 = 0 then null else 'b' || g end, g from generate_series(1, 1000) g;
+-- covered columns only
+select a, b from mot_cov where a = 5 order by b;
+select count(*), count(b) from mot_cov where a = 7;
+select b from mot_cov where a = 0 and b is null order by 1;
+-- columns outside of the index are read from the row
+select a, b, c from mot_cov where a = 5 order by c;
+-- changes are visible through the index entry
+delete from mot_cov where id = 105;
+update mot_cov set c = -c where a = 5;
+select a, b from mot_cov where a = 5 order by b;
+select sum(c) from mot_cov where a = 5;
+begin;
+insert into mot_cov values (1005, 5, 'b1005', 1005);
+select a, b from mot_cov where a = 5 and b = 'b1005';
+rollback;
+select a, b from mot_cov where a = 5 and b = 'b1005';
+insert into mot_cov values (1005, 5, 'b1005', 1005);
+select a, b from mot_cov where a = 5 and b = 'b1005';
+-- included columns are index columns, so they cannot be updated
+update mot_cov set b = 'x' where id = 5;
+drop index mot_cov_a;
+select count(*), count(b) from mot_cov where a = 7;
+drop foreign table mot_cov;
@@ -0,0 +1,32 @@
+--
+-- VACUUM compacts the row pool of a MOT table while keeping its contents and indexes intact
+--
+drop foreign table if exists mot_vac;
+create foreign table mot_vac (id int not null, grp int, name varchar(100), primary key (id)) server mot_server;
+create index mot_vac_grp on mot_vac (grp);
+insert into mot_vac select g, g % 10, 'name ' || g from generate_series(1, 20000) g;
+create table mot_vac_size (phase text, size bigint);
+insert into mot_vac_size select 'full', pg_relation_size('mot_vac');
+-- leave a sparse row pool behind
+delete from mot_vac where id % 10 <> 0;
+select count(*), sum(id) from mot_vac;
+vacuum mot_vac;
+-- a second pass releases the pools that were still referenced by retired rows
+vacuum mot_vac;
+insert into mot_vac_size select 'compacted', pg_relation_size('mot_vac');
+select (select size from mot_vac_size where phase = 'compacted') <= (select size from mot_vac_size where phase = 'full');
+-- contents, primary key and secondary index lookups after relocation
+select count(*), sum(id), min(name), max(name) from mot_vac;
+select * from mot_vac where id = 12340;
+select count(*) from mot_vac where grp = 0;
+select count(*) from mot_vac where id = 12341;
+-- relocated rows can be updated, deleted and re-inserted
+update mot_vac set name = 'updated' where id between 100 and 200;
+select count(*) from mot_vac where name = 'updated';
+delete from mot_vac where id = 20000;
+insert into mot_vac values (20000, 0, 'again');
+select * from mot_vac where id = 20000;
+vacuum mot_vac;
+select count(*), sum(id) from mot_vac;
+drop table mot_vac_size;
+drop foreign table mot_vac;
@@ -0,0 +1,43 @@
+--
+-- row tables created with compresstype = lz4 store their pages compressed
+--
+create table compresstype_bad (a int) with (compresstype = zstd);
+create table compresstype_col (a int) with (orientation = column, compresstype = lz4);
+create unlogged table compresstype_unlogged (a int) with (compresstype = lz4);
+create table compresstype_part (a int) with (compresstype = lz4)
+partition by range (a) (partition p1 values less than (100), partition p2 values less than (maxvalue));
+
+create table compresstype_lz4 (a int, b text) with (compresstype = lz4);
+create table compresstype_plain (a int, b text);
+select 'compresstype=lz4' = any(reloptions) as lz4 from pg_class where relname = 'compresstype_lz4';
+alter table compresstype_lz4 set (compresstype = none);
+-- every segment file has an address file next to it
+select (pg_stat_file(pg_relation_filepath('compresstype_lz4') || '_pca')).isdir;
+
+insert into compresstype_lz4 select i, repeat('openGauss', 20) || i from generate_series(1, 20000) i;
+insert into compresstype_plain select * from compresstype_lz4;
+checkpoint;
+select count(*), sum(a), count(distinct b) from compresstype_lz4;
+select pg_relation_size('compresstype_lz4') < pg_relation_size('compresstype_plain') / 2 as compressed;
+select count(*) from compresstype_lz4 l join compresstype_plain p on l.a = p.a and l.b = p.b;
+
+-- rewritten pages keep using the chunks of their block
+update compresstype_lz4 set b = md5(b) where a % 3 = 0;
+delete from compresstype_lz4 where a % 5 = 0;
+vacuum compresstype_lz4;
+checkpoint;
+select count(*), sum(a), sum(length(b)) from compresstype_lz4;
+select count(*) from compresstype_lz4 where b like 'openGauss%';
+
+-- a new relfilenode is compressed as well
+vacuum full compresstype_lz4;
+select (pg_stat_file(pg_relation_filepath('compresstype_lz4') || '_pca')).isdir;
+select count(*), sum(a), sum(length(b)) from compresstype_lz4;
+truncate compresstype_lz4;
+select (pg_stat_file(pg_relation_filepath('compresstype_lz4') || '_pca')).isdir;
+insert into compresstype_lz4 select i, repeat('x', i % 100) from generate_series(1, 1000) i;
+checkpoint;
+select count(*), sum(length(b)) from compresstype_lz4;
+
+drop table compresstype_lz4;
+drop table compresstype_plain;
@@ -0,0 +1,36 @@
+--
+-- smp workers of a seq scan take their blocks from a shared allocator; every
+-- row must be returned exactly once, whatever the dop
+--
+create table smp_seqscan_t (id int, pad char(500));
+insert into smp_seqscan_t select i, 'x' from generate_series(1, 30000) i;
+analyze smp_seqscan_t;
+set query_dop = 4;
+select count(*), sum(id), count(distinct id) from smp_seqscan_t;
+select count(*), sum(id) from smp_seqscan_t where id % 7 = 0;
+select id % 5 as g, count(*), sum(id) from smp_seqscan_t group by 1 order by 1;
+select count(*), sum(a.id) from smp_seqscan_t a join smp_seqscan_t b on a.id = b.id where b.id % 100 = 0;
+select count(*) from (select id from smp_seqscan_t limit 100) s;
+set query_dop = 1;
+select count(*), sum(id), count(distinct id) from smp_seqscan_t;
+select count(*), sum(id) from smp_seqscan_t where id % 7 = 0;
+select id % 5 as g, count(*), sum(id) from smp_seqscan_t group by 1 order by 1;
+select count(*), sum(a.id) from smp_seqscan_t a join smp_seqscan_t b on a.id = b.id where b.id % 100 = 0;
+select count(*) from (select id from smp_seqscan_t limit 100) s;
+-- empty pages in the middle of the table
+delete from smp_seqscan_t where id between 5000 and 20000;
+vacuum smp_seqscan_t;
+set query_dop = 4;
+select count(*), sum(id), count(distinct id) from smp_seqscan_t;
+select count(*), sum(id) from smp_seqscan_t where id % 7 = 0;
+select id % 5 as g, count(*), sum(id) from smp_seqscan_t group by 1 order by 1;
+select count(*), sum(a.id) from smp_seqscan_t a join smp_seqscan_t b on a.id = b.id where b.id % 100 = 0;
+select count(*) from (select id from smp_seqscan_t limit 100) s;
+set query_dop = 1;
+select count(*), sum(id), count(distinct id) from smp_seqscan_t;
+select count(*), sum(id) from smp_seqscan_t where id % 7 = 0;
+select id % 5 as g, count(*), sum(id) from smp_seqscan_t group by 1 order by 1;
+select count(*), sum(a.id) from smp_seqscan_t a join smp_seqscan_t b on a.id = b.id where b.id % 100 = 0;
+select count(*) from (select id from smp_seqscan_t limit 100) s;
+reset query_dop;
+drop table smp_seqscan_t;
@@ -0,0 +1,42 @@
+--
+-- smp threads of a Sonic hash join share one hash table under
+-- enable_sonic_shared_hashjoin; the joins must return the same rows as with
+-- a table per thread
+--
+create table sonic_shared_o (a int, b text) with (orientation = column);
+create table sonic_shared_i (a int, b text, c numeric) with (orientation = column);
+insert into sonic_shared_o select i % 1500, 'o' || i % 10 from generate_series(1, 20000) i;
+insert into sonic_shared_i select case when j % 50 = 0 then null else j end, 'i' || j % 3, j * 1.5
+    from generate_series(1, 1000) j;
+-- keys with two matches
+insert into sonic_shared_i select case when j % 50 = 0 then null else j end, 'i' || j % 3, j * 1.5
+    from generate_series(1, 100) j;
+analyze sonic_shared_o;
+analyze sonic_shared_i;
+set query_dop = 4;
+set enable_sonic_hashjoin = on;
+set enable_nestloop = off;
+set enable_mergejoin = off;
+set enable_sonic_shared_hashjoin = on;
+select count(*), sum(o.a), count(distinct i.b) from sonic_shared_o o join sonic_shared_i i on o.a = i.a;
+-- Sonic hash joins are inner joins only, these fall back to the vectorized hash join
+select count(*), count(i.a) from sonic_shared_o o left join sonic_shared_i i on o.a = i.a;
+select count(*) from sonic_shared_o o where o.a in (select a from sonic_shared_i);
+select count(*) from sonic_shared_o o where not exists (select 1 from sonic_shared_i i where i.a = o.a);
+-- the build side carries a numeric column, so it is never shared
+select count(*), sum(i.c) from sonic_shared_o o join sonic_shared_i i on o.a = i.a;
+set enable_sonic_shared_hashjoin = off;
+select count(*), sum(o.a), count(distinct i.b) from sonic_shared_o o join sonic_shared_i i on o.a = i.a;
+-- Sonic hash joins are inner joins only, these fall back to the vectorized hash join
+select count(*), count(i.a) from sonic_shared_o o left join sonic_shared_i i on o.a = i.a;
+select count(*) from sonic_shared_o o where o.a in (select a from sonic_shared_i);
+select count(*) from sonic_shared_o o where not exists (select 1 from sonic_shared_i i where i.a = o.a);
+-- the build side carries a numeric column, so it is never shared
+select count(*), sum(i.c) from sonic_shared_o o join sonic_shared_i i on o.a = i.a;
+reset enable_sonic_shared_hashjoin;
+reset enable_mergejoin;
+reset enable_nestloop;
+reset enable_sonic_hashjoin;
+reset query_dop;
+drop table sonic_shared_o;
+drop table sonic_shared_i;